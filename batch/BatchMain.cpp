@@ -0,0 +1,85 @@
+#include "core/BatchRunner.hpp"
+#include "core/Logger.hpp"
+#include <chrono>
+#include <cstdio>
+#include <exception>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+/**
+ * @file BatchMain.cpp
+ * @brief Entry point of parklogic_batch, the headless parameter sweep runner.
+ *
+ * Usage:
+ *
+ *     parklogic_batch <sweep-file> [--report=<csv>] [--runs=<csv>] [--threads=<n>]
+ *
+ * Runs every combination of the sweep file (see SweepSpec) and writes the aggregate report
+ * (mean and standard deviation over the seeds of each combination, default batch_report.csv).
+ * --runs additionally writes one row per run; --threads overrides the file's thread count.
+ */
+
+namespace {
+void writeFile(const std::string &path, const std::vector<BatchRun> &runs, const std::vector<BatchResult> &results,
+               void (*write)(std::ostream &, const std::vector<BatchRun> &, const std::vector<BatchResult> &)) {
+  std::ofstream out(path);
+  if (!out)
+    throw std::runtime_error("Could not write " + path);
+  write(out, runs, results);
+}
+} // namespace
+
+int main(int argc, char **argv) {
+  try {
+    std::string sweepPath;
+    std::string reportPath = "batch_report.csv";
+    std::string runsPath;
+    int threads = -1;
+
+    for (int i = 1; i < argc; ++i) {
+      std::string arg = argv[i];
+      if (arg.rfind("--report=", 0) == 0)
+        reportPath = arg.substr(9);
+      else if (arg.rfind("--runs=", 0) == 0)
+        runsPath = arg.substr(7);
+      else if (arg.rfind("--threads=", 0) == 0)
+        threads = std::stoi(arg.substr(10));
+      else if (arg.rfind("--", 0) != 0 && sweepPath.empty())
+        sweepPath = arg;
+      else
+        throw std::runtime_error("Unexpected argument: " + arg);
+    }
+    if (sweepPath.empty())
+      throw std::runtime_error("Usage: parklogic_batch <sweep-file> [--report=<csv>] [--runs=<csv>] [--threads=<n>]");
+
+    SweepSpec spec = SweepSpec::load(sweepPath);
+    if (threads >= 0)
+      spec.threads = threads;
+    std::vector<BatchRun> runs = spec.expand();
+
+    // Per-car info messages of hundreds of simultaneous simulations are noise here
+    Logger::SetLevel(Logger::Level::Warning);
+    std::printf("Running %zu simulations of %.0f s...\n", runs.size(), spec.duration);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<BatchResult> results =
+        BatchRunner::runAll(runs, spec.duration, spec.threads, [](size_t done, size_t total) {
+          std::printf("\r%zu / %zu", done, total);
+          std::fflush(stdout);
+        });
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("\nDone in %.1f s\n", seconds);
+
+    writeFile(reportPath, runs, results, &BatchRunner::writeReport);
+    std::printf("Report written to %s\n", reportPath.c_str());
+    if (!runsPath.empty()) {
+      writeFile(runsPath, runs, results, &BatchRunner::writeRuns);
+      std::printf("Runs written to %s\n", runsPath.c_str());
+    }
+  } catch (const std::exception &e) {
+    Logger::Error("Batch Error: {}", e.what());
+    return -1;
+  }
+  return 0;
+}
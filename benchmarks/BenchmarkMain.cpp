@@ -0,0 +1,35 @@
+#include <benchmark/benchmark.h>
+#include "raylib.h"
+#include <iostream>
+#include <streambuf>
+
+namespace {
+// Swallows Logger output so it does not interleave with the benchmark table.
+class NullBuffer : public std::streambuf {
+protected:
+    int overflow(int c) override { return c; }
+};
+} // namespace
+
+// --- Main ---
+int main(int argc, char **argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    // BenchmarkWorld seeds every simulation alike, so results are comparable across commits
+    SetTraceLogLevel(LOG_NONE);
+
+    NullBuffer nullBuffer;
+    std::ostream console(std::cout.rdbuf());
+    std::cout.rdbuf(&nullBuffer);
+
+    benchmark::ConsoleReporter reporter;
+    reporter.SetOutputStream(&console);
+    reporter.SetErrorStream(&console);
+    benchmark::RunSpecifiedBenchmarks(&reporter);
+    benchmark::Shutdown();
+
+    std::cout.rdbuf(console.rdbuf());
+    return 0;
+}
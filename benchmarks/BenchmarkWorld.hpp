@@ -0,0 +1,68 @@
+#pragma once
+#include "config.hpp"
+#include "core/EntityManager.hpp"
+#include "core/EventBus.hpp"
+#include "entities/map/Modules.hpp"
+#include "events/GameEvents.hpp"
+#include "systems/MetricsRecorder.hpp"
+#include "systems/OccupancyStats.hpp"
+#include "systems/TrackingSystem.hpp"
+#include "systems/TrafficSystem.hpp"
+#include <cstdint>
+#include <memory>
+
+/**
+ * @file BenchmarkWorld.hpp
+ * @brief Headless simulation setup shared by the benchmarks.
+ */
+
+/// Seed of every benchmark simulation (same random sequence on every run).
+constexpr uint64_t BENCHMARK_SEED = 42;
+
+/**
+ * @struct BenchmarkWorld
+ * @brief The simulation-side systems of GameScene, without window, camera or UI.
+ *
+ * Ticking it with GameUpdateEvent runs exactly what the simulation thread runs in the game.
+ */
+struct BenchmarkWorld {
+    std::shared_ptr<EventBus> bus = std::make_shared<EventBus>();
+    EntityManager entityManager{bus};
+    TrackingSystem trackingSystem{bus, entityManager};
+    TrafficSystem trafficSystem{bus, entityManager};
+    MetricsRecorder metricsRecorder{bus, entityManager};
+
+    explicit BenchmarkWorld(const MapConfig &config) {
+        entityManager.getRandom().reseed(BENCHMARK_SEED);
+        bus->publish(GenerateWorldEvent{config});
+    }
+
+    /**
+     * @brief Requests @p count spawns and lets the cars drive in for @p warmupTicks ticks.
+     */
+    void populate(int count, int warmupTicks) {
+        for (int i = 0; i < count; i++)
+            bus->publish(SpawnCarRequestEvent{});
+        for (int i = 0; i < warmupTicks; i++)
+            tick();
+    }
+
+    void tick() { bus->publish(GameUpdateEvent{1.0 / 60.0}); }
+
+    /**
+     * @brief First facility (parking or charging) of the generated map, or nullptr.
+     */
+    Module *firstFacility() const {
+        for (const auto &module : entityManager.getModules()) {
+            ModuleType type = module->getType();
+            if (OccupancyStats::isParking(type) || OccupancyStats::isCharging(type))
+                return module.get();
+        }
+        return nullptr;
+    }
+};
+
+/// Largest facility count the map configuration screen allows per type.
+constexpr int MAP_CONFIG_LIMIT = Config::Map::UI_MAX_PER_TYPE;
+
+inline MapConfig uniformMapConfig(int perType) { return MapConfig{perType, perType, perType, perType, {}}; }
@@ -0,0 +1,113 @@
+#include <benchmark/benchmark.h>
+#include "config.hpp"
+#include "core/ChunkGrid.hpp"
+#include "entities/Car.hpp"
+#include "entities/map/SplinePath.hpp"
+#include "entities/map/Waypoint.hpp"
+#include <memory>
+#include <vector>
+
+// One tick of every car in a single lane, args: {car count, spacing in meters}.
+// Smaller spacing means more neighbors inside each car's look-ahead.
+static void BM_CarUpdateWithNeighbors(benchmark::State &state) {
+    const int count = (int)state.range(0);
+    const float spacing = (float)state.range(1);
+
+    std::vector<std::unique_ptr<Car>> cars;
+    for (int i = 0; i < count; i++) {
+        Vector2 start = {(float)i * spacing, 0.0f};
+        auto car = std::make_unique<Car>(start, nullptr, Vector2{15, 0}, Car::CarType::COMBUSTION);
+        // Far-away goal: every car keeps driving for the whole benchmark
+        car->setPath({Waypoint({1.0e6f, 0.0f}, 10.0f)});
+        cars.push_back(std::move(car));
+    }
+
+    std::vector<const Car *> neighbors;
+    for (const auto &car : cars)
+        neighbors.push_back(car.get());
+
+    for (auto _ : state) {
+        for (auto &car : cars)
+            car->updateWithNeighbors(1.0 / 60.0, neighbors);
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+    state.SetComplexityN(count);
+}
+BENCHMARK(BM_CarUpdateWithNeighbors)->ArgsProduct({{16, 64, 256, 1024}, {2, 8}})->Complexity();
+
+// A zigzag path of N waypoints 30 m apart, as a planned route turns at its corners
+static std::vector<Waypoint> zigzag(int count) {
+    std::vector<Waypoint> path;
+    for (int i = 0; i < count; i++)
+        path.push_back(Waypoint({30.0f * (float)((i + 2) / 2), 30.0f * (float)((i + 1) / 2)}));
+    return path;
+}
+
+// Building the curve a car follows under the IDM, args: {waypoints}.
+static void BM_SplinePathBuild(benchmark::State &state) {
+    std::vector<Waypoint> path = zigzag((int)state.range(0));
+    SplinePath curve;
+    for (auto _ : state) {
+        curve.build({0.0f, 0.0f}, {1.0f, 0.0f}, path);
+        benchmark::DoNotOptimize(curve.getLength());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SplinePathBuild)->Arg(8)->Arg(64);
+
+// Looking up positions along the curve at 15 m/s steps of a 60 Hz tick, args: {waypoints}.
+static void BM_SplinePathSample(benchmark::State &state) {
+    SplinePath curve;
+    curve.build({0.0f, 0.0f}, {1.0f, 0.0f}, zigzag((int)state.range(0)));
+    float distance = 0.0f;
+    for (auto _ : state) {
+        distance += 0.25f;
+        if (distance > curve.getLength())
+            distance = 0.0f;
+        benchmark::DoNotOptimize(curve.sample(distance));
+    }
+}
+BENCHMARK(BM_SplinePathSample)->Arg(8)->Arg(64);
+
+// One ChunkGrid tick of 8 driving cars sharing their chunks with parked ones, args: {parked cars}.
+// Parked cars sleep until due, so the cost should not grow with their number.
+static void BM_ChunkGridTickWithParkedCars(benchmark::State &state) {
+    const int parked = (int)state.range(0);
+    const int chunkCount = 4;
+    const float span = chunkCount * Config::Chunks::WIDTH;
+
+    std::vector<std::unique_ptr<Car>> cars;
+    auto add = [&](Vector2 position, Vector2 velocity) {
+        auto car = std::make_unique<Car>(position, nullptr, velocity, Car::CarType::COMBUSTION);
+        car->setId({(uint32_t)cars.size(), 0});
+        cars.push_back(std::move(car));
+        return cars.back().get();
+    };
+
+    ChunkGrid grid;
+    for (int i = 0; i < 8; i++) {
+        // Drives back and forth across the parked area for the whole benchmark
+        Car *car = add({span * (float)i / 8.0f, 0.0f}, {5, 0});
+        car->setPath({Waypoint({span - 1.0f, 0.0f}, 0.5f), Waypoint({1.0f, 0.0f}, 0.5f),
+                      Waypoint({span - 1.0f, 0.0f}, 0.5f), Waypoint({1.0f, 0.0f}, 0.5f)});
+        grid.addCar(car);
+    }
+    for (int i = 0; i < parked; i++) {
+        Car *car = add({span * (float)i / (float)parked, 10.0f}, {0, 0});
+        car->setState(Car::CarState::PARKED);
+        car->skipParkedTime(-1.0e6f);
+        grid.addCar(car);
+    }
+
+    const double dt = 1.0 / 60.0;
+    for (auto _ : state) {
+        grid.beginTick(dt);
+        grid.forEachActiveChunk([dt](ChunkGrid::Chunk &chunk, std::span<const Car *const> neighbors) {
+            for (Car *car : chunk.cars)
+                car->updateWithNeighbors(dt, neighbors);
+        });
+        grid.endTick();
+    }
+    state.counters["awake"] = (double)grid.getActiveCars().size();
+}
+BENCHMARK(BM_ChunkGridTickWithParkedCars)->RangeMultiplier(10)->Range(100, 10000);
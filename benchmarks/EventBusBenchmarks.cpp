@@ -0,0 +1,34 @@
+#include <benchmark/benchmark.h>
+#include "core/EventBus.hpp"
+#include <memory>
+#include <vector>
+
+namespace {
+struct BenchEvent {
+    int value;
+};
+} // namespace
+
+// Cost of one publish() as a function of the number of listeners.
+static void BM_EventBusPublishFanOut(benchmark::State &state) {
+    auto bus = std::make_shared<EventBus>();
+    std::vector<Subscription> tokens;
+    int sum = 0;
+    for (int i = 0; i < state.range(0); i++)
+        tokens.push_back(bus->subscribe<BenchEvent>([&sum](const BenchEvent &e) { sum += e.value; }));
+
+    for (auto _ : state) {
+        bus->publish(BenchEvent{1});
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_EventBusPublishFanOut)->RangeMultiplier(4)->Range(1, 256);
+
+// Publish of an event type nobody listens to (early-out path).
+static void BM_EventBusPublishNoListeners(benchmark::State &state) {
+    auto bus = std::make_shared<EventBus>();
+    for (auto _ : state)
+        bus->publish(BenchEvent{1});
+}
+BENCHMARK(BM_EventBusPublishNoListeners);
@@ -0,0 +1,123 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkWorld.hpp"
+#include "entities/Car.hpp"
+#include "raymath.h"
+#include "systems/PathPlanner.hpp"
+#include "systems/RoadNetwork.hpp"
+#include <vector>
+
+static void BM_PathPlannerGeneratePath(benchmark::State &state) {
+    BenchmarkWorld world(uniformMapConfig(1));
+    Module *facility = world.firstFacility();
+    if (!facility) {
+        state.SkipWithError("No facility generated");
+        return;
+    }
+    Spot spot = facility->getSpot(0);
+    RoadNetwork roads;
+    roads.build(world.entityManager.getModules());
+    const RoadNetwork::Terminal &entry = roads.getEntries().front();
+    Car car(entry.position, nullptr, Vector2Scale(entry.direction, 15.0f), Car::CarType::COMBUSTION);
+
+    for (auto _ : state) {
+        auto path = PathPlanner::GeneratePath(roads, &car, facility, spot);
+        benchmark::DoNotOptimize(path.data());
+    }
+}
+BENCHMARK(BM_PathPlannerGeneratePath);
+
+static void BM_PathPlannerGenerateExitPath(benchmark::State &state) {
+    BenchmarkWorld world(uniformMapConfig(1));
+    Module *facility = world.firstFacility();
+    if (!facility) {
+        state.SkipWithError("No facility generated");
+        return;
+    }
+    Spot spot = facility->getSpot(0);
+    Car car({0, 0}, nullptr, {0, 0}, Car::CarType::COMBUSTION);
+    car.setParkingContext(facility, spot, 0);
+    RoadNetwork roads;
+    roads.build(world.entityManager.getModules());
+
+    int exit = 0;
+    for (auto _ : state) {
+        exit = (exit + 1) % (int)roads.getExits().size();
+        auto path = PathPlanner::GenerateExitPath(roads, &car, facility, spot, exit);
+        benchmark::DoNotOptimize(path.data());
+    }
+}
+BENCHMARK(BM_PathPlannerGenerateExitPath);
+
+// Road graph of a generated map, arg: facilities per type.
+static void BM_RoadNetworkBuild(benchmark::State &state) {
+    BenchmarkWorld world(uniformMapConfig((int)state.range(0)));
+    RoadNetwork roads;
+    for (auto _ : state) {
+        roads.build(world.entityManager.getModules());
+        benchmark::DoNotOptimize(roads.getNodeCount());
+    }
+}
+BENCHMARK(BM_RoadNetworkBuild)->Arg(MAP_CONFIG_LIMIT)->Arg(250)->Unit(benchmark::kMillisecond);
+
+// Entry to gate routes (what every spawn asks for), arg: facilities per type.
+static void BM_RoadNetworkRouteFromEntry(benchmark::State &state) {
+    BenchmarkWorld world(uniformMapConfig((int)state.range(0)));
+    RoadNetwork roads;
+    roads.build(world.entityManager.getModules());
+    std::vector<int> gates;
+    for (const auto &module : world.entityManager.getModules()) {
+        if (roads.getGate(module.get()) != -1)
+            gates.push_back(roads.getGate(module.get()));
+    }
+    const RoadNetwork::Terminal &entry = roads.getEntries().front();
+    Vector2 heading = entry.direction;
+
+    std::vector<Vector2> points;
+    size_t next = 0;
+    for (auto _ : state) {
+        next = (next + 1) % gates.size();
+        benchmark::DoNotOptimize(roads.route(entry.position, heading, gates[next], points));
+    }
+}
+BENCHMARK(BM_RoadNetworkRouteFromEntry)->Arg(MAP_CONFIG_LIMIT)->Arg(250);
+
+// Routes from part way along a lane (batch-assigned cars), arg: facilities per type.
+static void BM_RoadNetworkRouteFromLane(benchmark::State &state) {
+    BenchmarkWorld world(uniformMapConfig((int)state.range(0)));
+    RoadNetwork roads;
+    roads.build(world.entityManager.getModules());
+    std::vector<int> gates;
+    for (const auto &module : world.entityManager.getModules()) {
+        if (roads.getGate(module.get()) != -1)
+            gates.push_back(roads.getGate(module.get()));
+    }
+    const RoadNetwork::Terminal &entry = roads.getEntries().front();
+    Vector2 start = Vector2Add(entry.position, Vector2Scale(entry.direction, 10.0f));
+
+    std::vector<Vector2> points;
+    size_t next = 0;
+    for (auto _ : state) {
+        next = (next + 1) % gates.size();
+        benchmark::DoNotOptimize(roads.route(start, entry.direction, gates[next], points));
+    }
+}
+BENCHMARK(BM_RoadNetworkRouteFromLane)->Arg(MAP_CONFIG_LIMIT)->Arg(250);
+
+// Random free spot lookup, arg: percentage of spots already occupied.
+static void BM_ModuleGetRandomSpotIndex(benchmark::State &state) {
+    BenchmarkWorld world(MapConfig{0, 1, 0, 0, {}});
+    Module *facility = world.firstFacility();
+    if (!facility) {
+        state.SkipWithError("No facility generated");
+        return;
+    }
+    auto counts = facility->getSpotCounts();
+    int spots = counts.free + counts.reserved + counts.occupied;
+    int occupied = spots * (int)state.range(0) / 100;
+    for (int i = 0; i < occupied; i++)
+        world.entityManager.setSpotState(facility, i, SpotState::OCCUPIED);
+
+    for (auto _ : state)
+        benchmark::DoNotOptimize(facility->getRandomSpotIndex(world.entityManager.getRandom()));
+}
+BENCHMARK(BM_ModuleGetRandomSpotIndex)->Arg(0)->Arg(50)->Arg(90)->Arg(99);
@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+#include "BenchmarkWorld.hpp"
+#include "core/Checkpoint.hpp"
+#include "core/Random.hpp"
+#include "entities/map/MapFile.hpp"
+#include "entities/map/WorldGenerator.hpp"
+#include <cstdio>
+
+// Map generation, arg: facilities of each type. Up to MAP_CONFIG_LIMIT is reachable from the UI,
+// larger values measure how generation scales beyond it.
+static void BM_WorldGeneratorGenerate(benchmark::State &state) {
+    MapConfig config = uniformMapConfig((int)state.range(0));
+    Random random(BENCHMARK_SEED);
+    for (auto _ : state) {
+        GeneratedMap map = WorldGenerator::generate(config, random);
+        benchmark::DoNotOptimize(map.modules.data());
+    }
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_WorldGeneratorGenerate)
+    ->Arg(1)
+    ->Arg(MAP_CONFIG_LIMIT)
+    ->Arg(MAP_CONFIG_LIMIT * 4)
+    ->Arg(MAP_CONFIG_LIMIT * 16)
+    ->Complexity()
+    ->Unit(benchmark::kMicrosecond);
+
+// Loading a saved layout instead of generating it, arg: facilities of each type (2500 = a 10k site).
+static void BM_MapFileLoad(benchmark::State &state) {
+    const char *path = "benchmark_layout.map";
+    Random random(BENCHMARK_SEED);
+    GeneratedMap generated = WorldGenerator::generate(uniformMapConfig((int)state.range(0)), random);
+    MapFile::save(path, *generated.world, generated.modules);
+
+    for (auto _ : state) {
+        GeneratedMap map = MapFile::load(path);
+        benchmark::DoNotOptimize(map.modules.data());
+    }
+    std::remove(path);
+    state.SetComplexityN(state.range(0));
+}
+BENCHMARK(BM_MapFileLoad)->Arg(MAP_CONFIG_LIMIT)->Arg(2500)->Complexity()->Unit(benchmark::kMillisecond);
+
+// One full headless simulation tick (all GameUpdateEvent listeners), args: {facilities per type, spawned cars}.
+// Cars park and leave while it runs, so the "cars" counter reports the average population.
+static void BM_SimulationTick(benchmark::State &state) {
+    BenchmarkWorld world(uniformMapConfig((int)state.range(0)));
+    world.populate((int)state.range(1), 60);
+
+    size_t carTicks = 0;
+    for (auto _ : state) {
+        world.tick();
+        carTicks += world.entityManager.getCars().size();
+    }
+
+    state.counters["cars"] = benchmark::Counter((double)carTicks, benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_SimulationTick)
+    ->Args({1, 20})
+    ->Args({MAP_CONFIG_LIMIT, 100})
+    ->Args({MAP_CONFIG_LIMIT, 400})
+    ->Unit(benchmark::kMicrosecond);
+
+// Restoring a warm checkpoint (Monte Carlo restarts), args: {facilities per type, spawned cars}.
+static void BM_CheckpointRestore(benchmark::State &state) {
+    BenchmarkWorld world(uniformMapConfig((int)state.range(0)));
+    world.populate((int)state.range(1), 600);
+    Checkpoint checkpoint = Checkpoint::capture(world.entityManager, world.trafficSystem);
+
+    for (auto _ : state)
+        checkpoint.restore(world.entityManager, world.trafficSystem);
+
+    state.counters["cars"] = (double)world.entityManager.getCars().size();
+    state.counters["bytes"] = (double)checkpoint.size();
+}
+BENCHMARK(BM_CheckpointRestore)
+    ->Args({MAP_CONFIG_LIMIT, 100})
+    ->Args({MAP_CONFIG_LIMIT, 400})
+    ->Unit(benchmark::kMicrosecond);
@@ -19,8 +19,10 @@ constexpr int ART_PIXELS_PER_METER = 7;  ///< Art pixels per meter
 constexpr int BACKGROUND_TILE_SIZE = 32; ///< Background tile size in art pixels
 constexpr float PPM = static_cast<float>(PIXELS_PER_ART_PIXEL * ART_PIXELS_PER_METER); // Pixels Per Meter (28.0f)
 
-constexpr int LANE_OFFSET_UP = 61;   ///< Up lane offset from top of road (art pixels)
-constexpr int LANE_OFFSET_DOWN = 94; ///< Down lane offset from top of road (art pixels)
+constexpr int LANE_OFFSET_UP = 61;       ///< Up lane offset from top of road (art pixels)
+constexpr int LANE_OFFSET_DOWN = 94;     ///< Down lane offset from top of road (art pixels)
+constexpr int ROAD_CENTER_OFFSET = 78;   ///< Road attachment points from top of road (art pixels)
+constexpr int ENTRANCE_LANE_OFFSET = 18; ///< Entrance lanes from the center of the entrance (art pixels)
 
 // Physical Window Start Size
 constexpr int INITIAL_WINDOW_WIDTH = 1280; ///< Initial window width
@@ -32,25 +34,58 @@ constexpr double FIXED_DELTA_TIME = 1.0 / static_cast<double>(TICK_RATE); ///< T
 constexpr int TARGET_FPS = 60;       ///< Target frames per second
 constexpr bool VSYNC_ENABLED = true; ///< Vertical sync flag
 
+namespace Simulation {
+constexpr bool THREADED = true; ///< Tick the simulation on its own thread; the render thread interpolates snapshots
+} // namespace Simulation
+
+namespace Chunks {
+constexpr float WIDTH = 64.0f; ///< Chunk width in meters; must exceed the car look-ahead (~37 m at top speed)
+constexpr int VIEW_MARGIN = 1; ///< Chunks on each side of the camera view that stay fully simulated
+} // namespace Chunks
+
+namespace Map {
+constexpr int UI_MAX_PER_TYPE = 5;  ///< Facility count limit of the map configuration screen (per type)
+constexpr int MAX_PER_TYPE = 25000; ///< Hard limit for counts given on the command line / config file
+constexpr const char *SAVE_PATH = "parklogic.map"; ///< Written by the save map key (F5)
+constexpr float MAX_WORLD_SIZE = 1.0e7f;            ///< Largest world width / height a map file may declare (meters)
+} // namespace Map
+
+namespace Batch {
+constexpr int MAX_RANGE_LENGTH = 100000; ///< Most values one "a..b" range of a sweep file may expand to
+constexpr int MAX_RUNS = 1000000;        ///< Most runs (combinations times seeds) one sweep may expand to
+} // namespace Batch
+
+namespace Roads {
+constexpr float MERGE_DISTANCE = 0.5f; ///< Lane ends closer than this (meters) are one node of the road graph
+constexpr float SNAP_DISTANCE = 4.0f;  ///< Farthest a car may be from a lane to be routed from it (meters)
+constexpr float GRID_CELL = 64.0f;     ///< Cell size of the lane lookup grid in meters
+constexpr float EXIT_OVERRUN = 2.0f;   ///< Meters past the map exit that leaving cars drive to
+} // namespace Roads
+
 namespace CarAI {
 /**
  * @struct AIPhase
  * @brief Parameters for car behavior during different navigation phases.
  */
 struct AIPhase {
-  float speedFactor;    ///< Multiplier of max speed (0.0 to 1.0).
-  float tolerance;      ///< Distance to waypoint to consider it "reached".
-  float correctionStep; ///< Distance interval for path smoothing.
+  float speedFactor; ///< Multiplier of max speed (0.0 to 1.0).
+  float tolerance;   ///< Distance to waypoint to consider it "reached".
 };
 
 namespace Phases {
-constexpr AIPhase HIGHWAY = {1.0f, 10.0f, 20.0f}; // Fast, loose, corrections every 15m
-constexpr AIPhase APPROACH = {1.0f, 3.0f, 5.0f};  // Approaches to facility
-constexpr AIPhase ACCESS = {0.4f, 4.0f, 3.0f};    // Entry roads / Connector
-constexpr AIPhase MANEUVER = {0.2f, 2.0f, 2.0f};  // Alignment / Interior
-constexpr AIPhase PARKING = {0.1f, 0.3f, 3.0f};   // Final spot (corrected back to user pref)
+constexpr AIPhase HIGHWAY = {1.0f, 10.0f};  // Fast, loose
+constexpr AIPhase APPROACH = {1.0f, 3.0f};  // Approaches to facility
+constexpr AIPhase ACCESS = {0.4f, 4.0f};    // Entry roads / Connector
+constexpr AIPhase MANEUVER = {0.2f, 2.0f};  // Alignment / Interior
+constexpr AIPhase PARKING = {0.1f, 0.3f};   // Final spot (corrected back to user pref)
 } // namespace Phases
 
+namespace Spline {
+// Curved paths (SplinePath) followed by CarFollowingModel::IDM
+constexpr int TABLE_SAMPLES = 16;      ///< Arc-length table intervals per curve segment
+constexpr float HANDLE_FACTOR = 0.33f; ///< Bezier handle length as a share of the segment's chord
+} // namespace Spline
+
 namespace GateDepth {
 // Distance (Meters) to drive "into" the facility before aligning
 constexpr float SMALL_PARKING = 12.0f;
@@ -60,6 +95,19 @@ constexpr float LARGE_CHARGING = 12.0f;
 constexpr float GENERIC = 5.0f;
 } // namespace GateDepth
 
+namespace Idm {
+// Intelligent Driver Model (CarFollowingModel::IDM)
+constexpr float MAX_ACCELERATION = 6.0f;     ///< m/s^2 on a free road from standstill
+constexpr float COMFORT_BRAKING = 8.0f;      ///< m/s^2 the model aims to brake at
+constexpr float MAX_BRAKING = 25.0f;         ///< m/s^2 emergency limit of the computed deceleration
+constexpr float TIME_GAP = 1.0f;             ///< Seconds of headway kept to the leader
+constexpr float MIN_GAP = 1.0f;              ///< Meters bumper to bumper at standstill
+constexpr float VEHICLE_LENGTH = 4.4f;       ///< Meters, center distance minus the gap (sprite length)
+constexpr float LANE_HALF_WIDTH = 1.8f;      ///< Lateral offset under which a car counts as ahead in lane
+constexpr float LOOK_AHEAD_BASE = 7.0f;      ///< Leader search range in meters at standstill...
+constexpr float LOOK_AHEAD_PER_SPEED = 2.0f; ///< ...plus this many meters per m/s
+} // namespace Idm
+
 // Turn Logic
 constexpr float TURN_SLOWDOWN_DIST = 30.0f;    // Start slowing down X meters before a sharp turn
 constexpr float TURN_SLOWDOWN_ANGLE = 0.2f;    // Angle (radians) to consider "sharp" (~11 degrees)
@@ -72,10 +120,12 @@ constexpr float BATTERY_HIGH_THRESHOLD = 70.0f;
 constexpr float BATTERY_EXIT_THRESHOLD = 80.0f;       // Chance to leave
 constexpr float BATTERY_FORCE_EXIT_THRESHOLD = 95.0f; // Must leave
 constexpr float CHARGING_RATE = 0.25f;                // % per second
+constexpr float MAX_CHARGING_SESSION = 86400.0f;      // Seconds; cap for sessions that would never end
 
 // Parking Timers (Seconds)
 constexpr float PARKING_MIN_TIME = 120.0f;
 constexpr float PARKING_MAX_TIME = 300.0f;
+constexpr float MAX_PARKING_TIME = 1.0e6f; // Largest configurable parking time; stays are drawn in 0.1 s steps as int
 
 namespace Spawner {
 // Spawn Intervals in Seconds (Real-time seconds at 1x speed, scaling with speed)
@@ -86,5 +136,60 @@ namespace Spawner {
 // Level 4: Fast
 // Level 5: Very Fast
 constexpr float SPAWN_RATES[] = {0.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f};
+constexpr float ENTRY_CLEARANCE = 8.0f; ///< Meters the last car of a lane must be past its entry before the next enters
 } // namespace Spawner
+
+namespace Assignment {
+constexpr float WINDOW = 0.5f;     ///< Seconds of arrivals collected into one batch assignment
+constexpr int COST_LEVELS = 1000; ///< Resolution of the normalized spot costs (0 = best)
+} // namespace Assignment
+
+namespace Reservation {
+constexpr float TICK = 0.25f;     ///< Seconds per timer wheel tick (expiry resolution)
+constexpr int WHEEL_SLOTS = 512;   ///< Wheel size; longer timeouts take more than one turn
+constexpr float TIMEOUT = 300.0f; ///< Seconds a car has to reach its reserved spot before losing it
+} // namespace Reservation
+
+namespace Pricing {
+constexpr float INTERVAL = 30.0f;          ///< Simulated seconds between price updates
+constexpr float RESERVATION_WEIGHT = 0.5f; ///< Demand per reservation per spot and minute
+constexpr float SMOOTHING = 0.5f;          ///< Share of the way the surge moves toward its target per update
+constexpr float DIRTY_THRESHOLD = 0.01f;   ///< Surge change that reprices a facility's spots
+constexpr float MIN_SURGE = 0.5f;
+constexpr float MAX_SURGE = 3.0f;
+constexpr float MIN_SPOT_PRICE = 0.5f; ///< Same floor as Module::randomizePrices
+/// Elasticity curve (piecewise linear): surge factor at elasticity 1 for a demand (taken share
+/// plus weighted reservation rate). Flat beyond the ends.
+constexpr float CURVE_DEMAND[] = {0.0f, 0.5f, 0.8f, 1.0f, 1.5f};
+constexpr float CURVE_SURGE[] = {0.8f, 1.0f, 1.4f, 2.0f, 3.0f};
+} // namespace Pricing
+
+namespace Metrics {
+constexpr int SAMPLE_INTERVAL_TICKS = 60; ///< Ticks between metric samples (1 simulated second)
+constexpr int BUCKETS_PER_TIER = 120;     ///< Ring size of every resolution tier
+constexpr int TIERS = 5;                  ///< 1 s, 10 s, 100 s, 1000 s, 10000 s buckets (~2 weeks at the coarsest)
+constexpr int TIER_FACTOR = 10;           ///< Buckets folded into one bucket of the next tier
+constexpr const char *EXPORT_PATH = "metrics.csv";             ///< Written by the export key (E)
+constexpr const char *OCCUPANCY_EXPORT_PATH = "occupancy.csv"; ///< Written alongside the metrics
+} // namespace Metrics
+
+namespace Checkpoint {
+constexpr const char *PATH = "parklogic.checkpoint"; ///< Written by F6, restored by F9
+} // namespace Checkpoint
+
+namespace Replay {
+constexpr const char *PATH = "parklogic.replay"; ///< Written by F7, played with --replay=<path>
+constexpr int HASH_INTERVAL_TICKS = 60;          ///< State hash recorded every N ticks
+} // namespace Replay
+
+namespace Picking {
+constexpr float CAR_RADIUS = 0.8f;  ///< Click radius around a car's position in meters
+constexpr float SPOT_RADIUS = 4.0f; ///< A facility click selects the nearest spot within this radius
+} // namespace Picking
+
+namespace Profiler {
+constexpr int EVENTS_PER_THREAD = 1 << 16; ///< Zone ring size per thread (~2.5 MB)
+constexpr int OVERLAY_ROWS = 12;           ///< Zones listed in the profiler overlay
+constexpr const char *TRACE_PATH = "parklogic_trace.json"; ///< Written by the trace dump key (F4)
+} // namespace Profiler
 } // namespace Config
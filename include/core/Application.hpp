@@ -2,9 +2,11 @@
 #include "core/EventBus.hpp"
 #include "core/EventLogger.hpp"
 #include "core/GameLoop.hpp"
+#include "core/LaunchOptions.hpp"
 #include "core/Window.hpp"
 #include "input/InputSystem.hpp"
 #include "scenes/SceneManager.hpp"
+#include "ui/ProfilerOverlay.hpp"
 #include "raylib.h"
 #include <memory>
 #include <vector>
@@ -23,8 +25,10 @@ class Application {
 public:
   /**
    * @brief Constructs the Application and initializes core systems.
+   *
+   * @param options Startup options; a custom map skips the menus and starts the game directly.
    */
-  Application();
+  explicit Application(const LaunchOptions &options = {});
   ~Application();
 
   /**
@@ -59,6 +63,7 @@ private:
   std::unique_ptr<InputSystem> inputSystem;   ///< The input handling system.
   std::unique_ptr<SceneManager> sceneManager; ///< The scene manager.
   std::unique_ptr<EventLogger> eventLogger; ///< Logger for debugging events.
+  std::unique_ptr<ProfilerOverlay> profilerOverlay; ///< Zone timings (F3) and trace dump (F4).
 
   bool isRunning = true; ///< Flag indicating if the application is running.
   Subscription closeEventToken;          ///< Token for the window close event subscription.
@@ -0,0 +1,148 @@
+#pragma once
+#include "core/SimulationParams.hpp"
+#include "events/GameEvents.hpp"
+#include <cstdint>
+#include <functional>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+/**
+ * @file BatchRunner.hpp
+ * @brief Headless Monte Carlo parameter sweeps over many independent simulation instances.
+ */
+
+/**
+ * @struct BatchRun
+ * @brief One simulation of a sweep: a layout, a spawn level, the thresholds and a seed.
+ */
+struct BatchRun {
+  int configIndex = 0; ///< Parameter combination; runs that only differ in the seed share it.
+  MapConfig map{0, 0, 0, 0, {}};
+  int spawnLevel = 0;
+  SimulationParams params;
+  uint64_t seed = 0;
+  double tickLength = Config::FIXED_DELTA_TIME; ///< Simulated seconds per tick.
+};
+
+/**
+ * @struct BatchResult
+ * @brief What one run produced.
+ */
+struct BatchResult {
+  double meanOccupancy = 0.0; ///< % of all spots occupied, averaged over the run (sampled every second).
+  int carsSpawned = 0;
+  int carsTurnedAway = 0;       ///< Spawned cars that found no free suitable spot and drove through.
+  int staysCompleted = 0;       ///< Spots released after having been occupied.
+  double revenue = 0.0;         ///< Price of every completed stay.
+  double chargeDelivered = 0.0; ///< Battery percentage points charged into all cars.
+  double meanSpawnQueue = 0.0;  ///< Arrivals waiting at the entries, averaged like meanOccupancy.
+  int maxSpawnQueue = 0;        ///< Longest wait queue seen at those samples.
+  double wallSeconds = 0.0;     ///< Real time the run took.
+};
+
+/**
+ * @struct SweepSpec
+ * @brief The values to sweep, read from a plain "key = value" file.
+ *
+ * Each key takes a comma separated list; integer keys also accept inclusive ranges:
+ *
+ *     # 2 x 3 x 8 = 48 runs of one simulated hour each
+ *     small_parking = 1, 4
+ *     large_charging = 0..2
+ *     spawn_level = 4
+ *     battery_exit_threshold = 80
+ *     seeds = 1..8
+ *     duration = 3600
+ *
+ * Runs are the cartesian product of all lists. Keys: small_parking, large_parking,
+ * small_charging, large_charging, spawn_level, battery_low_threshold, battery_high_threshold,
+ * battery_exit_threshold, battery_force_exit_threshold, charging_rate, parking_min_time,
+ * parking_max_time, price_elasticity (lists), seeds (list), duration (simulated seconds), threads
+ * (0 = one per hardware thread), car_following (steering or idm), tick_length (simulated
+ * seconds per tick; coarse ticks need car_following = idm) and spot_assignment (greedy or
+ * batch). Omitted keys keep their defaults (one facility of each type, spawn level 3, the Config
+ * thresholds, fixed prices, seed 1, steering at 60 Hz, greedy spot choice).
+ */
+struct SweepSpec {
+  std::vector<int> smallParking{1};
+  std::vector<int> largeParking{1};
+  std::vector<int> smallCharging{1};
+  std::vector<int> largeCharging{1};
+  std::vector<int> spawnLevels{3};
+  std::vector<float> batteryLowThresholds{Config::BATTERY_LOW_THRESHOLD};
+  std::vector<float> batteryHighThresholds{Config::BATTERY_HIGH_THRESHOLD};
+  std::vector<float> batteryExitThresholds{Config::BATTERY_EXIT_THRESHOLD};
+  std::vector<float> batteryForceExitThresholds{Config::BATTERY_FORCE_EXIT_THRESHOLD};
+  std::vector<float> chargingRates{Config::CHARGING_RATE};
+  std::vector<float> parkingMinTimes{Config::PARKING_MIN_TIME};
+  std::vector<float> parkingMaxTimes{Config::PARKING_MAX_TIME};
+  std::vector<float> priceElasticities{0.0f};
+  std::vector<uint64_t> seeds{1};
+  double duration = 3600.0; ///< Simulated seconds per run.
+  int threads = 0;          ///< Worker threads, 0 = std::thread::hardware_concurrency().
+  CarFollowingModel carFollowing = CarFollowingModel::STEERING;
+  double tickLength = Config::FIXED_DELTA_TIME; ///< Simulated seconds per tick.
+  SpotAssignmentMode spotAssignment = SpotAssignmentMode::GREEDY;
+
+  /**
+   * @brief Parses a sweep file's contents.
+   * @throws std::runtime_error naming the line of an unknown key or invalid value.
+   */
+  static SweepSpec parse(std::istream &in);
+
+  /**
+   * @throws std::runtime_error if the file cannot be read or is invalid.
+   */
+  static SweepSpec load(const std::string &path);
+
+  /**
+   * @brief All runs of the sweep, grouped by parameter combination (seeds vary fastest).
+   * @throws std::runtime_error if that would be more than Config::Batch::MAX_RUNS runs.
+   */
+  std::vector<BatchRun> expand() const;
+};
+
+/**
+ * @class BatchRunner
+ * @brief Runs sweeps of isolated headless simulations in parallel and reports on them.
+ *
+ * Every run builds its own EventBus, EntityManager and TrafficSystem (the simulation side of
+ * GameScene, without camera or metrics recorder), seeds the EntityManager's Random with the run's
+ * seed, generates the layout and ticks at the run's tick length for the sweep duration. Runs
+ * share no state, so they are spread over worker threads and a run's result depends only on its
+ * parameters and seed, not on the thread count or scheduling.
+ */
+class BatchRunner {
+public:
+  /**
+   * @brief Called after each finished run with the number of finished runs (from worker threads,
+   * one call at a time).
+   */
+  using Progress = std::function<void(size_t done, size_t total)>;
+
+  /**
+   * @brief Simulates one run on the calling thread.
+   * @param duration Simulated seconds.
+   */
+  static BatchResult runOne(const BatchRun &run, double duration);
+
+  /**
+   * @brief Simulates all runs on @p threads workers (0 = one per hardware thread).
+   * @return Results in the order of @p runs.
+   */
+  static std::vector<BatchResult> runAll(const std::vector<BatchRun> &runs, double duration, int threads,
+                                         const Progress &progress = {});
+
+  /**
+   * @brief Writes the aggregate report as CSV: one row per parameter combination with the mean
+   * and standard deviation of every metric over its seeds.
+   */
+  static void writeReport(std::ostream &out, const std::vector<BatchRun> &runs,
+                          const std::vector<BatchResult> &results);
+
+  /**
+   * @brief Writes one CSV row per run (parameters, seed and raw metrics).
+   */
+  static void writeRuns(std::ostream &out, const std::vector<BatchRun> &runs, const std::vector<BatchResult> &results);
+};
@@ -0,0 +1,88 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @file BinaryIO.hpp
+ * @brief Minimal helpers to write and read flat binary files (native byte order).
+ */
+
+/**
+ * @class BinaryWriter
+ * @brief Appends trivially copyable values to an in-memory buffer, written to disk in one go.
+ */
+class BinaryWriter {
+public:
+  template <typename T> void write(const T &value) {
+    static_assert(std::is_trivially_copyable_v<T>, "BinaryWriter only writes trivially copyable types");
+    const auto *bytes = reinterpret_cast<const std::byte *>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+  }
+
+  template <typename T> void writeArray(std::span<const T> values) {
+    static_assert(std::is_trivially_copyable_v<T>, "BinaryWriter only writes trivially copyable types");
+    const auto *bytes = reinterpret_cast<const std::byte *>(values.data());
+    buffer.insert(buffer.end(), bytes, bytes + values.size_bytes());
+  }
+
+  void reserve(size_t bytes) { buffer.reserve(bytes); }
+  const std::vector<std::byte> &data() const { return buffer; }
+
+  /**
+   * @brief Writes the buffer to @p path (replacing the file).
+   * @throws std::runtime_error if the file cannot be written.
+   */
+  void saveTo(const std::string &path) const;
+
+private:
+  std::vector<std::byte> buffer;
+};
+
+/**
+ * @class BinaryReader
+ * @brief Reads values sequentially from a byte range, with bounds checking.
+ *
+ * The range is typically a memory-mapped file. Values are copied out with memcpy, so the data
+ * does not need to be aligned.
+ */
+class BinaryReader {
+public:
+  explicit BinaryReader(std::span<const std::byte> data) : data(data) {}
+
+  /**
+   * @throws std::runtime_error if fewer than sizeof(T) bytes are left.
+   */
+  template <typename T> T read() {
+    static_assert(std::is_trivially_copyable_v<T>, "BinaryReader only reads trivially copyable types");
+    std::array<std::byte, sizeof(T)> raw;
+    std::memcpy(raw.data(), take(sizeof(T)).data(), sizeof(T));
+    return std::bit_cast<T>(raw); // No default constructor needed (e.g. Waypoint)
+  }
+
+  /**
+   * @brief Returns the next @p count bytes without copying them.
+   * @throws std::runtime_error if fewer than @p count bytes are left.
+   */
+  std::span<const std::byte> take(size_t count) {
+    if (count > remaining())
+      throw std::runtime_error("Unexpected end of file (need " + std::to_string(count) + " bytes, " +
+                               std::to_string(remaining()) + " left)");
+    auto bytes = data.subspan(offset, count);
+    offset += count;
+    return bytes;
+  }
+
+  size_t remaining() const { return data.size() - offset; }
+
+private:
+  std::span<const std::byte> data;
+  size_t offset = 0;
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include "entities/Car.hpp"
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+/**
+ * @class CarPool
+ * @brief Recycles Car instances instead of allocating and freeing one per spawn/exit.
+ *
+ * Released cars are kept on a free list and handed out again by acquire(), which resets them
+ * in place (Car::reset). A recycled car also keeps its waypoint buffer, so once the pool has
+ * warmed up a spawn/exit cycle performs no Car or path-buffer allocations.
+ */
+class CarPool {
+public:
+  /**
+   * @struct Stats
+   * @brief Allocation counters, for checking that steady-state spawning does not allocate.
+   */
+  struct Stats {
+    size_t allocations = 0; ///< Cars created with new (pool misses).
+    size_t reuses = 0;      ///< Cars handed out from the free list (pool hits).
+    size_t releases = 0;    ///< Cars returned to the pool.
+  };
+
+  /**
+   * @brief Hands out a car in its freshly constructed state.
+   * @param startPos Initial position.
+   * @param world World passed to the Car constructor on a pool miss.
+   * @param initialVelocity Initial velocity (sets heading).
+   * @param type The type of car.
+   */
+  std::unique_ptr<Car> acquire(Vector2 startPos, const class World *world, Vector2 initialVelocity,
+                               Car::CarType type);
+
+  /**
+   * @brief Returns a car to the pool. The car must no longer be referenced anywhere.
+   */
+  void release(std::unique_ptr<Car> car);
+
+  /**
+   * @brief Pre-allocates cars so the first spawns are pool hits too.
+   */
+  void reserve(size_t count);
+
+  const Stats &getStats() const { return stats; }
+  size_t available() const { return freeList.size(); }
+
+private:
+  std::vector<std::unique_ptr<Car>> freeList;
+  Stats stats;
+};
@@ -0,0 +1,63 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class EntityManager;
+class TrafficSystem;
+
+/**
+ * @file Checkpoint.hpp
+ * @brief Snapshot of a running simulation that can be restored any number of times.
+ */
+
+/**
+ * @class Checkpoint
+ * @brief Compact binary copy of the dynamic simulation state.
+ *
+ * Contains every spot state, every car (kinematics, state, remaining path, battery, parking
+ * timer and spot, parked facility as a module index), the surge pricing state, the TrafficSystem
+ * spawner and its spot reservations. The layout itself is not included: a checkpoint is restored
+ * on the layout it was taken on (see MapFile to persist layouts), which a fingerprint of the module
+ * sizes, positions and spot counts checks. The random number generator is
+ * not part of it either; reseed EntityManager::getRandom() after a restore to make a forked run
+ * reproducible.
+ *
+ * A checkpoint lives in memory, so what-if runs can restart from it repeatedly without any file
+ * access; saveTo() / loadFrom() persist it.
+ */
+class Checkpoint {
+public:
+  /// 2: cars record the charge they received. 3: charging sessions. 4: spawn queues.
+  /// 5: spot reservations. 6: surge pricing. 7: arrivals waiting for the batch assignment.
+  /// 8: layout fingerprint, waypoints written field by field.
+  static constexpr uint32_t VERSION = 8;
+
+  /**
+   * @brief Captures the current state. Simulation thread (or simulation lock held).
+   */
+  static Checkpoint capture(EntityManager &entityManager, const TrafficSystem &trafficSystem);
+
+  /**
+   * @brief Puts the simulation back into the captured state.
+   * @throws std::runtime_error if the data is corrupt or belongs to another layout. Every section
+   *         is validated before anything is touched.
+   */
+  void restore(EntityManager &entityManager, TrafficSystem &trafficSystem) const;
+
+  /**
+   * @throws std::runtime_error if the file cannot be written.
+   */
+  void saveTo(const std::string &path) const;
+
+  /**
+   * @throws std::runtime_error if the file cannot be read or is not a checkpoint.
+   */
+  static Checkpoint loadFrom(const std::string &path);
+
+  size_t size() const { return data.size(); }
+
+private:
+  std::vector<std::byte> data;
+};
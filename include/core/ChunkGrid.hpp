@@ -0,0 +1,194 @@
+#pragma once
+#include "entities/Car.hpp"
+#include "entities/map/Modules.hpp"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <span>
+#include <vector>
+
+/**
+ * @file ChunkGrid.hpp
+ * @brief Partition of the world into fixed-width strips along X, with per-strip activation.
+ */
+
+/**
+ * @class ChunkGrid
+ * @brief Splits the world into Config::Chunks::WIDTH wide chunks, tracks which ones are active
+ * and lets parked cars sleep until they are due.
+ *
+ * Every chunk lists the modules whose left edge lies in it and the cars currently inside it.
+ * A parked car whose parking timer has not run out (for a charging car, the sampled end of its
+ * session) is moved out of its chunk's awake list into the sleepers and scheduled on a wake
+ * queue keyed by the time the timer expires. Sleeping cars are not updated, not handed to the
+ * TrafficSystem and not scanned as neighbors; only the cars popped from the queue are touched.
+ * On wake a car's timer is advanced by the whole interval it slept, which is what the per-tick
+ * updates would have produced (the battery of a charging car follows from the timer).
+ *
+ * A chunk is active (its awake cars are simulated) while it has awake cars or lies within
+ * Config::Chunks::VIEW_MARGIN chunks of the camera view. Chunks around the view are fully
+ * simulated: their cars do not sleep. The cost of a tick therefore follows the number of cars
+ * that are moving, due or visible, not the number of parked cars.
+ *
+ * Chunks own no entities: modules and cars stay owned by the EntityManager, chunks only index
+ * them. Chunks are created on demand to the right of X = 0; positions left of 0 map to chunk 0.
+ *
+ * Threading: module lists are filled while the world is generated and only read afterwards, so
+ * the render thread may query them. Everything about cars and activation belongs to the
+ * simulation thread; the render thread only publishes the camera view through setView().
+ */
+class ChunkGrid {
+public:
+  /**
+   * @struct Chunk
+   * @brief One strip of the world.
+   */
+  struct Chunk {
+    std::vector<Car *> cars;     ///< Awake cars whose position lies in this chunk.
+    std::vector<Car *> sleepers; ///< Parked cars of this chunk waiting on the wake queue.
+    int movingCars = 0;          ///< Cars that are not PARKED (as of the last tick).
+    bool active = false;
+    int activeSlot = -1; ///< Position in the active list while active.
+  };
+
+  // --- Content ---
+  void addModule(Module *module);
+  void addCar(Car *car);
+  void removeCar(const Car *car);
+  void clear();
+
+  /**
+   * @brief Forgets all cars and activation state, keeping the modules. Simulation time restarts
+   * at 0, so what happens after re-adding cars depends only on those cars (checkpoint restore).
+   */
+  void clearCars();
+
+  /**
+   * @brief Advances every sleeping car to the current simulation time, so each car's state is
+   * exact (used before taking a checkpoint). The cars keep sleeping.
+   */
+  void catchUpSleeping();
+
+  /**
+   * @brief Chunk index for a world X coordinate (clamped at 0, grows the grid if needed).
+   */
+  int chunkIndexAt(float x);
+
+  // --- Ticking (simulation thread) ---
+  /**
+   * @brief Starts a tick: wakes the cars that become due during it and the chunks in view, puts
+   * parked cars that are not due to sleep and deactivates chunks left without awake cars.
+   * @param dt Length of the tick about to be simulated, in seconds.
+   */
+  void beginTick(double dt);
+
+  /**
+   * @brief Ends a tick: moves cars that crossed a chunk border and recounts moving cars.
+   */
+  void endTick();
+
+  /**
+   * @brief Calls @p fn for every active chunk with that chunk and the awake cars of it and its two
+   * neighbours (the collision avoidance look-ahead never reaches further than one chunk, and it
+   * ignores parked cars, so sleepers are left out).
+   */
+  void forEachActiveChunk(const std::function<void(Chunk &, std::span<const Car *const>)> &fn);
+
+  /**
+   * @brief Awake cars of the active chunks, as of the end of the last tick.
+   */
+  const std::vector<CarId> &getActiveCars() const { return activeCars; }
+
+  size_t getChunkCount() const { return chunks.size(); }
+  size_t getActiveChunkCount() const { return activeList.size(); }
+  int getMovingCarCount() const { return movingCarCount; }
+  size_t getSleepingCarCount() const { return sleepingCarCount; }
+  double getSimulationTime() const { return now; }
+
+  // --- Queries ---
+  /**
+   * @brief Calls @p fn for every module that may overlap [minX, maxX].
+   */
+  void forEachModuleIn(float minX, float maxX, const std::function<void(Module &)> &fn) const;
+
+  /**
+   * @brief Calls @p fn for every car (awake or sleeping) in the chunks overlapping [minX, maxX].
+   */
+  void forEachCarIn(float minX, float maxX, const std::function<void(const Car &)> &fn) const;
+
+  // --- Camera view (written by the render thread, read by the simulation thread) ---
+  /**
+   * @brief Sets the visible X range in meters. An empty range (maxX <= minX) means "no view".
+   */
+  void setView(float minX, float maxX);
+  bool getView(float &minX, float &maxX) const;
+
+  /**
+   * @brief The view the current (or last) tick was scheduled with. beginTick() reads the view
+   * once, so this is exactly what decided which chunks stayed active (used by ReplayRecorder).
+   */
+  bool getTickView(float &minX, float &maxX) const {
+    minX = tickViewMinX;
+    maxX = tickViewMaxX;
+    return maxX > minX;
+  }
+
+private:
+  struct Location {
+    int chunk = -1;
+    uint32_t slot = 0; ///< Index in the chunk's cars or sleepers.
+    bool asleep = false;
+    uint32_t epoch = 0;      ///< Bumped when the car wakes or leaves; stale wake entries are ignored.
+    double sleptSince = 0.0; ///< Simulation time a sleeping car has been advanced to.
+  };
+
+  struct WakeEntry {
+    double at;
+    uint32_t carIndex;
+    uint32_t epoch;
+    bool operator>(const WakeEntry &other) const { return at > other.at; }
+  };
+
+  std::vector<Chunk> chunks;
+  std::vector<std::vector<Module *>> moduleChunks; ///< Modules by chunk of their left edge.
+  std::vector<Location> carLocations;              ///< Indexed by CarId::index.
+  std::vector<int> activeList;
+  std::vector<CarId> activeCars;
+  std::priority_queue<WakeEntry, std::vector<WakeEntry>, std::greater<>> wakeQueue;
+  std::vector<const Car *> neighborScratch;
+
+  double now = 0.0; ///< Simulation time the active chunks have been advanced to.
+  double tickEnd = 0.0;
+  int movingCarCount = 0;
+  size_t sleepingCarCount = 0;
+  float maxModuleWidth = 0.0f;
+
+  std::atomic<float> viewMinX{0.0f};
+  std::atomic<float> viewMaxX{0.0f};
+  float tickViewMinX = 0.0f; ///< View latched by beginTick() (simulation thread).
+  float tickViewMaxX = 0.0f;
+
+  Chunk &chunkAt(int index);
+  int clampedIndex(float x, size_t count) const;
+  void insertCar(Car *car, int chunkIndex);
+  void eraseCar(const Car *car);
+
+  void activate(int index);
+  void deactivate(int index);
+
+  void sleep(Car *car);
+  void wake(Car *car);
+
+  /**
+   * @brief Simulation time at which a parked car needs attention again.
+   */
+  double dueTime(const Car &car) const;
+
+  /**
+   * @brief Advances a sleeping car from sleptSince to now.
+   */
+  void catchUp(Car &car, Location &location);
+
+  bool isInView(int index) const;
+};
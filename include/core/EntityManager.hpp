@@ -1,47 +1,260 @@
 #pragma once
+#include "core/CarPool.hpp"
+#include "core/ChunkGrid.hpp"
 #include "core/EventBus.hpp"
+#include "core/LaneIndex.hpp"
+#include "core/Random.hpp"
+#include "core/RenderSnapshot.hpp"
+#include "core/SimulationParams.hpp"
+#include "core/SlotMap.hpp"
+#include "core/TripleBuffer.hpp"
 #include "entities/Car.hpp"
 #include "entities/map/Modules.hpp"
 #include "entities/map/World.hpp"
+#include "systems/OccupancyStats.hpp"
+#include "systems/PricingEngine.hpp"
+#include <cstdint>
 #include <memory>
+#include <string>
 #include <vector>
 
+struct GeneratedMap;
+class BinaryReader;
+class BinaryWriter;
+
 /**
  * @class EntityManager
  * @brief Manages the lifecycle and storage of all game entities.
  *
  * Stores the World, Modules, and Cars.
  * Subscribes to events to trigger spawning, generation, and updates.
+ *
+ * Cars live in a generational SlotMap: they are stored densely for iteration and addressed from
+ * events and other systems through CarId handles, which stop resolving once the car is removed.
+ * Removed cars go back to a CarPool and are recycled by later spawns.
+ *
+ * Cars and the spot states of the modules are drawn from a RenderSnapshot rather than from the
+ * live entities, so the simulation may run on another thread: the simulation side calls
+ * publishSnapshot() after its ticks and the render side picks the latest one up in draw().
+ *
+ * Modules and cars are also indexed by a ChunkGrid. update() only advances the cars of active
+ * chunks, and draw() / publishSnapshot() only handle the chunks around the camera view.
  */
 class EntityManager {
 public:
   /**
    * @brief Constructs the EntityManager.
    * @param bus EventBus for communication.
+   * @param params Behaviour thresholds of this simulation instance.
    */
-  explicit EntityManager(std::shared_ptr<EventBus> bus);
+  explicit EntityManager(std::shared_ptr<EventBus> bus, const SimulationParams &params = {});
   ~EntityManager();
 
   /**
-   * @brief Updates all managed entities.
+   * @brief Updates all managed entities, then publishes CarArrivedAtSpotEvent for the cars that
+   * reached their spot.
    * @param dt Delta time.
    */
   void update(double dt);
 
   /**
-   * @brief Draws all managed entities in the correct order (World -> Modules -> Cars -> Overlay).
+   * @brief Draws the managed entities in the correct order (World -> Modules -> Cars -> Overlay).
+   *
+   * Cars come from the latest published snapshot, interpolated between their previous and
+   * current transforms.
+   *
+   * @param view Visible world area in meters. Only tiles and modules overlapping it are drawn;
+   *             it is also handed to the ChunkGrid to keep the chunks around it active. An empty
+   *             rectangle draws everything.
+   */
+  void draw(Rectangle view = {0, 0, 0, 0});
+
+  /**
+   * @brief Captures the current simulation state into a snapshot and hands it to the renderer.
+   * Must be called from the thread that runs the simulation.
+   * @param fraction Leftover accumulator fraction after the last tick (0..1).
+   * @param tickInterval Real seconds per tick at the current speed (0 disables interpolation).
+   */
+  void publishSnapshot(double fraction, double tickInterval);
+
+  /**
+   * @brief The snapshot used for the current frame. Render thread only.
    */
-  void draw();
+  const RenderSnapshot &getRenderSnapshot() const { return snapshots.readBuffer(); }
+
+  /**
+   * @brief Car whose transforms every snapshot carries for the camera, wherever it is. An invalid
+   * handle tracks nothing. Simulation thread only.
+   */
+  void setTrackedCar(CarId id) { trackedCar = id; }
+
+  /**
+   * @brief Interpolated position of the tracked car in the latest snapshot. Render thread only.
+   * @return False if no car is tracked or it no longer exists.
+   */
+  bool getTrackedCarPosition(Vector2 &position);
 
   // Entity Management
   void setWorld(std::unique_ptr<World> world);
   void addModule(std::unique_ptr<Module> module);
-  void addCar(std::unique_ptr<Car> car);
+
+  /**
+   * @brief Writes the current layout (world and modules) as a binary map file.
+   * @throws std::runtime_error if there is no world or the file cannot be written.
+   */
+  void saveMap(const std::string &path) const;
+
+  /**
+   * @brief Replaces the current layout with one read from a binary map file.
+   *
+   * Publishes WorldBoundsEvent like a generated world does.
+   * @throws std::runtime_error if the file cannot be read (the current layout is left untouched).
+   */
+  void loadMap(const std::string &path);
+
+  /**
+   * @brief Appends the dynamic state (spot states, every car with its path) to a checkpoint.
+   *
+   * Sleeping cars are caught up first, so every car is written as of the current tick.
+   */
+  void saveCheckpoint(BinaryWriter &out);
+
+  /**
+   * @struct CheckpointState
+   * @brief The section written by saveCheckpoint(), read and validated but not applied yet.
+   */
+  struct CheckpointState {
+    std::vector<SpotState> spotStates;
+    std::vector<Car::Snapshot> cars;
+    std::vector<uint32_t> pathLengths; ///< Per car, its number of entries in waypoints.
+    std::vector<Waypoint> waypoints;   ///< The cars' paths, one after the other.
+    PricingEngine::State prices;
+  };
+
+  /**
+   * @brief Reads what saveCheckpoint() wrote, without changing anything.
+   * @throws std::runtime_error if the data is corrupt or belongs to another layout.
+   */
+  CheckpointState readCheckpoint(BinaryReader &in) const;
+
+  /**
+   * @brief Replaces spot states and cars with a state read by readCheckpoint().
+   *
+   * Current cars go back to the pool (CarDeletedEvent each) and the restored ones are taken from
+   * it, so repeated restores do not allocate. Publishes CheckpointRestoredEvent when done.
+   */
+  void restoreCheckpoint(const CheckpointState &state);
+
+  /**
+   * @brief The random source of this simulation instance.
+   *
+   * Every random decision of the simulation (world generation, spawns, spot choices, parking
+   * times) is drawn from it. It starts with a non-deterministic seed; reseed it before generating
+   * the world to make a run reproducible.
+   */
+  Random &getRandom() { return random; }
+
+  const SimulationParams &getParams() const { return params; }
+
+  /**
+   * @brief Counter bumped whenever the module set changes (added or cleared), for caches.
+   */
+  uint32_t getModuleRevision() const { return moduleRevision; }
+
+  /**
+   * @brief Takes ownership of a car and assigns its CarId.
+   * @return Handle to the stored car.
+   */
+  CarId addCar(std::unique_ptr<Car> car);
 
   // Accessors
   World *getWorld() const { return world.get(); }
   const std::vector<std::unique_ptr<Module>> &getModules() const { return modules; }
-  const std::vector<std::unique_ptr<Car>> &getCars() const { return cars; }
+
+  /**
+   * @brief All live cars, densely packed. Order changes when cars are removed.
+   */
+  const std::vector<std::unique_ptr<Car>> &getCars() const { return cars.values(); }
+
+  /**
+   * @brief Awake cars of the chunks simulated in the last tick. The others are parked cars that
+   * sleep until they are due for something (see ChunkGrid). Entries may be stale if a car was removed since; resolve them with
+   * getCar().
+   */
+  const std::vector<CarId> &getActiveCars() const { return chunks.getActiveCars(); }
+
+  const ChunkGrid &getChunkGrid() const { return chunks; }
+
+  /**
+   * @brief Cars of the main road lanes sorted by X, as of the last tick.
+   */
+  const LaneIndex &getLanes() const { return lanes; }
+
+  /**
+   * @brief Brings sleeping cars up to the current tick (timers and charge), for code that reads
+   * every car's state at once (checkpoints, batch run totals).
+   */
+  void catchUpSleepingCars() { chunks.catchUpSleeping(); }
+
+  /**
+   * @brief Sets the camera view that keeps chunks active, for runs without draw() (replays).
+   * An empty range (maxX <= minX) means no view.
+   */
+  void setView(float minX, float maxX) { chunks.setView(minX, maxX); }
+
+  /**
+   * @brief FNV-1a hash of the dynamic simulation state: every spot state and, per car in storage
+   * order, its id, kinematics, state, battery, parking timer and remaining path length.
+   *
+   * Sleeping cars are hashed as they are stored (not caught up), so two runs compare equal only
+   * if they also agree on which cars slept. Simulation thread only.
+   */
+  uint64_t computeStateHash() const;
+
+  /**
+   * @brief The selection a click at @p worldPos makes: the nearest car within
+   * Config::Picking::CAR_RADIUS, else the module containing the point, narrowed to its nearest spot
+   * within Config::Picking::SPOT_RADIUS. Type GENERAL if nothing is hit.
+   *
+   * Only the chunks around the point are searched. Simulation thread, or with the simulation locked.
+   */
+  EntitySelectedEvent pick(Vector2 worldPos) const;
+
+  /**
+   * @brief Rectangle multi-select: every car whose position lies inside @p area and every module
+   * overlapping it, searched in the chunks the rectangle covers. Same threading rule as pick().
+   */
+  void pickArea(Rectangle area, std::vector<CarId> &carsOut, std::vector<Module *> &modulesOut) const;
+
+  /**
+   * @brief Resolves a car handle.
+   * @return The car, or nullptr if it has been removed (or the handle is invalid).
+   */
+  Car *getCar(CarId id) const;
+
+  /**
+   * @brief Allocation counters of the car pool.
+   */
+  const CarPool::Stats &getCarPoolStats() const { return carPool.getStats(); }
+
+  /**
+   * @brief Changes a facility spot's state and publishes a SpotStateChangedEvent.
+   *
+   * All spot transitions made by the simulation go through here, so OccupancyStats stays exact.
+   * @param price Price quoted for the stay, when an OCCUPIED spot is released (see
+   *              SpotStateChangedEvent::price).
+   */
+  void setSpotState(Module *module, int spotIndex, SpotState state, float price = 0.0f);
+
+  /**
+   * @brief Incrementally maintained occupancy counters (simulation thread only).
+   */
+  const OccupancyStats &getOccupancyStats() const { return occupancy; }
+
+  /**
+   * @brief Surge pricing of the facilities (simulation thread only).
+   */
+  const PricingEngine &getPricing() const { return pricing; }
 
   /**
    * @brief Clears all entities and resets the world.
@@ -49,18 +262,38 @@ public:
   void clear();
 
   /**
-   * @brief Removes a specific car from the simulation.
-   * @param car Pointer to the car to remove.
+   * @brief Removes a specific car from the simulation in O(1).
+   * @param id Handle of the car to remove. Stale handles are ignored.
    */
-  void removeCar(Car *car);
+  void removeCar(CarId id);
 
 private:
   std::shared_ptr<EventBus> eventBus;
   std::vector<Subscription> eventTokens;
+  SimulationParams params;
+  Random random;
+
+  /**
+   * @brief Takes over a generated or loaded layout and announces the world bounds.
+   */
+  void installMap(GeneratedMap &&map);
 
   std::unique_ptr<World> world;
   std::vector<std::unique_ptr<Module>> modules;
-  std::vector<std::unique_ptr<Car>> cars;
+  SlotMap<std::unique_ptr<Car>> cars;
+  CarPool carPool;
+  ChunkGrid chunks;
+  LaneIndex lanes;
+  std::vector<CarId> arrivals; ///< Cars that reached their spot in the current tick (CarArrivedAtSpotEvent).
+  uint32_t moduleRevision = 0;
   
   bool dashboardVisible = false;
+  EntitySelectedEvent selection;
+  CarId trackedCar;
+
+  TripleBuffer<RenderSnapshot> snapshots;
+  OccupancyStats occupancy;
+  PricingEngine pricing;
+
+  void captureSelection(SelectionView &view) const;
 };
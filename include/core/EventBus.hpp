@@ -1,5 +1,6 @@
 #pragma once
 
+#include "core/Profiler.hpp"
 #include "events/EventTypes.hpp"
 #include <algorithm>
 #include <functional>
@@ -146,6 +147,7 @@ public:
    * @param event The event data instance.
    */
   template <EventType T> void publish(const T &event) {
+    PROFILE_ZONE_DETAIL("EventBus::publish", typeid(T).name());
     std::vector<std::shared_ptr<IEventWrapper>> listenersSnapshot;
 
     {
@@ -0,0 +1,127 @@
+#pragma once
+#include "entities/Car.hpp"
+#include "entities/map/Modules.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file LaneIndex.hpp
+ * @brief Cars in the two lanes of the main road, kept sorted by X.
+ */
+
+/**
+ * @class LaneIndex
+ * @brief Per-lane car lists of the main road, sorted by X and updated incrementally every tick.
+ *
+ * Lane::DOWN runs toward +X at Config::LANE_OFFSET_DOWN below the top of the road, Lane::UP
+ * toward -X at Config::LANE_OFFSET_UP. A car is in a lane while it is DRIVING or EXITING within
+ * Config::CarAI::Idm::LANE_HALF_WIDTH of the lane's center line and heads in the lane's direction.
+ *
+ * Each tick the simulated cars are observed after they moved; endTick() drops the cars that left
+ * a lane or were not seen, appends the newcomers and restores the order with an insertion sort.
+ * Overtaking is rare, so the lists are almost sorted and a tick costs O(n). The car ahead of or
+ * behind a lane car is then its neighbor in the list: O(1), no geometric search.
+ *
+ * Like the ChunkGrid, the index owns no cars and belongs to the simulation thread.
+ */
+class LaneIndex {
+public:
+  /**
+   * @brief Places the lanes on a main road whose top edge is at @p roadTopY (meters).
+   */
+  void setRoad(float roadTopY);
+  bool hasRoad() const { return roadSet; }
+
+  /**
+   * @brief Y of a lane's center line.
+   */
+  float laneY(Lane lane) const { return lane == Lane::DOWN ? downY : upY; }
+
+  /**
+   * @brief Forgets the road and all cars.
+   */
+  void clear();
+
+  /**
+   * @brief Forgets all cars, keeping the road.
+   */
+  void clearCars();
+
+  void removeCar(const Car *car);
+
+  // --- Ticking (simulation thread) ---
+  void beginTick();
+
+  /**
+   * @brief Reports a car after its update. Lists change only in endTick(), so lookups during the
+   * tick see the order of the previous one.
+   */
+  void observe(Car *car);
+  void endTick();
+
+  // --- Queries ---
+  /**
+   * @brief The car ahead of @p car in its lane.
+   * @param[out] leader Next car in the driving direction, nullptr if @p car is the first one.
+   * @return False if @p car is not in a lane.
+   */
+  bool findLeader(const Car &car, const Car *&leader) const;
+
+  /**
+   * @brief The car behind @p car in its lane (nullptr if none or not in a lane).
+   */
+  const Car *findFollower(const Car &car) const;
+
+  /**
+   * @brief The car nearest to where the lane enters the map (the last one in driving order),
+   * or nullptr if the lane is empty. Used to check that a spawn point is clear.
+   */
+  const Car *lastInLane(Lane lane) const;
+
+  /**
+   * @brief Cars of a lane in ascending X (as of the last endTick(); removed cars are nullptr).
+   */
+  const std::vector<Car *> &getCars(Lane lane) const { return lanes[index(lane)].cars; }
+
+private:
+  static constexpr int NONE = -1;
+
+  struct LaneList {
+    std::vector<Car *> cars;    ///< Ascending X; nullptr where a car was removed during the tick.
+    std::vector<Car *> joining; ///< Observed in this lane during the tick, not listed yet.
+  };
+
+  /**
+   * @struct Membership
+   * @brief Where a car (by CarId index) is listed.
+   */
+  struct Membership {
+    int lane = NONE; ///< Lane the car is listed in.
+    uint32_t slot = 0;
+    int seenLane = NONE; ///< Lane it was observed in during the current tick.
+    uint32_t seenTick = 0;
+  };
+
+  std::array<LaneList, 2> lanes;
+  std::vector<Membership> members;
+  uint32_t tick = 0;
+
+  bool roadSet = false;
+  float upY = 0.0f;
+  float downY = 0.0f;
+
+  static int index(Lane lane) { return lane == Lane::DOWN ? 1 : 0; }
+  Membership *membership(const Car &car);
+  const Membership *membership(const Car &car) const;
+
+  /**
+   * @brief Lane the car currently drives in, or NONE.
+   */
+  int classify(const Car &car) const;
+
+  /**
+   * @brief First car from @p slot (exclusive) in @p direction (+1 / -1) of a lane list.
+   */
+  const Car *step(int lane, long slot, int direction) const;
+};
@@ -0,0 +1,57 @@
+#pragma once
+#include "events/GameEvents.hpp"
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @file LaunchOptions.hpp
+ * @brief Command line / config file options read at startup.
+ */
+
+/**
+ * @struct LaunchOptions
+ * @brief Startup settings that bypass the interactive menus.
+ *
+ * The map configuration screen limits every facility type to Config::Map::UI_MAX_PER_TYPE.
+ * Larger sites (load tests) are described here instead, either on the command line:
+ *
+ *     parklogic --small-parking=2500 --large-parking=2500 --small-charging=2500 --large-charging=2500
+ *
+ * or in a plain "key = value" file passed with --map-config=<path>:
+ *
+ *     # 10k facilities
+ *     small_parking = 2500
+ *     large_parking = 2500
+ *     small_charging = 2500
+ *     large_charging = 2500
+ *
+ * Command line values override the file. When any count is given, the game starts directly in
+ * the generated world (counts left unspecified default to 0).
+ *
+ * A layout saved in game (MapFile) is loaded instead with --map=<path>; counts are then ignored.
+ *
+ * --replay=<path> plays a session recording (ReplayRecording, saved in game with F7) headless
+ * and exits instead of opening the window.
+ */
+struct LaunchOptions {
+  std::optional<MapConfig> mapConfig; ///< Set if the world should be generated right away.
+  std::string replayPath;             ///< Set to play a recording instead of starting the game.
+
+  /**
+   * @brief Parses the process arguments.
+   * @throws std::runtime_error on unknown options, malformed values or an unreadable config file.
+   */
+  static LaunchOptions parse(int argc, const char *const *argv);
+
+  /**
+   * @brief Parses already split arguments (without the program name).
+   */
+  static LaunchOptions parse(const std::vector<std::string> &args);
+
+  /**
+   * @brief Reads facility counts from a "key = value" file into @p config.
+   * @throws std::runtime_error if the file cannot be read or contains an invalid line.
+   */
+  static void loadMapConfigFile(const std::string &path, MapConfig &config);
+};
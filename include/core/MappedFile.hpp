@@ -0,0 +1,32 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+/**
+ * @class MappedFile
+ * @brief Read-only view of a whole file, memory-mapped where the platform supports it.
+ *
+ * On POSIX systems the file is mmap'ed, so opening it costs nothing up front and pages are
+ * faulted in as they are read. Elsewhere the file is read into memory in one call.
+ */
+class MappedFile {
+public:
+  /**
+   * @throws std::runtime_error if the file cannot be opened or mapped.
+   */
+  explicit MappedFile(const std::string &path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile &) = delete;
+  MappedFile &operator=(const MappedFile &) = delete;
+
+  std::span<const std::byte> bytes() const { return {data, size}; }
+
+private:
+  const std::byte *data = nullptr;
+  size_t size = 0;
+  bool mapped = false;
+  std::vector<std::byte> fallback; ///< File contents when memory mapping is unavailable.
+};
@@ -0,0 +1,88 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @file MetricSeries.hpp
+ * @brief Fixed-memory, multi-resolution time series.
+ */
+
+/**
+ * @class MetricSeries
+ * @brief Stores a sampled value at several resolutions in fixed-size ring buffers.
+ *
+ * Tier 0 keeps one bucket per sample. Every `factor` completed buckets of tier k are folded into
+ * one bucket of tier k + 1, so tier k covers factor^k samples per bucket. Each tier is a ring of
+ * `capacity` buckets and overwrites its oldest bucket when full. Memory is therefore constant
+ * (tiers x capacity buckets) no matter how long the simulation runs, while the coarse tiers still
+ * cover the whole run at reduced resolution.
+ *
+ * Buckets keep min, max and sum, so downsampling never loses the extremes.
+ */
+class MetricSeries {
+public:
+  /**
+   * @struct Bucket
+   * @brief Aggregate of one or more samples.
+   */
+  struct Bucket {
+    float min = 0.0f;
+    float max = 0.0f;
+    double sum = 0.0;
+    uint32_t count = 0; ///< Number of raw samples aggregated.
+
+    float mean() const { return count > 0 ? static_cast<float>(sum / count) : 0.0f; }
+    void add(const Bucket &other);
+  };
+
+  /**
+   * @param capacity Buckets per tier.
+   * @param tiers Number of resolutions.
+   * @param factor Buckets of one tier folded into one bucket of the next.
+   */
+  MetricSeries(size_t capacity, size_t tiers, size_t factor);
+
+  /**
+   * @brief Records one sample.
+   */
+  void add(float value);
+
+  /**
+   * @brief Copies the completed buckets of a tier, oldest first.
+   * @param tier Resolution (0 = finest).
+   * @param out Destination; cleared first, its capacity is reused.
+   */
+  void copyTier(size_t tier, std::vector<Bucket> &out) const;
+
+  /**
+   * @brief Raw samples per bucket at a tier.
+   */
+  size_t samplesPerBucket(size_t tier) const;
+
+  size_t tierCount() const { return rings.size(); }
+  size_t capacity() const { return bucketsPerTier; }
+
+  /**
+   * @brief The most recent sample (0 if none).
+   */
+  float latest() const { return lastValue; }
+
+  void clear();
+
+private:
+  struct Ring {
+    std::vector<Bucket> buckets; ///< Fixed size (capacity), allocated once.
+    size_t head = 0;             ///< Next slot to write.
+    size_t size = 0;             ///< Completed buckets stored.
+    Bucket pending;              ///< Bucket being filled from the tier below.
+    size_t pendingParts = 0;     ///< Lower-tier buckets folded into pending.
+  };
+
+  size_t bucketsPerTier;
+  size_t factor;
+  std::vector<Ring> rings;
+  float lastValue = 0.0f;
+
+  void push(size_t tier, const Bucket &bucket);
+};
@@ -0,0 +1,188 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+/**
+ * @file Profiler.hpp
+ * @brief Lightweight built-in instrumentation: scoped zones, per-frame timings, Chrome trace dump.
+ *
+ * Zones are recorded with PROFILE_ZONE("Name") at the top of a scope. The macros compile to
+ * nothing unless PARKLOGIC_PROFILER is defined (CMake option PARKLOGIC_ENABLE_PROFILER).
+ */
+
+/**
+ * @class Profiler
+ * @brief Collects timed zones from every thread into per-thread lock-free ring buffers.
+ *
+ * Each thread writes only to its own buffer (single producer), publishing the write index with
+ * release semantics; readers (overlay, trace dump) load it with acquire and drop entries the
+ * writer may have lapped while they were copying. The ring slots are relaxed atomics, so a copy
+ * that races a write is a stale value to discard rather than a data race. Recording a zone
+ * therefore never takes a lock.
+ *
+ * Timestamps come from std::chrono::steady_clock (nanoseconds) so they are comparable across
+ * threads and cores, unlike raw rdtsc.
+ */
+class Profiler {
+public:
+  /**
+   * @struct ZoneEvent
+   * @brief One completed zone.
+   */
+  struct ZoneEvent {
+    const char *name = nullptr;   ///< Static string (literal).
+    const char *detail = nullptr; ///< Optional static string (e.g. event type), may be null.
+    uint64_t start = 0;           ///< Nanoseconds (steady clock).
+    uint64_t end = 0;
+    uint32_t depth = 0; ///< Nesting depth on its thread.
+  };
+
+  /**
+   * @struct ZoneSummary
+   * @brief Per-frame aggregate of all zones sharing a name.
+   */
+  struct ZoneSummary {
+    const char *name = nullptr;
+    double totalMs = 0.0;
+    uint32_t calls = 0;
+  };
+
+  static Profiler &Get() {
+    static Profiler instance;
+    return instance;
+  }
+
+  Profiler(const Profiler &) = delete;
+  Profiler &operator=(const Profiler &) = delete;
+
+  /**
+   * @brief Current timestamp in nanoseconds.
+   */
+  static uint64_t now();
+
+  /**
+   * @brief Appends a completed zone to the calling thread's buffer. Lock-free.
+   */
+  void record(const char *name, const char *detail, uint64_t start, uint64_t end, uint32_t depth);
+
+  /**
+   * @brief Closes the current frame window and aggregates the zones that ended inside it.
+   *
+   * Called once per rendered frame from the main thread. The result (zones of all threads,
+   * including the simulation thread) is available through getFrameSummary().
+   */
+  void markFrame();
+
+  /**
+   * @brief Zone totals of the last completed frame, sorted by total time (main thread only).
+   */
+  const std::vector<ZoneSummary> &getFrameSummary() const { return frameSummary; }
+  double getFrameMs() const { return frameMs; }
+
+  /**
+   * @brief Writes all buffered zones in Chrome trace event format (chrome://tracing, Perfetto).
+   */
+  void writeChromeTrace(std::ostream &out);
+
+  void setEnabled(bool on) { enabled.store(on, std::memory_order_relaxed); }
+  bool isEnabled() const { return enabled.load(std::memory_order_relaxed); }
+
+  /**
+   * @brief Nesting depth bookkeeping for ProfileZone (per thread).
+   */
+  static uint32_t &threadDepth();
+
+private:
+  Profiler() = default;
+
+  /**
+   * @brief Ring storage of one ZoneEvent, written by its thread and read concurrently.
+   */
+  struct EventSlot {
+    std::atomic<const char *> name{nullptr};
+    std::atomic<const char *> detail{nullptr};
+    std::atomic<uint64_t> start{0};
+    std::atomic<uint64_t> end{0};
+    std::atomic<uint32_t> depth{0};
+  };
+
+  struct ThreadBuffer {
+    std::vector<EventSlot> events; ///< Ring storage, fixed size.
+    std::atomic<uint64_t> written{0};
+    std::atomic<bool> inUse{false};
+    uint32_t threadId = 0;
+  };
+
+  /**
+   * @brief Releases a thread's buffer for reuse when the thread exits.
+   */
+  struct ThreadSlot {
+    ThreadBuffer *buffer = nullptr;
+    ~ThreadSlot();
+  };
+
+  ThreadBuffer &threadBuffer();
+  void copyEvents(const ThreadBuffer &buffer, std::vector<ZoneEvent> &out) const;
+
+  std::atomic<bool> enabled{false}; ///< Recording is off until the overlay (F3) turns it on.
+
+  std::mutex registryMutex; ///< Guards buffers (registration only, never taken on record()).
+  std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+  uint32_t nextThreadId = 1;
+
+  // Main-thread frame aggregation
+  uint64_t frameStart = 0;
+  double frameMs = 0.0;
+  std::vector<ZoneSummary> frameSummary;
+  std::vector<ZoneEvent> scratch;
+};
+
+/**
+ * @class ProfileZone
+ * @brief RAII zone: records its lifetime when it goes out of scope.
+ */
+class ProfileZone {
+public:
+  explicit ProfileZone(const char *name, const char *detail = nullptr)
+      : name(name), detail(detail), active(Profiler::Get().isEnabled()) {
+    if (active) {
+      depth = Profiler::threadDepth()++;
+      start = Profiler::now();
+    }
+  }
+
+  ~ProfileZone() {
+    if (active) {
+      Profiler::Get().record(name, detail, start, Profiler::now(), depth);
+      Profiler::threadDepth()--;
+    }
+  }
+
+  ProfileZone(const ProfileZone &) = delete;
+  ProfileZone &operator=(const ProfileZone &) = delete;
+
+private:
+  const char *name;
+  const char *detail;
+  bool active;
+  uint32_t depth = 0;
+  uint64_t start = 0;
+};
+
+#define PARKLOGIC_PROFILE_CONCAT_INNER(a, b) a##b
+#define PARKLOGIC_PROFILE_CONCAT(a, b) PARKLOGIC_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef PARKLOGIC_PROFILER
+/// Times the enclosing scope under a static name.
+#define PROFILE_ZONE(name) ProfileZone PARKLOGIC_PROFILE_CONCAT(profileZone_, __LINE__)(name)
+/// Same as PROFILE_ZONE with an extra static detail string (shown as a trace argument).
+#define PROFILE_ZONE_DETAIL(name, detail) ProfileZone PARKLOGIC_PROFILE_CONCAT(profileZone_, __LINE__)(name, detail)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#define PROFILE_ZONE_DETAIL(name, detail) ((void)0)
+#endif
@@ -0,0 +1,53 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <utility>
+
+/**
+ * @file Random.hpp
+ * @brief Seedable random source owned by a simulation instance.
+ */
+
+/**
+ * @class Random
+ * @brief Per-instance pseudo random generator (std::mt19937).
+ *
+ * Everything random in a simulation (spawns, spot choices, prices, parking times) is drawn from
+ * the Random of its EntityManager instead of raylib's process-wide GetRandomValue(). Two
+ * instances seeded alike therefore produce the same run, and instances on different threads
+ * never share generator state.
+ */
+class Random {
+public:
+  /**
+   * @brief Creates a generator with a non-deterministic seed.
+   */
+  Random() : Random(std::random_device{}()) {}
+  explicit Random(uint64_t seed) { reseed(seed); }
+
+  void reseed(uint64_t seed) { engine.seed(static_cast<std::mt19937::result_type>(seed ^ (seed >> 32))); }
+
+  /**
+   * @brief Uniform integer in [min, max] (both inclusive, like GetRandomValue()).
+   */
+  int uniformInt(int min, int max) {
+    if (min > max)
+      std::swap(min, max);
+    return std::uniform_int_distribution<int>(min, max)(engine);
+  }
+
+  /**
+   * @brief Uniform float in [min, max).
+   */
+  float uniformFloat(float min, float max) { return std::uniform_real_distribution<float>(min, max)(engine); }
+
+  /**
+   * @brief True with probability @p p.
+   */
+  bool chance(float p) { return uniformFloat(0.0f, 1.0f) < p; }
+
+  std::mt19937 &getEngine() { return engine; }
+
+private:
+  std::mt19937 engine;
+};
@@ -0,0 +1,106 @@
+#pragma once
+#include "entities/Car.hpp"
+#include "entities/map/Modules.hpp"
+#include "events/GameEvents.hpp"
+#include "raylib.h"
+#include "systems/OccupancyStats.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @file RenderSnapshot.hpp
+ * @brief Immutable view of the simulation handed from the simulation thread to the render thread.
+ */
+
+/**
+ * @struct CarRenderState
+ * @brief Everything needed to draw (and inspect) one car without touching the live Car.
+ */
+struct CarRenderState {
+  CarId id;
+  Vector2 previousPosition = {0, 0}; ///< Position before the last tick (interpolation start).
+  Vector2 position = {0, 0};         ///< Position after the last tick (interpolation end).
+  float previousRotation = 0.0f;     ///< Sprite rotation (degrees) before the last tick.
+  float rotation = 0.0f;             ///< Sprite rotation (degrees) after the last tick.
+  std::string textureName;
+  bool selected = false;
+
+  // Dashboard details
+  Vector2 velocity = {0, 0};
+  Car::CarType type = Car::CarType::COMBUSTION;
+  Car::CarState state = Car::CarState::DRIVING;
+  Car::Priority priority = Car::Priority::PRIORITY_DISTANCE;
+  float batteryLevel = 0.0f;
+};
+
+/**
+ * @struct ModuleRenderState
+ * @brief A module to draw. Its geometry and textures do not change after generation; its spots
+ * are copied into RenderSnapshot::spots, since the simulation changes their states and prices.
+ */
+struct ModuleRenderState {
+  const Module *module = nullptr;
+  uint32_t firstSpot = 0; ///< Index of its first spot in RenderSnapshot::spots.
+  uint32_t spotCount = 0;
+};
+
+/**
+ * @struct SelectionView
+ * @brief Copy of the currently selected entity's details, resolved on the simulation thread.
+ */
+struct SelectionView {
+  SelectionType type = SelectionType::GENERAL;
+
+  bool carFound = false; ///< False if the selected car no longer exists.
+  CarRenderState car;
+  std::vector<Vector2> carPath; ///< Remaining waypoints of the selected car.
+
+  const Module *module = nullptr; ///< Identity only; its changing spots are copied below.
+  ModuleType moduleType = ModuleType::GENERIC;
+  Module::SpotCounts facilityCounts = {0, 0, 0};
+  float priceMultiplier = 1.0f;
+  float surge = 1.0f; ///< PricingEngine factor on top of the list prices.
+
+  int spotIndex = -1;
+  Spot spot = {{0, 0}, 0.0f, -1};
+};
+
+/**
+ * @struct RenderSnapshot
+ * @brief The complete state published after each batch of simulation ticks.
+ */
+struct RenderSnapshot {
+  std::vector<CarRenderState> cars;
+  std::vector<ModuleRenderState> modules;
+  std::vector<SpotRenderState> spots; ///< The modules' spots, module after module.
+  OccupancyCounters counters;
+  SelectionView selection;
+
+  bool trackedFound = false; ///< False if no car is tracked or it no longer exists.
+  CarRenderState tracked;    ///< Transforms of the tracked car, captured even outside the view.
+
+  double publishedAt = 0.0;  ///< Steady clock time (seconds) of publication.
+  double fraction = 1.0;     ///< Accumulator fraction (0..1) left over after the last tick.
+  double tickInterval = 0.0; ///< Real seconds per tick at the current speed (0 disables interpolation).
+
+  /**
+   * @brief Computes the interpolation factor between previous and current car transforms.
+   *
+   * Extends the accumulator fraction by the real time that passed since publication, so the
+   * render thread keeps moving cars smoothly while the simulation thread sleeps.
+   *
+   * @param now Current steady clock time in seconds.
+   * @return Interpolation factor clamped to [0, 1].
+   */
+  float interpolationAlpha(double now) const {
+    if (tickInterval <= 0.0)
+      return 1.0f;
+    double alpha = fraction + (now - publishedAt) / tickInterval;
+    if (alpha < 0.0)
+      alpha = 0.0;
+    if (alpha > 1.0)
+      alpha = 1.0;
+    return static_cast<float>(alpha);
+  }
+};
@@ -0,0 +1,161 @@
+#pragma once
+#include "config.hpp"
+#include "core/EventBus.hpp"
+#include "core/SimulationParams.hpp"
+#include "entities/CarId.hpp"
+#include "events/GameEvents.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class EntityManager;
+
+/**
+ * @file Replay.hpp
+ * @brief Recording of the externally injected events of a session, and their headless replay.
+ */
+
+/**
+ * @brief What a ReplayEntry stands for.
+ */
+enum class ReplayEventKind : uint32_t {
+  SPAWN_REQUEST,     ///< SpawnCarRequestEvent
+  CYCLE_SPAWN_LEVEL, ///< CycleAutoSpawnLevelEvent
+  SPEED_CHANGED,     ///< SimulationSpeedChangedEvent (value: multiplier)
+  PAUSED,            ///< GamePausedEvent
+  RESUMED,           ///< GameResumedEvent
+  SELECTION,         ///< EntitySelectedEvent
+  VIEW,              ///< Camera view the following ticks were scheduled with (value, value2: X range)
+  TICK_LENGTH,       ///< Length of the following ticks (value: seconds)
+  COUNT
+};
+
+/**
+ * @struct ReplayEntry
+ * @brief One recorded event, stored as a flat record.
+ */
+struct ReplayEntry {
+  uint64_t tick = 0; ///< Ticks completed when the event happened; it is replayed before the next one.
+  ReplayEventKind kind = ReplayEventKind::SPAWN_REQUEST;
+  int32_t selectionType = 0; ///< SelectionType of a SELECTION.
+  CarId carId;               ///< Selected car.
+  int32_t moduleIndex = -1;  ///< Selected facility, as an index into EntityManager::getModules().
+  int32_t spotIndex = -1;    ///< Selected spot.
+  double value = 0.0;
+  double value2 = 0.0;
+};
+static_assert(sizeof(ReplayEntry) == 48, "ReplayEntry is written as is");
+
+/**
+ * @struct ReplayHash
+ * @brief State hash (EntityManager::computeStateHash) after a number of ticks.
+ */
+struct ReplayHash {
+  uint64_t tick = 0;
+  uint64_t hash = 0;
+};
+
+/**
+ * @struct ReplayRecording
+ * @brief Everything needed to run a session again: seed, layout, thresholds and injected events.
+ *
+ * A layout loaded from a map file is referenced by its path, so the file has to be available
+ * (and unchanged) when the recording is played.
+ */
+struct ReplayRecording {
+  /// 2: params written field by field, with car following, spot assignment and price elasticity.
+  /// Bump it with every change of the params or of the records.
+  static constexpr uint32_t VERSION = 2;
+
+  uint64_t seed = 0;
+  MapConfig map;
+  SimulationParams params;
+  uint32_t hashInterval = Config::Replay::HASH_INTERVAL_TICKS;
+  uint64_t tickCount = 0;
+  std::vector<ReplayEntry> entries; ///< Ordered by tick.
+  std::vector<ReplayHash> hashes;   ///< Ordered by tick.
+
+  /**
+   * @throws std::runtime_error if the file cannot be written.
+   */
+  void saveTo(const std::string &path) const;
+
+  /**
+   * @throws std::runtime_error if the file cannot be read, is not a recording or is corrupt.
+   */
+  static ReplayRecording loadFrom(const std::string &path);
+};
+
+/**
+ * @class ReplayRecorder
+ * @brief Listens to a running session and records what came from outside the simulation.
+ *
+ * Records spawn requests, spawn level cycling, speed changes, pause / resume and selections
+ * with the tick they happened at, plus the two inputs the simulation reads directly: the
+ * length of each tick (variable when ticking on the render loop) and the camera view, which
+ * decides which chunks stay active. Every Config::Replay::HASH_INTERVAL_TICKS ticks the state
+ * hash is stored, so a replay can tell where it started to differ.
+ *
+ * Create it after the simulation systems: its GameUpdateEvent listener has to run last in a
+ * tick to hash the finished state. Restoring a checkpoint ends the recording, as the restored
+ * state is not part of it. Runs on the simulation thread, or under the simulation lock.
+ */
+class ReplayRecorder {
+public:
+  /**
+   * @param seed Seed the EntityManager's Random was given before the world was generated.
+   * @param map Layout the world is generated (or loaded) from.
+   */
+  ReplayRecorder(std::shared_ptr<EventBus> bus, EntityManager &entityManager, uint64_t seed, const MapConfig &map);
+
+  const ReplayRecording &getRecording() const { return recording; }
+  bool isRecording() const { return active; }
+
+private:
+  std::shared_ptr<EventBus> eventBus;
+  std::vector<Subscription> eventTokens;
+  EntityManager &entityManager;
+  ReplayRecording recording;
+  bool active = true; ///< Cleared by a checkpoint restore.
+
+  double lastTickLength = 0.0;
+  float lastViewMinX = 0.0f;
+  float lastViewMaxX = 0.0f;
+
+  void record(ReplayEventKind kind, double value = 0.0, double value2 = 0.0);
+  void recordSelection(const EntitySelectedEvent &e);
+  void onTick(double dt);
+};
+
+/**
+ * @struct ReplayResult
+ * @brief Outcome of ReplayPlayer::play.
+ */
+struct ReplayResult {
+  uint64_t ticks = 0;       ///< Ticks simulated.
+  size_t hashesChecked = 0; ///< Recorded hashes that matched.
+  bool diverged = false;
+  uint64_t divergedAtTick = 0; ///< Tick of the first mismatching hash.
+  uint64_t expectedHash = 0;
+  uint64_t actualHash = 0;
+  double wallSeconds = 0.0;
+};
+
+/**
+ * @class ReplayPlayer
+ * @brief Runs a recording headless, as fast as possible.
+ *
+ * Builds a fresh simulation (EventBus, EntityManager, TrafficSystem) without window or render
+ * thread, seeds it, generates the recorded layout and publishes every entry on the EventBus
+ * before the tick it was recorded at. Speed and pause events are published too, but have no
+ * effect without a SimulationThread: ticks are simply run back to back. Stops at the first
+ * state hash that differs from the recorded one.
+ */
+class ReplayPlayer {
+public:
+  /**
+   * @throws std::runtime_error if a selection refers to a facility the layout does not have.
+   */
+  static ReplayResult play(const ReplayRecording &recording);
+};
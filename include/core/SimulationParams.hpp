@@ -0,0 +1,43 @@
+#pragma once
+#include "config.hpp"
+
+/**
+ * @file SimulationParams.hpp
+ * @brief Behaviour thresholds of one simulation instance.
+ */
+
+/**
+ * @brief Longitudinal controller of driving cars (see Car::updateWithNeighbors).
+ */
+enum class CarFollowingModel {
+  STEERING, ///< Steering forces with proximity braking and lateral nudges; needs the 60 Hz tick.
+  IDM,      ///< Intelligent Driver Model on the gap to one leader; stable at coarse ticks.
+};
+
+/**
+ * @brief How arriving cars are given their spot (see TrafficSystem).
+ */
+enum class SpotAssignmentMode {
+  GREEDY, ///< Each car on its own at spawn: best facility, random free spot in it.
+  BATCH,  ///< Arrivals of a Config::Assignment::WINDOW are matched together by a SpotMatcher.
+};
+
+/**
+ * @struct SimulationParams
+ * @brief The tunable driver and charger thresholds, defaulting to the Config constants.
+ *
+ * Kept per EntityManager rather than read from Config directly, so instances running side by
+ * side (batch parameter sweeps) can each use their own values.
+ */
+struct SimulationParams {
+  float batteryLowThreshold = Config::BATTERY_LOW_THRESHOLD;   ///< Below: always look for a charger.
+  float batteryHighThreshold = Config::BATTERY_HIGH_THRESHOLD; ///< Above: never look for a charger.
+  float batteryExitThreshold = Config::BATTERY_EXIT_THRESHOLD; ///< Above: may leave the charger.
+  float batteryForceExitThreshold = Config::BATTERY_FORCE_EXIT_THRESHOLD; ///< Above: leaves the charger.
+  float chargingRate = Config::CHARGING_RATE;                             ///< % per second.
+  float parkingMinTime = Config::PARKING_MIN_TIME;                        ///< Seconds.
+  float parkingMaxTime = Config::PARKING_MAX_TIME;                        ///< Seconds.
+  CarFollowingModel carFollowing = CarFollowingModel::STEERING;
+  SpotAssignmentMode spotAssignment = SpotAssignmentMode::GREEDY;
+  float priceElasticity = 0.0f; ///< Surge pricing strength (see PricingEngine); 0 keeps the list prices.
+};
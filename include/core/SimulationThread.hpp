@@ -0,0 +1,61 @@
+#pragma once
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/**
+ * @class SimulationThread
+ * @brief Runs the fixed-timestep simulation on a dedicated thread.
+ *
+ * The thread accumulates real time (scaled by the speed multiplier), consumes it in
+ * Config::FIXED_DELTA_TIME slices by calling the tick callback, and then calls the publish
+ * callback once per batch so the render thread can pick up a fresh snapshot. While paused it
+ * keeps publishing (without ticking) at the tick rate.
+ *
+ * Every batch runs under the simulation mutex. Code on other threads that needs to touch
+ * simulation state (input dispatch, selection, spawn requests) takes the same mutex via lock(),
+ * which serializes it between batches. Rendering must not take the lock; it reads snapshots.
+ */
+class SimulationThread {
+public:
+  /**
+   * @brief Constructs the thread (does not start it).
+   * @param tick Called once per fixed step with the step size in seconds.
+   * @param publish Called after each batch with the leftover accumulator fraction (0..1) and the
+   *                real duration of one tick in seconds.
+   */
+  SimulationThread(std::function<void(double)> tick, std::function<void(double, double)> publish);
+
+  /**
+   * @brief Stops and joins the thread.
+   */
+  ~SimulationThread();
+
+  SimulationThread(const SimulationThread &) = delete;
+  SimulationThread &operator=(const SimulationThread &) = delete;
+
+  void start();
+  void stop();
+
+  /**
+   * @brief Acquires the simulation mutex. The simulation does not tick while the lock is held.
+   */
+  [[nodiscard]] std::unique_lock<std::mutex> lock() { return std::unique_lock<std::mutex>(mutex); }
+
+  void setSpeedMultiplier(double speed) { speedMultiplier.store(speed); }
+  void setPaused(bool paused) { isPaused.store(paused); }
+  bool isRunning() const { return running.load(); }
+
+private:
+  void run();
+
+  std::function<void(double)> tick;
+  std::function<void(double, double)> publish;
+
+  std::thread worker;
+  std::mutex mutex;
+  std::atomic<bool> running{false};
+  std::atomic<bool> isPaused{false};
+  std::atomic<double> speedMultiplier{1.0};
+};
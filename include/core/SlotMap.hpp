@@ -0,0 +1,146 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+/**
+ * @file SlotMap.hpp
+ * @brief Generational slot map: dense storage addressed through stable, checked handles.
+ */
+
+/**
+ * @struct SlotHandle
+ * @brief Stable reference to a SlotMap element.
+ *
+ * A handle stays valid until its element is removed. After that, resolving it fails instead of
+ * returning whatever element later reuses the slot, because the slot's generation has moved on.
+ */
+struct SlotHandle {
+  static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+  uint32_t index = INVALID_INDEX; ///< Slot in the indirection table.
+  uint32_t generation = 0;        ///< Generation the slot had when the handle was issued.
+
+  bool isValid() const { return index != INVALID_INDEX; }
+  bool operator==(const SlotHandle &) const = default;
+};
+
+/**
+ * @class SlotMap
+ * @brief Stores values contiguously and hands out generational handles to them.
+ *
+ * - insert / remove / get are O(1).
+ * - Values live in a dense vector (no holes), so iteration is a plain linear scan.
+ * - remove() swap-removes: the last value moves into the freed position. Dense order is therefore
+ *   not stable; handles are.
+ * - Freed slots are recycled through a free list; their generation is bumped on removal so old
+ *   handles no longer resolve.
+ *
+ * @tparam T The stored value type. Must be move constructible and move assignable.
+ */
+template <typename T> class SlotMap {
+public:
+  /**
+   * @brief Inserts a value.
+   * @return Handle to the new element.
+   */
+  SlotHandle insert(T value) {
+    uint32_t slotIndex;
+    if (freeHead != SlotHandle::INVALID_INDEX) {
+      slotIndex = freeHead;
+      freeHead = slots[slotIndex].target;
+    } else {
+      slotIndex = static_cast<uint32_t>(slots.size());
+      slots.push_back({0, 0});
+    }
+
+    slots[slotIndex].target = static_cast<uint32_t>(items.size());
+    items.push_back(std::move(value));
+    denseToSlot.push_back(slotIndex);
+    return {slotIndex, slots[slotIndex].generation};
+  }
+
+  /**
+   * @brief Removes the element a handle refers to.
+   * @return False if the handle was stale or invalid (nothing removed).
+   */
+  bool remove(SlotHandle handle) {
+    if (!contains(handle))
+      return false;
+
+    uint32_t dense = slots[handle.index].target;
+    uint32_t last = static_cast<uint32_t>(items.size() - 1);
+
+    // Swap-remove: move the last value into the hole and repoint its slot
+    if (dense != last) {
+      items[dense] = std::move(items[last]);
+      denseToSlot[dense] = denseToSlot[last];
+      slots[denseToSlot[dense]].target = dense;
+    }
+    items.pop_back();
+    denseToSlot.pop_back();
+
+    Slot &slot = slots[handle.index];
+    slot.generation++;
+    slot.target = freeHead;
+    freeHead = handle.index;
+    return true;
+  }
+
+  /**
+   * @brief Checks whether a handle still refers to a live element.
+   */
+  bool contains(SlotHandle handle) const {
+    return handle.index < slots.size() && slots[handle.index].generation == handle.generation &&
+           slots[handle.index].target < items.size() && denseToSlot[slots[handle.index].target] == handle.index;
+  }
+
+  /**
+   * @brief Resolves a handle.
+   * @return Pointer to the element, or nullptr if the handle is stale or invalid.
+   */
+  T *get(SlotHandle handle) { return contains(handle) ? &items[slots[handle.index].target] : nullptr; }
+  const T *get(SlotHandle handle) const { return contains(handle) ? &items[slots[handle.index].target] : nullptr; }
+
+  /**
+   * @brief Handle of the element at a dense position (0 <= denseIndex < size()).
+   */
+  SlotHandle handleAt(size_t denseIndex) const {
+    uint32_t slotIndex = denseToSlot[denseIndex];
+    return {slotIndex, slots[slotIndex].generation};
+  }
+
+  /**
+   * @brief Dense view of all live values, in storage order.
+   */
+  const std::vector<T> &values() const { return items; }
+
+  size_t size() const { return items.size(); }
+  bool empty() const { return items.empty(); }
+
+  /**
+   * @brief Removes every element. All outstanding handles become stale.
+   */
+  void clear() {
+    for (uint32_t slotIndex : denseToSlot) {
+      slots[slotIndex].generation++;
+      slots[slotIndex].target = freeHead;
+      freeHead = slotIndex;
+    }
+    items.clear();
+    denseToSlot.clear();
+  }
+
+private:
+  struct Slot {
+    uint32_t target;     ///< Dense index while occupied, next free slot while free.
+    uint32_t generation; ///< Bumped every time the slot is vacated.
+  };
+
+  std::vector<T> items;
+  std::vector<uint32_t> denseToSlot;
+  std::vector<Slot> slots;
+  uint32_t freeHead = SlotHandle::INVALID_INDEX;
+};
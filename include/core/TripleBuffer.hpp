@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * @file TripleBuffer.hpp
+ * @brief Lock-free single-producer / single-consumer triple buffer.
+ */
+
+/**
+ * @class TripleBuffer
+ * @brief Hands complete values from one writer thread to one reader thread without locking.
+ *
+ * Three slots rotate between the roles "back" (owned by the writer), "middle" (the latest
+ * published value) and "front" (owned by the reader). Publishing swaps back and middle;
+ * refreshing swaps middle and front if something new was published. Neither side ever waits
+ * for the other, and each side always has a complete, stable value to work on.
+ *
+ * Slots are reused, so types with internal buffers (std::vector) keep their capacity across
+ * frames and steady-state publishing does not allocate.
+ *
+ * @tparam T The payload type. Must be default constructible.
+ */
+template <typename T> class TripleBuffer {
+public:
+  TripleBuffer() = default;
+
+  TripleBuffer(const TripleBuffer &) = delete;
+  TripleBuffer &operator=(const TripleBuffer &) = delete;
+
+  /**
+   * @brief Writer side: the slot to fill before calling publish().
+   */
+  T &writeBuffer() { return slots[backIndex]; }
+
+  /**
+   * @brief Writer side: makes the contents of writeBuffer() visible to the reader.
+   */
+  void publish() {
+    uint8_t previous = middle.exchange(static_cast<uint8_t>(backIndex | DIRTY_BIT), std::memory_order_acq_rel);
+    backIndex = previous & INDEX_MASK;
+  }
+
+  /**
+   * @brief Reader side: switches to the most recently published value, if any.
+   * @return True if a new value was picked up.
+   */
+  bool refresh() {
+    if ((middle.load(std::memory_order_relaxed) & DIRTY_BIT) == 0)
+      return false;
+    uint8_t previous = middle.exchange(frontIndex, std::memory_order_acq_rel);
+    frontIndex = previous & INDEX_MASK;
+    return true;
+  }
+
+  /**
+   * @brief Reader side: the value picked up by the last refresh().
+   */
+  const T &readBuffer() const { return slots[frontIndex]; }
+
+private:
+  static constexpr uint8_t DIRTY_BIT = 0x4;
+  static constexpr uint8_t INDEX_MASK = 0x3;
+
+  std::array<T, 3> slots{};
+  uint8_t backIndex = 0;             ///< Writer-owned slot.
+  std::atomic<uint8_t> middle{1};    ///< Shared slot index + dirty flag.
+  uint8_t frontIndex = 2;            ///< Reader-owned slot.
+};
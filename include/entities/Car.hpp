@@ -1,8 +1,13 @@
 #pragma once
+#include "core/SimulationParams.hpp"
+#include "entities/CarId.hpp"
 #include "entities/Entity.hpp"
 #include "raylib.h"
-#include <deque>
+#include <algorithm>
+#include <cstdint>
 #include <memory>
+#include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
@@ -16,6 +21,7 @@ class World;
  * It supports collision avoidance and dynamic waypoint generation.
  */
 #include "entities/map/Modules.hpp"
+#include "entities/map/SplinePath.hpp"
 #include "entities/map/Waypoint.hpp"
 
 class Car : public Entity {
@@ -31,6 +37,18 @@ public:
    */
   Car(Vector2 startPos, const class World *world, Vector2 initialVelocity, CarType type);
 
+  /**
+   * @brief Re-initializes a recycled car as if it had just been constructed.
+   *
+   * Used by the CarPool instead of destroying and allocating a new car. Keeps the capacity of
+   * the waypoint buffer, so a reused car does not allocate when it is given a path.
+   *
+   * @param startPos Initial position.
+   * @param initialVelocity Initial velocity (sets heading).
+   * @param type The type of car (Combustion or Electric).
+   */
+  void reset(Vector2 startPos, Vector2 initialVelocity, CarType type);
+
   /**
    * @brief Updates the car's physics and logic.
    *
@@ -42,9 +60,18 @@ public:
    * @brief Updates the car's state with awareness of other cars.
    *
    * @param dt Delta time in seconds.
-   * @param cars Pointer to the list of other cars for collision avoidance.
+   * @param neighbors Cars close enough to matter for collision avoidance (may include this car).
+   * @param model Controller of driving and exiting cars. With CarFollowingModel::IDM the car
+   *              moves along a SplinePath through its waypoints and its speed follows the IDM on the
+   *              gap to the nearest car ahead in its lane, instead of steering forces and proximity
+   *              braking.
+   * @param laneLeader For IDM: the car ahead in the main road lane (nullptr: nobody), as listed by
+   *                   the LaneIndex. Replaces the search through @p neighbors; empty if the car is
+   *                   not in a lane.
    */
-  void updateWithNeighbors(double dt, const std::vector<std::unique_ptr<Car>> *cars = nullptr);
+  void updateWithNeighbors(double dt, std::span<const Car *const> neighbors = {},
+                           CarFollowingModel model = CarFollowingModel::STEERING,
+                           std::optional<const Car *> laneLeader = std::nullopt);
 
   /**
    * @brief Draws the car and its debug info (waypoints, velocity).
@@ -53,14 +80,37 @@ public:
   void draw(bool showPath);
   void draw() override { draw(false); }
 
+  /**
+   * @brief Draws a car sprite without needing a live Car (used for snapshot rendering).
+   * @param textureName Texture of the car variant.
+   * @param position Center position in meters.
+   * @param rotation Sprite rotation in degrees.
+   */
+  static void drawSprite(const std::string &textureName, Vector2 position, float rotation);
+
+  /**
+   * @brief Draws a planned path as dots connected by lines, starting from the car position.
+   */
+  static void drawPath(Vector2 from, const std::vector<Vector2> &points);
+
   // --- State Management ---
   enum class CarState { DRIVING, ALIGNING, PARKED, EXITING };
 
   bool isSelected() const { return selected; }
   void setSelected(bool s) { selected = s; }
 
+  /**
+   * @brief Handle under which the EntityManager stores this car (invalid until added).
+   */
+  CarId getId() const { return id; }
+  void setId(CarId newId) { id = newId; }
+
   CarState getState() const { return state; }
-  void setState(CarState newState) { state = newState; }
+
+  /**
+   * @brief Changes the state. Leaving PARKED ends a charging session (see startCharging()).
+   */
+  void setState(CarState newState);
 
   /**
    * @brief Adds a waypoint to the car's path.
@@ -82,12 +132,32 @@ public:
   void clearWaypoints();
 
   Vector2 getPosition() const { return position; }
+  Vector2 getPreviousPosition() const { return previousPosition; }
   Vector2 getVelocity() const { return velocity; }
+  float getRotation() const { return currentRotation; }
+  float getPreviousRotation() const { return previousRotation; }
+  const std::string &getTextureName() const { return textureName; }
+  /**
+   * @brief The waypoints not reached yet, in order.
+   */
+  std::span<const Waypoint> getWaypoints() const {
+    return std::span<const Waypoint>(waypoints).subspan(nextWaypoint);
+  }
+  size_t getWaypointCapacity() const { return waypoints.capacity(); }
   void setVelocity(Vector2 v) { velocity = v; }
 
   bool isReadyToLeave() const { return state == CarState::PARKED && parkingTimer <= 0.0f; }
+  float getParkingTimer() const { return parkingTimer; }
 
-  bool hasArrived() const { return waypoints.empty(); }
+  /**
+   * @brief Advances the parking timer of a parked car by a whole interval at once.
+   *
+   * Equivalent to that many seconds of update() calls while PARKED; used to catch up a car
+   * that slept (ChunkGrid).
+   */
+  void skipParkedTime(float seconds) { parkingTimer -= seconds; }
+
+  bool hasArrived() const { return nextWaypoint >= waypoints.size(); }
 
   // Context for Parking
   // Used to generate the exit path.
@@ -100,11 +170,13 @@ private:
   Vector2 position;
   Vector2 velocity;
   Vector2 acceleration;
+  Vector2 previousPosition; // Position before the last update, for render interpolation
 
   CarState state = CarState::DRIVING;
   float parkingTimer = 0.0f;
   float targetRotation = 0.0f;
   float currentRotation = 0.0f; // degrees, for smooth rendering
+  float previousRotation = 0.0f;
 
   const Module *parkedFacility = nullptr;
   Spot parkedSpot = {{0, 0}, 0.0f, -1};
@@ -113,7 +185,17 @@ private:
   float maxSpeed;
   float maxForce;
 
-  std::deque<Waypoint> waypoints;
+  // Path storage: reached waypoints are skipped by advancing the cursor instead of erasing them,
+  // so the buffer keeps its capacity across paths (and across pool reuse).
+  std::vector<Waypoint> waypoints;
+  size_t nextWaypoint = 0; ///< Index of the current target waypoint.
+
+  // Curve through the waypoints for CarFollowingModel::IDM, built on the first IDM tick of a path
+  // from where the car is then. Dropped when the path changes or the car steers.
+  SplinePath curve;
+  bool curveReady = false;
+  size_t curveStart = 0;      ///< Waypoint at which the curve's first segment ends.
+  float curveDistance = 0.0f; ///< How far along the curve the car is.
 
   /**
    * @brief Applies a force to the car's acceleration.
@@ -127,12 +209,40 @@ private:
    *
    * @param wp The target waypoint.
    */
+  void seek(const Waypoint &wp);
+
+  /**
+   * @brief Speed wanted toward @p wp: its speed limit, reduced before sharp turns and on arrival.
+   * @param dist Distance to the waypoint in meters.
+   */
+  float desiredSpeed(const Waypoint &wp, float dist) const;
+
   /**
-   * @brief Calculates and applies a steering force towards a target.
-   *
-   * @param wp The target waypoint.
+   * @brief Advances the path cursor; reaching a final stop waypoint starts aligning.
    */
-  void seek(const Waypoint &wp);
+  void reachWaypoint();
+
+  /**
+   * @brief One tick of CarFollowingModel::IDM for a car that has a waypoint to drive to.
+   */
+  void driveWithIdm(double dt, std::span<const Car *const> neighbors, std::optional<const Car *> laneLeader);
+
+  /**
+   * @brief Gap (bumper to bumper) to and speed of the nearest car ahead within the lane.
+   * @return False if nobody is ahead within the look-ahead range.
+   */
+  bool findLeader(Vector2 heading, float lookAhead, std::span<const Car *const> neighbors, float &gap,
+                  float &leaderSpeed) const;
+
+  /**
+   * @brief findLeader() for the one car known to be ahead in the lane.
+   */
+  bool followLaneLeader(const Car *leader, Vector2 heading, float lookAhead, float &gap, float &leaderSpeed) const;
+
+  /**
+   * @brief Unit vector the sprite points at.
+   */
+  Vector2 rotationHeading() const;
   std::string textureName;
 
   // New Members for Traffic Overhaul
@@ -151,15 +261,98 @@ public:
   CarType getType() const { return type; }
 
   void charge(float amount);
-  float getBatteryLevel() const { return batteryLevel; }
+  void setBatteryLevel(float level); ///< Clamped to 0-100; ignored for combustion cars.
+
+  /**
+   * @brief Current battery level. During a charging session it is computed from the level at
+   * plug-in, the rate and the time parked since (O(1), nothing is accumulated per tick).
+   */
+  float getBatteryLevel() const {
+    if (!charging)
+      return batteryLevel;
+    return std::min(100.0f, batteryLevel + chargingRate * (parkingDuration - parkingTimer));
+  }
+
+  /**
+   * @brief Total percentage points added by charge() and charging sessions since the car was spawned.
+   */
+  float getChargeReceived() const { return chargeReceived + (charging ? getBatteryLevel() - batteryLevel : 0.0f); }
+
+  /**
+   * @brief Plugs a parked electric car in for a session of @p duration seconds.
+   *
+   * The parking timer restarts from @p duration (the sampled exit time, see ChargingModel), so
+   * the car becomes ready to leave like any parked car; the battery follows from the elapsed
+   * time. The session ends when the car leaves PARKED. Ignored for combustion cars.
+   */
+  void startCharging(float rate, float duration);
+  bool isCharging() const { return charging; }
 
+  /**
+   * @brief Sets how long the car stays once parked (the parking timer starts from it).
+   */
   void setParkingDuration(float duration) { parkingDuration = duration; }
+  float getParkingDuration() const { return parkingDuration; }
+
+  /**
+   * @brief Selects the visual variant (1-3) of the car's texture.
+   */
+  void setTextureVariant(int variant);
+
+  /**
+   * @struct Snapshot
+   * @brief Plain copy of a car's simulation state, for checkpoints (path and id excluded).
+   *
+   * The parked facility is kept as an index into EntityManager::getModules() instead of a
+   * pointer, so a snapshot stays valid across a reloaded layout.
+   */
+  struct Snapshot {
+    Vector2 position;
+    Vector2 velocity;
+    Vector2 acceleration;
+    Vector2 previousPosition;
+    CarState state;
+    float parkingTimer;
+    float targetRotation;
+    float currentRotation;
+    float previousRotation;
+    int32_t parkedFacility; ///< Module index, -1 if none.
+    Spot parkedSpot;
+    int32_t parkedSpotIndex;
+    float maxSpeed;
+    float maxForce;
+    CarType type;
+    Priority priority;
+    bool enteredFromLeft;
+    float batteryLevel;
+    float parkingDuration;
+    int32_t textureVariant;
+    float chargeReceived;
+    bool charging;
+    float chargingRate;
+  };
+
+  /**
+   * @param parkedFacilityIndex Index of getParkedFacility() in the module list (-1 if none).
+   */
+  Snapshot saveState(int32_t parkedFacilityIndex) const;
+
+  /**
+   * @brief Overwrites the whole state with a snapshot. Clears the path and the selection.
+   * @param parkedFacility The module the snapshot's facility index resolves to (or nullptr).
+   */
+  void restoreState(const Snapshot &snapshot, const Module *parkedFacility);
 
 private:
   CarType type;
   Priority priority = Priority::PRIORITY_DISTANCE; // Default
   bool enteredFromLeft = true;                     // Default
-  float batteryLevel = 100.0f;                     // 0-100%
-  float parkingDuration = 0.0f;                    // Assigned when parking starts
+  float batteryLevel = 100.0f;                     // 0-100% (at plug-in while charging)
+  float parkingDuration = 0.0f;                    // Assigned with the spot, starts the timer on park
+  float chargeReceived = 0.0f;                     // Charge added since spawning (% points)
+  int textureVariant = 1;                          // Visual variant (1-3) of the texture
+  bool charging = false;                           // In a charging session (see startCharging)
+  float chargingRate = 0.0f;                       // % per second of the current session
   bool selected = false;
+  CarId id;
 };
@@ -0,0 +1,10 @@
+#pragma once
+#include "core/SlotMap.hpp"
+
+/**
+ * @brief Stable handle to a car owned by the EntityManager.
+ *
+ * Events and systems refer to cars by CarId instead of raw pointers. Resolve it through
+ * EntityManager::getCar(), which returns nullptr once the car has been removed.
+ */
+using CarId = SlotHandle;
@@ -0,0 +1,44 @@
+#pragma once
+#include "entities/map/WorldGenerator.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * @file MapFile.hpp
+ * @brief Versioned binary format for generated layouts.
+ */
+
+/**
+ * @class MapFile
+ * @brief Saves a layout (world + modules) to disk and loads it back exactly.
+ *
+ * Layout of a file (native byte order, checked through a byte order mark):
+ * 1. Header: magic "PLKMAP", version, world size, tile grid size, module and spot counts.
+ * 2. One fixed-size record per module, in EntityManager order: kind (road variant or facility
+ *    type), orientation (top/bottom), parent index (-1 for none), world position, price
+ *    multiplier and spot count.
+ * 3. The price of every spot, module after module.
+ * 4. The background tile indices, row-major.
+ *
+ * Spot positions and angles are not stored: they follow from the module kind and orientation,
+ * so the loader rebuilds them through the module constructors and only restores the prices.
+ * Loading maps the file and makes one pass over it, without any placement logic.
+ */
+class MapFile {
+public:
+  static constexpr uint32_t VERSION = 1;
+
+  /**
+   * @brief Writes a layout to @p path.
+   * @throws std::runtime_error if the file cannot be written or a module cannot be represented.
+   */
+  static void save(const std::string &path, const World &world, const std::vector<std::unique_ptr<Module>> &modules);
+
+  /**
+   * @brief Reads a layout written by save().
+   * @throws std::runtime_error if the file is missing, truncated, of another version or corrupt.
+   */
+  static GeneratedMap load(const std::string &path);
+};
@@ -6,8 +6,11 @@
  */
 #include "entities/map/Waypoint.hpp"
 #include "raylib.h"
+#include <span>
 #include <vector>
 
+class Random;
+
 /**
  * @struct AttachmentPoint
  * @brief Defines a connection point on a module.
@@ -39,6 +42,15 @@ struct Spot {
   float price = 0.0f; ///< Dynamic price for using this spot.
 };
 
+/**
+ * @struct SpotRenderState
+ * @brief Copy of the fields of a Spot that change during the simulation, for the render thread.
+ */
+struct SpotRenderState {
+  SpotState state = SpotState::FREE;
+  float price = 0.0f;
+};
+
 /**
  * @class Module
  * @brief Base class for all buildable map units (Roads, Facilities).
@@ -68,11 +80,11 @@ public:
   void setPriceMultiplier(float m) { priceMultiplier = m; }
 
   /**
-   * @brief Generates random prices for spots based on facility multiplier.
-   * @param baseSpotPrice Base cost.
-   * @param variance Random fluctuation range.
+   * @brief Draws a random facility multiplier and per-spot price fluctuations.
+   *
+   * Until this is called every spot costs the facility's base price (times its fixed boost).
    */
-  void assignRandomPricesToSpots(float baseSpotPrice, float variance);
+  void randomizePrices(Random &random);
 
   // --- Attachments ---
   const std::vector<AttachmentPoint> &getAttachmentPoints() const { return attachmentPoints; }
@@ -81,10 +93,17 @@ public:
   Vector2 worldPosition = {0, 0}; ///< Top-left position in the World (Meters).
 
   /**
-   * @brief Draws the module using specific logic per type.
+   * @brief Draws the module using specific logic per type. Reads only what does not change after
+   * generation (geometry, textures), so it is safe on the render thread.
    */
   virtual void draw() const;
 
+  /**
+   * @brief Marks the reserved spots.
+   * @param spots The spots' states, in spot order (a RenderSnapshot copy, not the live spots).
+   */
+  void drawSpots(std::span<const SpotRenderState> spots) const;
+
   // --- Pathfinding & Waypoints ---
   /**
    * @brief Adds a local waypoint (relative to module).
@@ -105,18 +124,36 @@ public:
   const AttachmentPoint *getAttachmentPointByNormal(Vector2 normal) const;
 
   // --- Spot Management ---
-  int getRandomSpotIndex() const;
+  /**
+   * @brief A uniformly chosen FREE spot, or -1 if the facility is full.
+   */
+  int getRandomSpotIndex(Random &random) const;
   Spot getSpot(int index) const;
-  void setSpotState(int index, SpotState state);
+  void setSpotPrice(int index, float price); ///< Ignored if the index is out of range.
+
+  /**
+   * @brief Changes a spot's state and updates the facility's counters.
+   *
+   * Simulation code should go through EntityManager::setSpotState so that the site-wide
+   * OccupancyStats see the transition as well.
+   *
+   * @return The state the spot had before (or @p state if the index is out of range).
+   */
+  SpotState setSpotState(int index, SpotState state);
 
   struct SpotCounts {
     int free;
     int reserved;
     int occupied;
   };
+
+  /**
+   * @brief Spot counts by state. O(1): maintained by setSpotState.
+   */
   SpotCounts getSpotCounts() const;
   float getOccupancyPercentage() const;
   size_t getSpotCount() const { return spots.size(); }
+  const std::vector<Spot> &getSpots() const { return spots; }
 
   // --- Type Info ---
   virtual bool isUp() const { return false; }
@@ -127,10 +164,24 @@ protected:
   float width;
   float height;
   float priceMultiplier = 1.0f;
+  float priceBoost = 1.0f;    ///< Fixed factor applied on top of the random multiplier.
+  float basePrice = 0.0f;     ///< Spot price before the multiplier.
+  float priceVariance = 0.0f; ///< Random +/- range of individual spot prices.
   std::vector<AttachmentPoint> attachmentPoints;
   std::vector<Waypoint> localWaypoints;
   std::vector<Spot> spots;
   Module *parent = nullptr;
+
+  /**
+   * @brief Sets the base price and fluctuation of the spots (called by facility constructors).
+   * @param baseSpotPrice Base cost.
+   * @param variance Random fluctuation range used by randomizePrices().
+   */
+  void setPricing(float baseSpotPrice, float variance);
+
+private:
+  int reservedCount = 0; ///< Spots in RESERVED state. Spots are created FREE.
+  int occupiedCount = 0; ///< Spots in OCCUPIED state.
 };
 
 // --- Roads ---
@@ -0,0 +1,73 @@
+#pragma once
+#include "entities/map/Waypoint.hpp"
+#include "raylib.h"
+#include <span>
+#include <vector>
+
+/**
+ * @file SplinePath.hpp
+ * @brief Smooth curve through a car's waypoints, addressed by distance along it.
+ */
+
+/**
+ * @class SplinePath
+ * @brief Chain of cubic Bezier segments from a start point through a list of waypoints.
+ *
+ * The curve passes through every waypoint. Its tangent there is the mean of the directions to and
+ * from it (the direction from the previous waypoint at the last one; the start heading at the
+ * start, unless it points away from the first waypoint). Each segment's handles reach
+ * Config::CarAI::Spline::HANDLE_FACTOR of its chord along those tangents, so straight runs stay
+ * straight and corners are rounded within the shorter leg.
+ *
+ * Each segment keeps a table of the distance along the path at Config::CarAI::Spline::TABLE_SAMPLES
+ * even steps of its parameter. A position at a distance is found with a binary search of the
+ * segment ends and of that table, a linear blend between two table entries and one evaluation of
+ * the segment.
+ */
+class SplinePath {
+public:
+  /**
+   * @struct Sample
+   * @brief A point of the path.
+   */
+  struct Sample {
+    Vector2 position;
+    Vector2 tangent; ///< Unit direction of travel (zero where the path has no length).
+  };
+
+  /**
+   * @brief Replaces the path. Keeps the buffers' capacity.
+   * @param start Where the path begins (the car's position).
+   * @param heading Direction the car is moving in or facing (need not be a unit vector; zero for
+   *                none).
+   */
+  void build(Vector2 start, Vector2 heading, std::span<const Waypoint> waypoints);
+  void clear();
+
+  bool empty() const { return segments.empty(); }
+  size_t getSegmentCount() const { return segments.size(); }
+  float getLength() const { return ends.empty() ? 0.0f : ends.back(); }
+
+  /**
+   * @return Distance along the path to waypoint @p i (the end of segment @p i).
+   */
+  float getWaypointDistance(size_t i) const { return ends[i]; }
+
+  /**
+   * @brief Point of the path at a distance from its start, clamped to the path.
+   */
+  Sample sample(float distance) const;
+
+private:
+  /**
+   * @struct Segment
+   * @brief Cubic Bezier between two consecutive points of the path.
+   */
+  struct Segment {
+    Vector2 p0, p1, p2, p3;
+  };
+
+  std::vector<Segment> segments;
+  std::vector<float> ends;  ///< Per segment, the distance along the path at its end.
+  std::vector<float> table; ///< Per segment, TABLE_SAMPLES + 1 distances along the path.
+};
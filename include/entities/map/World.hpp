@@ -1,8 +1,12 @@
 #pragma once
 #include "entities/Entity.hpp"
+#include "raylib.h"
+#include <cstdint>
 #include <string>
 #include <vector>
 
+class Random;
+
 /**
  * @class World
  * @brief Represents the game world boundaries and grid.
@@ -15,9 +19,22 @@ class World : public Entity {
 public:
   World(float width, float height);
 
+  /**
+   * @brief Creates a world whose background tiles are drawn from @p random (reproducible).
+   */
+  World(float width, float height, Random &random);
+
+  /**
+   * @brief Creates a world with a known background (e.g. loaded from a map file).
+   * @param tiles Texture index per tile, row-major; ignored (randomized) if the size does not
+   *        match getTileCols() x getTileRows().
+   */
+  World(float width, float height, std::vector<uint8_t> tiles);
+
   void update(double dt) override;
   void draw() override;
-  void drawOverlay(); // Draws grid and borders on top of entities
+  void draw(Rectangle view);        // Draws only the background tiles overlapping view (meters)
+  void drawOverlay(Rectangle view); // Draws grid and borders on top of entities (grid limited to view)
 
   void setGridEnabled(bool enabled) { showGrid = enabled; }
   bool isGridEnabled() const { return showGrid; }
@@ -28,14 +45,29 @@ public:
   float getWidth() const { return width; }
   float getHeight() const { return height; }
 
+  const std::vector<uint8_t> &getBackgroundTiles() const { return backgroundTiles; }
+  int getTileCols() const { return tileCols; }
+  int getTileRows() const { return tileRows; }
+
+  /**
+   * @brief Number of background tiles that cover @p length meters (the grid a world of that width
+   * or height gets). @p length must be finite and within Config::Map::MAX_WORLD_SIZE.
+   */
+  static int tilesToCover(float length);
+
 private:
   float width;
   float height;
   bool showGrid;
 
   // Background
-  std::vector<std::vector<int>> backgroundTiles; // Stores index of texture to use
-  std::vector<std::string> tileTextures;         // Texture names
+  std::vector<uint8_t> backgroundTiles;  // Texture index per tile, row-major (tileCols x tileRows)
+  std::vector<std::string> tileTextures; // Texture names
+  int tileCols = 0;
+  int tileRows = 0;
   float tileWidthMeter;
   float tileHeightMeter;
+
+  void initTileGrid(); // Tile size and tile counts for the current width/height
+  void randomizeTiles(Random &random);
 };
@@ -32,4 +32,10 @@ public:
    * @return A struct containing the World and Modules.
    */
   static GeneratedMap generate(const struct MapConfig &config);
+
+  /**
+   * @brief Same as generate(config), drawing every random choice (layout, prices, background)
+   * from @p random, so the result is reproducible from its seed.
+   */
+  static GeneratedMap generate(const struct MapConfig &config, class Random &random);
 };
@@ -1,6 +1,9 @@
 #pragma once
+#include "entities/CarId.hpp"
+#include "entities/map/Modules.hpp"
 #include "entities/map/Waypoint.hpp"
 #include "raylib.h"
+#include <string>
 #include <vector>
 
 struct MapConfig {
@@ -8,6 +11,7 @@ struct MapConfig {
   int largeParkingCount = 1;
   int smallChargingCount = 1;
   int largeChargingCount = 0;
+  std::string mapFile; ///< Binary map to load instead of generating (counts are then ignored).
 };
 
 enum class SceneType { MainMenu, MapConfig, Game };
@@ -29,9 +33,19 @@ struct GameUpdateEvent {
   double dt;
 };
 
+/**
+ * @brief Published once per rendered frame on the main thread with the real frame time in seconds.
+ * Unlike GameUpdateEvent it does not depend on the simulation speed and keeps coming while paused.
+ */
+struct FrameUpdateEvent {
+  double dt;
+};
+
 struct BeginCameraEvent {};
 struct EndCameraEvent {};
-struct DrawWorldEvent {};
+struct DrawWorldEvent {
+  Rectangle view = {0, 0, 0, 0}; ///< Visible world area in meters (empty: draw everything).
+};
 
 struct GamePausedEvent {};
 struct GameResumedEvent {};
@@ -46,6 +60,13 @@ struct CameraMoveEvent {
   Vector2 delta;
 };
 
+/**
+ * @brief Centers the camera on a world position while tracking is active (ignored otherwise).
+ */
+struct CameraFollowEvent {
+  Vector2 target;
+};
+
 struct SpawnCarEvent {};
 
 struct CycleAutoSpawnLevelEvent {};
@@ -64,26 +85,71 @@ struct CreateCarEvent {
 };
 
 struct CarSpawnedEvent {
-  class Car *car;
+  CarId carId;
+};
+
+/**
+ * @brief A spawned car found no free spot in a suitable facility and drives through.
+ */
+struct CarTurnedAwayEvent {
+  CarId carId;
+};
+
+/**
+ * @brief The number of arrivals waiting at the map entries for space changed.
+ */
+struct SpawnQueueChangedEvent {
+  int length;
 };
 
 struct AssignPathEvent {
-  class Car *car;
+  CarId carId;
   std::vector<struct Waypoint> path;
 };
 
+/**
+ * @brief A car reached the spot it was sent to and starts aligning into it. Published by
+ * EntityManager::update once the tick's cars have moved.
+ */
+struct CarArrivedAtSpotEvent {
+  CarId carId;
+};
+
 struct CarFinishedParkingEvent {
-  class Car *car;
+  CarId carId;
 };
 
 struct CarDespawnEvent {
-  class Car *car;
+  CarId carId;
 };
 
 struct CarDeletedEvent {
-  class Car *car;
+  CarId carId;
+};
+
+/**
+ * @brief A parking/charging spot changed state. Published by EntityManager::setSpotState.
+ */
+struct SpotStateChangedEvent {
+  const class Module *module;
+  int spotIndex;
+  SpotState previous;
+  SpotState current;
+  float price = 0.0f; ///< When an OCCUPIED spot is released: the price quoted for the stay.
 };
 
+struct ExportMetricsEvent {};
+
+struct SaveMapEvent {
+  std::string path;
+};
+
+/**
+ * @brief Published after spots and cars were replaced from a checkpoint. Listeners that track
+ * per-car or per-spot history resynchronize from the entities.
+ */
+struct CheckpointRestoredEvent {};
+
 struct SimulationSpeedChangedEvent {
   double speedMultiplier;
 };
@@ -92,7 +158,7 @@ enum class SelectionType { NONE, CAR, FACILITY, SPOT, GENERAL };
 
 struct EntitySelectedEvent {
   SelectionType type = SelectionType::GENERAL;
-  class Car *car = nullptr;
+  CarId carId;
   class Module *module = nullptr;
   int spotIndex = -1;
 };
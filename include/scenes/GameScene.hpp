@@ -16,18 +16,23 @@ public:
   void unload() override;
   void update(double dt) override;
   void draw() override;
+  std::unique_lock<std::mutex> lockSimulation() override;
 
 private:
+  void stopSimulation();
   void handleInput();
-  std::unique_ptr<TrackingSystem> trackingSystem;
   std::shared_ptr<EventBus> eventBus;
   std::vector<Subscription> eventTokens;
 
   std::unique_ptr<class EntityManager> entityManager;
   std::unique_ptr<class TrafficSystem> trafficSystem;
+  std::unique_ptr<TrackingSystem> trackingSystem;
+  std::unique_ptr<class MetricsRecorder> metricsRecorder;
   std::unique_ptr<class GameHUD> gameHUD;
+  std::unique_ptr<class ReplayRecorder> replayRecorder;
 
   std::unique_ptr<class CameraSystem> cameraSystem;
+  std::unique_ptr<class SimulationThread> simulationThread; ///< Null when ticking on the main loop.
   bool isPaused = false;
   MapConfig config;
   std::set<int> keysDown;
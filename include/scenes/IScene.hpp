@@ -1,4 +1,6 @@
 #pragma once
+#include <mutex>
+
 /**
  * @class IScene
  * @brief Interface for game scenes.
@@ -34,4 +36,13 @@ public:
    * @brief Draws the scene content.
    */
   virtual void draw() = 0;
+
+  /**
+   * @brief Pauses the scene's simulation thread (if any) for as long as the lock is held.
+   *
+   * Input is dispatched under this lock so event handlers never race with a simulation tick.
+   *
+   * @return The acquired lock, or an empty lock if the scene does not simulate off-thread.
+   */
+  virtual std::unique_lock<std::mutex> lockSimulation() { return {}; }
 };
@@ -37,6 +37,11 @@ public:
    */
   void render();
 
+  /**
+   * @brief Locks the current scene's simulation (see IScene::lockSimulation).
+   */
+  std::unique_lock<std::mutex> lockSimulation();
+
   /**
    * @brief Sets the active scene.
    *
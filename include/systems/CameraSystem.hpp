@@ -2,6 +2,7 @@
 #include "core/EventBus.hpp"
 #include "raylib.h"
 #include <memory>
+#include <mutex>
 #include <set>
 #include <vector>
 
@@ -14,6 +15,10 @@
  * - Panning (WASD Keys).
  * - Clamping to World Bounds.
  * - Coordinate transformation (World <-> Screen).
+ *
+ * Panning and tracking are applied once per rendered frame (FrameUpdateEvent) on the main thread.
+ * Camera state is still guarded by a mutex because tracking starts and stops on the simulation
+ * thread.
  */
 class CameraSystem {
 public:
@@ -25,8 +30,8 @@ public:
   ~CameraSystem();
 
   /**
-   * @brief Updates camera position based on input and physics.
-   * @param dt Delta time.
+   * @brief Updates camera position based on input.
+   * @param dt Real frame time in seconds.
    */
   void update(double dt);
 
@@ -41,17 +46,30 @@ public:
    * @brief Gets the underlying Raylib camera object.
    * @return Camera2D struct.
    */
-  Camera2D getCamera() const { return camera; }
+  Camera2D getCamera() const {
+    std::scoped_lock lock(cameraMutex);
+    return camera;
+  }
 
   // Setters for initial setup
-  void setTarget(Vector2 target) { camera.target = target; }
-  void setOffset(Vector2 offset) { camera.offset = offset; }
-  void setZoom(float zoom) { camera.zoom = zoom; }
+  void setTarget(Vector2 target) {
+    std::scoped_lock lock(cameraMutex);
+    camera.target = target;
+  }
+  void setOffset(Vector2 offset) {
+    std::scoped_lock lock(cameraMutex);
+    camera.offset = offset;
+  }
+  void setZoom(float zoom) {
+    std::scoped_lock lock(cameraMutex);
+    camera.zoom = zoom;
+  }
 
 private:
   std::shared_ptr<EventBus> eventBus;
   std::vector<Subscription> eventTokens;
 
+  mutable std::mutex cameraMutex; ///< Guards every member below.
   Camera2D camera = {{0, 0}, {0, 0}, 0.0f, 1.0f};
 
   float worldWidth = 0.0f;
@@ -59,7 +77,6 @@ private:
   bool boundsSet = false;
 
   std::set<int> keysDown;
-  double speedMultiplier = 1.0;
 
   bool isTracking = false;
 };
@@ -0,0 +1,34 @@
+#pragma once
+
+/**
+ * @file CarFollowing.hpp
+ * @brief Intelligent Driver Model: longitudinal acceleration from the gap to the leader.
+ */
+
+/**
+ * @class CarFollowing
+ * @brief The IDM acceleration and its ballistic integration (Treiber & Kesting).
+ *
+ *     a = aMax * (1 - (v / v0)^4 - (s* / s)^2),   s* = s0 + v * T + v * dv / (2 * sqrt(aMax * b))
+ *
+ * with the speed v, the desired speed v0, the bumper-to-bumper gap s, the approach rate dv (own
+ * speed minus the leader's) and the Config::CarAI::Idm constants. The speed is integrated as
+ * constant acceleration over the tick and never goes negative, which keeps platoons free of
+ * oscillation and collisions at ticks far coarser than 60 Hz.
+ */
+class CarFollowing {
+public:
+  /**
+   * @brief IDM acceleration in m/s^2, no lower than -Config::CarAI::Idm::MAX_BRAKING.
+   * @param gap Meters to the leader's rear bumper; infinity on a free road.
+   * @param approachRate Own speed minus the leader's, m/s (ignored on a free road).
+   */
+  static float acceleration(float speed, float desiredSpeed, float gap, float approachRate);
+
+  /**
+   * @brief Advances @p speed by @p acceleration over @p dt.
+   * @param[in,out] speed Speed at the start of the tick; at its end on return (>= 0).
+   * @return Distance driven during the tick (the stopping distance if the car stops in it).
+   */
+  static float advance(float &speed, float acceleration, double dt);
+};
@@ -0,0 +1,38 @@
+#pragma once
+#include "core/Random.hpp"
+#include "core/SimulationParams.hpp"
+
+/**
+ * @file ChargingModel.hpp
+ * @brief Closed-form charging sessions: when an electric car leaves the charger.
+ */
+
+/**
+ * @class ChargingModel
+ * @brief Samples the length of a charging session once, at plug-in.
+ *
+ * While parked on a charger the battery rises linearly at the charging rate (capped at 100 %).
+ * Above the exit threshold the driver leaves with a hazard rate of
+ *
+ *     h = 0.5 * (battery - exitThreshold) / (forceExitThreshold - exitThreshold)   per second,
+ *
+ * and leaves for certain once the battery passes the force-exit threshold. This is the per-tick
+ * exit roll of the TrafficSystem in continuous form: the session length is drawn by inverting the
+ * cumulative hazard for one uniform sample, so the exit times follow the same distribution
+ * without touching the car on every tick.
+ */
+class ChargingModel {
+public:
+  /**
+   * @brief Session length in seconds for a car plugging in at @p batteryLevel.
+   * @param u Uniform sample in (0, 1]; the session ends when the survival probability reaches it.
+   * @return Seconds until the car leaves, capped at Config::MAX_CHARGING_SESSION (sessions that
+   *         would never end: exit threshold at or above 100 %, or no charging below it).
+   */
+  static float exitDelay(float batteryLevel, const SimulationParams &params, float u);
+
+  /**
+   * @brief exitDelay() for a sample drawn from @p random (one draw per session).
+   */
+  static float sampleExitDelay(float batteryLevel, const SimulationParams &params, Random &random);
+};
@@ -0,0 +1,106 @@
+#pragma once
+#include "core/EventBus.hpp"
+#include "core/MetricSeries.hpp"
+#include "entities/map/Modules.hpp"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+class EntityManager;
+
+/**
+ * @class MetricsRecorder
+ * @brief Samples simulation metrics into bounded-memory time series.
+ *
+ * Every Config::Metrics::SAMPLE_INTERVAL_TICKS ticks one value per Metric is appended to its
+ * MetricSeries. Rates (spawns, charging sessions, revenue) are accumulated from events between
+ * samples and reported per simulated minute. The spawn queue is the length at sampling time.
+ *
+ * Sampling runs on the simulation thread; readers (dashboard, CSV export) may call from the
+ * render thread. All access to the series is guarded by a mutex.
+ */
+class MetricsRecorder {
+public:
+  enum class Metric {
+    OCCUPANCY,
+    IN_TRANSIT,
+    SPAWN_RATE,
+    AVG_DWELL,
+    CHARGING_THROUGHPUT,
+    REVENUE,
+    SPAWN_QUEUE,
+    COUNT
+  };
+  static constexpr size_t METRIC_COUNT = static_cast<size_t>(Metric::COUNT);
+
+  /**
+   * @brief Constructs the recorder and subscribes to simulation events.
+   * @param bus EventBus to listen on.
+   * @param entityManager Source of occupancy counters and car states.
+   */
+  MetricsRecorder(std::shared_ptr<EventBus> bus, const EntityManager &entityManager);
+
+  /**
+   * @brief Copies one tier of a metric's history (oldest first) into @p out.
+   */
+  void copySeries(Metric metric, size_t tier, std::vector<MetricSeries::Bucket> &out) const;
+
+  /**
+   * @brief The most recent sample of a metric.
+   */
+  float latest(Metric metric) const;
+
+  /**
+   * @brief Writes every tier of every metric as CSV.
+   *
+   * Columns: metric,tier,seconds_per_bucket,bucket,min,max,mean.
+   */
+  void writeCsv(std::ostream &out) const;
+
+  /**
+   * @brief Forces a sample now (normally driven by the tick counter).
+   */
+  void sample();
+
+  static const char *name(Metric metric);
+  static const char *unit(Metric metric);
+
+private:
+  std::shared_ptr<EventBus> eventBus;
+  const EntityManager &entityManager;
+  std::vector<Subscription> eventTokens;
+
+  mutable std::mutex mutex; ///< Guards series.
+  std::vector<MetricSeries> series;
+
+  // Accumulators for the current sample interval (simulation thread only)
+  uint64_t tickCount = 0;
+  double simTime = 0.0;
+  double intervalStart = 0.0;
+  int spawnsInInterval = 0;
+  int chargingSessionsInInterval = 0;
+  double revenueInInterval = 0.0;
+  double dwellSumInInterval = 0.0;
+  int dwellCountInInterval = 0;
+  float lastAverageDwell = 0.0f;
+  int spawnQueueLength = 0; ///< Arrivals waiting at the entries (TrafficSystem).
+
+  struct SpotKey {
+    const Module *module;
+    int index;
+    bool operator==(const SpotKey &) const = default;
+  };
+  struct SpotKeyHash {
+    size_t operator()(const SpotKey &k) const {
+      return std::hash<const void *>()(k.module) ^ (std::hash<int>()(k.index) << 1);
+    }
+  };
+  std::unordered_map<SpotKey, double, SpotKeyHash> occupiedSince; ///< Sim time each occupied spot was taken.
+
+  void onSpotStateChanged(const Module *module, int spotIndex, SpotState previous, SpotState current, float price);
+  void exportFiles() const;
+};
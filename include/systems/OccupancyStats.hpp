@@ -0,0 +1,81 @@
+#pragma once
+#include "core/EventBus.hpp"
+#include "entities/map/Modules.hpp"
+#include <memory>
+#include <ostream>
+#include <vector>
+
+/**
+ * @struct OccupancyCounters
+ * @brief Site-wide counters shown on the dashboard's general page.
+ */
+struct OccupancyCounters {
+  int totalFacilities = 0;
+  int parkingLots = 0;
+  int chargingStations = 0;
+
+  int totalSpots = 0;
+  int occupiedSpots = 0;
+  int reservedSpots = 0;
+  int parkingSpots = 0;
+  int occupiedParking = 0;
+  int reservedParking = 0;
+  int chargingSpots = 0;
+  int occupiedCharging = 0;
+  int reservedCharging = 0;
+};
+
+/**
+ * @class OccupancyStats
+ * @brief Maintains occupancy aggregates incrementally from spot state transitions.
+ *
+ * Facilities are registered once as they are added to the world (counting their spots). After that,
+ * every SpotStateChangedEvent adjusts the global and per-category (parking / charging) counters
+ * in O(1). Per-facility counts live on the facility itself (Module::getSpotCounts is O(1)).
+ */
+class OccupancyStats {
+public:
+  /**
+   * @brief Constructs the aggregator and subscribes to spot transitions.
+   * @param bus EventBus to listen on.
+   */
+  explicit OccupancyStats(std::shared_ptr<EventBus> bus);
+
+  /**
+   * @brief Registers one module. Non-facility modules (roads) are ignored.
+   */
+  void addFacility(const Module *module);
+
+  /**
+   * @brief Forgets everything and registers the given modules from scratch.
+   */
+  void rebuild(const std::vector<std::unique_ptr<Module>> &modules);
+
+  /**
+   * @brief Forgets all facilities and zeroes the counters.
+   */
+  void reset();
+
+  const OccupancyCounters &getCounters() const { return counters; }
+  const std::vector<const Module *> &getFacilities() const { return facilities; }
+
+  /**
+   * @brief Writes the global, per-category and per-facility counters as CSV.
+   *
+   * Columns: scope,type,spots,free,reserved,occupied.
+   */
+  void writeCsv(std::ostream &out) const;
+
+  static bool isParking(ModuleType type) { return type == ModuleType::SMALL_PARKING || type == ModuleType::LARGE_PARKING; }
+  static bool isCharging(ModuleType type) {
+    return type == ModuleType::SMALL_CHARGING || type == ModuleType::LARGE_CHARGING;
+  }
+
+private:
+  std::vector<Subscription> eventTokens;
+
+  OccupancyCounters counters;
+  std::vector<const Module *> facilities;
+
+  void apply(const Module *module, SpotState previous, SpotState current);
+};
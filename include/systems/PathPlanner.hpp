@@ -8,6 +8,7 @@
 #include "entities/Car.hpp"
 #include "entities/map/Modules.hpp"
 #include "entities/map/Waypoint.hpp"
+#include "systems/RoadNetwork.hpp"
 #include <vector>
 
 class PathPlanner {
@@ -15,38 +16,43 @@ public:
   /**
    * @brief Constructs a complete path for a car to reach a specific spot in a facility.
    *
-   * @param car The car entity (used for velocity/state).
+   * The road part is the network's route from the car's lane to the facility's gate. A car the
+   * network has no route for (off the lanes, or the facility is not connected) heads straight
+   * for the gate.
+   *
+   * @param network Road graph of the current layout.
+   * @param car The car entity (used for position/velocity).
    * @param targetFac The target facility module.
    * @param targetSpot The specific spot within the facility.
    * @return std::vector<Waypoint> The ordered list of waypoints.
    */
-  static std::vector<Waypoint> GeneratePath(const Car *car, const Module *targetFac, const Spot &targetSpot);
+  static std::vector<Waypoint> GeneratePath(const RoadNetwork &network, const Car *car, const Module *targetFac,
+                                            const Spot &targetSpot);
 
   /**
    * @brief Constructs a path for a car to leave the facility and map.
-   * @param finalX The X coordinate (in Meters) where the car should exit the map.
+   * @param exit Index of the map exit in network.getExits(). The path ends Config::Roads::EXIT_OVERRUN
+   * past it (at the gate if there is no such exit or no route to it).
    */
-  static std::vector<Waypoint> GenerateExitPath(const Car *car, const Module *currentFac, const Spot &currentSpot,
-                                                bool exitRight, float finalX);
+  static std::vector<Waypoint> GenerateExitPath(const RoadNetwork &network, const Car *car, const Module *currentFac,
+                                                const Spot &currentSpot, int exit);
 
-private:
   /**
-   * @brief Calculates the entry waypoint on the road leading to the facility.
-   *
-   * @param road The parent entrance road module.
-   * @param roadLane The horizontal lane the car is currently in (UP or DOWN).
-   * @param useRightSideEntry Whether to use the right-side entry (for UP facilities) or left-side (for DOWN
-   * facilities).
+   * @brief Constructs a path along the roads from the car's lane out of the nearest exit it can reach.
+   * A car on no lane heads straight for the closest exit ahead of it (or the closest one at all).
+   * @return Empty if the map has no exit.
    */
-  static Waypoint CalculateRoadEntry(const Module *road, Lane roadLane, bool useRightSideEntry);
+  static std::vector<Waypoint> GenerateThroughPath(const RoadNetwork &network, const Car *car);
 
+private:
   /**
-   * @brief Calculates the facility's main entry/center waypoint.
+   * @brief Calculates the facility's gate waypoint: the lane end at its attachment point, moved into
+   * the facility by the gate depth of its type.
    *
    * @param facility The target facility.
-   * @param useRightSideEntry Whether to align with the right-side entry or left-side entry.
+   * @param inbound Whether to use the lane into the facility or the one out of it.
    */
-  static Waypoint CalculateFacilityEntry(const Module *facility, bool useRightSideEntry);
+  static Waypoint CalculateFacilityEntry(const Module *facility, bool inbound);
 
   /**
    * @brief Calculates the alignment waypoint (pull-up point) for a spot.
@@ -59,8 +65,15 @@ private:
   static Waypoint CalculateSpotPoint(const Module *facility, const Spot &spot);
 
   /**
-   * @brief Adds a segment of waypoints from start to target, subdividing based on the Phase config.
+   * @brief Adds the corners of a road route. Long legs are driven in HIGHWAY mode up to the braking
+   * distance before their corner, the rest in @p phase.
+   * @param next Where the path goes after the last corner (sets the heading out of it).
+   */
+  static void AddRoute(std::vector<Waypoint> &path, Vector2 &currentPos, const std::vector<Vector2> &corners,
+                       Vector2 next, const Config::CarAI::AIPhase &phase);
+
+  /**
+   * @brief Adds a waypoint with the tolerance and speed limit of a phase.
    */
-  static void AddSegment(std::vector<Waypoint> &path, Vector2 startPos, Waypoint target,
-                         const Config::CarAI::AIPhase &phase);
+  static void AddSegment(std::vector<Waypoint> &path, Waypoint target, const Config::CarAI::AIPhase &phase);
 };
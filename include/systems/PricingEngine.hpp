@@ -0,0 +1,114 @@
+#pragma once
+#include "core/EventBus.hpp"
+#include "entities/map/Modules.hpp"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+class BinaryReader;
+class BinaryWriter;
+
+/**
+ * @file PricingEngine.hpp
+ * @brief Demand-driven spot prices.
+ */
+
+/**
+ * @class PricingEngine
+ * @brief Recomputes the spot prices of every facility from its live demand (surge pricing).
+ *
+ * Each facility's spots keep the list price they had when it was registered (the generated or
+ * loaded prices). Every Config::Pricing::INTERVAL simulated seconds a facility's demand is its
+ * share of taken spots plus its reservation rate (SpotStateChangedEvent to RESERVED, per spot and
+ * minute, weighted by Config::Pricing::RESERVATION_WEIGHT). Config::Pricing's curve turns demand
+ * into a surge factor, scaled by the elasticity (0 keeps the list prices, 1 is the curve as is),
+ * and the facility's surge moves part of the way toward it (Config::Pricing::SMOOTHING).
+ *
+ * The per-facility figures are kept as parallel arrays and recomputed in one pass without
+ * branches. Spots are only repriced (list price times surge) for the facilities whose surge moved
+ * by more than Config::Pricing::DIRTY_THRESHOLD since they were last repriced; their list prices
+ * are contiguous in one array.
+ */
+class PricingEngine {
+public:
+  /**
+   * @brief Constructs the engine and subscribes to spot transitions (reservation counting).
+   */
+  explicit PricingEngine(std::shared_ptr<EventBus> bus);
+
+  /**
+   * @brief Registers one module with its current spot prices as list prices. Non-facility
+   * modules (roads) are ignored.
+   */
+  void addFacility(Module *module);
+
+  /**
+   * @brief Forgets all facilities.
+   */
+  void reset();
+
+  /**
+   * @brief Advances the update timer; recomputes the prices when an interval is over.
+   * @param elasticity SimulationParams::priceElasticity. 0 (or less) leaves the prices alone.
+   */
+  void update(double dt, float elasticity);
+
+  /**
+   * @brief Recomputes the surge factors and reprices the dirty facilities now.
+   */
+  void recompute(float elasticity);
+
+  /**
+   * @return The facility's current surge factor (1 for unknown modules).
+   */
+  float getSurge(const Module *module) const;
+
+  /**
+   * @brief Surge factor of the curve for a demand, at elasticity 1.
+   */
+  static float curve(float demand);
+
+  /**
+   * @struct State
+   * @brief What a checkpoint stores: the timer and the per-facility figures.
+   */
+  struct State {
+    float clock = 0.0f;
+    std::vector<float> surge;
+    std::vector<float> appliedSurge;
+    std::vector<float> reservations;
+  };
+
+  void saveCheckpoint(BinaryWriter &out) const;
+
+  /**
+   * @brief Reads what saveCheckpoint() wrote, without changing anything.
+   * @throws std::runtime_error if it does not fit the registered facilities.
+   */
+  State readCheckpoint(BinaryReader &in) const;
+
+  /**
+   * @brief Puts a state read by readCheckpoint() in place and reprices the facilities whose
+   * prices were computed with another surge.
+   */
+  void restore(const State &state);
+
+private:
+  std::vector<Subscription> eventTokens;
+  std::unordered_map<const Module *, int> facilityIndex;
+  float clock = 0.0f; ///< Seconds into the current interval.
+
+  // Per facility (parallel arrays)
+  std::vector<Module *> facilities;
+  std::vector<int> spotOffset;     ///< First spot of the facility in listPrices.
+  std::vector<float> spotCount;
+  std::vector<float> taken;        ///< Reserved and occupied spots, gathered at each recompute.
+  std::vector<float> reservations; ///< Reservations since the last recompute.
+  std::vector<float> surge;        ///< Current factor.
+  std::vector<float> appliedSurge; ///< Factor the spot prices were last computed with.
+
+  std::vector<float> listPrices; ///< Every facility's spots, facility after facility.
+
+  void reprice(int facility);
+};
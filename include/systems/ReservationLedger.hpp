@@ -0,0 +1,114 @@
+#pragma once
+#include "entities/CarId.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+class Module;
+
+/**
+ * @file ReservationLedger.hpp
+ * @brief Who holds which spot, and until when.
+ */
+
+/**
+ * @class ReservationLedger
+ * @brief Spot to car and car to spot records of the reserved and occupied spots.
+ *
+ * A reservation is made when a car is sent to a spot and carries an expiry tick. The car's arrival
+ * confirms it (no expiry from then on); leaving or disappearing releases it. Expiries sit in a
+ * timer wheel of Config::Reservation::WHEEL_SLOTS buckets, so a tick only looks at the one bucket
+ * that is due instead of at every reservation. Entries whose reservation was confirmed, released
+ * or renewed meanwhile are dropped from their bucket lazily when it comes up.
+ *
+ * The ledger only keeps records; the owner changes the spot states accordingly.
+ */
+class ReservationLedger {
+public:
+  static constexpr uint64_t NO_EXPIRY = std::numeric_limits<uint64_t>::max();
+
+  /**
+   * @struct Reservation
+   * @brief A spot held by a car.
+   */
+  struct Reservation {
+    CarId carId;
+    Module *facility = nullptr;
+    int spotIndex = -1;
+    uint64_t expiry = NO_EXPIRY; ///< Wheel tick it lapses at; NO_EXPIRY once the car arrived.
+    float price = 0.0f;          ///< Spot price quoted when it was assigned; what the stay is charged.
+  };
+
+  ReservationLedger();
+
+  /**
+   * @brief Records that the car holds the spot until getTick() + timeoutTicks. Replaces an earlier
+   * reservation of the car.
+   * @param price The spot's price when it was assigned to the car.
+   */
+  void reserve(CarId carId, Module *facility, int spotIndex, uint64_t timeoutTicks, float price);
+
+  /**
+   * @brief The car reached its spot: the reservation no longer expires.
+   * @return False if the car holds no spot (its reservation lapsed).
+   */
+  bool confirm(CarId carId);
+
+  /**
+   * @brief Removes the car's record.
+   * @param released Receives the record, if there was one.
+   * @return False if the car held no spot.
+   */
+  bool release(CarId carId, Reservation &released);
+
+  /**
+   * @return The car's record, or nullptr.
+   */
+  const Reservation *find(CarId carId) const;
+
+  /**
+   * @return The car holding the spot, or an invalid CarId.
+   */
+  CarId holder(const Module *facility, int spotIndex) const;
+
+  /**
+   * @brief Moves the wheel on by one tick and removes the reservations that lapsed.
+   * @param expired Receives the removed records (appended).
+   */
+  void advance(std::vector<Reservation> &expired);
+
+  uint64_t getTick() const { return tick; }
+  size_t size() const { return spotHolders.size(); }
+
+  /**
+   * @brief Forgets every record and restarts the clock at the given tick.
+   */
+  void clear(uint64_t startTick = 0);
+
+private:
+  /**
+   * @struct SpotKey
+   * @brief A spot of a facility, as a hash key.
+   */
+  struct SpotKey {
+    const Module *facility;
+    int spotIndex;
+    bool operator==(const SpotKey &) const = default;
+  };
+  struct SpotKeyHash {
+    size_t operator()(const SpotKey &key) const {
+      return std::hash<const Module *>()(key.facility) ^ ((size_t)key.spotIndex * 0x9E3779B97F4A7C15ull);
+    }
+  };
+
+  std::vector<Reservation> byCar; ///< Indexed by CarId::index; checked against the generation.
+  std::unordered_map<SpotKey, CarId, SpotKeyHash> spotHolders;
+  std::vector<std::vector<CarId>> wheel;
+  uint64_t tick = 0;
+
+  bool holds(CarId carId) const;
+  Reservation *lookup(CarId carId);
+};
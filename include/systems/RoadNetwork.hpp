@@ -0,0 +1,175 @@
+#pragma once
+#include "entities/map/Modules.hpp"
+#include "raylib.h"
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @file RoadNetwork.hpp
+ * @brief Lane graph of the road modules and the routes through it.
+ */
+
+/**
+ * @class RoadNetwork
+ * @brief Directed lane graph built from the modules' AttachmentPoints, with precomputed routes
+ * from the map entries and to the map exits.
+ *
+ * Every attachment point of a road carries two lanes, one into the module and one out of it
+ * (right-hand traffic, see lanePosition()). Inside a road each incoming lane connects to the
+ * outgoing lanes of the other points, through the corner where the two lanes cross if it turns.
+ * Modules that touch share their lane ends. A facility's attachment point gives its gate (the
+ * lane end into it) and its way out. The lane ends of road attachment points that touch nothing
+ * and face the outside of the layout are the map's entries and exits.
+ *
+ * Lane ends that only lead from one module into the next are folded into the edges, so the graph
+ * keeps junctions, gates and map ends only. After building, a shortest-path tree is computed from
+ * every entry and toward every exit: routes from an entry or to an exit, and the entry to gate
+ * distances, are lookups that walk a tree. Other routes are searched with A* (straight-line
+ * distance heuristic).
+ *
+ * Queries share scratch buffers: one network must not be queried from several threads at once.
+ */
+class RoadNetwork {
+public:
+  static constexpr float UNREACHABLE = std::numeric_limits<float>::infinity();
+
+  /**
+   * @struct Terminal
+   * @brief A map entry or exit.
+   */
+  struct Terminal {
+    int node;
+    Vector2 position;
+    Vector2 direction; ///< Direction of travel (into the map at entries, out of it at exits).
+  };
+
+  /**
+   * @brief Rebuilds the graph and the route trees from a module layout.
+   */
+  void build(const std::vector<std::unique_ptr<Module>> &modules);
+  void clear();
+
+  /**
+   * @brief Where the lane that crosses an attachment point in a direction passes it: offset to the
+   * right of the direction by Config::LANE_OFFSET_DOWN / LANE_OFFSET_UP for horizontal travel
+   * (main roads) and by Config::ENTRANCE_LANE_OFFSET for vertical travel (entrance roads).
+   * @param point Attachment point in world coordinates.
+   */
+  static Vector2 lanePosition(Vector2 point, Vector2 direction);
+
+  size_t getNodeCount() const { return nodes.size(); }
+  size_t getEdgeCount() const { return edges.size(); }
+  Vector2 getNodePosition(int node) const { return nodes[node]; }
+  const std::vector<Terminal> &getEntries() const { return entries; }
+  const std::vector<Terminal> &getExits() const { return exits; }
+
+  /**
+   * @return The node of the lane into the facility, or -1 if it is not connected.
+   */
+  int getGate(const Module *facility) const;
+
+  /**
+   * @return The node of the lane out of the facility, or -1 if it is not connected.
+   */
+  int getFacilityExit(const Module *facility) const;
+
+  /**
+   * @return Driving distance from the entry (index into getEntries()) to a node, or UNREACHABLE.
+   */
+  float getEntryDistance(int entry, int node) const;
+
+  /**
+   * @return Driving distance from a node to the exit (index into getExits()), or UNREACHABLE.
+   */
+  float getExitDistance(int node, int exit) const;
+
+  /**
+   * @return Index of the exit a node reaches soonest, or -1 if it reaches none.
+   */
+  int findNearestExit(int node) const;
+
+  /**
+   * @brief Same for a car on a lane (see route()).
+   */
+  int findNearestExit(Vector2 position, Vector2 heading) const;
+
+  /**
+   * @brief Shortest route between two nodes.
+   * @param points Receives the corners along the way and the target node, not the start (cleared
+   * first). Points in line with their neighbors are left out.
+   * @return False if the target cannot be reached.
+   */
+  bool route(int from, int to, std::vector<Vector2> &points) const;
+
+  /**
+   * @brief Shortest route for a car on a lane: the rest of the lane, then on from its end. The lane
+   * is the closest one within Config::Roads::SNAP_DISTANCE running along the heading (any
+   * direction if the heading is zero).
+   * @return False if the car is on no lane or the target cannot be reached.
+   */
+  bool route(Vector2 position, Vector2 heading, int to, std::vector<Vector2> &points) const;
+
+private:
+  /**
+   * @struct Edge
+   * @brief A lane from one node to the next. Its corners are corners[firstCorner, +cornerCount).
+   */
+  struct Edge {
+    int from;
+    int to;
+    float length;
+    uint32_t firstCorner;
+    uint32_t cornerCount;
+  };
+
+  std::vector<Vector2> nodes;
+  std::vector<Edge> edges;           ///< Sorted by from.
+  std::vector<uint32_t> firstOut;    ///< Per node, its first edge (size nodes + 1).
+  std::vector<uint32_t> incoming;    ///< Edge indices sorted by to.
+  std::vector<uint32_t> firstIn;     ///< Per node, its first entry in incoming (size nodes + 1).
+  std::vector<Vector2> corners;
+  std::vector<Terminal> entries;
+  std::vector<Terminal> exits;
+  std::unordered_map<const Module *, std::pair<int, int>> facilityLanes; ///< Gate and exit node.
+
+  // Route trees: per entry the distance and the edge that reaches each node, per exit the distance
+  // and the edge that leads on toward it
+  std::vector<std::vector<float>> entryDistance;
+  std::vector<std::vector<int>> entryParent;
+  std::vector<std::vector<float>> exitDistance;
+  std::vector<std::vector<int>> exitNext;
+
+  std::unordered_map<uint64_t, std::vector<std::pair<int, int>>> grid; ///< Cell -> (edge, segment).
+
+  // A* scratch, reused between searches
+  mutable std::vector<float> searchCost;
+  mutable std::vector<int> searchEdge;
+  mutable std::vector<uint32_t> searchStamp;
+  mutable uint32_t searchId = 0;
+
+  /**
+   * @brief The lane segment a car is on, as an edge and the index of its segment.
+   * @return False if there is none within Config::Roads::SNAP_DISTANCE.
+   */
+  bool locate(Vector2 position, Vector2 heading, int &edge, int &segment) const;
+
+  Vector2 edgePoint(const Edge &edge, uint32_t i) const; ///< i-th point of the lane, start included.
+
+  /**
+   * @brief Appends the route between two nodes to @p out (route() without clearing).
+   * @param start Where the route began, for leaving out points in line.
+   */
+  bool appendRoute(int from, int to, Vector2 start, std::vector<Vector2> &out) const;
+  void appendEdge(int edge, Vector2 start, std::vector<Vector2> &out) const;
+
+  /**
+   * @brief A* from one node to another.
+   */
+  bool search(int from, int to, Vector2 start, std::vector<Vector2> &out) const;
+  void computeTrees();
+  void buildGrid();
+};
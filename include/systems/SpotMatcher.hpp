@@ -0,0 +1,52 @@
+#pragma once
+#include <vector>
+
+/**
+ * @file SpotMatcher.hpp
+ * @brief Min-cost matching of arriving cars to free spots.
+ */
+
+/**
+ * @class SpotMatcher
+ * @brief Assigns a batch of cars to spots (successive shortest paths on sparse candidate lists).
+ *
+ * Cars that rank the spots alike (same kind of facility, same preference, same entry) form a
+ * Group with one candidate list; each candidate has a cost in [0, Config::Assignment::COST_LEVELS].
+ * The result first places as many cars as possible, then minimizes the total cost. Cars that are
+ * not placed drive through.
+ *
+ * This is the Hungarian method in min-cost flow form: cars are added one at a time along a
+ * shortest augmenting path (Dijkstra on reduced costs, with node potentials), which may move
+ * earlier cars to other spots. Every group can also "stay out" at a cost above any sum of spot
+ * costs of the batch, so a car is only left out when no reshuffle finds it a spot. A search
+ * scans each group's list at most once and stops at the first free spot it reaches. A group
+ * needs no more candidates than there are cars in the batch to keep the optimum.
+ */
+class SpotMatcher {
+public:
+  /**
+   * @struct Candidate
+   * @brief A spot a group would take and what it costs.
+   */
+  struct Candidate {
+    int spot; ///< Index into the batch's spot list.
+    int cost; ///< 0 (best) to Config::Assignment::COST_LEVELS.
+  };
+
+  /**
+   * @struct Group
+   * @brief Interchangeable cars: how many, and the spots they would take.
+   */
+  struct Group {
+    int cars = 0;
+    std::vector<Candidate> candidates; ///< No duplicate spots.
+  };
+
+  /**
+   * @brief Solves the assignment.
+   * @param groups The cars of the batch.
+   * @param spotCount Number of spots the candidates index into.
+   * @return For every group, the spots its cars got (at most Group::cars).
+   */
+  static std::vector<std::vector<int>> solve(const std::vector<Group> &groups, int spotCount);
+};
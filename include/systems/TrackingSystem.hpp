@@ -1,21 +1,39 @@
 #pragma once
+#include "core/EntityManager.hpp"
 #include "core/EventBus.hpp"
 #include "entities/Car.hpp"
 #include <memory>
 #include <vector>
 
+/**
+ * @class TrackingSystem
+ * @brief Follows a newly spawned car with the camera until it leaves.
+ *
+ * The target's lifecycle is checked on the simulation ticks. The camera follows it once per
+ * rendered frame (FrameUpdateEvent), at the car's interpolated position from the render snapshot,
+ * so there is one camera update per frame at any simulation speed.
+ */
 class TrackingSystem {
 public:
-    explicit TrackingSystem(std::shared_ptr<EventBus> bus);
+    TrackingSystem(std::shared_ptr<EventBus> bus, EntityManager &entityManager);
     ~TrackingSystem();
 
+    /**
+     * @brief Stops tracking once the target has exited or disappeared. Simulation thread.
+     */
     void update(double dt);
 
+    /**
+     * @brief Centers the camera on the target's interpolated position. Render thread.
+     */
+    void followTarget();
+
 private:
     std::shared_ptr<EventBus> eventBus;
+    EntityManager &entityManager;
     std::vector<Subscription> eventTokens;
     
-    Car* targetCar = nullptr;
+    CarId targetCar; ///< Resolved every tick; stops tracking once it no longer resolves.
     bool isTrackingActive = false;
     bool waitingForSpawn = false;
 
@@ -1,9 +1,16 @@
 #pragma once
 #include "core/EntityManager.hpp"
 #include "core/EventBus.hpp"
+#include "systems/ReservationLedger.hpp"
+#include "systems/RoadNetwork.hpp"
+#include <array>
+#include <deque>
 #include <memory>
 #include <vector>
 
+class BinaryReader;
+class BinaryWriter;
+
 /**
  * @class TrafficSystem
  * @brief Manages navigation, spawning, and high-level behavior of cars.
@@ -13,25 +20,224 @@
  * - Assigning parking spots and paths to cars.
  * - Monitoring car states (Parking, Exiting).
  * - Cleaning up cars that have exited the map.
+ *
+ * Arrivals (auto-spawn and SpawnCarRequestEvent) are admitted only while their entry is clear:
+ * the last car of the lane, found through the EntityManager's LaneIndex, must be
+ * Config::Spawner::ENTRY_CLEARANCE past it. Otherwise the arrival waits in the entry's queue as a
+ * plain record, not a Car, and enters once the lane moved on. Overload shows up as a growing
+ * queue (SpawnQueueChangedEvent) instead of cars stacked on the spawn point.
+ *
+ * With SpotAssignmentMode::BATCH a spawned car keeps driving along its lane while the arrivals
+ * of Config::Assignment::WINDOW accumulate; they are then matched to the free spots together by
+ * a SpotMatcher (price or distance from the entry, normalized per group) instead of one by one.
+ *
+ * Paths follow a RoadNetwork built from the modules' attachment points whenever the module set
+ * changes. Cars enter and leave at the ends of the main road; the distance-minded ones compare
+ * facilities by driving distance from their entry.
+ *
+ * Spots held by cars are recorded in a ReservationLedger. A spot turns OCCUPIED on the car's
+ * CarArrivedAtSpotEvent, not by watching the cars every tick. A car that has not arrived within
+ * Config::Reservation::TIMEOUT loses its spot (freed when its timer wheel tick comes up) and, if
+ * the spot was given away meanwhile, leaves again on arrival. The spot of a removed car is freed
+ * on the next tick.
  */
 class TrafficSystem {
 public:
   /**
    * @brief Constructs the TrafficSystem.
    * @param bus Shared pointer to the EventBus.
-   * @param entityManager Reference to the EntityManager for querying modules and cars.
+   * @param entityManager Reference to the EntityManager for querying modules and cars, and for
+   *        spot state changes and car removal.
    */
-  TrafficSystem(std::shared_ptr<EventBus> bus, const EntityManager &entityManager);
+  TrafficSystem(std::shared_ptr<EventBus> bus, EntityManager &entityManager);
   ~TrafficSystem();
 
+  /**
+   * @brief Sets the auto-spawn level (0 = off, up to the last Config::Spawner::SPAWN_RATES entry)
+   * and publishes AutoSpawnLevelChangedEvent.
+   * @throws std::out_of_range if the level does not exist.
+   */
+  void setSpawnLevel(int level);
+  int getSpawnLevel() const { return currentSpawnLevel; }
+
+  /**
+   * @brief Arrivals waiting at both entries.
+   */
+  int getSpawnQueueLength() const { return (int)(entryQueues[0].size() + entryQueues[1].size()); }
+
+  /**
+   * @brief Spots reserved or occupied by cars.
+   */
+  const ReservationLedger &getReservations() const { return reservations; }
+
+  /**
+   * @brief Appends the spawner state (level, timer and queued arrivals), the reservations and the
+   * arrivals waiting for the batch assignment to a checkpoint.
+   */
+  void saveCheckpoint(BinaryWriter &out) const;
+
+  /**
+   * @struct QueuedArrival
+   * @brief A car waiting to enter: what CreateCarEvent needs besides the entry.
+   */
+  struct QueuedArrival {
+    int carType;
+    int priority;
+  };
+
+  /**
+   * @struct CheckpointState
+   * @brief The section written by saveCheckpoint(), read and validated but not applied yet.
+   */
+  struct CheckpointState {
+    int32_t spawnLevel = 0;
+    float spawnTimer = 0.0f;
+    std::array<std::deque<QueuedArrival>, 2> entryQueues;
+
+    /**
+     * @struct HeldSpot
+     * @brief A reservation, by the car's position in the checkpoint's car list and the facility's
+     * module index.
+     */
+    struct HeldSpot {
+      uint32_t car;
+      int32_t facility;
+      int32_t spotIndex;
+      uint64_t expiry;
+    };
+    uint64_t reservationTick = 0;
+    float reservationClock = 0.0f;
+    std::vector<HeldSpot> held;
+
+    /**
+     * @struct Pending
+     * @brief An arrival waiting for the batch assignment, by the car's position in the car list.
+     */
+    struct Pending {
+      uint32_t car;
+      bool seekCharging;
+    };
+    float assignmentTimer = 0.0f;
+    std::vector<Pending> pending;
+  };
+
+  /**
+   * @brief Reads what saveCheckpoint() wrote, without changing anything.
+   * @param carCount Number of cars in the checkpoint's EntityManager section.
+   * @throws std::runtime_error if the data is truncated or invalid.
+   */
+  CheckpointState readCheckpoint(BinaryReader &in, size_t carCount) const;
+
+  /**
+   * @brief Puts a state read by readCheckpoint() in place, after the EntityManager restored the cars.
+   */
+  void restoreCheckpoint(const CheckpointState &state);
+
 private:
   std::shared_ptr<EventBus> eventBus;
-  const EntityManager &entityManager;
+  EntityManager &entityManager;
   std::vector<Subscription> eventTokens;
 
   int currentSpawnLevel = 0;
   float spawnTimer = 0.0f;
 
+  std::array<std::deque<QueuedArrival>, 2> entryQueues; ///< Left entry (Lane::DOWN), right entry (Lane::UP).
+  std::array<CarId, 2> lastAdmitted;                    ///< Newest car of each entry, not listed in a lane yet.
+  int reportedQueueLength = 0;
+
+  /**
+   * @struct PendingAssignment
+   * @brief A spawned car waiting for the batch assignment.
+   */
+  struct PendingAssignment {
+    CarId carId;
+    bool seekCharging; ///< Drawn at spawn, like in the greedy mode.
+  };
+  std::vector<PendingAssignment> pendingAssignments;
+  float assignmentTimer = 0.0f; ///< Seconds since the first pending arrival.
+
+  ReservationLedger reservations;
+  float reservationClock = 0.0f; ///< Seconds toward the next wheel tick.
+  std::vector<ReservationLedger::Reservation> lapsedReservations;   ///< Reused by advanceReservations().
+  std::vector<ReservationLedger::Reservation> orphanedReservations; ///< Held by removed cars, freed next tick.
+
+  /**
+   * @struct RoadEnds
+   * @brief The map entries and exits of the main road's two ends: the westmost eastbound and
+   * eastmost westbound ones (indices into the RoadNetwork's lists, -1 if there is none).
+   */
+  struct RoadEnds {
+    int leftEntry = -1;
+    int rightEntry = -1;
+    int leftExit = -1;
+    int rightExit = -1;
+  };
+  RoadNetwork roads;
+  RoadEnds roadEnds;
+  uint32_t roadsRevision = 0; ///< EntityManager module revision the network was built for.
+
+  /**
+   * @brief Returns the road network, rebuilding it (and the road ends) when the module set changed.
+   */
+  const RoadNetwork &getRoads();
+
+  /**
+   * @brief Draws an arrival (side, type, priority) and admits or queues it.
+   */
   void spawnCar();
+
+  /**
+   * @brief Spawn position and velocity of an entry.
+   * @return False if the map has no road on that side.
+   */
+  bool getEntry(bool left, Vector2 &position, Vector2 &velocity);
+
+  /**
+   * @brief True if no car of the entry's lane is within Config::Spawner::ENTRY_CLEARANCE of it.
+   */
+  bool isEntryClear(bool left, Vector2 entry);
+
+  /**
+   * @brief Lets the head of each queue in if its entry cleared.
+   */
+  void releaseQueuedArrivals();
+  void publishQueueLength();
+
+  /**
+   * @brief Parking facilities, or charging stations for an electric car looking for a charger.
+   */
+  std::vector<Module *> suitableFacilities(Car::CarType type, bool seekCharging) const;
+
+  /**
+   * @brief Reserves the spot, draws the parking duration and sends the car there.
+   */
+  void assignSpot(Car *car, Module *facility, int spotIndex);
+
+  /**
+   * @brief Occupies the arriving car's spot, or sends it out if its reservation lapsed and the
+   * spot is taken.
+   */
+  void occupyOnArrival(CarId carId);
+
+  /**
+   * @brief Frees the spots of removed cars, then the spots whose reservations lapsed.
+   */
+  void advanceReservations(float dt);
+
+  /**
+   * @brief Sends a car from its spot to an exit (the entry side for distance-minded drivers).
+   */
+  void sendToExit(Car *car);
+
+  /**
+   * @brief Adds a car to the pending batch and lets it drive on meanwhile.
+   */
+  void holdForAssignment(Car *car, bool seekCharging);
+
+  /**
+   * @brief Matches the pending batch to the free spots; unmatched cars drive through.
+   */
+  void assignPendingArrivals();
+
   void assignThroughTrafficPath(class Car *car);
 };
@@ -7,6 +7,7 @@
 #include "core/EntityManager.hpp"
 #include "core/EventBus.hpp"
 #include "events/GameEvents.hpp"
+#include "systems/MetricsRecorder.hpp"
 #include "ui/UIElement.hpp"
 #include <memory>
 #include <vector>
@@ -19,10 +20,15 @@
  * - General Simulator stats (FPS, Entity count).
  * - Selected Car details.
  * - Facility occupancy and economics.
+ * - Sparklines of the recorded metrics history (general page).
+ *
+ * All values come from the EntityManager's render snapshot, so the overlay never reads live
+ * simulation state from the render thread.
  */
 class DashboardOverlay : public UIElement {
 public:
-  DashboardOverlay(std::shared_ptr<EventBus> bus, EntityManager *entityManager);
+  DashboardOverlay(std::shared_ptr<EventBus> bus, EntityManager *entityManager,
+                   const MetricsRecorder *metrics = nullptr);
   ~DashboardOverlay();
 
   void update(double dt) override;
@@ -30,14 +36,20 @@ public:
 
 private:
   EntityManager *entityManager;
+  const MetricsRecorder *metrics;
   std::vector<Subscription> eventTokens;
+  std::vector<MetricSeries::Bucket> sparkBuffer; ///< Reused every frame for sparkline data.
 
-  EntitySelectedEvent currentSelection;
+  void drawGeneralInfo(const RenderSnapshot &snapshot, int x, int y, int width);
+  void drawCarInfo(const SelectionView &selection, int x, int y, int width);
+  void drawFacilityInfo(const SelectionView &selection, int x, int y, int width);
+  void drawSpotInfo(const SelectionView &selection, int x, int y, int width);
 
-  void drawGeneralInfo(int x, int y, int width);
-  void drawCarInfo(int x, int y, int width);
-  void drawFacilityInfo(int x, int y, int width);
-  void drawSpotInfo(int x, int y, int width);
+  /**
+   * @brief Draws one metric's recent history: min/max band with the mean as a line.
+   * @return Height used in pixels.
+   */
+  int drawSparkline(MetricsRecorder::Metric metric, int x, int y, int width);
 
   bool visible = true;
 };
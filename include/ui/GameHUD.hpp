@@ -10,6 +10,7 @@
 #include <vector>
 
 class EntityManager;
+class MetricsRecorder;
 
 /**
  * @class GameHUD
@@ -19,7 +20,7 @@ class EntityManager;
  */
 class GameHUD {
 public:
-  GameHUD(std::shared_ptr<EventBus> bus, EntityManager *entityManager);
+  GameHUD(std::shared_ptr<EventBus> bus, EntityManager *entityManager, const MetricsRecorder *metrics = nullptr);
   ~GameHUD();
 
   void update(double dt);
@@ -0,0 +1,36 @@
+#pragma once
+
+/**
+ * @file ProfilerOverlay.hpp
+ * @brief On-screen view of the built-in profiler.
+ */
+#include "core/EventBus.hpp"
+#include "ui/UIElement.hpp"
+#include <memory>
+#include <vector>
+
+/**
+ * @class ProfilerOverlay
+ * @brief Shows last-frame zone timings from Profiler and handles the profiler hotkeys.
+ *
+ * - F3 toggles the overlay; recording is enabled only while it is visible.
+ * - F4 writes every buffered zone to Config::Profiler::TRACE_PATH as a Chrome trace.
+ *
+ * Owned by Application and drawn on top of every scene.
+ */
+class ProfilerOverlay : public UIElement {
+public:
+  explicit ProfilerOverlay(std::shared_ptr<EventBus> bus);
+
+  void update(double dt) override;
+  void draw() override;
+
+  /**
+   * @brief Dumps the trace to Config::Profiler::TRACE_PATH.
+   * @return True if the file was written.
+   */
+  bool dumpTrace();
+
+private:
+  std::vector<Subscription> eventTokens;
+};
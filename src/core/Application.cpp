@@ -2,6 +2,7 @@
 #include "core/AssetManager.hpp"
 #include "core/AudioManager.hpp"
 #include "core/Logger.hpp"
+#include "core/Profiler.hpp"
 #include "events/GameEvents.hpp"
 #include "events/WindowEvents.hpp"
 
@@ -13,7 +14,7 @@
  * and high-level event management (e.g., window closing).
  */
 
-Application::Application() {
+Application::Application(const LaunchOptions &options) {
   Logger::Info("Application Starting...");
 
   InitAudioDevice();
@@ -25,6 +26,9 @@ Application::Application() {
   sceneManager = std::make_unique<SceneManager>(eventBus);
   eventLogger = std::make_unique<EventLogger>(eventBus);
   gameLoop = std::make_unique<GameLoop>();
+#ifdef PARKLOGIC_PROFILER
+  profilerOverlay = std::make_unique<ProfilerOverlay>(eventBus);
+#endif
 
   // Centralized asset loading
   AssetManager::Get().LoadAllAssets();
@@ -33,8 +37,11 @@ Application::Application() {
   AudioManager::Get().PlayMusic("bg_music");
   AudioManager::Get().InitUI(eventBus);
 
-  // Start with the main menu
+  // Start with the main menu, or go straight to a map given on the command line
   sceneManager->setScene(SceneType::MainMenu);
+  if (options.mapConfig) {
+    eventBus->publish(SceneChangeEvent{SceneType::Game, *options.mapConfig});
+  }
 
   // Subscribe to the WindowCloseEvent to stop the application loop
   closeEventToken = eventBus->subscribe<WindowCloseEvent>([this](const WindowCloseEvent &) {
@@ -68,17 +75,31 @@ void Application::run() {
       [this]() { this->render(); }, [this]() { return isRunning; });
 }
 
-void Application::update(double dt) { sceneManager->update(dt); }
+void Application::update(double dt) {
+  PROFILE_ZONE("Application::update");
+  sceneManager->update(dt);
+}
 
 void Application::render() {
+  PROFILE_ZONE("Application::render");
   if (window->shouldClose()) {
     eventBus->publish(WindowCloseEvent{});
   }
-  inputSystem->update();
+  {
+    // Input handlers mutate simulation state; keep them out of a running tick.
+    auto simulationLock = sceneManager->lockSimulation();
+    inputSystem->update();
+  }
 
   window->beginDrawing();
   sceneManager->render();
 
   AudioManager::Get().DrawUI();
+  if (profilerOverlay)
+    profilerOverlay->draw();
   window->endDrawing();
+
+#ifdef PARKLOGIC_PROFILER
+  Profiler::Get().markFrame();
+#endif
 }
@@ -0,0 +1,448 @@
+#include "core/BatchRunner.hpp"
+#include "config.hpp"
+#include "core/EntityManager.hpp"
+#include "core/EventBus.hpp"
+#include "entities/Car.hpp"
+#include "systems/TrafficSystem.hpp"
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <mutex>
+#include <ostream>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+
+/**
+ * @file BatchRunner.cpp
+ * @brief Implementation of the sweep parser, the parallel runner and the CSV reports.
+ */
+
+namespace {
+std::string trim(const std::string &s) {
+  size_t begin = s.find_first_not_of(" \t\r");
+  if (begin == std::string::npos)
+    return "";
+  size_t end = s.find_last_not_of(" \t\r");
+  return s.substr(begin, end - begin + 1);
+}
+
+template <typename T> T parseNumber(const std::string &key, const std::string &text) {
+  T value{};
+  auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+  if (error != std::errc() || end != text.data() + text.size())
+    throw std::runtime_error("Invalid value for " + key + ": '" + text + "'");
+  return value;
+}
+
+CarFollowingModel parseCarFollowing(const std::string &value) {
+  if (value == "steering")
+    return CarFollowingModel::STEERING;
+  if (value == "idm")
+    return CarFollowingModel::IDM;
+  throw std::runtime_error("Invalid value for car_following: '" + value + "' (steering or idm)");
+}
+
+SpotAssignmentMode parseSpotAssignment(const std::string &value) {
+  if (value == "greedy")
+    return SpotAssignmentMode::GREEDY;
+  if (value == "batch")
+    return SpotAssignmentMode::BATCH;
+  throw std::runtime_error("Invalid value for spot_assignment: '" + value + "' (greedy or batch)");
+}
+
+/**
+ * @brief Parses "a, b, c" where integer items may also be inclusive ranges "a..b".
+ */
+template <typename T> std::vector<T> parseList(const std::string &key, const std::string &value) {
+  std::vector<T> list;
+  size_t start = 0;
+  while (start <= value.size()) {
+    size_t comma = value.find(',', start);
+    std::string item = trim(value.substr(start, comma == std::string::npos ? std::string::npos : comma - start));
+    size_t dots = item.find("..");
+    if (std::is_integral_v<T> && dots != std::string::npos) {
+      T first = parseNumber<T>(key, trim(item.substr(0, dots)));
+      T last = parseNumber<T>(key, trim(item.substr(dots + 2)));
+      if (last < first)
+        throw std::runtime_error("Empty range for " + key + ": '" + item + "'");
+      // Length in unsigned arithmetic (exact for signed bounds too); a range may end at the type's maximum
+      if ((uint64_t)last - (uint64_t)first >= (uint64_t)Config::Batch::MAX_RANGE_LENGTH)
+        throw std::runtime_error("Range for " + key + " is too long: '" + item + "' (at most " +
+                                 std::to_string(Config::Batch::MAX_RANGE_LENGTH) + " values)");
+      for (T v = first;; ++v) {
+        list.push_back(v);
+        if (v == last)
+          break;
+      }
+    } else {
+      list.push_back(parseNumber<T>(key, item));
+    }
+    if (comma == std::string::npos)
+      break;
+    start = comma + 1;
+  }
+  return list;
+}
+
+void requireRange(const std::string &key, const std::vector<int> &values, int min, int max) {
+  for (int v : values) {
+    if (v < min || v > max)
+      throw std::runtime_error(key + " must be between " + std::to_string(min) + " and " + std::to_string(max));
+  }
+}
+
+void requireAmount(const std::string &key, const std::vector<float> &values, float max) {
+  for (float v : values) {
+    if (!std::isfinite(v) || v < 0.0f)
+      throw std::runtime_error(key + " must be a finite, non-negative number");
+    if (v > max)
+      throw std::runtime_error(key + " must not exceed " + std::to_string((long long)max));
+  }
+}
+
+/// Report columns: name and accessor of every metric of a run.
+struct MetricColumn {
+  const char *name;
+  double (*get)(const BatchResult &);
+};
+
+const MetricColumn METRIC_COLUMNS[] = {
+    {"mean_occupancy", [](const BatchResult &r) { return r.meanOccupancy; }},
+    {"cars_spawned", [](const BatchResult &r) { return (double)r.carsSpawned; }},
+    {"cars_turned_away", [](const BatchResult &r) { return (double)r.carsTurnedAway; }},
+    {"stays_completed", [](const BatchResult &r) { return (double)r.staysCompleted; }},
+    {"revenue", [](const BatchResult &r) { return r.revenue; }},
+    {"charge_delivered", [](const BatchResult &r) { return r.chargeDelivered; }},
+    {"mean_spawn_queue", [](const BatchResult &r) { return r.meanSpawnQueue; }},
+    {"max_spawn_queue", [](const BatchResult &r) { return (double)r.maxSpawnQueue; }},
+};
+
+const char *PARAM_HEADER = "config,small_parking,large_parking,small_charging,large_charging,spawn_level,"
+                           "battery_low_threshold,battery_high_threshold,battery_exit_threshold,"
+                           "battery_force_exit_threshold,charging_rate,parking_min_time,parking_max_time,"
+                           "price_elasticity";
+
+void writeParams(std::ostream &out, const BatchRun &run) {
+  const SimulationParams &p = run.params;
+  out << run.configIndex << ',' << run.map.smallParkingCount << ',' << run.map.largeParkingCount << ','
+      << run.map.smallChargingCount << ',' << run.map.largeChargingCount << ',' << run.spawnLevel << ','
+      << p.batteryLowThreshold << ',' << p.batteryHighThreshold << ',' << p.batteryExitThreshold << ','
+      << p.batteryForceExitThreshold << ',' << p.chargingRate << ',' << p.parkingMinTime << ','
+      << p.parkingMaxTime << ',' << p.priceElasticity;
+}
+} // namespace
+
+// --- SweepSpec ---
+
+SweepSpec SweepSpec::parse(std::istream &in) {
+  SweepSpec spec;
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(in, line)) {
+    lineNumber++;
+    line = trim(line.substr(0, line.find('#')));
+    if (line.empty())
+      continue;
+
+    size_t eq = line.find('=');
+    if (eq == std::string::npos)
+      throw std::runtime_error("Line " + std::to_string(lineNumber) + ": expected key = value");
+    std::string key = trim(line.substr(0, eq));
+    std::string value = trim(line.substr(eq + 1));
+
+    auto counts = [&](int max) {
+      std::vector<int> list = parseList<int>(key, value);
+      requireRange(key, list, 0, max);
+      return list;
+    };
+    auto amounts = [&](float max = std::numeric_limits<float>::infinity()) {
+      std::vector<float> list = parseList<float>(key, value);
+      requireAmount(key, list, max);
+      return list;
+    };
+
+    try {
+      if (key == "small_parking")
+        spec.smallParking = counts(Config::Map::MAX_PER_TYPE);
+      else if (key == "large_parking")
+        spec.largeParking = counts(Config::Map::MAX_PER_TYPE);
+      else if (key == "small_charging")
+        spec.smallCharging = counts(Config::Map::MAX_PER_TYPE);
+      else if (key == "large_charging")
+        spec.largeCharging = counts(Config::Map::MAX_PER_TYPE);
+      else if (key == "spawn_level")
+        spec.spawnLevels = counts((int)std::size(Config::Spawner::SPAWN_RATES) - 1);
+      else if (key == "battery_low_threshold")
+        spec.batteryLowThresholds = amounts();
+      else if (key == "battery_high_threshold")
+        spec.batteryHighThresholds = amounts();
+      else if (key == "battery_exit_threshold")
+        spec.batteryExitThresholds = amounts();
+      else if (key == "battery_force_exit_threshold")
+        spec.batteryForceExitThresholds = amounts();
+      else if (key == "charging_rate")
+        spec.chargingRates = amounts();
+      else if (key == "parking_min_time")
+        spec.parkingMinTimes = amounts(Config::MAX_PARKING_TIME);
+      else if (key == "parking_max_time")
+        spec.parkingMaxTimes = amounts(Config::MAX_PARKING_TIME);
+      else if (key == "price_elasticity")
+        spec.priceElasticities = amounts();
+      else if (key == "seeds")
+        spec.seeds = parseList<uint64_t>(key, value);
+      else if (key == "duration")
+        spec.duration = parseNumber<double>(key, value);
+      else if (key == "threads")
+        spec.threads = parseNumber<int>(key, value);
+      else if (key == "car_following")
+        spec.carFollowing = parseCarFollowing(value);
+      else if (key == "tick_length")
+        spec.tickLength = parseNumber<double>(key, value);
+      else if (key == "spot_assignment")
+        spec.spotAssignment = parseSpotAssignment(value);
+      else
+        throw std::runtime_error("Unknown key '" + key + "'");
+
+      if (spec.duration <= 0.0)
+        throw std::runtime_error("duration must be positive");
+      if (spec.threads < 0)
+        throw std::runtime_error("threads must not be negative");
+      if (spec.tickLength <= 0.0 || spec.tickLength > 1.0)
+        throw std::runtime_error("tick_length must be in (0, 1]");
+    } catch (const std::runtime_error &e) {
+      throw std::runtime_error("Line " + std::to_string(lineNumber) + ": " + e.what());
+    }
+  }
+  return spec;
+}
+
+SweepSpec SweepSpec::load(const std::string &path) {
+  std::ifstream file(path);
+  if (!file)
+    throw std::runtime_error("Could not open sweep file: " + path);
+  try {
+    return parse(file);
+  } catch (const std::runtime_error &e) {
+    throw std::runtime_error(path + ": " + e.what());
+  }
+}
+
+std::vector<BatchRun> SweepSpec::expand() const {
+  // Mixed-radix counter over the parameter lists, the last one varying fastest
+  const size_t sizes[] = {smallParking.size(),          largeParking.size(),          smallCharging.size(),
+                          largeCharging.size(),         spawnLevels.size(),           batteryLowThresholds.size(),
+                          batteryHighThresholds.size(), batteryExitThresholds.size(), batteryForceExitThresholds.size(),
+                          chargingRates.size(),         parkingMinTimes.size(),       parkingMaxTimes.size(),
+                          priceElasticities.size()};
+  constexpr size_t DIMENSIONS = std::size(sizes);
+
+  // Checked against the cap at every step, so the product cannot overflow
+  const size_t maxRuns = (size_t)Config::Batch::MAX_RUNS;
+  auto tooMany = [&](size_t count, size_t factor) { return factor != 0 && count > maxRuns / factor; };
+  size_t combinations = 1;
+  for (size_t size : sizes) {
+    if (tooMany(combinations, size))
+      throw std::runtime_error("Sweep expands to more than " + std::to_string(maxRuns) + " runs");
+    combinations *= size;
+  }
+  if (tooMany(combinations, seeds.size()))
+    throw std::runtime_error("Sweep expands to more than " + std::to_string(maxRuns) + " runs");
+
+  std::vector<BatchRun> runs;
+  runs.reserve(combinations * seeds.size());
+  for (size_t c = 0; c < combinations; ++c) {
+    size_t digit[DIMENSIONS];
+    size_t rest = c;
+    for (size_t d = DIMENSIONS; d-- > 0;) {
+      digit[d] = rest % sizes[d];
+      rest /= sizes[d];
+    }
+
+    BatchRun run;
+    run.configIndex = (int)c;
+    run.map = MapConfig{smallParking[digit[0]], largeParking[digit[1]], smallCharging[digit[2]],
+                        largeCharging[digit[3]], {}};
+    run.spawnLevel = spawnLevels[digit[4]];
+    run.params.batteryLowThreshold = batteryLowThresholds[digit[5]];
+    run.params.batteryHighThreshold = batteryHighThresholds[digit[6]];
+    run.params.batteryExitThreshold = batteryExitThresholds[digit[7]];
+    run.params.batteryForceExitThreshold = batteryForceExitThresholds[digit[8]];
+    run.params.chargingRate = chargingRates[digit[9]];
+    run.params.parkingMinTime = parkingMinTimes[digit[10]];
+    run.params.parkingMaxTime = parkingMaxTimes[digit[11]];
+    run.params.priceElasticity = priceElasticities[digit[12]];
+    run.params.carFollowing = carFollowing;
+    run.params.spotAssignment = spotAssignment;
+    run.tickLength = tickLength;
+
+    for (uint64_t seed : seeds) {
+      run.seed = seed;
+      runs.push_back(run);
+    }
+  }
+  return runs;
+}
+
+// --- BatchRunner ---
+
+BatchResult BatchRunner::runOne(const BatchRun &run, double duration) {
+  auto start = std::chrono::steady_clock::now();
+
+  auto bus = std::make_shared<EventBus>();
+  EntityManager entityManager(bus, run.params);
+  TrafficSystem trafficSystem(bus, entityManager);
+  entityManager.getRandom().reseed(run.seed);
+
+  BatchResult result;
+  std::vector<Subscription> tokens;
+  tokens.push_back(bus->subscribe<CarSpawnedEvent>([&result](const CarSpawnedEvent &) { result.carsSpawned++; }));
+  tokens.push_back(
+      bus->subscribe<CarTurnedAwayEvent>([&result](const CarTurnedAwayEvent &) { result.carsTurnedAway++; }));
+
+  // A stay is paid when its spot is released (same rule as MetricsRecorder)
+  tokens.push_back(bus->subscribe<SpotStateChangedEvent>([&result](const SpotStateChangedEvent &e) {
+    if (e.previous == SpotState::OCCUPIED && e.current != SpotState::OCCUPIED) {
+      result.staysCompleted++;
+      result.revenue += e.price;
+    }
+  }));
+
+  // Charge is collected from cars as they leave; the ones still on site are added at the end
+  tokens.push_back(bus->subscribe<CarDeletedEvent>([&](const CarDeletedEvent &e) {
+    if (const Car *car = entityManager.getCar(e.carId))
+      result.chargeDelivered += car->getChargeReceived();
+  }));
+
+  bus->publish(GenerateWorldEvent{run.map});
+  trafficSystem.setSpawnLevel(run.spawnLevel);
+
+  long long ticks = std::llround(duration / run.tickLength);
+  long long ticksPerSample = std::max(1LL, std::llround(1.0 / run.tickLength));
+  double occupancySum = 0.0;
+  double queueSum = 0.0;
+  long long samples = 0;
+  for (long long tick = 1; tick <= ticks; ++tick) {
+    bus->publish(GameUpdateEvent{run.tickLength});
+
+    if (tick % ticksPerSample == 0) {
+      const OccupancyCounters &c = entityManager.getOccupancyStats().getCounters();
+      occupancySum += c.totalSpots > 0 ? (double)c.occupiedSpots / c.totalSpots * 100.0 : 0.0;
+      queueSum += trafficSystem.getSpawnQueueLength();
+      result.maxSpawnQueue = std::max(result.maxSpawnQueue, trafficSystem.getSpawnQueueLength());
+      samples++;
+    }
+  }
+  result.meanOccupancy = samples > 0 ? occupancySum / (double)samples : 0.0;
+  result.meanSpawnQueue = samples > 0 ? queueSum / (double)samples : 0.0;
+
+  entityManager.catchUpSleepingCars();
+  for (const auto &car : entityManager.getCars())
+    result.chargeDelivered += car->getChargeReceived();
+
+  result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return result;
+}
+
+std::vector<BatchResult> BatchRunner::runAll(const std::vector<BatchRun> &runs, double duration, int threads,
+                                             const Progress &progress) {
+  std::vector<BatchResult> results(runs.size());
+  if (runs.empty())
+    return results;
+
+  if (threads <= 0)
+    threads = (int)std::max(1u, std::thread::hardware_concurrency());
+  threads = (int)std::min<size_t>((size_t)threads, runs.size());
+
+  std::atomic<size_t> next{0};
+  std::atomic<bool> failed{false};
+  std::mutex reportMutex; // Guards done, error and progress calls
+  size_t done = 0;
+  std::exception_ptr error;
+
+  // Workers pull the next run index until the list is exhausted (or a run failed)
+  auto worker = [&] {
+    for (size_t i; !failed.load() && (i = next.fetch_add(1)) < runs.size();) {
+      try {
+        results[i] = runOne(runs[i], duration);
+      } catch (...) {
+        std::scoped_lock lock(reportMutex);
+        if (!error)
+          error = std::current_exception();
+        failed.store(true);
+        return;
+      }
+      std::scoped_lock lock(reportMutex);
+      done++;
+      if (progress)
+        progress(done, runs.size());
+    }
+  };
+
+  std::vector<std::thread> pool;
+  pool.reserve((size_t)threads - 1);
+  for (int t = 1; t < threads; ++t)
+    pool.emplace_back(worker);
+  worker();
+  for (auto &thread : pool)
+    thread.join();
+
+  if (error)
+    std::rethrow_exception(error);
+  return results;
+}
+
+void BatchRunner::writeReport(std::ostream &out, const std::vector<BatchRun> &runs,
+                              const std::vector<BatchResult> &results) {
+  out << PARAM_HEADER << ",runs";
+  for (const MetricColumn &column : METRIC_COLUMNS)
+    out << ',' << column.name << "_mean," << column.name << "_stddev";
+  out << '\n';
+
+  // Runs of one combination are adjacent (expand() varies the seed fastest)
+  for (size_t first = 0; first < runs.size();) {
+    size_t last = first;
+    while (last < runs.size() && runs[last].configIndex == runs[first].configIndex)
+      last++;
+    size_t count = last - first;
+
+    writeParams(out, runs[first]);
+    out << ',' << count;
+    for (const MetricColumn &column : METRIC_COLUMNS) {
+      double sum = 0.0;
+      for (size_t i = first; i < last; ++i)
+        sum += column.get(results[i]);
+      double mean = sum / (double)count;
+
+      double squares = 0.0;
+      for (size_t i = first; i < last; ++i)
+        squares += (column.get(results[i]) - mean) * (column.get(results[i]) - mean);
+      double stddev = count > 1 ? std::sqrt(squares / (double)(count - 1)) : 0.0;
+      out << ',' << mean << ',' << stddev;
+    }
+    out << '\n';
+    first = last;
+  }
+}
+
+void BatchRunner::writeRuns(std::ostream &out, const std::vector<BatchRun> &runs,
+                            const std::vector<BatchResult> &results) {
+  out << PARAM_HEADER << ",seed";
+  for (const MetricColumn &column : METRIC_COLUMNS)
+    out << ',' << column.name;
+  out << ",wall_seconds\n";
+
+  for (size_t i = 0; i < runs.size(); ++i) {
+    writeParams(out, runs[i]);
+    out << ',' << runs[i].seed;
+    for (const MetricColumn &column : METRIC_COLUMNS)
+      out << ',' << column.get(results[i]);
+    out << ',' << results[i].wallSeconds << '\n';
+  }
+}
@@ -0,0 +1,16 @@
+#include "core/BinaryIO.hpp"
+#include <fstream>
+
+/**
+ * @file BinaryIO.cpp
+ * @brief Implementation of the binary buffer writer.
+ */
+
+void BinaryWriter::saveTo(const std::string &path) const {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if (!out)
+    throw std::runtime_error("Could not open " + path + " for writing");
+  out.write(reinterpret_cast<const char *>(buffer.data()), (std::streamsize)buffer.size());
+  if (!out)
+    throw std::runtime_error("Could not write " + path);
+}
@@ -0,0 +1,35 @@
+#include "core/CarPool.hpp"
+
+/**
+ * @file CarPool.cpp
+ * @brief Implementation of the recycled Car free list.
+ */
+
+std::unique_ptr<Car> CarPool::acquire(Vector2 startPos, const World *world, Vector2 initialVelocity,
+                                      Car::CarType type) {
+  if (freeList.empty()) {
+    stats.allocations++;
+    return std::make_unique<Car>(startPos, world, initialVelocity, type);
+  }
+
+  std::unique_ptr<Car> car = std::move(freeList.back());
+  freeList.pop_back();
+  car->reset(startPos, initialVelocity, type);
+  stats.reuses++;
+  return car;
+}
+
+void CarPool::release(std::unique_ptr<Car> car) {
+  if (!car)
+    return;
+  stats.releases++;
+  freeList.push_back(std::move(car));
+}
+
+void CarPool::reserve(size_t count) {
+  freeList.reserve(count);
+  while (freeList.size() < count) {
+    stats.allocations++;
+    freeList.push_back(std::make_unique<Car>(Vector2{0, 0}, nullptr, Vector2{0, 0}, Car::CarType::COMBUSTION));
+  }
+}
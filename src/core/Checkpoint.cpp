@@ -0,0 +1,79 @@
+#include "core/Checkpoint.hpp"
+#include "core/BinaryIO.hpp"
+#include "core/EntityManager.hpp"
+#include "core/MappedFile.hpp"
+#include "systems/TrafficSystem.hpp"
+#include <cstring>
+#include <stdexcept>
+
+/**
+ * @file Checkpoint.cpp
+ * @brief Implementation of simulation checkpoints.
+ */
+
+namespace {
+constexpr char MAGIC[8] = {'P', 'L', 'K', 'C', 'H', 'K', 'P', 'T'};
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t byteOrder;
+};
+
+void readHeader(BinaryReader &in) {
+  auto header = in.read<Header>();
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    throw std::runtime_error("Not a ParkLogic checkpoint");
+  if (header.byteOrder != BYTE_ORDER_MARK)
+    throw std::runtime_error("Checkpoint was written on a machine with a different byte order");
+  if (header.version != Checkpoint::VERSION)
+    throw std::runtime_error("Unsupported checkpoint version " + std::to_string(header.version));
+}
+} // namespace
+
+Checkpoint Checkpoint::capture(EntityManager &entityManager, const TrafficSystem &trafficSystem) {
+  BinaryWriter out;
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.byteOrder = BYTE_ORDER_MARK;
+  out.write(header);
+
+  entityManager.saveCheckpoint(out);
+  trafficSystem.saveCheckpoint(out);
+
+  Checkpoint checkpoint;
+  checkpoint.data = out.data();
+  return checkpoint;
+}
+
+void Checkpoint::restore(EntityManager &entityManager, TrafficSystem &trafficSystem) const {
+  BinaryReader in(data);
+  readHeader(in);
+
+  // Every section is read and validated before any of them is applied
+  EntityManager::CheckpointState entities = entityManager.readCheckpoint(in);
+  TrafficSystem::CheckpointState traffic = trafficSystem.readCheckpoint(in, entities.cars.size());
+  if (in.remaining() != 0)
+    throw std::runtime_error("Checkpoint has trailing data");
+
+  entityManager.restoreCheckpoint(entities);
+  trafficSystem.restoreCheckpoint(traffic);
+}
+
+void Checkpoint::saveTo(const std::string &path) const {
+  BinaryWriter out;
+  out.writeArray(std::span<const std::byte>(data));
+  out.saveTo(path);
+}
+
+Checkpoint Checkpoint::loadFrom(const std::string &path) {
+  MappedFile file(path);
+  BinaryReader in(file.bytes());
+  readHeader(in);
+
+  Checkpoint checkpoint;
+  checkpoint.data.assign(file.bytes().begin(), file.bytes().end());
+  return checkpoint;
+}
@@ -0,0 +1,323 @@
+#include "core/ChunkGrid.hpp"
+#include "config.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file ChunkGrid.cpp
+ * @brief Implementation of the chunk partition and its activation scheduling.
+ */
+
+int ChunkGrid::clampedIndex(float x, size_t count) const {
+  if (count == 0 || !(x > 0.0f))
+    return 0;
+  return (int)std::min<size_t>((size_t)(x / Config::Chunks::WIDTH), count - 1);
+}
+
+int ChunkGrid::chunkIndexAt(float x) {
+  if (!(x > 0.0f))
+    return 0;
+  return (int)(x / Config::Chunks::WIDTH);
+}
+
+ChunkGrid::Chunk &ChunkGrid::chunkAt(int index) {
+  if ((size_t)index >= chunks.size())
+    chunks.resize(index + 1);
+  return chunks[index];
+}
+
+// --- Content ---
+
+void ChunkGrid::addModule(Module *module) {
+  int index = chunkIndexAt(module->worldPosition.x);
+  if ((size_t)index >= moduleChunks.size())
+    moduleChunks.resize(index + 1);
+  moduleChunks[index].push_back(module);
+  maxModuleWidth = std::max(maxModuleWidth, module->getWidth());
+  chunkAt(index);
+}
+
+void ChunkGrid::addCar(Car *car) { insertCar(car, chunkIndexAt(car->getPosition().x)); }
+
+void ChunkGrid::removeCar(const Car *car) { eraseCar(car); }
+
+void ChunkGrid::insertCar(Car *car, int index) {
+  Chunk &chunk = chunkAt(index);
+  uint32_t carIndex = car->getId().index;
+  if (carIndex >= carLocations.size())
+    carLocations.resize(carIndex + 1);
+
+  // Cars always arrive awake; a parked newcomer goes to sleep at the next tick if it is not due
+  Location &location = carLocations[carIndex];
+  location.chunk = index;
+  location.slot = (uint32_t)chunk.cars.size();
+  location.asleep = false;
+  chunk.cars.push_back(car);
+
+  if (car->getState() != Car::CarState::PARKED)
+    chunk.movingCars++;
+  activate(index);
+}
+
+void ChunkGrid::eraseCar(const Car *car) {
+  uint32_t carIndex = car->getId().index;
+  if (carIndex >= carLocations.size() || carLocations[carIndex].chunk < 0)
+    return;
+
+  Location &location = carLocations[carIndex];
+  Chunk &chunk = chunks[location.chunk];
+  std::vector<Car *> &list = location.asleep ? chunk.sleepers : chunk.cars;
+
+  // Swap-remove and repoint the car that moved into the hole
+  Car *last = list.back();
+  list[location.slot] = last;
+  carLocations[last->getId().index].slot = location.slot;
+  list.pop_back();
+
+  if (location.asleep)
+    sleepingCarCount--;
+  else if (car->getState() != Car::CarState::PARKED && chunk.movingCars > 0)
+    chunk.movingCars--;
+
+  // Keep the epoch counting, so wake entries of this car cannot match a later car in its slot
+  location = Location{-1, 0, false, location.epoch + 1, 0.0};
+}
+
+void ChunkGrid::clear() {
+  chunks.clear();
+  moduleChunks.clear();
+  carLocations.clear();
+  activeList.clear();
+  activeCars.clear();
+  wakeQueue = {};
+  now = 0.0;
+  tickEnd = 0.0;
+  movingCarCount = 0;
+  sleepingCarCount = 0;
+  maxModuleWidth = 0.0f;
+}
+
+void ChunkGrid::clearCars() {
+  for (Chunk &chunk : chunks)
+    chunk = Chunk{};
+  carLocations.clear();
+  activeList.clear();
+  activeCars.clear();
+  wakeQueue = {};
+  now = 0.0;
+  tickEnd = 0.0;
+  movingCarCount = 0;
+  sleepingCarCount = 0;
+}
+
+void ChunkGrid::catchUpSleeping() {
+  for (Chunk &chunk : chunks) {
+    for (Car *car : chunk.sleepers)
+      catchUp(*car, carLocations[car->getId().index]);
+  }
+}
+
+// --- Activation ---
+
+void ChunkGrid::activate(int index) {
+  Chunk &chunk = chunks[index];
+  if (chunk.active)
+    return;
+  chunk.active = true;
+  chunk.activeSlot = (int)activeList.size();
+  activeList.push_back(index);
+}
+
+void ChunkGrid::deactivate(int index) {
+  Chunk &chunk = chunks[index];
+  if (!chunk.active)
+    return;
+
+  int last = activeList.back();
+  activeList[chunk.activeSlot] = last;
+  chunks[last].activeSlot = chunk.activeSlot;
+  activeList.pop_back();
+
+  chunk.active = false;
+  chunk.activeSlot = -1;
+}
+
+void ChunkGrid::sleep(Car *car) {
+  Location &location = carLocations[car->getId().index];
+  Chunk &chunk = chunks[location.chunk];
+
+  Car *last = chunk.cars.back();
+  chunk.cars[location.slot] = last;
+  carLocations[last->getId().index].slot = location.slot;
+  chunk.cars.pop_back();
+
+  location.asleep = true;
+  location.slot = (uint32_t)chunk.sleepers.size();
+  location.sleptSince = now;
+  chunk.sleepers.push_back(car);
+  sleepingCarCount++;
+  wakeQueue.push({dueTime(*car), car->getId().index, location.epoch});
+}
+
+void ChunkGrid::wake(Car *car) {
+  Location &location = carLocations[car->getId().index];
+  Chunk &chunk = chunks[location.chunk];
+  catchUp(*car, location);
+
+  Car *last = chunk.sleepers.back();
+  chunk.sleepers[location.slot] = last;
+  carLocations[last->getId().index].slot = location.slot;
+  chunk.sleepers.pop_back();
+  sleepingCarCount--;
+
+  location.asleep = false;
+  location.epoch++;
+  location.slot = (uint32_t)chunk.cars.size();
+  chunk.cars.push_back(car);
+  activate(location.chunk);
+}
+
+double ChunkGrid::dueTime(const Car &car) const { return now + std::max(0.0, (double)car.getParkingTimer()); }
+
+void ChunkGrid::catchUp(Car &car, Location &location) {
+  double elapsed = now - location.sleptSince;
+  location.sleptSince = now;
+  if (elapsed <= 0.0)
+    return;
+
+  // What the skipped ticks would have done: Car::update counts parking time down
+  car.skipParkedTime((float)elapsed);
+}
+
+bool ChunkGrid::isInView(int index) const {
+  float minX, maxX;
+  if (!getTickView(minX, maxX))
+    return false;
+  int first = (int)std::floor(minX / Config::Chunks::WIDTH) - Config::Chunks::VIEW_MARGIN;
+  int last = (int)std::floor(maxX / Config::Chunks::WIDTH) + Config::Chunks::VIEW_MARGIN;
+  return index >= first && index <= last;
+}
+
+// --- Ticking ---
+
+void ChunkGrid::beginTick(double dt) {
+  tickEnd = now + dt;
+
+  // Read the view once: the render thread may move it while this tick is being scheduled
+  getView(tickViewMinX, tickViewMaxX);
+
+  // 1. Wake the cars that become due during this tick
+  while (!wakeQueue.empty() && wakeQueue.top().at <= tickEnd) {
+    WakeEntry entry = wakeQueue.top();
+    wakeQueue.pop();
+    const Location &location = carLocations[entry.carIndex];
+    if (location.asleep && location.epoch == entry.epoch)
+      wake(chunks[location.chunk].sleepers[location.slot]);
+  }
+
+  // 2. Keep everything around the camera fully simulated
+  float minX, maxX;
+  if (getTickView(minX, maxX) && !chunks.empty()) {
+    int first = std::max(0, clampedIndex(minX, chunks.size()) - Config::Chunks::VIEW_MARGIN);
+    int last = std::min((int)chunks.size() - 1, clampedIndex(maxX, chunks.size()) + Config::Chunks::VIEW_MARGIN);
+    for (int i = first; i <= last; ++i) {
+      while (!chunks[i].sleepers.empty())
+        wake(chunks[i].sleepers.back());
+      activate(i);
+    }
+  }
+
+  // 3. Put parked cars that are not due this tick to sleep, and chunks left without awake cars.
+  //    This runs before the update, so the listeners of the previous tick (TrafficSystem) have
+  //    already seen every car that just parked.
+  for (size_t k = activeList.size(); k-- > 0;) {
+    int index = activeList[k];
+    Chunk &chunk = chunks[index];
+    if (isInView(index))
+      continue;
+    for (size_t j = chunk.cars.size(); j-- > 0;) {
+      Car *car = chunk.cars[j];
+      if (car->getState() == Car::CarState::PARKED && dueTime(*car) > tickEnd)
+        sleep(car);
+    }
+    if (chunk.cars.empty())
+      deactivate(index);
+  }
+}
+
+void ChunkGrid::forEachActiveChunk(const std::function<void(Chunk &, std::span<const Car *const>)> &fn) {
+  for (int index : activeList) {
+    neighborScratch.clear();
+    for (int n = std::max(0, index - 1); n <= std::min((int)chunks.size() - 1, index + 1); ++n) {
+      neighborScratch.insert(neighborScratch.end(), chunks[n].cars.begin(), chunks[n].cars.end());
+    }
+    fn(chunks[index], neighborScratch);
+  }
+}
+
+void ChunkGrid::endTick() {
+  now = tickEnd;
+
+  // Move cars that crossed a border (may wake the chunk they enter, which appends to activeList)
+  for (size_t k = 0; k < activeList.size(); ++k) {
+    int index = activeList[k];
+    for (size_t j = chunks[index].cars.size(); j-- > 0;) {
+      Car *car = chunks[index].cars[j];
+      int target = chunkIndexAt(car->getPosition().x);
+      if (target != index) {
+        eraseCar(car);
+        insertCar(car, target);
+      }
+    }
+  }
+
+  movingCarCount = 0;
+  activeCars.clear();
+  for (int index : activeList) {
+    Chunk &chunk = chunks[index];
+    chunk.movingCars = 0;
+    for (const Car *car : chunk.cars) {
+      if (car->getState() != Car::CarState::PARKED)
+        chunk.movingCars++;
+      activeCars.push_back(car->getId());
+    }
+    movingCarCount += chunk.movingCars;
+  }
+}
+
+// --- Queries ---
+
+void ChunkGrid::forEachModuleIn(float minX, float maxX, const std::function<void(Module &)> &fn) const {
+  if (moduleChunks.empty())
+    return;
+  int first = clampedIndex(minX - maxModuleWidth, moduleChunks.size());
+  int last = clampedIndex(maxX, moduleChunks.size());
+  for (int i = first; i <= last; ++i) {
+    for (Module *module : moduleChunks[i])
+      fn(*module);
+  }
+}
+
+void ChunkGrid::forEachCarIn(float minX, float maxX, const std::function<void(const Car &)> &fn) const {
+  if (chunks.empty())
+    return;
+  int first = clampedIndex(minX, chunks.size());
+  int last = clampedIndex(maxX, chunks.size());
+  for (int i = first; i <= last; ++i) {
+    for (const Car *car : chunks[i].cars)
+      fn(*car);
+    for (const Car *car : chunks[i].sleepers)
+      fn(*car);
+  }
+}
+
+void ChunkGrid::setView(float minX, float maxX) {
+  viewMinX.store(minX, std::memory_order_relaxed);
+  viewMaxX.store(maxX, std::memory_order_relaxed);
+}
+
+bool ChunkGrid::getView(float &minX, float &maxX) const {
+  minX = viewMinX.load(std::memory_order_relaxed);
+  maxX = viewMaxX.load(std::memory_order_relaxed);
+  return maxX > minX;
+}
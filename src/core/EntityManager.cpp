@@ -1,6 +1,3 @@
-#include "core/EntityManager.hpp"
-#include "core/Logger.hpp"
-
 /**
  * @file EntityManager.cpp
  * @brief Implementation of EntityManager.
@@ -9,25 +6,146 @@
  */
 
 #include "core/EntityManager.hpp"
+#include "config.hpp"
+#include "core/BinaryIO.hpp"
 #include "core/Logger.hpp"
+#include "core/Profiler.hpp"
 #include "entities/Car.hpp"
+#include "entities/map/MapFile.hpp"
 #include "entities/map/WorldGenerator.hpp"
 #include "events/GameEvents.hpp"
+#include "raymath.h"
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+
+namespace {
+/**
+ * @brief Incremental 64-bit FNV-1a over the bytes of trivially copyable values (floats bitwise).
+ */
+struct StateHasher {
+  uint64_t hash = 14695981039346656037ull;
+
+  template <typename T> void add(const T &value) {
+    const auto *bytes = reinterpret_cast<const unsigned char *>(&value);
+    for (size_t i = 0; i < sizeof(T); ++i) {
+      hash ^= bytes[i];
+      hash *= 1099511628211ull;
+    }
+  }
+};
 
-EntityManager::EntityManager(std::shared_ptr<EventBus> bus) : eventBus(bus) {
+template <typename T> T fieldAt(std::span<const std::byte> record, size_t offset) {
+  T value;
+  std::memcpy(&value, record.data() + offset, sizeof(T));
+  return value;
+}
+
+template <typename E> bool enumAt(std::span<const std::byte> record, size_t offset, E last) {
+  using U = std::underlying_type_t<E>;
+  U value = fieldAt<U>(record, offset);
+  return value >= 0 && value <= (U)last;
+}
+
+/**
+ * @brief Reads a car record of a checkpoint. Its enums and bools are checked in the raw bytes:
+ * copying an out-of-range value into a Car::Snapshot would already be undefined.
+ * @throws std::runtime_error if one of them is out of range.
+ */
+Car::Snapshot readCarSnapshot(BinaryReader &in) {
+  using S = Car::Snapshot;
+  auto record = in.take(sizeof(S));
+  size_t spotState = offsetof(S, parkedSpot) + offsetof(Spot, state);
+  if (!enumAt(record, offsetof(S, state), Car::CarState::EXITING) ||
+      !enumAt(record, offsetof(S, type), Car::CarType::ELECTRIC) ||
+      !enumAt(record, offsetof(S, priority), Car::Priority::PRIORITY_DISTANCE) ||
+      !enumAt(record, spotState, SpotState::OCCUPIED))
+    throw std::runtime_error("Checkpoint car has an out-of-range state, type, priority or spot state");
+  if (fieldAt<uint8_t>(record, offsetof(S, enteredFromLeft)) > 1 ||
+      fieldAt<uint8_t>(record, offsetof(S, charging)) > 1)
+    throw std::runtime_error("Checkpoint car has an invalid flag");
+
+  S snapshot;
+  std::memcpy(&snapshot, record.data(), sizeof(S));
+  return snapshot;
+}
+
+/// Bytes one waypoint takes in a checkpoint (written field by field, see writeWaypoint).
+constexpr size_t WAYPOINT_SIZE = 5 * sizeof(float) + sizeof(int32_t) + sizeof(uint8_t);
+
+void writeWaypoint(BinaryWriter &out, const Waypoint &waypoint) {
+  out.write(waypoint.position.x);
+  out.write(waypoint.position.y);
+  out.write(waypoint.tolerance);
+  out.write((int32_t)waypoint.id);
+  out.write(waypoint.entryAngle);
+  out.write((uint8_t)(waypoint.stopAtEnd ? 1 : 0));
+  out.write(waypoint.speedLimitFactor);
+}
+
+/**
+ * @brief Reads a waypoint written by writeWaypoint().
+ * @throws std::runtime_error if a value is not finite or the stop flag is not 0 / 1.
+ */
+Waypoint readWaypoint(BinaryReader &in) {
+  float x = in.read<float>();
+  float y = in.read<float>();
+  float tolerance = in.read<float>();
+  int32_t id = in.read<int32_t>();
+  float entryAngle = in.read<float>();
+  uint8_t stopAtEnd = in.read<uint8_t>();
+  float speedLimitFactor = in.read<float>();
+  if (!std::isfinite(x) || !std::isfinite(y) || !std::isfinite(tolerance) || !std::isfinite(entryAngle) ||
+      !std::isfinite(speedLimitFactor))
+    throw std::runtime_error("Checkpoint waypoint has a non-finite value");
+  if (stopAtEnd > 1)
+    throw std::runtime_error("Checkpoint waypoint has an invalid flag");
+  return Waypoint({x, y}, tolerance, id, entryAngle, stopAtEnd != 0, speedLimitFactor);
+}
+
+/// Hash of what a checkpoint depends on in the layout: every module's size, position and spot count.
+uint64_t layoutFingerprint(const std::vector<std::unique_ptr<Module>> &modules) {
+  StateHasher hasher;
+  for (const auto &mod : modules) {
+    hasher.add(mod->getWidth());
+    hasher.add(mod->getHeight());
+    hasher.add(mod->worldPosition);
+    hasher.add((uint64_t)mod->getSpotCount());
+  }
+  return hasher.hash;
+}
+} // namespace
+
+EntityManager::EntityManager(std::shared_ptr<EventBus> bus, const SimulationParams &params)
+    : eventBus(bus), params(params), occupancy(bus), pricing(bus) {
   // Subscribe to GenerateWorldEvent
   eventTokens.push_back(eventBus->subscribe<GenerateWorldEvent>([this](const GenerateWorldEvent &e) {
-    Logger::Info("Generating World...");
-    auto generated = WorldGenerator::generate(e.config);
-    this->setWorld(std::move(generated.world));
-
-    for (auto &mod : generated.modules) {
-      this->addModule(std::move(mod));
+    if (!e.config.mapFile.empty()) {
+      try {
+        this->loadMap(e.config.mapFile);
+        return;
+      } catch (const std::exception &ex) {
+        Logger::Error("EntityManager: {}. Generating a new world instead.", ex.what());
+      }
     }
 
-    // Publish WorldBounds
-    if (world) {
-      eventBus->publish(WorldBoundsEvent{world->getWidth(), world->getHeight()});
+    Logger::Info("Generating World...");
+    GeneratedMap generated = WorldGenerator::generate(e.config, random);
+    this->installMap(std::move(generated));
+  }));
+
+  // Subscribe to SaveMapEvent
+  eventTokens.push_back(eventBus->subscribe<SaveMapEvent>([this](const SaveMapEvent &e) {
+    try {
+      this->saveMap(e.path);
+      Logger::Info("EntityManager: Map saved to {}", e.path);
+    } catch (const std::exception &ex) {
+      Logger::Error("EntityManager: {}", ex.what());
     }
   }));
 
@@ -35,28 +153,31 @@ EntityManager::EntityManager(std::shared_ptr<EventBus> bus) : eventBus(bus) {
   eventTokens.push_back(eventBus->subscribe<GameUpdateEvent>([this](const GameUpdateEvent &e) { this->update(e.dt); }));
 
   // Subscribe to DrawWorldEvent
-  eventTokens.push_back(eventBus->subscribe<DrawWorldEvent>([this](const DrawWorldEvent &) { this->draw(); }));
+  eventTokens.push_back(eventBus->subscribe<DrawWorldEvent>([this](const DrawWorldEvent &e) { this->draw(e.view); }));
 
   // Subscribe to CreateCarEvent
   eventTokens.push_back(eventBus->subscribe<CreateCarEvent>([this](const CreateCarEvent &e) {
     if (!world)
       return;
 
-    auto car = std::make_unique<Car>(e.position, world.get(), e.velocity, static_cast<Car::CarType>(e.carType));
+    auto car = carPool.acquire(e.position, world.get(), e.velocity, static_cast<Car::CarType>(e.carType));
     car->setPriority(static_cast<Car::Priority>(e.priority));
     car->setEnteredFromLeft(e.enteredFromLeft);
 
-    Car *carPtr = car.get();
-    this->addCar(std::move(car));
+    // Random visual variant (1-3), and electric cars arrive with 10-90% charge
+    car->setTextureVariant(random.uniformInt(1, 3));
+    car->setBatteryLevel((float)random.uniformInt(10, 90));
+
+    CarId id = this->addCar(std::move(car));
 
     // Notify that a car has spawned
-    eventBus->publish(CarSpawnedEvent{carPtr});
+    eventBus->publish(CarSpawnedEvent{id});
   }));
 
   // Subscribe to AssignPathEvent
-  eventTokens.push_back(eventBus->subscribe<AssignPathEvent>([](const AssignPathEvent &e) {
-    if (e.car) {
-      e.car->setPath(e.path);
+  eventTokens.push_back(eventBus->subscribe<AssignPathEvent>([this](const AssignPathEvent &e) {
+    if (Car *car = this->getCar(e.carId)) {
+      car->setPath(e.path);
     }
   }));
 
@@ -71,9 +192,10 @@ EntityManager::EntityManager(std::shared_ptr<EventBus> bus) : eventBus(bus) {
       if (e.type != SelectionType::GENERAL) {
           this->dashboardVisible = true;
       }
-      
-      for(auto& car : cars) {
-          car->setSelected(car.get() == e.car);
+      this->selection = e;
+
+      for(auto& car : cars.values()) {
+          car->setSelected(car->getId() == e.carId);
       }
   }));
 }
@@ -85,54 +207,478 @@ void EntityManager::update(double dt) {
     world->update(dt);
   }
 
-  // Update Cars
-  // Note: Cars need access to other cars for collision avoidance/logic
-  // Currently Car::updateWithNeighbors takes a vector of unique_ptr<Car>
-  // We might need to refactor Car::updateWithNeighbors to take a raw pointer list or reference to the vector
-  for (auto &car : cars) {
-    car->updateWithNeighbors(dt, &cars);
-  }
+  // Update the awake cars of active chunks; each sees the awake cars of its own and the adjacent chunks
+  // Cars in a main road lane take their IDM leader from the lane lists instead
+  chunks.beginTick(dt);
+  lanes.beginTick();
+  CarFollowingModel model = params.carFollowing;
+  arrivals.clear();
+  chunks.forEachActiveChunk([this, dt, model](ChunkGrid::Chunk &chunk, std::span<const Car *const> neighbors) {
+    for (Car *car : chunk.cars) {
+      bool driving = car->getState() == Car::CarState::DRIVING;
+      const Car *leader = nullptr;
+      if (model == CarFollowingModel::IDM && lanes.findLeader(*car, leader))
+        car->updateWithNeighbors(dt, neighbors, model, leader);
+      else
+        car->updateWithNeighbors(dt, neighbors, model);
+      lanes.observe(car);
+      if (driving && car->getState() == Car::CarState::ALIGNING)
+        arrivals.push_back(car->getId());
+    }
+  });
+  chunks.endTick();
+  lanes.endTick();
+
+  // Reported after the sweep, so listeners see a consistent world
+  for (CarId id : arrivals)
+    eventBus->publish(CarArrivedAtSpotEvent{id});
+
+  pricing.update(dt, params.priceElasticity);
 }
 
-void EntityManager::draw() {
+static double steadyNow() {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void EntityManager::draw(Rectangle view) {
+  PROFILE_ZONE("EntityManager::draw");
+  snapshots.refresh();
+  const RenderSnapshot &snapshot = snapshots.readBuffer();
+  float alpha = snapshot.interpolationAlpha(steadyNow());
+
+  bool culled = view.width > 0.0f && view.height > 0.0f;
+  chunks.setView(view.x, view.x + view.width);
+
   if (world) {
-    world->draw();
+    if (culled)
+      world->draw(view);
+    else
+      world->draw();
   }
 
-  for (const auto &mod : modules) {
-    mod->draw();
+  // Modules from the snapshot too: their spots are the copies taken with the cars
+  for (const ModuleRenderState &mod : snapshot.modules) {
+    const Module &module = *mod.module;
+    if (culled && (module.worldPosition.x > view.x + view.width ||
+                   module.worldPosition.x + module.getWidth() < view.x))
+      continue;
+    module.draw();
+    module.drawSpots(std::span<const SpotRenderState>(snapshot.spots).subspan(mod.firstSpot, mod.spotCount));
   }
 
-  for (const auto &car : cars) {
-    bool showPath = car->isSelected() && this->dashboardVisible;
-    car->draw(showPath);
+  for (const auto &car : snapshot.cars) {
+    Vector2 pos = Vector2Lerp(car.previousPosition, car.position, alpha);
+
+    // Interpolate rotation along the shortest arc
+    float diff = car.rotation - car.previousRotation;
+    while (diff > 180.0f)
+      diff -= 360.0f;
+    while (diff < -180.0f)
+      diff += 360.0f;
+    float rotation = car.previousRotation + diff * alpha;
+
+    if (car.selected && this->dashboardVisible) {
+      Car::drawPath(pos, snapshot.selection.carPath);
+    }
+    Car::drawSprite(car.textureName, pos, rotation);
   }
 
   // Draw Mask last (Foreground)
   if (world) {
-    world->drawOverlay();
+    world->drawOverlay(culled ? view : Rectangle{0, 0, world->getWidth(), world->getHeight()});
     world->drawMask();
   }
 }
 
+void EntityManager::publishSnapshot(double fraction, double tickInterval) {
+  RenderSnapshot &snapshot = snapshots.writeBuffer();
+
+  // Reuse the slot's storage (resize keeps capacity, strings stay in SSO).
+  // With a camera view, only the cars around it are needed for drawing.
+  size_t count = 0;
+  auto capture = [&](const Car &car) {
+    if (count == snapshot.cars.size())
+      snapshot.cars.emplace_back();
+    CarRenderState &out = snapshot.cars[count++];
+    out.id = car.getId();
+    out.previousPosition = car.getPreviousPosition();
+    out.position = car.getPosition();
+    out.previousRotation = car.getPreviousRotation();
+    out.rotation = car.getRotation();
+    out.textureName = car.getTextureName();
+    out.selected = car.isSelected();
+    out.velocity = car.getVelocity();
+    out.type = car.getType();
+    out.state = car.getState();
+    out.priority = car.getPriority();
+    out.batteryLevel = car.getBatteryLevel();
+  };
+
+  snapshot.modules.clear();
+  snapshot.spots.clear();
+  auto captureModule = [&](const Module &mod) {
+    snapshot.modules.push_back({&mod, (uint32_t)snapshot.spots.size(), (uint32_t)mod.getSpotCount()});
+    for (const Spot &spot : mod.getSpots())
+      snapshot.spots.push_back({spot.state, spot.price});
+  };
+
+  float viewMinX, viewMaxX;
+  if (chunks.getView(viewMinX, viewMaxX)) {
+    chunks.forEachCarIn(viewMinX - Config::Chunks::WIDTH, viewMaxX + Config::Chunks::WIDTH, capture);
+    chunks.forEachModuleIn(viewMinX - Config::Chunks::WIDTH, viewMaxX + Config::Chunks::WIDTH, captureModule);
+  } else {
+    for (const auto &car : cars.values())
+      capture(*car);
+    for (const auto &mod : modules)
+      captureModule(*mod);
+  }
+  snapshot.cars.resize(count);
+
+  snapshot.counters = occupancy.getCounters();
+  captureSelection(snapshot.selection);
+
+  snapshot.trackedFound = false;
+  if (const Car *car = getCar(trackedCar)) {
+    snapshot.trackedFound = true;
+    snapshot.tracked.id = car->getId();
+    snapshot.tracked.previousPosition = car->getPreviousPosition();
+    snapshot.tracked.position = car->getPosition();
+  }
+
+  snapshot.publishedAt = steadyNow();
+  snapshot.fraction = fraction;
+  snapshot.tickInterval = tickInterval;
+
+  snapshots.publish();
+}
+
+bool EntityManager::getTrackedCarPosition(Vector2 &position) {
+  snapshots.refresh();
+  const RenderSnapshot &snapshot = snapshots.readBuffer();
+  if (!snapshot.trackedFound)
+    return false;
+  position = Vector2Lerp(snapshot.tracked.previousPosition, snapshot.tracked.position,
+                         snapshot.interpolationAlpha(steadyNow()));
+  return true;
+}
+
+void EntityManager::captureSelection(SelectionView &view) const {
+  view.type = selection.type;
+  view.carFound = false;
+  view.carPath.clear();
+  view.module = selection.module;
+  view.spotIndex = selection.spotIndex;
+
+  if (selection.type == SelectionType::CAR) {
+    // The selected car may have left the map since it was clicked; the handle then fails to resolve
+    if (const Car *car = getCar(selection.carId)) {
+      view.carFound = true;
+      view.car.id = car->getId();
+      view.car.position = car->getPosition();
+      view.car.velocity = car->getVelocity();
+      view.car.type = car->getType();
+      view.car.state = car->getState();
+      view.car.priority = car->getPriority();
+      view.car.batteryLevel = car->getBatteryLevel();
+      for (const auto &wp : car->getWaypoints())
+        view.carPath.push_back(wp.position);
+    }
+  }
+
+  if (selection.module) {
+    view.moduleType = selection.module->getType();
+    view.facilityCounts = selection.module->getSpotCounts();
+    view.priceMultiplier = selection.module->getPriceMultiplier();
+    view.surge = pricing.getSurge(selection.module);
+    view.spot = selection.module->getSpot(selection.spotIndex);
+  }
+}
+
 void EntityManager::setWorld(std::unique_ptr<World> w) { world = std::move(w); }
 
-void EntityManager::addModule(std::unique_ptr<Module> module) { modules.push_back(std::move(module)); }
+void EntityManager::installMap(GeneratedMap &&map) {
+  this->setWorld(std::move(map.world));
 
-void EntityManager::addCar(std::unique_ptr<Car> car) { cars.push_back(std::move(car)); }
+  for (auto &mod : map.modules) {
+    this->addModule(std::move(mod));
+  }
+
+  // Publish WorldBounds
+  if (world) {
+    eventBus->publish(WorldBoundsEvent{world->getWidth(), world->getHeight()});
+  }
+}
+
+void EntityManager::saveMap(const std::string &path) const {
+  if (!world)
+    throw std::runtime_error("No world to save");
+  MapFile::save(path, *world, modules);
+}
+
+void EntityManager::loadMap(const std::string &path) {
+  auto start = std::chrono::steady_clock::now();
+  GeneratedMap map = MapFile::load(path);
+  double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+  Logger::Info("EntityManager: Loaded {} ({} modules) in {:.1f} ms", path, map.modules.size(), ms);
+
+  clear();
+  installMap(std::move(map));
+}
+
+void EntityManager::addModule(std::unique_ptr<Module> module) {
+  occupancy.addFacility(module.get());
+  pricing.addFacility(module.get());
+  chunks.addModule(module.get());
+  if (!lanes.hasRoad() && dynamic_cast<NormalRoad *>(module.get()))
+    lanes.setRoad(module->worldPosition.y);
+  modules.push_back(std::move(module));
+  moduleRevision++;
+}
+
+CarId EntityManager::addCar(std::unique_ptr<Car> car) {
+  Car *carPtr = car.get();
+  CarId id = cars.insert(std::move(car));
+  carPtr->setId(id);
+  chunks.addCar(carPtr);
+  return id;
+}
+
+Car *EntityManager::getCar(CarId id) const {
+  const auto *slot = cars.get(id);
+  return slot ? slot->get() : nullptr;
+}
+
+EntitySelectedEvent EntityManager::pick(Vector2 worldPos) const {
+  EntitySelectedEvent result;
+  result.type = SelectionType::GENERAL;
+
+  // 1. Cars: nearest one within the click radius
+  const float carRadiusSq = Config::Picking::CAR_RADIUS * Config::Picking::CAR_RADIUS;
+  float bestCarSq = carRadiusSq;
+  chunks.forEachCarIn(worldPos.x - Config::Picking::CAR_RADIUS, worldPos.x + Config::Picking::CAR_RADIUS,
+                      [&](const Car &car) {
+                        float dSq = Vector2DistanceSqr(worldPos, car.getPosition());
+                        if (dSq <= bestCarSq) {
+                          bestCarSq = dSq;
+                          result.type = SelectionType::CAR;
+                          result.carId = car.getId();
+                        }
+                      });
+  if (result.type == SelectionType::CAR)
+    return result;
+
+  // 2. Modules: the first one containing the point, 3. narrowed to its nearest spot
+  Module *hit = nullptr;
+  chunks.forEachModuleIn(worldPos.x, worldPos.x, [&](Module &mod) {
+    Rectangle rec = {mod.worldPosition.x, mod.worldPosition.y, mod.getWidth(), mod.getHeight()};
+    if (!hit && CheckCollisionPointRec(worldPos, rec))
+      hit = &mod;
+  });
+  if (!hit)
+    return result;
+
+  result.type = SelectionType::FACILITY;
+  result.module = hit;
+  float bestSpotSq = Config::Picking::SPOT_RADIUS * Config::Picking::SPOT_RADIUS;
+  const std::vector<Spot> &spots = hit->getSpots();
+  for (size_t i = 0; i < spots.size(); i++) {
+    Vector2 spotWorldPos = Vector2Add(hit->worldPosition, spots[i].localPosition);
+    float dSq = Vector2DistanceSqr(worldPos, spotWorldPos);
+    if (dSq < bestSpotSq) {
+      bestSpotSq = dSq;
+      result.type = SelectionType::SPOT;
+      result.spotIndex = (int)i;
+    }
+  }
+  return result;
+}
+
+void EntityManager::pickArea(Rectangle area, std::vector<CarId> &carsOut, std::vector<Module *> &modulesOut) const {
+  carsOut.clear();
+  modulesOut.clear();
+  chunks.forEachCarIn(area.x, area.x + area.width, [&](const Car &car) {
+    if (CheckCollisionPointRec(car.getPosition(), area))
+      carsOut.push_back(car.getId());
+  });
+  chunks.forEachModuleIn(area.x, area.x + area.width, [&](Module &mod) {
+    Rectangle rec = {mod.worldPosition.x, mod.worldPosition.y, mod.getWidth(), mod.getHeight()};
+    if (CheckCollisionRecs(area, rec))
+      modulesOut.push_back(&mod);
+  });
+}
 
 void EntityManager::clear() {
-  for (auto &car : cars) {
-    eventBus->publish(CarDeletedEvent{car.get()});
+  for (auto &car : cars.values()) {
+    eventBus->publish(CarDeletedEvent{car->getId()});
   }
   cars.clear();
+  const auto &stats = carPool.getStats();
+  if (stats.allocations + stats.reuses > 0) {
+    Logger::Info("CarPool: {} allocated, {} reused, {} released", stats.allocations, stats.reuses, stats.releases);
+  }
+  selection = EntitySelectedEvent{};
+  occupancy.reset();
+  pricing.reset();
+  chunks.clear();
+  lanes.clear();
   modules.clear();
+  moduleRevision++;
   world.reset();
 }
 
-void EntityManager::removeCar(Car *car) {
-  if (!car)
+void EntityManager::saveCheckpoint(BinaryWriter &out) {
+  chunks.catchUpSleeping();
+
+  std::unordered_map<const Module *, int32_t> moduleIndex;
+  moduleIndex.reserve(modules.size());
+  uint32_t spotCount = 0;
+  for (size_t i = 0; i < modules.size(); ++i) {
+    moduleIndex[modules[i].get()] = (int32_t)i;
+    spotCount += (uint32_t)modules[i]->getSpotCount();
+  }
+
+  // Layout fingerprint, so a checkpoint is never applied to another map
+  out.write((uint32_t)modules.size());
+  out.write(spotCount);
+  out.write(layoutFingerprint(modules));
+  for (const auto &mod : modules) {
+    for (int i = 0; i < (int)mod->getSpotCount(); ++i)
+      out.write((uint8_t)mod->getSpot(i).state);
+  }
+
+  out.write((uint32_t)cars.size());
+  for (const auto &car : cars.values()) {
+    int32_t facility = -1;
+    if (const Module *parked = car->getParkedFacility()) {
+      auto it = moduleIndex.find(parked);
+      facility = it != moduleIndex.end() ? it->second : -1;
+    }
+    out.write(car->saveState(facility));
+
+    auto path = car->getWaypoints();
+    out.write((uint32_t)path.size());
+    for (const auto &waypoint : path)
+      writeWaypoint(out, waypoint);
+  }
+
+  pricing.saveCheckpoint(out);
+}
+
+EntityManager::CheckpointState EntityManager::readCheckpoint(BinaryReader &in) const {
+  CheckpointState state;
+  uint32_t moduleCount = in.read<uint32_t>();
+  uint32_t spotCount = in.read<uint32_t>();
+  uint64_t fingerprint = in.read<uint64_t>();
+  uint32_t expectedSpots = 0;
+  for (const auto &mod : modules)
+    expectedSpots += (uint32_t)mod->getSpotCount();
+  if (moduleCount != modules.size() || spotCount != expectedSpots || fingerprint != layoutFingerprint(modules))
+    throw std::runtime_error("Checkpoint belongs to a different layout");
+
+  state.spotStates.reserve(spotCount);
+  for (std::byte spot : in.take(spotCount)) {
+    if ((uint8_t)spot > (uint8_t)SpotState::OCCUPIED)
+      throw std::runtime_error("Checkpoint contains an invalid spot state");
+    state.spotStates.push_back((SpotState)spot);
+  }
+
+  // Each car takes at least its snapshot and path length: bound the count before reserving
+  uint32_t carCount = in.read<uint32_t>();
+  if (carCount > in.remaining() / (sizeof(Car::Snapshot) + sizeof(uint32_t)))
+    throw std::runtime_error("Checkpoint is truncated (cars)");
+  state.cars.reserve(carCount);
+  state.pathLengths.reserve(carCount);
+  for (uint32_t i = 0; i < carCount; ++i) {
+    Car::Snapshot snapshot = readCarSnapshot(in);
+    if (snapshot.parkedFacility < -1 || snapshot.parkedFacility >= (int32_t)moduleCount)
+      throw std::runtime_error("Checkpoint car refers to an unknown facility");
+    uint32_t length = in.read<uint32_t>();
+    if ((size_t)length * WAYPOINT_SIZE > in.remaining())
+      throw std::runtime_error("Checkpoint is truncated");
+    for (uint32_t w = 0; w < length; ++w)
+      state.waypoints.push_back(readWaypoint(in));
+    state.cars.push_back(snapshot);
+    state.pathLengths.push_back(length);
+  }
+  state.prices = pricing.readCheckpoint(in);
+  return state;
+}
+
+void EntityManager::restoreCheckpoint(const CheckpointState &state) {
+  // 1. Spot states (straight into the modules: these are not transitions to report)
+  size_t spot = 0;
+  for (auto &mod : modules) {
+    for (int i = 0; i < (int)mod->getSpotCount(); ++i)
+      mod->setSpotState(i, state.spotStates[spot++]);
+  }
+  occupancy.rebuild(modules);
+  pricing.restore(state.prices);
+
+  // 2. Cars: return the current ones to the pool, then rebuild from the snapshots
+  while (!cars.empty())
+    removeCar(cars.handleAt(cars.size() - 1));
+  chunks.clearCars();
+  lanes.clearCars();
+  selection = EntitySelectedEvent{};
+
+  std::vector<Waypoint> path;
+  size_t nextWaypoint = 0;
+  for (size_t i = 0; i < state.cars.size(); ++i) {
+    const Car::Snapshot &snapshot = state.cars[i];
+    const Module *facility = snapshot.parkedFacility >= 0 ? modules[snapshot.parkedFacility].get() : nullptr;
+
+    auto car = carPool.acquire(snapshot.position, world.get(), snapshot.velocity, snapshot.type);
+    car->restoreState(snapshot, facility);
+    auto first = state.waypoints.begin() + nextWaypoint;
+    path.assign(first, first + state.pathLengths[i]);
+    nextWaypoint += state.pathLengths[i];
+    car->setPath(path);
+    addCar(std::move(car));
+  }
+
+  // List the lanes right away: lane leaders and spawn admission should not wait for a tick
+  lanes.beginTick();
+  for (const auto &car : cars.values())
+    lanes.observe(car.get());
+  lanes.endTick();
+
+  eventBus->publish(CheckpointRestoredEvent{});
+}
+
+void EntityManager::setSpotState(Module *module, int spotIndex, SpotState state, float price) {
+  if (!module)
+    return;
+  SpotState previous = module->setSpotState(spotIndex, state);
+  if (previous != state) {
+    eventBus->publish(SpotStateChangedEvent{module, spotIndex, previous, state, price});
+  }
+}
+
+uint64_t EntityManager::computeStateHash() const {
+  StateHasher hasher;
+  for (const auto &module : modules) {
+    for (size_t i = 0; i < module->getSpotCount(); ++i)
+      hasher.add(module->getSpot((int)i).state);
+  }
+  for (const auto &car : cars.values()) {
+    hasher.add(car->getId().index);
+    hasher.add(car->getId().generation);
+    hasher.add(car->getPosition());
+    hasher.add(car->getVelocity());
+    hasher.add(car->getState());
+    hasher.add(car->getBatteryLevel());
+    hasher.add(car->getParkingTimer());
+    hasher.add((uint64_t)car->getWaypoints().size());
+  }
+  return hasher.hash;
+}
+
+void EntityManager::removeCar(CarId id) {
+  if (!cars.contains(id))
     return;
-  eventBus->publish(CarDeletedEvent{car});
-  std::erase_if(cars, [car](const std::unique_ptr<Car> &ptr) { return ptr.get() == car; });
+  eventBus->publish(CarDeletedEvent{id});
+  chunks.removeCar(cars.get(id)->get());
+  lanes.removeCar(cars.get(id)->get());
+  carPool.release(std::move(*cars.get(id)));
+  cars.remove(id);
 }
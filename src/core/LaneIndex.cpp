@@ -0,0 +1,154 @@
+#include "core/LaneIndex.hpp"
+#include "config.hpp"
+#include <cmath>
+
+/**
+ * @file LaneIndex.cpp
+ * @brief Incremental per-lane ordering of the main road.
+ */
+
+void LaneIndex::setRoad(float roadTopY) {
+  float pixelsPerMeter = static_cast<float>(Config::ART_PIXELS_PER_METER);
+  upY = roadTopY + (float)Config::LANE_OFFSET_UP / pixelsPerMeter;
+  downY = roadTopY + (float)Config::LANE_OFFSET_DOWN / pixelsPerMeter;
+  roadSet = true;
+}
+
+void LaneIndex::clear() {
+  clearCars();
+  roadSet = false;
+}
+
+void LaneIndex::clearCars() {
+  for (LaneList &lane : lanes) {
+    lane.cars.clear();
+    lane.joining.clear();
+  }
+  members.clear();
+}
+
+LaneIndex::Membership *LaneIndex::membership(const Car &car) {
+  uint32_t i = car.getId().index;
+  if (i >= members.size())
+    members.resize(i + 1);
+  return &members[i];
+}
+
+const LaneIndex::Membership *LaneIndex::membership(const Car &car) const {
+  uint32_t i = car.getId().index;
+  return i < members.size() ? &members[i] : nullptr;
+}
+
+void LaneIndex::removeCar(const Car *car) {
+  // Leave a hole instead of shifting the list; the next endTick() closes it
+  Membership *m = membership(*car);
+  if (m->lane != NONE)
+    lanes[m->lane].cars[m->slot] = nullptr;
+  for (LaneList &lane : lanes)
+    std::erase(lane.joining, car);
+  *m = Membership{};
+}
+
+int LaneIndex::classify(const Car &car) const {
+  if (!roadSet || (car.getState() != Car::CarState::DRIVING && car.getState() != Car::CarState::EXITING))
+    return NONE;
+
+  // Heading: the velocity, or the sprite direction when standing
+  Vector2 v = car.getVelocity();
+  float headingX = v.x;
+  float headingY = v.y;
+  if (v.x * v.x + v.y * v.y < 0.01f) {
+    float radians = (car.getRotation() - 90.0f) * DEG2RAD;
+    headingX = cosf(radians);
+    headingY = sinf(radians);
+  }
+  if (std::fabs(headingX) <= std::fabs(headingY))
+    return NONE;
+
+  Lane lane = headingX > 0.0f ? Lane::DOWN : Lane::UP;
+  if (std::fabs(car.getPosition().y - laneY(lane)) >= Config::CarAI::Idm::LANE_HALF_WIDTH)
+    return NONE;
+  return index(lane);
+}
+
+void LaneIndex::beginTick() { tick++; }
+
+void LaneIndex::observe(Car *car) {
+  Membership *m = membership(*car);
+  m->seenTick = tick;
+  m->seenLane = classify(*car);
+  if (m->seenLane != NONE && m->seenLane != m->lane)
+    lanes[m->seenLane].joining.push_back(car);
+}
+
+void LaneIndex::endTick() {
+  // Drop the cars that left a lane or were not simulated, keeping the order of the rest. Every
+  // lane is compacted before any newcomer is listed, so a car that switched lanes during the tick
+  // is not unlisted from its new lane by the drop of its old one
+  for (int l = 0; l < (int)lanes.size(); ++l) {
+    std::vector<Car *> &list = lanes[l].cars;
+    size_t kept = 0;
+    for (Car *car : list) {
+      if (!car)
+        continue;
+      Membership *m = membership(*car);
+      if (m->seenTick == tick && m->seenLane == l)
+        list[kept++] = car;
+      else if (m->lane == l)
+        m->lane = NONE;
+    }
+    list.resize(kept);
+  }
+
+  for (int l = 0; l < (int)lanes.size(); ++l) {
+    std::vector<Car *> &list = lanes[l].cars;
+    for (Car *car : lanes[l].joining) {
+      list.push_back(car);
+      membership(*car)->lane = l;
+    }
+    lanes[l].joining.clear();
+
+    // Insertion sort: O(n) for the almost sorted list of a lane
+    for (size_t i = 1; i < list.size(); ++i) {
+      Car *car = list[i];
+      float x = car->getPosition().x;
+      size_t j = i;
+      for (; j > 0 && list[j - 1]->getPosition().x > x; --j)
+        list[j] = list[j - 1];
+      list[j] = car;
+    }
+    for (size_t s = 0; s < list.size(); ++s)
+      membership(*list[s])->slot = (uint32_t)s;
+  }
+}
+
+bool LaneIndex::findLeader(const Car &car, const Car *&leader) const {
+  const Membership *m = membership(car);
+  if (!m || m->lane == NONE)
+    return false;
+  // DOWN drives toward +X (next slot), UP toward -X (previous slot)
+  leader = step(m->lane, m->slot, m->lane == index(Lane::DOWN) ? 1 : -1);
+  return true;
+}
+
+const Car *LaneIndex::findFollower(const Car &car) const {
+  const Membership *m = membership(car);
+  if (!m || m->lane == NONE)
+    return nullptr;
+  return step(m->lane, m->slot, m->lane == index(Lane::DOWN) ? -1 : 1);
+}
+
+const Car *LaneIndex::lastInLane(Lane lane) const {
+  const std::vector<Car *> &list = lanes[index(lane)].cars;
+  return lane == Lane::DOWN ? step(index(lane), -1, 1) : step(index(lane), (long)list.size(), -1);
+}
+
+const Car *LaneIndex::step(int lane, long slot, int direction) const {
+  const std::vector<Car *> &list = lanes[lane].cars;
+  // Skips the holes of cars removed during this tick
+  for (long s = slot + direction; s >= 0 && s < (long)list.size(); s += direction) {
+    if (list[s])
+      return list[s];
+  }
+  return nullptr;
+}
@@ -0,0 +1,148 @@
+#include "core/LaunchOptions.hpp"
+#include "config.hpp"
+#include "core/Logger.hpp"
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <stdexcept>
+
+/**
+ * @file LaunchOptions.cpp
+ * @brief Implementation of the startup option parser.
+ */
+
+namespace {
+/**
+ * @brief Maps an option / config key to the MapConfig field it sets (nullptr if unknown).
+ *
+ * Command line uses dashes, config files underscores; both spellings are accepted everywhere.
+ */
+int *facilityCountField(MapConfig &config, std::string key) {
+  std::replace(key.begin(), key.end(), '_', '-');
+  if (key == "small-parking")
+    return &config.smallParkingCount;
+  if (key == "large-parking")
+    return &config.largeParkingCount;
+  if (key == "small-charging")
+    return &config.smallChargingCount;
+  if (key == "large-charging")
+    return &config.largeChargingCount;
+  return nullptr;
+}
+
+int parseCount(const std::string &key, const std::string &value) {
+  int count = 0;
+  auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), count);
+  if (error != std::errc() || end != value.data() + value.size() || count < 0)
+    throw std::runtime_error("Invalid value for " + key + ": '" + value + "'");
+  if (count > Config::Map::MAX_PER_TYPE) {
+    Logger::Warn("LaunchOptions: {} clamped to {}", key, Config::Map::MAX_PER_TYPE);
+    count = Config::Map::MAX_PER_TYPE;
+  }
+  return count;
+}
+
+std::string trim(const std::string &s) {
+  size_t begin = s.find_first_not_of(" \t\r");
+  if (begin == std::string::npos)
+    return "";
+  size_t end = s.find_last_not_of(" \t\r");
+  return s.substr(begin, end - begin + 1);
+}
+
+// All counts start at 0 when a custom map is given; MapConfig's defaults are for the UI
+MapConfig emptyMapConfig() { return MapConfig{0, 0, 0, 0, {}}; }
+} // namespace
+
+LaunchOptions LaunchOptions::parse(int argc, const char *const *argv) {
+  std::vector<std::string> args;
+  for (int i = 1; i < argc; ++i)
+    args.emplace_back(argv[i]);
+  return parse(args);
+}
+
+LaunchOptions LaunchOptions::parse(const std::vector<std::string> &args) {
+  LaunchOptions options;
+  MapConfig config = emptyMapConfig();
+  bool hasFile = false;
+  std::vector<std::pair<std::string, int>> overrides; // Applied after the file so the command line wins
+
+  for (size_t i = 0; i < args.size(); ++i) {
+    const std::string &arg = args[i];
+    if (arg.rfind("--", 0) != 0)
+      throw std::runtime_error("Unexpected argument: " + arg);
+
+    // Accept both --key=value and --key value
+    std::string key = arg.substr(2);
+    std::string value;
+    size_t eq = key.find('=');
+    if (eq != std::string::npos) {
+      value = key.substr(eq + 1);
+      key = key.substr(0, eq);
+    }
+
+    bool isMapConfig = (key == "map-config");
+    bool isMapFile = (key == "map");
+    bool isReplay = (key == "replay");
+    if (!isMapConfig && !isMapFile && !isReplay && !facilityCountField(config, key))
+      throw std::runtime_error("Unknown option: --" + key);
+
+    if (eq == std::string::npos) {
+      if (i + 1 >= args.size())
+        throw std::runtime_error("Missing value for --" + key);
+      value = args[++i];
+    }
+
+    if (isMapConfig) {
+      loadMapConfigFile(value, config);
+      hasFile = true;
+    } else if (isMapFile) {
+      config.mapFile = value;
+      hasFile = true;
+    } else if (isReplay) {
+      options.replayPath = value;
+    } else {
+      overrides.emplace_back(key, parseCount("--" + key, value));
+    }
+  }
+
+  if (!hasFile && overrides.empty())
+    return options;
+
+  for (const auto &[key, count] : overrides)
+    *facilityCountField(config, key) = count;
+  options.mapConfig = config;
+  if (!config.mapFile.empty()) {
+    Logger::Info("LaunchOptions: Loading map {}", config.mapFile);
+    return options;
+  }
+  Logger::Info("LaunchOptions: Custom map [{} small parking, {} large parking, {} small charging, {} large charging]",
+               config.smallParkingCount, config.largeParkingCount, config.smallChargingCount,
+               config.largeChargingCount);
+  return options;
+}
+
+void LaunchOptions::loadMapConfigFile(const std::string &path, MapConfig &config) {
+  std::ifstream in(path);
+  if (!in)
+    throw std::runtime_error("Could not open map config: " + path);
+
+  std::string line;
+  int lineNumber = 0;
+  while (std::getline(in, line)) {
+    lineNumber++;
+    line = trim(line.substr(0, line.find('#')));
+    if (line.empty())
+      continue;
+
+    size_t eq = line.find('=');
+    if (eq == std::string::npos)
+      throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": expected 'key = value'");
+
+    std::string key = trim(line.substr(0, eq));
+    int *field = facilityCountField(config, key);
+    if (!field)
+      throw std::runtime_error(path + ":" + std::to_string(lineNumber) + ": unknown key '" + key + "'");
+    *field = parseCount(key, trim(line.substr(eq + 1)));
+  }
+}
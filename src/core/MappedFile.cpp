@@ -0,0 +1,61 @@
+#include "core/MappedFile.hpp"
+#include <fstream>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define PARKLOGIC_HAS_MMAP 1
+#endif
+
+/**
+ * @file MappedFile.cpp
+ * @brief Implementation of the read-only file mapping.
+ */
+
+MappedFile::MappedFile(const std::string &path) {
+#ifdef PARKLOGIC_HAS_MMAP
+  int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throw std::runtime_error("Could not open " + path);
+
+  struct stat info {};
+  if (::fstat(fd, &info) != 0) {
+    ::close(fd);
+    throw std::runtime_error("Could not stat " + path);
+  }
+
+  size = (size_t)info.st_size;
+  if (size > 0) {
+    void *address = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (address == MAP_FAILED) {
+      ::close(fd);
+      throw std::runtime_error("Could not map " + path);
+    }
+    data = static_cast<const std::byte *>(address);
+    mapped = true;
+  }
+  // The mapping stays valid after the descriptor is closed
+  ::close(fd);
+#else
+  std::ifstream in(path, std::ios::binary | std::ios::ate);
+  if (!in)
+    throw std::runtime_error("Could not open " + path);
+  fallback.resize((size_t)in.tellg());
+  in.seekg(0);
+  in.read(reinterpret_cast<char *>(fallback.data()), (std::streamsize)fallback.size());
+  if (!in)
+    throw std::runtime_error("Could not read " + path);
+  data = fallback.data();
+  size = fallback.size();
+#endif
+}
+
+MappedFile::~MappedFile() {
+#ifdef PARKLOGIC_HAS_MMAP
+  if (mapped)
+    ::munmap(const_cast<std::byte *>(data), size);
+#endif
+}
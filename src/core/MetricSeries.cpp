@@ -0,0 +1,80 @@
+#include "core/MetricSeries.hpp"
+#include <algorithm>
+
+/**
+ * @file MetricSeries.cpp
+ * @brief Implementation of the multi-resolution ring buffers.
+ */
+
+void MetricSeries::Bucket::add(const Bucket &other) {
+  if (other.count == 0)
+    return;
+  if (count == 0) {
+    *this = other;
+    return;
+  }
+  min = std::min(min, other.min);
+  max = std::max(max, other.max);
+  sum += other.sum;
+  count += other.count;
+}
+
+MetricSeries::MetricSeries(size_t capacity, size_t tiers, size_t factor)
+    : bucketsPerTier(std::max<size_t>(capacity, 1)), factor(std::max<size_t>(factor, 2)) {
+  rings.resize(std::max<size_t>(tiers, 1));
+  for (auto &ring : rings) {
+    ring.buckets.resize(bucketsPerTier);
+  }
+}
+
+void MetricSeries::add(float value) {
+  lastValue = value;
+  push(0, Bucket{value, value, value, 1});
+}
+
+void MetricSeries::push(size_t tier, const Bucket &bucket) {
+  Ring &ring = rings[tier];
+  ring.buckets[ring.head] = bucket;
+  ring.head = (ring.head + 1) % bucketsPerTier;
+  ring.size = std::min(ring.size + 1, bucketsPerTier);
+
+  // Fold into the next (coarser) tier
+  if (tier + 1 >= rings.size())
+    return;
+  Ring &next = rings[tier + 1];
+  next.pending.add(bucket);
+  if (++next.pendingParts == factor) {
+    Bucket completed = next.pending;
+    next.pending = {};
+    next.pendingParts = 0;
+    push(tier + 1, completed);
+  }
+}
+
+void MetricSeries::copyTier(size_t tier, std::vector<Bucket> &out) const {
+  out.clear();
+  if (tier >= rings.size())
+    return;
+  const Ring &ring = rings[tier];
+  size_t start = (ring.head + bucketsPerTier - ring.size) % bucketsPerTier;
+  for (size_t i = 0; i < ring.size; ++i) {
+    out.push_back(ring.buckets[(start + i) % bucketsPerTier]);
+  }
+}
+
+size_t MetricSeries::samplesPerBucket(size_t tier) const {
+  size_t samples = 1;
+  for (size_t i = 0; i < tier; ++i)
+    samples *= factor;
+  return samples;
+}
+
+void MetricSeries::clear() {
+  for (auto &ring : rings) {
+    ring.head = 0;
+    ring.size = 0;
+    ring.pending = {};
+    ring.pendingParts = 0;
+  }
+  lastValue = 0.0f;
+}
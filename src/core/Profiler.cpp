@@ -0,0 +1,167 @@
+#include "core/Profiler.hpp"
+#include "config.hpp"
+#include <algorithm>
+#include <chrono>
+
+/**
+ * @file Profiler.cpp
+ * @brief Implementation of the zone profiler.
+ */
+
+uint64_t Profiler::now() {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+uint32_t &Profiler::threadDepth() {
+  thread_local uint32_t depth = 0;
+  return depth;
+}
+
+Profiler::ThreadSlot::~ThreadSlot() {
+  if (buffer)
+    buffer->inUse.store(false, std::memory_order_release);
+}
+
+Profiler::ThreadBuffer &Profiler::threadBuffer() {
+  thread_local ThreadSlot slot;
+  if (slot.buffer)
+    return *slot.buffer;
+
+  // First zone on this thread: claim a free buffer or create one (the only locked path)
+  std::scoped_lock lock(registryMutex);
+  for (auto &buffer : buffers) {
+    bool expected = false;
+    if (buffer->inUse.compare_exchange_strong(expected, true)) {
+      buffer->threadId = nextThreadId++;
+      buffer->written.store(0, std::memory_order_release);
+      slot.buffer = buffer.get();
+      return *slot.buffer;
+    }
+  }
+
+  auto buffer = std::make_unique<ThreadBuffer>();
+  buffer->events = std::vector<EventSlot>(Config::Profiler::EVENTS_PER_THREAD);
+  buffer->inUse.store(true);
+  buffer->threadId = nextThreadId++;
+  slot.buffer = buffer.get();
+  buffers.push_back(std::move(buffer));
+  return *slot.buffer;
+}
+
+void Profiler::record(const char *name, const char *detail, uint64_t start, uint64_t end, uint32_t depth) {
+  ThreadBuffer &buffer = threadBuffer();
+  uint64_t index = buffer.written.load(std::memory_order_relaxed);
+  // Orders the earlier write index before the slot stores: a reader that sees any of them also
+  // sees written >= index afterwards, and drops the slot as lapped
+  std::atomic_thread_fence(std::memory_order_release);
+  EventSlot &slot = buffer.events[index % buffer.events.size()];
+  slot.name.store(name, std::memory_order_relaxed);
+  slot.detail.store(detail, std::memory_order_relaxed);
+  slot.start.store(start, std::memory_order_relaxed);
+  slot.end.store(end, std::memory_order_relaxed);
+  slot.depth.store(depth, std::memory_order_relaxed);
+  buffer.written.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::copyEvents(const ThreadBuffer &buffer, std::vector<ZoneEvent> &out) const {
+  const uint64_t capacity = buffer.events.size();
+  uint64_t end = buffer.written.load(std::memory_order_acquire);
+  uint64_t begin = end > capacity ? end - capacity : 0;
+
+  size_t firstOut = out.size();
+  for (uint64_t i = begin; i < end; ++i) {
+    const EventSlot &slot = buffer.events[i % capacity];
+    out.push_back({slot.name.load(std::memory_order_relaxed), slot.detail.load(std::memory_order_relaxed),
+                   slot.start.load(std::memory_order_relaxed), slot.end.load(std::memory_order_relaxed),
+                   slot.depth.load(std::memory_order_relaxed)});
+  }
+
+  // Entries the writer overwrote while we were copying are unreliable: drop them. With `after`
+  // events published, event `after` may be half written into the slot of event after - capacity,
+  // so that one is dropped too.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  uint64_t after = buffer.written.load(std::memory_order_relaxed);
+  uint64_t safeBegin = after >= capacity ? after - capacity + 1 : 0;
+  if (safeBegin > begin) {
+    size_t drop = static_cast<size_t>(std::min(safeBegin - begin, end - begin));
+    out.erase(out.begin() + firstOut, out.begin() + firstOut + drop);
+  }
+}
+
+void Profiler::markFrame() {
+  uint64_t frameEnd = now();
+  if (frameStart == 0) {
+    frameStart = frameEnd;
+    return;
+  }
+
+  scratch.clear();
+  {
+    std::scoped_lock lock(registryMutex);
+    for (const auto &buffer : buffers) {
+      copyEvents(*buffer, scratch);
+    }
+  }
+
+  frameSummary.clear();
+  for (const auto &e : scratch) {
+    if (e.end < frameStart || e.end >= frameEnd)
+      continue;
+    auto it = std::find_if(frameSummary.begin(), frameSummary.end(),
+                           [&](const ZoneSummary &s) { return s.name == e.name; });
+    if (it == frameSummary.end()) {
+      frameSummary.push_back({e.name, 0.0, 0});
+      it = frameSummary.end() - 1;
+    }
+    it->totalMs += (double)(e.end - e.start) / 1e6;
+    it->calls++;
+  }
+  std::sort(frameSummary.begin(), frameSummary.end(),
+            [](const ZoneSummary &a, const ZoneSummary &b) { return a.totalMs > b.totalMs; });
+
+  frameMs = (double)(frameEnd - frameStart) / 1e6;
+  frameStart = frameEnd;
+}
+
+static void writeJsonString(std::ostream &out, const char *s) {
+  out << '"';
+  for (; s && *s; ++s) {
+    if (*s == '"' || *s == '\\')
+      out << '\\';
+    out << *s;
+  }
+  out << '"';
+}
+
+void Profiler::writeChromeTrace(std::ostream &out) {
+  std::vector<ZoneEvent> events;
+  std::vector<uint32_t> threadIds;
+  {
+    std::scoped_lock lock(registryMutex);
+    for (const auto &buffer : buffers) {
+      copyEvents(*buffer, events);
+      threadIds.resize(events.size(), buffer->threadId);
+    }
+  }
+
+  // Complete events ("ph":"X"), timestamps in microseconds
+  out << "{\"traceEvents\":[";
+  for (size_t i = 0; i < events.size(); ++i) {
+    const ZoneEvent &e = events[i];
+    if (i > 0)
+      out << ',';
+    out << "\n{\"name\":";
+    writeJsonString(out, e.name);
+    out << ",\"cat\":\"parklogic\",\"ph\":\"X\",\"pid\":1,\"tid\":" << threadIds[i]
+        << ",\"ts\":" << (double)e.start / 1000.0 << ",\"dur\":" << (double)(e.end - e.start) / 1000.0;
+    if (e.detail) {
+      out << ",\"args\":{\"detail\":";
+      writeJsonString(out, e.detail);
+      out << '}';
+    }
+    out << '}';
+  }
+  out << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
@@ -0,0 +1,360 @@
+#include "core/Replay.hpp"
+#include "config.hpp"
+#include "core/BinaryIO.hpp"
+#include "core/EntityManager.hpp"
+#include "core/Logger.hpp"
+#include "core/MappedFile.hpp"
+#include "systems/TrafficSystem.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+/**
+ * @file Replay.cpp
+ * @brief Implementation of session recording and headless replay.
+ */
+
+namespace {
+constexpr char MAGIC[8] = {'P', 'L', 'K', 'R', 'E', 'P', 'L', 'Y'};
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t byteOrder;
+  uint64_t seed;
+  uint64_t tickCount;
+  uint64_t entryCount;
+  uint64_t hashCount;
+  uint32_t hashInterval;
+  uint32_t mapFileLength;
+  int32_t smallParking;
+  int32_t largeParking;
+  int32_t smallCharging;
+  int32_t largeCharging;
+};
+static_assert(sizeof(Header) == 72);
+
+/**
+ * @brief Throws unless @p count records of @p recordSize bytes are left (checked before reserving).
+ */
+void requireRecords(const BinaryReader &in, uint64_t count, size_t recordSize, const char *what) {
+  if (count > in.remaining() / recordSize)
+    throw std::runtime_error(std::string("Replay is truncated (") + what + ")");
+}
+
+/// Bytes writeParams() writes: eight floats and two enums as int32.
+constexpr size_t PARAMS_SIZE = 8 * sizeof(float) + 2 * sizeof(int32_t);
+static_assert(sizeof(SimulationParams) == PARAMS_SIZE,
+              "SimulationParams changed: update writeParams() / readParams() and bump ReplayRecording::VERSION");
+
+/**
+ * @brief Writes the params field by field, so the file does not depend on the struct's layout.
+ */
+void writeParams(BinaryWriter &out, const SimulationParams &p) {
+  out.write(p.batteryLowThreshold);
+  out.write(p.batteryHighThreshold);
+  out.write(p.batteryExitThreshold);
+  out.write(p.batteryForceExitThreshold);
+  out.write(p.chargingRate);
+  out.write(p.parkingMinTime);
+  out.write(p.parkingMaxTime);
+  out.write((int32_t)p.carFollowing);
+  out.write((int32_t)p.spotAssignment);
+  out.write(p.priceElasticity);
+}
+
+/**
+ * @brief Reads what writeParams() wrote.
+ * @throws std::runtime_error if a value is not finite or a parking time or an enum is out of range.
+ */
+SimulationParams readParams(BinaryReader &in) {
+  auto number = [&in](const char *name) {
+    float value = in.read<float>();
+    if (!std::isfinite(value))
+      throw std::runtime_error(std::string("Replay has an invalid ") + name);
+    return value;
+  };
+  auto choice = [&in](const char *name, int32_t last) {
+    int32_t value = in.read<int32_t>();
+    if (value < 0 || value > last)
+      throw std::runtime_error(std::string("Replay has an invalid ") + name + " " + std::to_string(value));
+    return value;
+  };
+
+  SimulationParams p;
+  p.batteryLowThreshold = number("battery low threshold");
+  p.batteryHighThreshold = number("battery high threshold");
+  p.batteryExitThreshold = number("battery exit threshold");
+  p.batteryForceExitThreshold = number("battery force exit threshold");
+  p.chargingRate = number("charging rate");
+  p.parkingMinTime = number("parking min time");
+  p.parkingMaxTime = number("parking max time");
+  for (float time : {p.parkingMinTime, p.parkingMaxTime}) {
+    if (time < 0.0f || time > Config::MAX_PARKING_TIME)
+      throw std::runtime_error("Replay has an invalid parking time");
+  }
+  p.carFollowing = (CarFollowingModel)choice("car following model", (int32_t)CarFollowingModel::IDM);
+  p.spotAssignment = (SpotAssignmentMode)choice("spot assignment mode", (int32_t)SpotAssignmentMode::BATCH);
+  p.priceElasticity = number("price elasticity");
+  return p;
+}
+
+/**
+ * @throws std::runtime_error if a field the player interprets is out of range.
+ */
+void validateEntry(const ReplayEntry &entry) {
+  if ((uint32_t)entry.kind >= (uint32_t)ReplayEventKind::COUNT)
+    throw std::runtime_error("Replay has an unknown event kind " + std::to_string((uint32_t)entry.kind));
+  if (entry.kind == ReplayEventKind::SELECTION &&
+      (entry.selectionType < 0 || entry.selectionType > (int32_t)SelectionType::GENERAL))
+    throw std::runtime_error("Replay has an invalid selection type " + std::to_string(entry.selectionType));
+  if (entry.kind == ReplayEventKind::TICK_LENGTH && !(entry.value >= 0.0 && entry.value <= 1.0))
+    throw std::runtime_error("Replay has an invalid tick length");
+  if ((entry.kind == ReplayEventKind::SPEED_CHANGED || entry.kind == ReplayEventKind::VIEW) &&
+      !(std::isfinite(entry.value) && std::isfinite(entry.value2)))
+    throw std::runtime_error("Replay has a non-finite event value");
+}
+} // namespace
+
+// --- File format ---
+
+void ReplayRecording::saveTo(const std::string &path) const {
+  BinaryWriter out;
+  out.reserve(sizeof(Header) + PARAMS_SIZE + map.mapFile.size() + entries.size() * sizeof(ReplayEntry) +
+              hashes.size() * sizeof(ReplayHash));
+
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.byteOrder = BYTE_ORDER_MARK;
+  header.seed = seed;
+  header.tickCount = tickCount;
+  header.entryCount = entries.size();
+  header.hashCount = hashes.size();
+  header.hashInterval = hashInterval;
+  header.mapFileLength = (uint32_t)map.mapFile.size();
+  header.smallParking = map.smallParkingCount;
+  header.largeParking = map.largeParkingCount;
+  header.smallCharging = map.smallChargingCount;
+  header.largeCharging = map.largeChargingCount;
+  out.write(header);
+  writeParams(out, params);
+
+  out.writeArray(std::span<const char>(map.mapFile));
+  out.writeArray(std::span<const ReplayEntry>(entries));
+  out.writeArray(std::span<const ReplayHash>(hashes));
+  out.saveTo(path);
+}
+
+ReplayRecording ReplayRecording::loadFrom(const std::string &path) {
+  MappedFile file(path);
+  BinaryReader in(file.bytes());
+
+  auto header = in.read<Header>();
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    throw std::runtime_error("Not a ParkLogic replay: " + path);
+  if (header.byteOrder != BYTE_ORDER_MARK)
+    throw std::runtime_error("Replay was written on a machine with a different byte order");
+  if (header.version != VERSION)
+    throw std::runtime_error("Unsupported replay version " + std::to_string(header.version));
+
+  ReplayRecording recording;
+  recording.seed = header.seed;
+  recording.tickCount = header.tickCount;
+  recording.hashInterval = header.hashInterval;
+  recording.map = MapConfig{header.smallParking, header.largeParking, header.smallCharging, header.largeCharging, {}};
+  recording.params = readParams(in);
+
+  auto name = in.take(header.mapFileLength);
+  recording.map.mapFile.assign(reinterpret_cast<const char *>(name.data()), name.size());
+
+  requireRecords(in, header.entryCount, sizeof(ReplayEntry), "events");
+  recording.entries.reserve(header.entryCount);
+  for (uint64_t i = 0; i < header.entryCount; ++i) {
+    auto entry = in.read<ReplayEntry>();
+    validateEntry(entry);
+    if (entry.tick > recording.tickCount || (i > 0 && entry.tick < recording.entries.back().tick))
+      throw std::runtime_error("Replay events are out of order");
+    recording.entries.push_back(entry);
+  }
+
+  requireRecords(in, header.hashCount, sizeof(ReplayHash), "hashes");
+  recording.hashes.reserve(header.hashCount);
+  for (uint64_t i = 0; i < header.hashCount; ++i) {
+    auto hash = in.read<ReplayHash>();
+    if (hash.tick > recording.tickCount || (i > 0 && hash.tick <= recording.hashes.back().tick))
+      throw std::runtime_error("Replay hashes are out of order");
+    recording.hashes.push_back(hash);
+  }
+
+  if (in.remaining() != 0)
+    throw std::runtime_error("Replay has trailing data");
+  return recording;
+}
+
+// --- Recorder ---
+
+ReplayRecorder::ReplayRecorder(std::shared_ptr<EventBus> bus, EntityManager &entityManager, uint64_t seed,
+                               const MapConfig &map)
+    : eventBus(bus), entityManager(entityManager) {
+  recording.seed = seed;
+  recording.map = map;
+  recording.params = entityManager.getParams();
+
+  eventTokens.push_back(eventBus->subscribe<SpawnCarRequestEvent>(
+      [this](const SpawnCarRequestEvent &) { record(ReplayEventKind::SPAWN_REQUEST); }));
+  eventTokens.push_back(eventBus->subscribe<CycleAutoSpawnLevelEvent>(
+      [this](const CycleAutoSpawnLevelEvent &) { record(ReplayEventKind::CYCLE_SPAWN_LEVEL); }));
+  eventTokens.push_back(eventBus->subscribe<SimulationSpeedChangedEvent>(
+      [this](const SimulationSpeedChangedEvent &e) { record(ReplayEventKind::SPEED_CHANGED, e.speedMultiplier); }));
+  eventTokens.push_back(
+      eventBus->subscribe<GamePausedEvent>([this](const GamePausedEvent &) { record(ReplayEventKind::PAUSED); }));
+  eventTokens.push_back(
+      eventBus->subscribe<GameResumedEvent>([this](const GameResumedEvent &) { record(ReplayEventKind::RESUMED); }));
+  eventTokens.push_back(eventBus->subscribe<EntitySelectedEvent>(
+      [this](const EntitySelectedEvent &e) { recordSelection(e); }));
+  eventTokens.push_back(eventBus->subscribe<GameUpdateEvent>([this](const GameUpdateEvent &e) { onTick(e.dt); }));
+
+  eventTokens.push_back(eventBus->subscribe<CheckpointRestoredEvent>([this](const CheckpointRestoredEvent &) {
+    if (active)
+      Logger::Warn("ReplayRecorder: Checkpoint restored, recording stopped after {} ticks", recording.tickCount);
+    active = false;
+  }));
+}
+
+void ReplayRecorder::record(ReplayEventKind kind, double value, double value2) {
+  if (!active)
+    return;
+  ReplayEntry entry;
+  entry.tick = recording.tickCount;
+  entry.kind = kind;
+  entry.value = value;
+  entry.value2 = value2;
+  recording.entries.push_back(entry);
+}
+
+void ReplayRecorder::recordSelection(const EntitySelectedEvent &e) {
+  if (!active)
+    return;
+  ReplayEntry entry;
+  entry.tick = recording.tickCount;
+  entry.kind = ReplayEventKind::SELECTION;
+  entry.selectionType = (int32_t)e.type;
+  entry.carId = e.carId;
+  entry.spotIndex = e.spotIndex;
+  if (e.module) {
+    const auto &modules = entityManager.getModules();
+    auto it = std::find_if(modules.begin(), modules.end(), [&](const auto &m) { return m.get() == e.module; });
+    if (it != modules.end())
+      entry.moduleIndex = (int32_t)(it - modules.begin());
+  }
+  recording.entries.push_back(entry);
+}
+
+void ReplayRecorder::onTick(double dt) {
+  if (!active)
+    return;
+
+  // Inputs of the tick that just ran, recorded as if injected right before it
+  if (dt != lastTickLength) {
+    record(ReplayEventKind::TICK_LENGTH, dt);
+    lastTickLength = dt;
+  }
+  float minX, maxX;
+  entityManager.getChunkGrid().getTickView(minX, maxX);
+  if (minX != lastViewMinX || maxX != lastViewMaxX) {
+    record(ReplayEventKind::VIEW, minX, maxX);
+    lastViewMinX = minX;
+    lastViewMaxX = maxX;
+  }
+
+  recording.tickCount++;
+  if (recording.hashInterval > 0 && recording.tickCount % recording.hashInterval == 0)
+    recording.hashes.push_back({recording.tickCount, entityManager.computeStateHash()});
+}
+
+// --- Player ---
+
+ReplayResult ReplayPlayer::play(const ReplayRecording &recording) {
+  auto start = std::chrono::steady_clock::now();
+
+  auto bus = std::make_shared<EventBus>();
+  EntityManager entityManager(bus, recording.params);
+  TrafficSystem trafficSystem(bus, entityManager);
+  entityManager.getRandom().reseed(recording.seed);
+  bus->publish(GenerateWorldEvent{recording.map});
+
+  const auto &modules = entityManager.getModules();
+  auto apply = [&](const ReplayEntry &entry, double &dt) {
+    switch (entry.kind) {
+    case ReplayEventKind::SPAWN_REQUEST:
+      bus->publish(SpawnCarRequestEvent{});
+      break;
+    case ReplayEventKind::CYCLE_SPAWN_LEVEL:
+      bus->publish(CycleAutoSpawnLevelEvent{});
+      break;
+    case ReplayEventKind::SPEED_CHANGED:
+      bus->publish(SimulationSpeedChangedEvent{entry.value});
+      break;
+    case ReplayEventKind::PAUSED:
+      bus->publish(GamePausedEvent{});
+      break;
+    case ReplayEventKind::RESUMED:
+      bus->publish(GameResumedEvent{});
+      break;
+    case ReplayEventKind::SELECTION: {
+      EntitySelectedEvent selection;
+      selection.type = (SelectionType)entry.selectionType;
+      selection.carId = entry.carId;
+      selection.spotIndex = entry.spotIndex;
+      if (entry.moduleIndex >= 0) {
+        if ((size_t)entry.moduleIndex >= modules.size())
+          throw std::runtime_error("Replay selects facility " + std::to_string(entry.moduleIndex) +
+                                   ", the layout has " + std::to_string(modules.size()) + " modules");
+        selection.module = modules[entry.moduleIndex].get();
+      }
+      bus->publish(selection);
+      break;
+    }
+    case ReplayEventKind::VIEW:
+      entityManager.setView((float)entry.value, (float)entry.value2);
+      break;
+    case ReplayEventKind::TICK_LENGTH:
+      dt = entry.value;
+      break;
+    case ReplayEventKind::COUNT:
+      break;
+    }
+  };
+
+  ReplayResult result;
+  double dt = Config::FIXED_DELTA_TIME;
+  size_t nextEntry = 0;
+  size_t nextHash = 0;
+  for (uint64_t tick = 0; tick < recording.tickCount; ++tick) {
+    for (; nextEntry < recording.entries.size() && recording.entries[nextEntry].tick <= tick; ++nextEntry)
+      apply(recording.entries[nextEntry], dt);
+
+    bus->publish(GameUpdateEvent{dt});
+    result.ticks = tick + 1;
+
+    if (nextHash < recording.hashes.size() && recording.hashes[nextHash].tick == result.ticks) {
+      uint64_t actual = entityManager.computeStateHash();
+      if (actual != recording.hashes[nextHash].hash) {
+        result.diverged = true;
+        result.divergedAtTick = result.ticks;
+        result.expectedHash = recording.hashes[nextHash].hash;
+        result.actualHash = actual;
+        break;
+      }
+      result.hashesChecked++;
+      nextHash++;
+    }
+  }
+
+  result.wallSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  return result;
+}
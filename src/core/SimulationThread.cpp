@@ -0,0 +1,80 @@
+#include "core/SimulationThread.hpp"
+#include "config.hpp"
+#include "core/Logger.hpp"
+#include "core/Profiler.hpp"
+#include <algorithm>
+#include <chrono>
+
+/**
+ * @file SimulationThread.cpp
+ * @brief Implementation of the dedicated simulation thread.
+ */
+
+SimulationThread::SimulationThread(std::function<void(double)> tickFn, std::function<void(double, double)> publishFn)
+    : tick(std::move(tickFn)), publish(std::move(publishFn)) {}
+
+SimulationThread::~SimulationThread() { stop(); }
+
+void SimulationThread::start() {
+  if (running.exchange(true))
+    return;
+  worker = std::thread([this]() { this->run(); });
+  Logger::Info("SimulationThread: Started.");
+}
+
+void SimulationThread::stop() {
+  if (!running.exchange(false))
+    return;
+  if (worker.joinable())
+    worker.join();
+  Logger::Info("SimulationThread: Stopped.");
+}
+
+/**
+ * @brief Fixed-timestep loop, same "Fix Your Timestep" scheme as GameLoop but without rendering.
+ *
+ * Sleeps until the next tick is due instead of spinning, so an idle or paused simulation
+ * costs no CPU.
+ */
+void SimulationThread::run() {
+  using Clock = std::chrono::steady_clock;
+  const double dt = Config::FIXED_DELTA_TIME;
+
+  auto currentTime = Clock::now();
+  double accumulator = 0.0;
+
+  while (running.load()) {
+    auto newTime = Clock::now();
+    double frameTime = std::chrono::duration<double>(newTime - currentTime).count();
+    currentTime = newTime;
+
+    // Cap frame time to avoid spiral of death
+    if (frameTime > 0.25)
+      frameTime = 0.25;
+
+    double speed = speedMultiplier.load();
+    if (isPaused.load()) {
+      accumulator = 0.0;
+    } else {
+      accumulator += frameTime * speed;
+    }
+
+    if (isPaused.load()) {
+      // Keep publishing so selection changes made while paused still reach the render thread.
+      std::scoped_lock guard(mutex);
+      publish(1.0, 0.0);
+    } else if (accumulator >= dt) {
+      PROFILE_ZONE("SimulationThread::batch");
+      std::scoped_lock guard(mutex);
+      while (accumulator >= dt) {
+        tick(dt);
+        accumulator -= dt;
+      }
+      publish(accumulator / dt, dt / speed);
+    }
+
+    // Sleep until the next tick is due (real time), never longer than one tick.
+    double untilNextTick = std::clamp((dt - accumulator) / std::max(speed, 0.01), 0.0, dt);
+    std::this_thread::sleep_for(std::chrono::duration<double>(untilNextTick));
+  }
+}
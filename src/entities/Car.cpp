@@ -1,11 +1,15 @@
 #include "entities/Car.hpp"
 #include "entities/map/World.hpp"
 #include "raymath.h"
+#include <algorithm>
+#include <limits>
 #include <memory>
 #include <vector>
 
 #include "config.hpp"
 #include "core/AssetManager.hpp"
+#include "core/Profiler.hpp"
+#include "systems/CarFollowing.hpp"
 
 /**
  * @file Car.cpp
@@ -24,22 +28,123 @@
  * @param type The propulsion type (Combustion or Electric).
  */
 Car::Car(Vector2 startPos, const World * /*world*/, Vector2 initialVelocity, CarType type)
-    : position(startPos), velocity(initialVelocity), acceleration{0, 0}, maxSpeed(15.0f), maxForce(60.0f), type(type) {
+    : maxSpeed(15.0f), maxForce(60.0f), type(type) {
+  reset(startPos, initialVelocity, type);
+}
 
-  // Select a random visual variant (1-3) based on vehicle type
-  int variant = GetRandomValue(1, 3);
-  if (type == CarType::COMBUSTION) {
-    textureName = "car1" + std::to_string(variant);
-    batteryLevel = 0.0f;
-  } else {
-    textureName = "car2" + std::to_string(variant);
-    batteryLevel = (float)GetRandomValue(10, 90); // Initialize with random charge
-  }
+/**
+ * @brief Restores the freshly constructed state (used when a pooled car is recycled).
+ *
+ * Every member is re-assigned here; the waypoint buffer is only cleared so its capacity is kept.
+ */
+void Car::reset(Vector2 startPos, Vector2 initialVelocity, CarType newType) {
+  position = startPos;
+  velocity = initialVelocity;
+  acceleration = {0, 0};
+  previousPosition = startPos;
+
+  state = CarState::DRIVING;
+  parkingTimer = 0.0f;
+  targetRotation = 0.0f;
+  currentRotation = 0.0f;
+
+  parkedFacility = nullptr;
+  parkedSpot = {{0, 0}, 0.0f, -1};
+  parkedSpotIndex = -1;
+
+  maxSpeed = 15.0f;
+  maxForce = 60.0f;
+  clearWaypoints();
+
+  type = newType;
+  priority = Priority::PRIORITY_DISTANCE;
+  enteredFromLeft = true;
+  parkingDuration = Config::PARKING_MIN_TIME;
+  chargeReceived = 0.0f;
+  charging = false;
+  chargingRate = 0.0f;
+  selected = false;
+  id = CarId{};
+
+  // Variant and charge are randomized by whoever spawns the car (EntityManager)
+  setTextureVariant(1);
+  batteryLevel = (type == CarType::COMBUSTION) ? 0.0f : 50.0f;
 
   // Set initial heading based on starting velocity
   if (Vector2Length(velocity) > 0.1f) {
     currentRotation = atan2f(velocity.y, velocity.x) * RAD2DEG + 90.0f;
   }
+  previousRotation = currentRotation;
+}
+
+/**
+ * @brief Copies every simulated member into a plain snapshot.
+ */
+Car::Snapshot Car::saveState(int32_t parkedFacilityIndex) const {
+  Snapshot s{};
+  s.position = position;
+  s.velocity = velocity;
+  s.acceleration = acceleration;
+  s.previousPosition = previousPosition;
+
+  s.state = state;
+  s.parkingTimer = parkingTimer;
+  s.targetRotation = targetRotation;
+  s.currentRotation = currentRotation;
+  s.previousRotation = previousRotation;
+
+  s.parkedFacility = parkedFacilityIndex;
+  s.parkedSpot = parkedSpot;
+  s.parkedSpotIndex = parkedSpotIndex;
+
+  s.maxSpeed = maxSpeed;
+  s.maxForce = maxForce;
+
+  s.type = type;
+  s.priority = priority;
+  s.enteredFromLeft = enteredFromLeft;
+  s.batteryLevel = batteryLevel;
+  s.parkingDuration = parkingDuration;
+  s.textureVariant = textureVariant;
+  s.chargeReceived = chargeReceived;
+  s.charging = charging;
+  s.chargingRate = chargingRate;
+  return s;
+}
+
+/**
+ * @brief Restores a snapshot taken by saveState (the caller sets the path afterwards).
+ */
+void Car::restoreState(const Snapshot &s, const Module *facility) {
+  position = s.position;
+  velocity = s.velocity;
+  acceleration = s.acceleration;
+  previousPosition = s.previousPosition;
+
+  state = s.state;
+  parkingTimer = s.parkingTimer;
+  targetRotation = s.targetRotation;
+  currentRotation = s.currentRotation;
+  previousRotation = s.previousRotation;
+
+  parkedFacility = facility;
+  parkedSpot = s.parkedSpot;
+  parkedSpotIndex = s.parkedSpotIndex;
+
+  maxSpeed = s.maxSpeed;
+  maxForce = s.maxForce;
+  clearWaypoints();
+
+  type = s.type;
+  priority = s.priority;
+  enteredFromLeft = s.enteredFromLeft;
+  batteryLevel = s.batteryLevel;
+  parkingDuration = s.parkingDuration;
+  chargeReceived = s.chargeReceived;
+  charging = s.charging;
+  chargingRate = s.chargingRate;
+  setTextureVariant(s.textureVariant);
+  selected = false;
 }
 
 /**
@@ -48,10 +153,43 @@ Car::Car(Vector2 startPos, const World * /*world*/, Vector2 initialVelocity, Car
  */
 void Car::charge(float amount) {
   if (type == CarType::ELECTRIC) {
+    float before = batteryLevel;
     batteryLevel += amount;
     if (batteryLevel > 100.0f)
       batteryLevel = 100.0f;
+    if (batteryLevel > before)
+      chargeReceived += batteryLevel - before;
+  }
+}
+
+void Car::setState(CarState newState) {
+  if (charging && newState != CarState::PARKED) {
+    // Unplug: settle the session into the stored level
+    float level = getBatteryLevel();
+    chargeReceived += level - batteryLevel;
+    batteryLevel = level;
+    charging = false;
   }
+  state = newState;
+}
+
+void Car::startCharging(float rate, float duration) {
+  if (type != CarType::ELECTRIC)
+    return;
+  charging = true;
+  chargingRate = rate;
+  parkingDuration = duration;
+  parkingTimer = duration;
+}
+
+void Car::setBatteryLevel(float level) {
+  if (type == CarType::ELECTRIC)
+    batteryLevel = std::clamp(level, 0.0f, 100.0f);
+}
+
+void Car::setTextureVariant(int variant) {
+  textureVariant = std::clamp(variant, 1, 3);
+  textureName = (type == CarType::COMBUSTION ? "car1" : "car2") + std::to_string(textureVariant);
 }
 
 /**
@@ -67,7 +205,7 @@ void Car::setParkingContext(const Module *fac, const Spot &spot, int spotIndex)
  * @brief Standard update override.
  * Calls updateWithNeighbors with no neighbor context.
  */
-void Car::update(double dt) { updateWithNeighbors(dt, nullptr); }
+void Car::update(double dt) { updateWithNeighbors(dt); }
 
 /**
  * @brief Core AI and Physics update loop.
@@ -79,10 +217,20 @@ void Car::update(double dt) { updateWithNeighbors(dt, nullptr); }
  * 4. Physics Integration (Apply forces to velocity and position).
  * 5. Visual Rotation (Smoothly lerp sprite rotation toward heading).
  *
+ * With CarFollowingModel::IDM, steps 2 to 4 of driving and exiting cars are replaced by
+ * driveWithIdm().
+ *
  * @param dt Delta time in seconds.
- * @param cars Pointer to a vector of other cars for spatial awareness.
+ * @param neighbors Nearby cars for spatial awareness.
+ * @param model Longitudinal controller.
+ * @param laneLeader Car ahead in the lane, if the car is in a lane of the main road (IDM only).
  */
-void Car::updateWithNeighbors(double dt, const std::vector<std::unique_ptr<Car>> *cars) {
+void Car::updateWithNeighbors(double dt, std::span<const Car *const> neighbors, CarFollowingModel model,
+                              std::optional<const Car *> laneLeader) {
+  PROFILE_ZONE("Car::updateWithNeighbors");
+  // Remember the last transform so the renderer can interpolate between ticks
+  previousPosition = position;
+  previousRotation = currentRotation;
 
   // 1. Handle Static States
   if (state == CarState::PARKED) {
@@ -90,24 +238,21 @@ void Car::updateWithNeighbors(double dt, const std::vector<std::unique_ptr<Car>>
     return;
   }
 
+  if (model == CarFollowingModel::IDM && !hasArrived() &&
+      (state == CarState::DRIVING || state == CarState::EXITING)) {
+    driveWithIdm(dt, neighbors, laneLeader);
+    return;
+  }
+  curveReady = false; // Steering leaves the curve; it is rebuilt from wherever IDM picks up again
+
   // 2. Path Following (Seek Logic)
-  if (!waypoints.empty()) {
-    Waypoint &currentWp = waypoints.front();
+  if (!hasArrived()) {
+    Waypoint &currentWp = waypoints[nextWaypoint];
     seek(currentWp);
 
     // Check if waypoint reached (within tolerance)
-    if (Vector2Distance(position, currentWp.position) < currentWp.tolerance) {
-      if (waypoints.size() == 1) {
-        // Transition to alignment/parking if this is the final waypoint
-        if (currentWp.stopAtEnd && state == CarState::DRIVING) {
-          velocity = {0, 0};
-          acceleration = {0, 0};
-          state = CarState::ALIGNING;
-          targetRotation = currentWp.entryAngle;
-        }
-      }
-      waypoints.pop_front();
-    }
+    if (Vector2Distance(position, currentWp.position) < currentWp.tolerance)
+      reachWaypoint();
   } else {
     // Logic for cars currently parking (Aligning to the spot angle)
     if (state == CarState::ALIGNING) {
@@ -124,8 +269,7 @@ void Car::updateWithNeighbors(double dt, const std::vector<std::unique_ptr<Car>>
       if (fabs(diff) < 1.0f) {
         currentRotation = targetDeg;
         state = CarState::PARKED;
-        parkingTimer =
-            (float)GetRandomValue((int)(Config::PARKING_MIN_TIME * 10), (int)(Config::PARKING_MAX_TIME * 10)) / 10.0f;
+        parkingTimer = parkingDuration;
       } else {
         float change = rotSpeed * (float)dt;
         if (change > fabs(diff))
@@ -140,7 +284,7 @@ void Car::updateWithNeighbors(double dt, const std::vector<std::unique_ptr<Car>>
   }
 
   // 3. Collision Avoidance and "Creep" Logic
-  if (cars && (state == CarState::DRIVING || state == CarState::EXITING)) {
+  if (!neighbors.empty() && (state == CarState::DRIVING || state == CarState::EXITING)) {
     // Determine current heading vector
     Vector2 heading = (Vector2Length(velocity) > 0.1f) ? Vector2Normalize(velocity)
                                                        : Vector2{cosf((currentRotation - 90.0f) * DEG2RAD),
@@ -152,8 +296,8 @@ void Car::updateWithNeighbors(double dt, const std::vector<std::unique_ptr<Car>>
     float laneWidth = 1.8f;
     float criticalStopDist = 3.2f;
 
-    for (const auto &other : *cars) {
-      if (other.get() == this || other->state == CarState::PARKED)
+    for (const Car *other : neighbors) {
+      if (other == this || other->state == CarState::PARKED)
         continue;
 
       Vector2 toOther = Vector2Subtract(other->getPosition(), position);
@@ -245,23 +389,178 @@ void Car::updateWithNeighbors(double dt, const std::vector<std::unique_ptr<Car>>
   acceleration = {0, 0}; // Reset forces for next frame
 }
 
+void Car::reachWaypoint() {
+  const Waypoint &currentWp = waypoints[nextWaypoint];
+  // Transition to alignment/parking if this is the final waypoint
+  if (nextWaypoint + 1 == waypoints.size() && currentWp.stopAtEnd && state == CarState::DRIVING) {
+    velocity = {0, 0};
+    acceleration = {0, 0};
+    state = CarState::ALIGNING;
+    targetRotation = currentWp.entryAngle;
+  }
+  nextWaypoint++;
+}
+
+Vector2 Car::rotationHeading() const {
+  return {cosf((currentRotation - 90.0f) * DEG2RAD), sinf((currentRotation - 90.0f) * DEG2RAD)};
+}
+
+/**
+ * @brief Intelligent Driver Model tick.
+ *
+ * The car moves along the curve through its waypoints by advancing its distance on it (never past
+ * the next waypoint within one tick) and only its speed is modelled: the desired speed of the
+ * waypoint (speed limit, turn slowdown, arrival) and the gap to a single leader go through
+ * CarFollowing. On the main road the leader comes from the lane lists; elsewhere the neighbors are
+ * searched.
+ */
+void Car::driveWithIdm(double dt, std::span<const Car *const> neighbors, std::optional<const Car *> laneLeader) {
+  using namespace Config::CarAI::Idm;
+  if (!curveReady) {
+    curve.build(position, Vector2Length(velocity) > 0.1f ? velocity : rotationHeading(), getWaypoints());
+    curveReady = true;
+    curveStart = nextWaypoint;
+    curveDistance = 0.0f;
+  }
+
+  const Waypoint &wp = waypoints[nextWaypoint];
+  float dist = curve.getWaypointDistance(nextWaypoint - curveStart) - curveDistance;
+  Vector2 heading = curve.sample(curveDistance).tangent;
+  if (Vector2LengthSqr(heading) == 0.0f)
+    heading = rotationHeading();
+  float speed = Vector2Length(velocity);
+
+  float gap = std::numeric_limits<float>::infinity();
+  float leaderSpeed = 0.0f;
+  float lookAhead = LOOK_AHEAD_BASE + LOOK_AHEAD_PER_SPEED * speed;
+  if (laneLeader)
+    followLaneLeader(*laneLeader, heading, lookAhead, gap, leaderSpeed);
+  else
+    findLeader(heading, lookAhead, neighbors, gap, leaderSpeed);
+
+  float accel = CarFollowing::acceleration(speed, desiredSpeed(wp, dist), gap, speed - leaderSpeed);
+  float step = std::min(CarFollowing::advance(speed, accel, dt), dist);
+  curveDistance += step;
+  SplinePath::Sample at = curve.sample(curveDistance);
+  position = at.position;
+  if (Vector2LengthSqr(at.tangent) > 0.0f)
+    heading = at.tangent;
+  velocity = Vector2Scale(heading, speed);
+  acceleration = {0, 0};
+
+  if (dist - step < wp.tolerance)
+    reachWaypoint();
+
+  // Same smoothing as the steering model at 60 Hz, scaled to the tick length
+  if (speed > 0.1f) {
+    float targetRot = atan2f(heading.y, heading.x) * RAD2DEG + 90.0f;
+    float angleDiff = targetRot - currentRotation;
+    while (angleDiff > 180)
+      angleDiff -= 360;
+    while (angleDiff < -180)
+      angleDiff += 360;
+    currentRotation += angleDiff * (1.0f - powf(0.88f, (float)dt * Config::TICK_RATE));
+  }
+}
+
+bool Car::findLeader(Vector2 heading, float lookAhead, std::span<const Car *const> neighbors, float &gap,
+                     float &leaderSpeed) const {
+  using namespace Config::CarAI::Idm;
+  Vector2 sideVec = {-heading.y, heading.x};
+  bool found = false;
+
+  for (const Car *other : neighbors) {
+    if (other == this || other->state == CarState::PARKED)
+      continue;
+
+    Vector2 toOther = Vector2Subtract(other->position, position);
+    float ahead = Vector2DotProduct(toOther, heading);
+    if (ahead <= 0.0f || ahead > lookAhead || fabsf(Vector2DotProduct(toOther, sideVec)) >= LANE_HALF_WIDTH)
+      continue;
+
+    float otherSpeed = Vector2Length(other->velocity);
+    Vector2 otherHeading =
+        otherSpeed > 0.1f ? Vector2Scale(other->velocity, 1.0f / otherSpeed) : other->rotationHeading();
+    float alignment = Vector2DotProduct(heading, otherHeading);
+
+    // Oncoming traffic passes in the other lane
+    if (alignment < -0.5f)
+      continue;
+
+    // Crossing paths: if each is ahead of the other, the older car (lower slot) goes first
+    if (alignment < 0.5f) {
+      Vector2 toThis = Vector2Scale(toOther, -1.0f);
+      float otherAhead = Vector2DotProduct(toThis, otherHeading);
+      Vector2 otherSide = {-otherHeading.y, otherHeading.x};
+      bool mutual = otherAhead > 0.0f && otherAhead <= LOOK_AHEAD_BASE + LOOK_AHEAD_PER_SPEED * otherSpeed &&
+                    fabsf(Vector2DotProduct(toThis, otherSide)) < LANE_HALF_WIDTH;
+      if (mutual && id.index < other->id.index)
+        continue;
+    }
+
+    // A car already overlapping this one (spawned on top of it, merging paths) cannot be followed;
+    // following keeps gaps positive otherwise
+    float otherGap = ahead - VEHICLE_LENGTH;
+    if (otherGap < 0.0f)
+      continue;
+    if (!found || otherGap < gap) {
+      found = true;
+      gap = otherGap;
+      leaderSpeed = std::max(0.0f, Vector2DotProduct(other->velocity, heading));
+    }
+  }
+  return found;
+}
+
+bool Car::followLaneLeader(const Car *leader, Vector2 heading, float lookAhead, float &gap,
+                           float &leaderSpeed) const {
+  if (!leader)
+    return false;
+  // Same gap rules as findLeader(): out of range or already overlapping counts as a free road
+  float ahead = Vector2DotProduct(Vector2Subtract(leader->position, position), heading);
+  float leaderGap = ahead - Config::CarAI::Idm::VEHICLE_LENGTH;
+  if (ahead > lookAhead || leaderGap < 0.0f)
+    return false;
+  gap = leaderGap;
+  leaderSpeed = std::max(0.0f, Vector2DotProduct(leader->velocity, heading));
+  return true;
+}
+
 /**
  * @brief Renders the car and optional debug information (paths/waypoints).
  * @param showPath If true, draws the car's planned trajectory.
  */
 void Car::draw(bool showPath) {
-  if (showPath && !waypoints.empty()) {
-    for (size_t i = 0; i < waypoints.size(); ++i) {
-      Vector2 wpPos = waypoints[i].position;
-      DrawCircleV(wpPos, 0.25f, Fade(BLUE, 0.5f));
-      if (i > 0) {
-        DrawLineV(waypoints[i - 1].position, wpPos, Fade(BLUE, 0.3f));
-      } else {
-        DrawLineV(position, wpPos, Fade(BLUE, 0.3f));
-      }
+  if (showPath && !hasArrived()) {
+    std::vector<Vector2> points;
+    points.reserve(waypoints.size() - nextWaypoint);
+    for (const auto &wp : getWaypoints())
+      points.push_back(wp.position);
+    drawPath(position, points);
+  }
+
+  drawSprite(textureName, position, currentRotation);
+}
+
+/**
+ * @brief Draws waypoint dots and connecting lines, starting at the car's position.
+ */
+void Car::drawPath(Vector2 from, const std::vector<Vector2> &points) {
+  for (size_t i = 0; i < points.size(); ++i) {
+    Vector2 wpPos = points[i];
+    DrawCircleV(wpPos, 0.25f, Fade(BLUE, 0.5f));
+    if (i > 0) {
+      DrawLineV(points[i - 1], wpPos, Fade(BLUE, 0.3f));
+    } else {
+      DrawLineV(from, wpPos, Fade(BLUE, 0.3f));
     }
   }
+}
 
+/**
+ * @brief Draws the car texture centered on a position with the given rotation.
+ */
+void Car::drawSprite(const std::string &textureName, Vector2 position, float rotation) {
   Texture2D tex = AssetManager::Get().GetTexture(textureName);
 
   // Convert pixel dimensions to meters using config scaling
@@ -272,28 +571,37 @@ void Car::draw(bool showPath) {
   Rectangle dest = {position.x, position.y, width, height};
   Vector2 origin = {width / 2.0f, height / 2.0f};
 
-  DrawTexturePro(tex, source, dest, origin, currentRotation, WHITE);
+  DrawTexturePro(tex, source, dest, origin, rotation, WHITE);
 }
 
 /**
  * @brief Appends a single waypoint to the path.
  */
-void Car::addWaypoint(Waypoint wp) { waypoints.push_back(wp); }
+void Car::addWaypoint(Waypoint wp) {
+  // Drop consumed waypoints first so an exhausted path does not keep growing the buffer
+  if (hasArrived())
+    clearWaypoints();
+  waypoints.push_back(wp);
+  curveReady = false;
+}
 
 /**
- * @brief Replaces current waypoints with a new path.
+ * @brief Replaces current waypoints with a new path (reuses the existing buffer).
  */
 void Car::setPath(const std::vector<Waypoint> &path) {
-  waypoints.clear();
-  for (const auto &wp : path) {
-    waypoints.push_back(wp);
-  }
+  waypoints.assign(path.begin(), path.end());
+  nextWaypoint = 0;
+  curveReady = false;
 }
 
 /**
  * @brief Removes all waypoints from the path.
  */
-void Car::clearWaypoints() { waypoints.clear(); }
+void Car::clearWaypoints() {
+  waypoints.clear();
+  nextWaypoint = 0;
+  curveReady = false;
+}
 
 /**
  * @brief Accumulates a force vector to be applied during the next physics update.
@@ -301,19 +609,14 @@ void Car::clearWaypoints() { waypoints.clear(); }
 void Car::applyForce(Vector2 force) { acceleration = Vector2Add(acceleration, force); }
 
 /**
- * @brief Calculates steering force toward a target using Seek/Arrive behaviors.
+ * @brief Target speed toward a waypoint.
  *
  * Includes logic for:
  * - Speed limits defined by waypoints.
  * - Turn slowdown (reducing speed based on angle difference).
  * - Arrival damping (slowing down as the final destination is reached).
  */
-void Car::seek(const Waypoint &wp) {
-  Vector2 target = wp.position;
-  Vector2 desired = Vector2Subtract(target, position);
-  float dist = Vector2Length(desired);
-  desired = Vector2Normalize(desired);
-
+float Car::desiredSpeed(const Waypoint &wp, float dist) const {
   float currentAngle = atan2f(velocity.y, velocity.x);
 
   // 1. Base speed for this segment
@@ -362,6 +665,19 @@ void Car::seek(const Waypoint &wp) {
     }
   }
 
+  return speed;
+}
+
+/**
+ * @brief Calculates steering force toward a target using Seek/Arrive behaviors (see desiredSpeed()).
+ */
+void Car::seek(const Waypoint &wp) {
+  Vector2 target = wp.position;
+  Vector2 desired = Vector2Subtract(target, position);
+  float dist = Vector2Length(desired);
+  desired = Vector2Normalize(desired);
+  float speed = desiredSpeed(wp, dist);
+
   desired = Vector2Scale(desired, speed);
   Vector2 steer = Vector2Subtract(desired, velocity);
 
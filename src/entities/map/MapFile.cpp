@@ -0,0 +1,233 @@
+#include "entities/map/MapFile.hpp"
+#include "core/BinaryIO.hpp"
+#include "core/MappedFile.hpp"
+#include "config.hpp"
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <unordered_map>
+
+/**
+ * @file MapFile.cpp
+ * @brief Implementation of the binary map format.
+ */
+
+namespace {
+constexpr char MAGIC[8] = {'P', 'L', 'K', 'M', 'A', 'P', 0, 0};
+constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+/**
+ * @brief Concrete module class, as stored in a record.
+ */
+enum class Kind : uint8_t {
+  NORMAL_ROAD,
+  UP_ENTRANCE_ROAD,
+  DOWN_ENTRANCE_ROAD,
+  DOUBLE_ENTRANCE_ROAD,
+  SMALL_PARKING,
+  LARGE_PARKING,
+  SMALL_CHARGING,
+  LARGE_CHARGING,
+  COUNT
+};
+
+struct Header {
+  char magic[8];
+  uint32_t version;
+  uint32_t byteOrder;
+  float worldWidth;
+  float worldHeight;
+  uint32_t tileCols;
+  uint32_t tileRows;
+  uint32_t moduleCount;
+  uint32_t spotCount;
+};
+static_assert(sizeof(Header) == 40);
+
+struct ModuleRecord {
+  uint8_t kind;
+  uint8_t isTop;
+  uint16_t reserved;
+  int32_t parent;
+  float x;
+  float y;
+  float priceMultiplier;
+  uint32_t spotCount;
+};
+static_assert(sizeof(ModuleRecord) == 24);
+
+Kind kindOf(const Module &module) {
+  switch (module.getType()) {
+  case ModuleType::SMALL_PARKING:
+    return Kind::SMALL_PARKING;
+  case ModuleType::LARGE_PARKING:
+    return Kind::LARGE_PARKING;
+  case ModuleType::SMALL_CHARGING:
+    return Kind::SMALL_CHARGING;
+  case ModuleType::LARGE_CHARGING:
+    return Kind::LARGE_CHARGING;
+  default:
+    break;
+  }
+
+  // Roads share ModuleType::GENERIC
+  if (dynamic_cast<const NormalRoad *>(&module))
+    return Kind::NORMAL_ROAD;
+  if (dynamic_cast<const UpEntranceRoad *>(&module))
+    return Kind::UP_ENTRANCE_ROAD;
+  if (dynamic_cast<const DownEntranceRoad *>(&module))
+    return Kind::DOWN_ENTRANCE_ROAD;
+  if (dynamic_cast<const DoubleEntranceRoad *>(&module))
+    return Kind::DOUBLE_ENTRANCE_ROAD;
+  throw std::runtime_error("MapFile: unsupported module type");
+}
+
+std::unique_ptr<Module> createModule(Kind kind, bool isTop) {
+  switch (kind) {
+  case Kind::NORMAL_ROAD:
+    return std::make_unique<NormalRoad>();
+  case Kind::UP_ENTRANCE_ROAD:
+    return std::make_unique<UpEntranceRoad>();
+  case Kind::DOWN_ENTRANCE_ROAD:
+    return std::make_unique<DownEntranceRoad>();
+  case Kind::DOUBLE_ENTRANCE_ROAD:
+    return std::make_unique<DoubleEntranceRoad>();
+  case Kind::SMALL_PARKING:
+    return std::make_unique<SmallParking>(isTop);
+  case Kind::LARGE_PARKING:
+    return std::make_unique<LargeParking>(isTop);
+  case Kind::SMALL_CHARGING:
+    return std::make_unique<SmallChargingStation>(isTop);
+  case Kind::LARGE_CHARGING:
+    return std::make_unique<LargeChargingStation>(isTop);
+  default:
+    return nullptr;
+  }
+}
+} // namespace
+
+void MapFile::save(const std::string &path, const World &world, const std::vector<std::unique_ptr<Module>> &modules) {
+  std::unordered_map<const Module *, int32_t> indexOf;
+  indexOf.reserve(modules.size());
+  uint32_t spotCount = 0;
+  for (size_t i = 0; i < modules.size(); ++i) {
+    indexOf[modules[i].get()] = (int32_t)i;
+    spotCount += (uint32_t)modules[i]->getSpotCount();
+  }
+
+  const auto &tiles = world.getBackgroundTiles();
+  BinaryWriter out;
+  out.reserve(sizeof(Header) + modules.size() * sizeof(ModuleRecord) + spotCount * sizeof(float) + tiles.size());
+
+  Header header{};
+  std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+  header.version = VERSION;
+  header.byteOrder = BYTE_ORDER_MARK;
+  header.worldWidth = world.getWidth();
+  header.worldHeight = world.getHeight();
+  header.tileCols = (uint32_t)world.getTileCols();
+  header.tileRows = (uint32_t)world.getTileRows();
+  header.moduleCount = (uint32_t)modules.size();
+  header.spotCount = spotCount;
+  out.write(header);
+
+  for (const auto &module : modules) {
+    ModuleRecord record{};
+    record.kind = (uint8_t)kindOf(*module);
+    record.isTop = module->isUp() ? 1 : 0;
+    record.parent = -1;
+    if (const Module *parent = module->getParent()) {
+      auto it = indexOf.find(parent);
+      if (it == indexOf.end())
+        throw std::runtime_error("MapFile: module parent is not part of the layout");
+      record.parent = it->second;
+    }
+    record.x = module->worldPosition.x;
+    record.y = module->worldPosition.y;
+    record.priceMultiplier = module->getPriceMultiplier();
+    record.spotCount = (uint32_t)module->getSpotCount();
+    out.write(record);
+  }
+
+  for (const auto &module : modules) {
+    for (int i = 0; i < (int)module->getSpotCount(); ++i)
+      out.write(module->getSpot(i).price);
+  }
+
+  out.writeArray(std::span<const uint8_t>(tiles));
+  out.saveTo(path);
+}
+
+GeneratedMap MapFile::load(const std::string &path) {
+  MappedFile file(path);
+  BinaryReader in(file.bytes());
+
+  auto header = in.read<Header>();
+  if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+    throw std::runtime_error(path + ": not a ParkLogic map file");
+  if (header.byteOrder != BYTE_ORDER_MARK)
+    throw std::runtime_error(path + ": written on a machine with a different byte order");
+  if (header.version != VERSION)
+    throw std::runtime_error(path + ": unsupported map version " + std::to_string(header.version));
+
+  // The world size decides the tile grid: check it before anything is sized from it
+  auto validSize = [](float size) {
+    return std::isfinite(size) && size > 0.0f && size <= Config::Map::MAX_WORLD_SIZE;
+  };
+  if (!validSize(header.worldWidth) || !validSize(header.worldHeight))
+    throw std::runtime_error(path + ": invalid world size");
+  if (World::tilesToCover(header.worldWidth) != (int)header.tileCols ||
+      World::tilesToCover(header.worldHeight) != (int)header.tileRows)
+    throw std::runtime_error(path + ": tile grid does not match the world size");
+
+  // Everything after the header has a known size: reject truncated files before allocating
+  size_t expected = (size_t)header.moduleCount * sizeof(ModuleRecord) + (size_t)header.spotCount * sizeof(float) +
+                    (size_t)header.tileCols * header.tileRows;
+  if (in.remaining() != expected)
+    throw std::runtime_error(path + ": size does not match its header");
+
+  GeneratedMap map;
+  map.modules.reserve(header.moduleCount);
+  std::vector<int32_t> parents(header.moduleCount);
+  uint32_t spotTotal = 0;
+
+  for (uint32_t i = 0; i < header.moduleCount; ++i) {
+    auto record = in.read<ModuleRecord>();
+    if (record.kind >= (uint8_t)Kind::COUNT)
+      throw std::runtime_error(path + ": unknown module kind in record " + std::to_string(i));
+    if (record.parent < -1 || record.parent >= (int32_t)header.moduleCount)
+      throw std::runtime_error(path + ": invalid parent in record " + std::to_string(i));
+    if (!std::isfinite(record.x) || !std::isfinite(record.y) || !std::isfinite(record.priceMultiplier))
+      throw std::runtime_error(path + ": non-finite position or price in record " + std::to_string(i));
+
+    auto module = createModule((Kind)record.kind, record.isTop != 0);
+    if (module->getSpotCount() != record.spotCount)
+      throw std::runtime_error(path + ": spot count mismatch in record " + std::to_string(i));
+    module->worldPosition = {record.x, record.y};
+    module->setPriceMultiplier(record.priceMultiplier);
+    parents[i] = record.parent;
+    spotTotal += record.spotCount;
+    map.modules.push_back(std::move(module));
+  }
+  if (spotTotal != header.spotCount)
+    throw std::runtime_error(path + ": spot total does not match its header");
+
+  for (size_t i = 0; i < map.modules.size(); ++i) {
+    Module &module = *map.modules[i];
+    if (parents[i] >= 0)
+      module.setParent(map.modules[parents[i]].get());
+    for (int s = 0; s < (int)module.getSpotCount(); ++s) {
+      float price = in.read<float>();
+      if (!std::isfinite(price))
+        throw std::runtime_error(path + ": non-finite spot price in record " + std::to_string(i));
+      module.setSpotPrice(s, price);
+    }
+  }
+
+  auto tileBytes = in.take((size_t)header.tileCols * header.tileRows);
+  std::vector<uint8_t> tiles(tileBytes.size());
+  std::memcpy(tiles.data(), tileBytes.data(), tileBytes.size());
+  map.world = std::make_unique<World>(header.worldWidth, header.worldHeight, std::move(tiles));
+
+  return map;
+}
@@ -1,8 +1,10 @@
 #include "entities/map/Modules.hpp"
 #include "config.hpp"
 #include "core/AssetManager.hpp"
+#include "core/Random.hpp"
 #include "raylib.h"
 #include "raymath.h"
+#include <algorithm>
 
 // --- Helper Conversion ---
 
@@ -14,17 +16,25 @@ static float P2M(float artPixels) {
 
 // --- Module Base Class ---
 
-Module::Module(float w, float h) : width(w), height(h) {
+Module::Module(float w, float h) : width(w), height(h) {}
+
+void Module::setPricing(float baseSpotPrice, float variance) {
+  basePrice = baseSpotPrice;
+  priceVariance = variance;
+  priceMultiplier = priceBoost;
+  for (auto &spot : spots)
+    spot.price = std::max(basePrice * priceMultiplier, 0.5f);
+}
+
+void Module::randomizePrices(Random &random) {
   // Base random multiplier for this facility (1.0 to 3.0)
   // This makes some facilities "posh" and others "cheap"
-  priceMultiplier = (float)GetRandomValue(10, 30) / 10.0f;
-}
+  priceMultiplier = priceBoost * (float)random.uniformInt(10, 30) / 10.0f;
 
-void Module::assignRandomPricesToSpots(float baseSpotPrice, float variance) {
   for (auto &spot : spots) {
     // Spot Price = Base * FacilityMultiplier + RandomVariance
-    float r = (float)GetRandomValue(-(int)(variance * 10), (int)(variance * 10)) / 10.0f;
-    spot.price = (baseSpotPrice * priceMultiplier) + r;
+    float r = (float)random.uniformInt(-(int)(priceVariance * 10), (int)(priceVariance * 10)) / 10.0f;
+    spot.price = (basePrice * priceMultiplier) + r;
     if (spot.price < 0.5f)
       spot.price = 0.5f; // Min price
   }
@@ -41,6 +51,14 @@ void Module::draw() const {
   // }
 }
 
+void Module::drawSpots(std::span<const SpotRenderState> spotStates) const {
+  size_t count = std::min(spotStates.size(), spots.size());
+  for (size_t i = 0; i < count; ++i) {
+    if (spotStates[i].state == SpotState::RESERVED)
+      DrawCircleV(Vector2Add(worldPosition, spots[i].localPosition), 0.6f, Fade(GOLD, 0.6f));
+  }
+}
+
 void Module::addWaypoint(Vector2 localPos, float tolerance, int id, float angle, bool stop) {
   localWaypoints.emplace_back(localPos, tolerance, id, angle, stop);
 }
@@ -82,19 +100,18 @@ const AttachmentPoint *Module::getAttachmentPointByNormal(Vector2 normal) const
 // --- New Pathfinding Implementation ---
 // Logic moved to PathPlanner system.
 
-int Module::getRandomSpotIndex() const {
-  std::vector<int> freeIndices;
-  for (int i = 0; i < (int)spots.size(); ++i) {
-    if (spots[i].state == SpotState::FREE) {
-      freeIndices.push_back(i);
-    }
-  }
-
-  if (freeIndices.empty())
+int Module::getRandomSpotIndex(Random &random) const {
+  int freeCount = getSpotCounts().free;
+  if (freeCount == 0)
     return -1;
 
-  int randIdx = GetRandomValue(0, (int)freeIndices.size() - 1);
-  return freeIndices[randIdx];
+  // Pick the n-th free spot (no scratch list of candidates)
+  int n = random.uniformInt(0, freeCount - 1);
+  for (int i = 0; i < (int)spots.size(); ++i) {
+    if (spots[i].state == SpotState::FREE && n-- == 0)
+      return i;
+  }
+  return -1;
 }
 
 Spot Module::getSpot(int index) const {
@@ -104,35 +121,31 @@ Spot Module::getSpot(int index) const {
   return {{0, 0}, 0, -1, SpotState::FREE}; // Safe default
 }
 
-void Module::setSpotState(int index, SpotState state) {
-  if (index >= 0 && index < (int)spots.size()) {
-    spots[index].state = state;
-  }
+void Module::setSpotPrice(int index, float price) {
+  if (index >= 0 && index < (int)spots.size())
+    spots[index].price = price;
+}
+
+SpotState Module::setSpotState(int index, SpotState state) {
+  if (index < 0 || index >= (int)spots.size())
+    return state;
+
+  SpotState previous = spots[index].state;
+  spots[index].state = state;
+
+  // Keep the per-facility counters in step (free is derived from the spot count)
+  reservedCount += (state == SpotState::RESERVED) - (previous == SpotState::RESERVED);
+  occupiedCount += (state == SpotState::OCCUPIED) - (previous == SpotState::OCCUPIED);
+  return previous;
 }
 
 Module::SpotCounts Module::getSpotCounts() const {
-  SpotCounts counts = {0, 0, 0};
-  for (const auto &spot : spots) {
-    if (spot.state == SpotState::FREE)
-      counts.free++;
-    else if (spot.state == SpotState::RESERVED)
-      counts.reserved++;
-    else if (spot.state == SpotState::OCCUPIED)
-      counts.occupied++;
-  }
-  return counts;
+  return {(int)spots.size() - reservedCount - occupiedCount, reservedCount, occupiedCount};
 }
 
 float Module::getOccupancyPercentage() const {
   if (spots.empty())
     return 0.0f;
-
-  int occupiedCount = 0;
-  for (const auto &spot : spots) {
-    if (spot.state == SpotState::OCCUPIED) {
-      occupiedCount++;
-    }
-  }
   return (float)occupiedCount / (float)spots.size();
 }
 
@@ -275,7 +288,7 @@ SmallParking::SmallParking(bool isTop) : Module(P2M(274), P2M(330)), isTop(isTop
   addWaypoint({P2M(218), height / 2.0f});
 
   // Base Price: $2.0, Variance $0.5
-  assignRandomPricesToSpots(2.0f, 0.5f);
+  setPricing(2.0f, 0.5f);
 }
 
 void SmallParking::draw() const {
@@ -338,7 +351,7 @@ LargeParking::LargeParking(bool isTop) : Module(P2M(436), P2M(363)), isTop(isTop
   addWaypoint({P2M(218), height / 2.0f});
 
   // Base Price: $1.0, Variance $0.5
-  assignRandomPricesToSpots(1.0f, 0.5f);
+  setPricing(1.0f, 0.5f);
 }
 
 void LargeParking::draw() const {
@@ -389,7 +402,7 @@ SmallChargingStation::SmallChargingStation(bool isTop) : Module(P2M(219), P2M(16
   // Charging is more expensive (2-5x more than parking)
   // Base Price: $10.0, Variance $1.0
   // priceMultiplier *= 1.5f; // Add extra multiplier boost for being a charging station module?
-  assignRandomPricesToSpots(10.0f, 1.0f);
+  setPricing(10.0f, 1.0f);
 }
 
 void SmallChargingStation::draw() const {
@@ -435,8 +448,8 @@ LargeChargingStation::LargeChargingStation(bool isTop) : Module(P2M(274), P2M(33
   addWaypoint({P2M(218), height / 2.0f});
 
   // Base Price: $8.0, Variance $2.0
-  priceMultiplier *= 1.5f;
-  assignRandomPricesToSpots(8.0f, 2.0f);
+  priceBoost = 1.5f;
+  setPricing(8.0f, 2.0f);
 }
 
 void LargeChargingStation::draw() const {
@@ -0,0 +1,106 @@
+#include "entities/map/SplinePath.hpp"
+#include "config.hpp"
+#include "raymath.h"
+#include <algorithm>
+
+/**
+ * @file SplinePath.cpp
+ * @brief Bezier segments and their arc-length tables.
+ */
+
+namespace {
+Vector2 unit(Vector2 v) {
+  float length = Vector2Length(v);
+  return length > 1e-4f ? Vector2Scale(v, 1.0f / length) : Vector2{0.0f, 0.0f};
+}
+
+Vector2 evaluate(Vector2 p0, Vector2 p1, Vector2 p2, Vector2 p3, float t) {
+  float u = 1.0f - t;
+  float a = u * u * u, b = 3.0f * u * u * t, c = 3.0f * u * t * t, d = t * t * t;
+  return {a * p0.x + b * p1.x + c * p2.x + d * p3.x, a * p0.y + b * p1.y + c * p2.y + d * p3.y};
+}
+
+Vector2 derivative(Vector2 p0, Vector2 p1, Vector2 p2, Vector2 p3, float t) {
+  float u = 1.0f - t;
+  float a = 3.0f * u * u, b = 6.0f * u * t, c = 3.0f * t * t;
+  return {a * (p1.x - p0.x) + b * (p2.x - p1.x) + c * (p3.x - p2.x),
+          a * (p1.y - p0.y) + b * (p2.y - p1.y) + c * (p3.y - p2.y)};
+}
+} // namespace
+
+void SplinePath::clear() {
+  segments.clear();
+  ends.clear();
+  table.clear();
+}
+
+void SplinePath::build(Vector2 start, Vector2 heading, std::span<const Waypoint> waypoints) {
+  using namespace Config::CarAI::Spline;
+  clear();
+  if (waypoints.empty())
+    return;
+
+  size_t count = waypoints.size();
+  segments.reserve(count);
+  ends.reserve(count);
+  table.reserve(count * (TABLE_SAMPLES + 1));
+
+  auto point = [&](size_t i) { return i == 0 ? start : waypoints[i - 1].position; };
+  auto chord = [&](size_t i) { return unit(Vector2Subtract(point(i + 1), point(i))); };
+
+  // Tangent at the start: the car's heading, unless it would have to turn back
+  Vector2 out = chord(0);
+  Vector2 tangent = unit(heading);
+  if (Vector2DotProduct(tangent, out) <= 0.0f)
+    tangent = out;
+
+  float distance = 0.0f;
+  for (size_t i = 0; i < count; ++i) {
+    Vector2 a = point(i), b = point(i + 1);
+
+    // Tangent at the far end: the mean of the chords meeting there
+    Vector2 next = i + 1 < count ? chord(i + 1) : out;
+    Vector2 nextTangent = unit(Vector2Add(out, next));
+    if (Vector2LengthSqr(nextTangent) == 0.0f)
+      nextTangent = Vector2LengthSqr(next) > 0.0f ? next : out;
+
+    float handle = Vector2Distance(a, b) * HANDLE_FACTOR;
+    Segment segment{a, Vector2Add(a, Vector2Scale(tangent, handle)),
+                    Vector2Subtract(b, Vector2Scale(nextTangent, handle)), b};
+    segments.push_back(segment);
+
+    table.push_back(distance);
+    Vector2 previous = a;
+    for (int k = 1; k <= TABLE_SAMPLES; ++k) {
+      Vector2 p = evaluate(segment.p0, segment.p1, segment.p2, segment.p3, (float)k / (float)TABLE_SAMPLES);
+      distance += Vector2Distance(previous, p);
+      table.push_back(distance);
+      previous = p;
+    }
+    ends.push_back(distance);
+
+    tangent = nextTangent;
+    out = next;
+  }
+}
+
+SplinePath::Sample SplinePath::sample(float distance) const {
+  using namespace Config::CarAI::Spline;
+  if (segments.empty())
+    return {{0.0f, 0.0f}, {0.0f, 0.0f}};
+  distance = std::clamp(distance, 0.0f, getLength());
+
+  size_t s = std::min((size_t)(std::lower_bound(ends.begin(), ends.end(), distance) - ends.begin()),
+                      segments.size() - 1);
+  const float *row = table.data() + s * (TABLE_SAMPLES + 1);
+  int k = (int)(std::upper_bound(row + 1, row + TABLE_SAMPLES + 1, distance) - row);
+  k = std::min(k, TABLE_SAMPLES);
+  float span = row[k] - row[k - 1];
+  float t = ((float)(k - 1) + (span > 0.0f ? (distance - row[k - 1]) / span : 0.0f)) / (float)TABLE_SAMPLES;
+
+  const Segment &seg = segments[s];
+  Vector2 tangent = unit(derivative(seg.p0, seg.p1, seg.p2, seg.p3, t));
+  if (Vector2LengthSqr(tangent) == 0.0f)
+    tangent = unit(Vector2Subtract(seg.p3, seg.p0));
+  return {evaluate(seg.p0, seg.p1, seg.p2, seg.p3, t), tangent};
+}
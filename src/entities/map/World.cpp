@@ -2,7 +2,9 @@
 #include "config.hpp"
 #include "core/AssetManager.hpp"
 #include "core/Logger.hpp"
+#include "core/Random.hpp"
 #include "raylib.h"
+#include <algorithm>
 #include <cmath>
 
 /**
@@ -13,6 +15,47 @@
  */
 
 World::World(float width, float height) : width(width), height(height), showGrid(false) {
+  initTileGrid();
+  Random random;
+  randomizeTiles(random);
+
+  Logger::Info("World initialized with {}x{} background tiles.", tileCols, tileRows);
+}
+
+World::World(float width, float height, Random &random) : width(width), height(height), showGrid(false) {
+  initTileGrid();
+  randomizeTiles(random);
+
+  Logger::Info("World initialized with {}x{} background tiles.", tileCols, tileRows);
+}
+
+World::World(float width, float height, std::vector<uint8_t> tiles) : width(width), height(height), showGrid(false) {
+  initTileGrid();
+
+  if (tiles.size() == (size_t)tileCols * tileRows) {
+    backgroundTiles = std::move(tiles);
+  } else {
+    Logger::Warn("World: {} background tiles given for a {}x{} grid, randomizing.", tiles.size(), tileCols, tileRows);
+    Random random;
+    randomizeTiles(random);
+  }
+
+  // Out of range indices would read past the texture list when drawing
+  for (auto &tile : backgroundTiles) {
+    if (tile >= tileTextures.size())
+      tile = 0;
+  }
+}
+
+void World::randomizeTiles(Random &random) {
+  // One byte per tile: large maps have millions of tiles
+  backgroundTiles.resize((size_t)tileCols * tileRows);
+  for (auto &tile : backgroundTiles) {
+    tile = (uint8_t)random.uniformInt(0, (int)tileTextures.size() - 1);
+  }
+}
+
+void World::initTileGrid() {
   tileTextures = {"grass1", "grass2", "grass3", "grass4"};
 
   // Calculate Tile Size in Meters
@@ -22,32 +65,34 @@ World::World(float width, float height) : width(width), height(height), showGrid
   tileWidthMeter = artPixelsPerTile / static_cast<float>(Config::ART_PIXELS_PER_METER);
   tileHeightMeter = tileWidthMeter;
 
-  // Generate Tile Map
-  int cols = std::ceil(width / tileWidthMeter);
-  int rows = std::ceil(height / tileHeightMeter);
-
-  backgroundTiles.resize(rows, std::vector<int>(cols));
-
-  for (int y = 0; y < rows; ++y) {
-    for (int x = 0; x < cols; ++x) {
-      backgroundTiles[y][x] = GetRandomValue(0, tileTextures.size() - 1);
-    }
-  }
+  tileCols = tilesToCover(width);
+  tileRows = tilesToCover(height);
+}
 
-  Logger::Info("World initialized with {}x{} background tiles.", cols, rows);
+int World::tilesToCover(float length) {
+  float artPixelsPerTile = static_cast<float>(Config::BACKGROUND_TILE_SIZE);
+  float tileMeter = artPixelsPerTile / static_cast<float>(Config::ART_PIXELS_PER_METER);
+  return (int)std::ceil(length / tileMeter);
 }
 
 void World::update(double /*dt*/) {
   // World update logic (if any)
 }
 
-void World::draw() {
-  // Draw Background Tiles
+void World::draw() { draw({0, 0, width, height}); }
+
+void World::draw(Rectangle view) {
+  // Draw Background Tiles (only the ones inside the view)
   auto &AM = AssetManager::Get();
 
-  for (size_t y = 0; y < backgroundTiles.size(); ++y) {
-    for (size_t x = 0; x < backgroundTiles[y].size(); ++x) {
-      int tileIndex = backgroundTiles[y][x];
+  int firstCol = std::max(0, (int)std::floor(view.x / tileWidthMeter));
+  int lastCol = std::min(tileCols - 1, (int)std::floor((view.x + view.width) / tileWidthMeter));
+  int firstRow = std::max(0, (int)std::floor(view.y / tileHeightMeter));
+  int lastRow = std::min(tileRows - 1, (int)std::floor((view.y + view.height) / tileHeightMeter));
+
+  for (int y = firstRow; y <= lastRow; ++y) {
+    for (int x = firstCol; x <= lastCol; ++x) {
+      int tileIndex = backgroundTiles[(size_t)y * tileCols + x];
       Texture2D tex = AM.GetTexture(tileTextures[tileIndex]);
 
       Rectangle source = {0, 0, (float)tex.width, (float)tex.height};
@@ -59,21 +104,25 @@ void World::draw() {
   }
 }
 
-void World::drawOverlay() {
+void World::drawOverlay(Rectangle view) {
   // Draw World Boundary (in Meters)
   // User wanted this over everything
   DrawRectangleLinesEx({0, 0, width, height}, 0.1f, BLACK);
 
-  // Draw Grid
+  // Draw Grid (clipped to the view: a long map has hundreds of thousands of lines)
   if (showGrid) {
     // Grid lines every 1 meter
     float spacing = 1.0f;
+    float x0 = std::max(0.0f, std::floor(view.x));
+    float x1 = std::min(width, view.x + view.width);
+    float y0 = std::max(0.0f, std::floor(view.y));
+    float y1 = std::min(height, view.y + view.height);
 
-    for (float x = 0; x <= width; x += spacing) {
-      DrawLineV({x, 0}, {x, height}, Fade(LIGHTGRAY, 0.3f));
+    for (float x = x0; x <= x1; x += spacing) {
+      DrawLineV({x, y0}, {x, y1}, Fade(LIGHTGRAY, 0.3f));
     }
-    for (float y = 0; y <= height; y += spacing) {
-      DrawLineV({0, y}, {width, y}, Fade(LIGHTGRAY, 0.3f));
+    for (float y = y0; y <= y1; y += spacing) {
+      DrawLineV({x0, y}, {x1, y}, Fade(LIGHTGRAY, 0.3f));
     }
   }
 }
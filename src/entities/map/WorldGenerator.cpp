@@ -1,6 +1,7 @@
 #include "entities/map/WorldGenerator.hpp"
 #include "config.hpp"
 #include "core/Logger.hpp"
+#include "core/Random.hpp"
 #include "entities/map/Modules.hpp"
 #include "raymath.h"
 #include <algorithm>
@@ -10,6 +11,9 @@
 /**
  * @file WorldGenerator.cpp
  * @brief Implementation of the procedural generation algorithm.
+ *
+ * Every step is a single pass over the plan (no rescans of the module list), so generation time
+ * and memory grow linearly with the facility count.
  */
 
 struct PlannedUnit {
@@ -19,18 +23,27 @@ struct PlannedUnit {
 };
 
 GeneratedMap WorldGenerator::generate(const MapConfig &config) {
+  Random random;
+  return generate(config, random);
+}
+
+GeneratedMap WorldGenerator::generate(const MapConfig &config, Random &random) {
   Logger::Info("Generating World...");
 
   std::vector<std::unique_ptr<Module>> modules;
   std::vector<PlannedUnit> plan;
-  std::random_device rd;
-  std::mt19937 gen(rd());
+  std::mt19937 &gen = random.getEngine();
 
   int smallParkingLeft = config.smallParkingCount;
   int largeParkingLeft = config.largeParkingCount;
   int smallChargingLeft = config.smallChargingCount;
   int largeChargingLeft = config.largeChargingCount;
 
+  // Upper bounds: one unit per facility, each unit may be preceded by a spacer road
+  size_t facilityCount = (size_t)smallParkingLeft + largeParkingLeft + smallChargingLeft + largeChargingLeft;
+  plan.reserve(facilityCount);
+  modules.reserve(facilityCount * 3 + 8);
+
   auto createFacility = [&](int type, int size, bool isTop) -> std::unique_ptr<Module> {
     if (type == 0) {
       if (size == 0)
@@ -46,18 +59,19 @@ GeneratedMap WorldGenerator::generate(const MapConfig &config) {
   };
 
   auto getNextFacility = [&](bool isTop) -> std::unique_ptr<Module> {
-    std::vector<int> available;
+    int available[4];
+    int availableCount = 0;
     if (smallParkingLeft > 0)
-      available.push_back(0);
+      available[availableCount++] = 0;
     if (largeParkingLeft > 0)
-      available.push_back(1);
+      available[availableCount++] = 1;
     if (smallChargingLeft > 0)
-      available.push_back(2);
+      available[availableCount++] = 2;
     if (largeChargingLeft > 0)
-      available.push_back(3);
-    if (available.empty())
+      available[availableCount++] = 3;
+    if (availableCount == 0)
       return nullptr;
-    std::uniform_int_distribution<> dist(0, (int)available.size() - 1);
+    std::uniform_int_distribution<> dist(0, availableCount - 1);
     int choice = available[dist(gen)];
     if (choice == 0) {
       smallParkingLeft--;
@@ -111,13 +125,23 @@ GeneratedMap WorldGenerator::generate(const MapConfig &config) {
   float safeX_bottom = -1e6f;
   float safeX_road = -1e6f;
 
+  // Bounding box of everything placed so far, kept up to date by addPlaced()
+  float minX = 1e9f, minY = 1e9f, maxX = -1e9f, maxY = -1e9f;
+  auto addPlaced = [&](std::unique_ptr<Module> mod) {
+    minX = std::min(minX, mod->worldPosition.x);
+    minY = std::min(minY, mod->worldPosition.y);
+    maxX = std::max(maxX, mod->worldPosition.x + mod->getWidth());
+    maxY = std::max(maxY, mod->worldPosition.y + mod->getHeight());
+    modules.push_back(std::move(mod));
+  };
+
   auto placeRoadAt = [&](float &x, float y) {
     auto road = std::make_unique<NormalRoad>();
     const auto *leftAtt = road->getAttachmentPointByNormal({-1, 0});
     const auto *rightAtt = road->getAttachmentPointByNormal({1, 0});
     road->worldPosition = {x - leftAtt->position.x, y - leftAtt->position.y};
     x += (rightAtt->position.x - leftAtt->position.x);
-    modules.push_back(std::move(road));
+    addPlaced(std::move(road));
   };
 
   // START PADDING: One extra road inside the world at the start
@@ -157,7 +181,7 @@ GeneratedMap WorldGenerator::generate(const MapConfig &config) {
       const auto *fAtt = fac->getAttachmentPointByNormal(Vector2Scale(normal, -1.0f));
       fac->worldPosition = Vector2Subtract(Vector2Add(unit.road->worldPosition, rAtt->position), fAtt->position);
       sideSafeX = fac->worldPosition.x + fac->getWidth();
-      modules.push_back(std::move(fac));
+      addPlaced(std::move(fac));
     };
 
     placeFac(unit.topFacility, {0, -1}, safeX_top);
@@ -166,15 +190,12 @@ GeneratedMap WorldGenerator::generate(const MapConfig &config) {
     const auto *rR = unit.road->getAttachmentPointByNormal({1, 0});
     currentX = unit.road->worldPosition.x + rR->position.x;
     safeX_road = currentX;
-    modules.push_back(std::move(unit.road));
+    addPlaced(std::move(unit.road));
   }
 
   // 3. TAIL PADDING
-  float facMaxX = currentX;
-  for (const auto &mod : modules)
-    facMaxX = std::max(facMaxX, mod->worldPosition.x + mod->getWidth());
-
-  // Ensure road covers all facilities
+  // Ensure road covers all facilities (maxX is the right edge of everything placed)
+  float facMaxX = std::max(currentX, maxX);
   while (currentX < (facMaxX - 0.1f))
     placeRoadAt(currentX, startY);
 
@@ -182,13 +203,6 @@ GeneratedMap WorldGenerator::generate(const MapConfig &config) {
   placeRoadAt(currentX, startY);
 
   // 4. WORLD BOUNDS & TILE ALIGNMENT
-  float minX = 1e9f, minY = 1e9f, maxX = -1e9f, maxY = -1e9f;
-  for (const auto &mod : modules) {
-    minX = std::min(minX, mod->worldPosition.x);
-    minY = std::min(minY, mod->worldPosition.y);
-    maxX = std::max(maxX, mod->worldPosition.x + mod->getWidth());
-    maxY = std::max(maxY, mod->worldPosition.y + mod->getHeight());
-  }
 
   float tileM = (float)Config::BACKGROUND_TILE_SIZE / (float)Config::ART_PIXELS_PER_METER;
 
@@ -226,12 +240,18 @@ GeneratedMap WorldGenerator::generate(const MapConfig &config) {
   extL->worldPosition = {-attL->position.x, finalRoadY - attL->position.y};
   modules.push_back(std::move(extL));
 
-  // External Right: Connects to X=worldWidth
+  // External Right: Connects to the end of the strip (at or past X=worldWidth)
   auto extR = std::make_unique<NormalRoad>();
   const auto *attR = extR->getAttachmentPointByNormal({-1, 0});
-  extR->worldPosition = {worldWidth - attR->position.x, finalRoadY - attR->position.y};
+  extR->worldPosition = {currentX + offsetX - attR->position.x, finalRoadY - attR->position.y};
   modules.push_back(std::move(extR));
 
-  auto world = std::make_unique<World>(worldWidth, worldHeight);
+  Logger::Info("WorldGenerator: {} facilities, {} modules, {:.0f}m x {:.0f}m", facilityCount, modules.size(),
+               worldWidth, worldHeight);
+
+  for (auto &module : modules)
+    module->randomizePrices(random);
+
+  auto world = std::make_unique<World>(worldWidth, worldHeight, random);
   return {std::move(world), std::move(modules)};
 }
@@ -1,18 +1,53 @@
 #include "core/Application.hpp"
+#include "core/LaunchOptions.hpp"
 #include "core/Logger.hpp"
+#include "core/Replay.hpp"
+#include <cstdio>
 #include <exception>
+#include <string>
+
+namespace {
+/**
+ * @brief Plays a recording headless and reports whether it reproduced the recorded states.
+ * @return 0 if every state hash matched, 1 on divergence.
+ */
+int runReplay(const std::string &path) {
+  ReplayRecording recording = ReplayRecording::loadFrom(path);
+  std::printf("Replaying %s: %llu ticks, %zu events, seed %llu\n", path.c_str(),
+              (unsigned long long)recording.tickCount, recording.entries.size(),
+              (unsigned long long)recording.seed);
+
+  // Per-car info messages would dominate the run time
+  Logger::SetLevel(Logger::Level::Warning);
+  ReplayResult result = ReplayPlayer::play(recording);
+
+  if (result.diverged) {
+    std::printf("DIVERGED at tick %llu (expected hash %016llx, got %016llx) after %zu matching hashes\n",
+                (unsigned long long)result.divergedAtTick, (unsigned long long)result.expectedHash,
+                (unsigned long long)result.actualHash, result.hashesChecked);
+    return 1;
+  }
+  std::printf("OK: %llu ticks, %zu hashes matched in %.2f s\n", (unsigned long long)result.ticks,
+              result.hashesChecked, result.wallSeconds);
+  return 0;
+}
+} // namespace
 
 /**
  * @brief Main entry point of the application.
  *
- * Initializes the Application instance and runs the game loop.
- * Catches and logs any unhandled exceptions.
+ * Parses the launch options, initializes the Application instance and runs the game loop
+ * (or plays a recording headless when --replay is given).
+ * Catches and logs any unhandled exceptions (including invalid options).
  *
- * @return 0 on success, -1 on error.
+ * @return 0 on success, 1 if a replay diverged, -1 on error.
  */
-int main() {
+int main(int argc, char **argv) {
   try {
-    Application app;
+    LaunchOptions options = LaunchOptions::parse(argc, argv);
+    if (!options.replayPath.empty())
+      return runReplay(options.replayPath);
+    Application app(options);
     app.run();
   } catch (const std::exception &e) {
     Logger::Error("Fatal Error: {}", e.what());
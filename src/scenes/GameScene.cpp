@@ -1,15 +1,20 @@
 #include "scenes/GameScene.hpp"
 #include "systems/TrackingSystem.hpp"
 #include "config.hpp"
+#include "core/Checkpoint.hpp"
 #include "core/EntityManager.hpp"
 #include "core/Logger.hpp"
+#include "core/Replay.hpp"
+#include "core/SimulationThread.hpp"
 #include "events/GameEvents.hpp"
 #include "events/InputEvents.hpp"
 #include "raymath.h"
 #include "systems/CameraSystem.hpp"
+#include "systems/MetricsRecorder.hpp"
 #include "systems/TrafficSystem.hpp"
 #include "ui/GameHUD.hpp"
 #include <format>
+#include <random>
 
 /**
  * @file GameScene.cpp
@@ -21,18 +26,30 @@
 
 GameScene::GameScene(std::shared_ptr<EventBus> bus, MapConfig config) : eventBus(bus), config(config) {}
 
-GameScene::~GameScene() { Logger::Info("GameScene Destroyed"); }
+GameScene::~GameScene() {
+  // The simulation thread uses every system below; it has to go first.
+  stopSimulation();
+  Logger::Info("GameScene Destroyed");
+}
 
 void GameScene::load() {
   Logger::Info("Loading GameScene (Generated World)...");
 
-  trackingSystem = std::make_unique<TrackingSystem>(eventBus);
-
   // Initialize Managers
   cameraSystem = std::make_unique<CameraSystem>(eventBus);
   entityManager = std::make_unique<EntityManager>(eventBus);
+  trackingSystem = std::make_unique<TrackingSystem>(eventBus, *entityManager);
   trafficSystem = std::make_unique<TrafficSystem>(eventBus, *entityManager);
-  gameHUD = std::make_unique<GameHUD>(eventBus, entityManager.get());
+  metricsRecorder = std::make_unique<MetricsRecorder>(eventBus, *entityManager);
+  gameHUD = std::make_unique<GameHUD>(eventBus, entityManager.get(), metricsRecorder.get());
+
+  // Seed explicitly so the session can be recorded and replayed (F7 saves the recording).
+  // The recorder comes last: it hashes the state after every other system has ticked.
+  std::random_device device;
+  uint64_t seed = ((uint64_t)device() << 32) | device();
+  entityManager->getRandom().reseed(seed);
+  replayRecorder = std::make_unique<ReplayRecorder>(eventBus, *entityManager, seed, config);
+  Logger::Info("GameScene: Simulation seed {}", seed);
 
   // Generate World via Event
   eventBus->publish(GenerateWorldEvent{config});
@@ -49,6 +66,39 @@ void GameScene::load() {
       Logger::Info("Switching to MainMenu");
       eventBus->publish(SceneChangeEvent{SceneType::MainMenu, {}});
     }
+    if (e.key == KEY_E) {
+      eventBus->publish(ExportMetricsEvent{});
+    }
+    if (e.key == KEY_F5) {
+      eventBus->publish(SaveMapEvent{Config::Map::SAVE_PATH});
+    }
+    // Input is dispatched under the simulation lock, so the state is consistent here
+    if (e.key == KEY_F6) {
+      try {
+        Checkpoint checkpoint = Checkpoint::capture(*entityManager, *trafficSystem);
+        checkpoint.saveTo(Config::Checkpoint::PATH);
+        Logger::Info("GameScene: Checkpoint saved to {} ({} bytes)", Config::Checkpoint::PATH, checkpoint.size());
+      } catch (const std::exception &ex) {
+        Logger::Error("GameScene: {}", ex.what());
+      }
+    }
+    if (e.key == KEY_F7) {
+      try {
+        replayRecorder->getRecording().saveTo(Config::Replay::PATH);
+        Logger::Info("GameScene: Replay of {} ticks saved to {}", replayRecorder->getRecording().tickCount,
+                     Config::Replay::PATH);
+      } catch (const std::exception &ex) {
+        Logger::Error("GameScene: {}", ex.what());
+      }
+    }
+    if (e.key == KEY_F9) {
+      try {
+        Checkpoint::loadFrom(Config::Checkpoint::PATH).restore(*entityManager, *trafficSystem);
+        Logger::Info("GameScene: Checkpoint restored from {}", Config::Checkpoint::PATH);
+      } catch (const std::exception &ex) {
+        Logger::Error("GameScene: {}", ex.what());
+      }
+    }
     if (e.key == KEY_P) {
       if (isPaused) {
         eventBus->publish(GameResumedEvent{});
@@ -61,8 +111,20 @@ void GameScene::load() {
   eventTokens.push_back(
       eventBus->subscribe<KeyReleasedEvent>([this](const KeyReleasedEvent &e) { keysDown.erase(e.key); }));
 
-  eventTokens.push_back(eventBus->subscribe<GamePausedEvent>([this](const GamePausedEvent &) { isPaused = true; }));
-  eventTokens.push_back(eventBus->subscribe<GameResumedEvent>([this](const GameResumedEvent &) { isPaused = false; }));
+  eventTokens.push_back(eventBus->subscribe<GamePausedEvent>([this](const GamePausedEvent &) {
+    isPaused = true;
+    if (simulationThread)
+      simulationThread->setPaused(true);
+  }));
+  eventTokens.push_back(eventBus->subscribe<GameResumedEvent>([this](const GameResumedEvent &) {
+    isPaused = false;
+    if (simulationThread)
+      simulationThread->setPaused(false);
+  }));
+  eventTokens.push_back(eventBus->subscribe<SimulationSpeedChangedEvent>([this](const SimulationSpeedChangedEvent &e) {
+    if (simulationThread)
+      simulationThread->setSpeedMultiplier(e.speedMultiplier);
+  }));
 
   // Mouse Click Handling
   eventTokens.push_back(eventBus->subscribe<MouseClickEvent>([this](const MouseClickEvent &e) {
@@ -74,79 +136,46 @@ void GameScene::load() {
       // e.position is already in Logical Coordinates (thanks to InputSystem)
       Vector2 worldPos = GetScreenToWorld2D(e.position, renderCamera);
 
+      // Nearest car, else the facility (and spot) under the cursor, from the chunks around the point
       EntitySelectedEvent selectionEvent;
-      selectionEvent.type = SelectionType::GENERAL; // Default
-
-      bool found = false;
-
-      // 1. Check Cars
-      if (entityManager) {
-        for (const auto &car : entityManager->getCars()) {
-          Vector2 pos = car->getPosition();
-          // Check distance in World Space (Meters)
-          // Car radius ~0.5m - 1.0m?
-          // Using 0.8m as clickable radius
-          if (CheckCollisionPointCircle(worldPos, pos, 0.8f)) {
-            selectionEvent.type = SelectionType::CAR;
-            selectionEvent.car = car.get();
-            found = true;
-            break;
-          }
-        }
-
-        // 2. Check Facilities
-        if (!found) {
-          for (const auto &mod : entityManager->getModules()) {
-            Rectangle rec = {mod->worldPosition.x, mod->worldPosition.y, mod->getWidth(), mod->getHeight()};
-
-            if (CheckCollisionPointRec(worldPos, rec)) {
-              selectionEvent.type = SelectionType::FACILITY;
-              selectionEvent.module = mod.get();
-              found = true;
-
-              // 3. Check Spots logic
-              int bestSpotIndex = -1;
-              float minDistSq = 1000000.0f;
-              // TUNING: Spot click radius in meters
-              float threshold = 4.0f;
-              float thresholdSq = threshold * threshold;
-
-              for (size_t i = 0; i < mod->getSpotCount(); i++) {
-                Spot s = mod->getSpot(i);
-                Vector2 spotWorldPos = {mod->worldPosition.x + s.localPosition.x,
-                                        mod->worldPosition.y + s.localPosition.y};
-
-                float dSq = Vector2DistanceSqr(worldPos, spotWorldPos);
-                if (dSq < thresholdSq && dSq < minDistSq) {
-                  minDistSq = dSq;
-                  bestSpotIndex = (int)i;
-                }
-              }
-
-              if (bestSpotIndex != -1) {
-                selectionEvent.type = SelectionType::SPOT;
-                selectionEvent.module = mod.get();
-                selectionEvent.spotIndex = bestSpotIndex;
-              }
-
-              break;
-            }
-          }
-        }
-      }
+      if (entityManager)
+        selectionEvent = entityManager->pick(worldPos);
 
       eventBus->publish(selectionEvent);
     }
   }));
 
   // Camera Zoom is now handled by CameraSystem
+
+  // Hand the fixed-timestep loop to a dedicated thread. The main loop keeps rendering and only
+  // reads the snapshots published after each batch of ticks.
+  if (Config::Simulation::THREADED) {
+    simulationThread = std::make_unique<SimulationThread>(
+        [this](double dt) { eventBus->publish(GameUpdateEvent{dt}); },
+        [this](double fraction, double tickInterval) { entityManager->publishSnapshot(fraction, tickInterval); });
+    simulationThread->start();
+  }
 }
 
 void GameScene::unload() {
+  stopSimulation();
   entityManager->clear();
   eventTokens.clear();
 }
 
+void GameScene::stopSimulation() {
+  if (simulationThread) {
+    simulationThread->stop();
+    simulationThread.reset();
+  }
+}
+
+std::unique_lock<std::mutex> GameScene::lockSimulation() {
+  if (simulationThread)
+    return simulationThread->lock();
+  return {};
+}
+
 void GameScene::handleInput() {
   // Camera movement is now handled by CameraSystem
 
@@ -159,19 +188,33 @@ void GameScene::handleInput() {
 void GameScene::update(double dt) {
   gameHUD->update(dt);
 
+  if (simulationThread)
+    return; // Ticks run on the simulation thread
+
   if (!isPaused) {
     eventBus->publish(GameUpdateEvent{dt});
   }
+  // Ticking in lockstep with rendering: the latest state is always the one to draw.
+  entityManager->publishSnapshot(1.0, 0.0);
 }
 
 void GameScene::draw() {
   handleInput();
 
+  // Camera panning and tracking follow the rendered frames, not the simulation ticks
+  eventBus->publish(FrameUpdateEvent{GetFrameTime()});
+
   // Create a render camera that applies the PPM scaling
   eventBus->publish(BeginCameraEvent{});
   ClearBackground(RAYWHITE);
 
-  eventBus->publish(DrawWorldEvent{});
+  // Visible world area, so only the chunks around the camera are drawn
+  Camera2D renderCamera = cameraSystem->getCamera();
+  renderCamera.zoom *= Config::PPM;
+  Vector2 topLeft = GetScreenToWorld2D({0, 0}, renderCamera);
+  Vector2 bottomRight =
+      GetScreenToWorld2D({(float)Config::LOGICAL_WIDTH, (float)Config::LOGICAL_HEIGHT}, renderCamera);
+  eventBus->publish(DrawWorldEvent{{topLeft.x, topLeft.y, bottomRight.x - topLeft.x, bottomRight.y - topLeft.y}});
 
   eventBus->publish(EndCameraEvent{});
 
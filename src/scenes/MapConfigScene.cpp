@@ -42,7 +42,7 @@ void MapConfigScene::load() {
     });
 
     incBtn->setOnClick([&value, dispBtn, label]() {
-      if (value < 5)
+      if (value < Config::Map::UI_MAX_PER_TYPE)
         value++;
       dispBtn->setText(label + ": " + std::to_string(value));
     });
@@ -28,6 +28,12 @@ void SceneManager::render() {
     currentScene->draw();
 }
 
+std::unique_lock<std::mutex> SceneManager::lockSimulation() {
+  if (currentScene)
+    return currentScene->lockSimulation();
+  return {};
+}
+
 void SceneManager::setScene(SceneType type) {
   if (currentScene) {
     currentScene->unload();
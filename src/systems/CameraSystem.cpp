@@ -17,6 +17,7 @@ CameraSystem::CameraSystem(std::shared_ptr<EventBus> bus) : eventBus(bus) {
 
   // Subscribe to Zoom Event
   eventTokens.push_back(eventBus->subscribe<CameraZoomEvent>([this](const CameraZoomEvent &e) {
+    std::scoped_lock lock(cameraMutex);
     // Multiplicative Zoom for "more linear and granular" feel at different levels
     // e.zoomDelta is usually +/- 0.1
     // We want step to be small, e.g. 5-10%
@@ -32,34 +33,34 @@ CameraSystem::CameraSystem(std::shared_ptr<EventBus> bus) : eventBus(bus) {
       camera.zoom = 5.0f;
   }));
 
-  // Subscribe to Move Event
+  // Subscribe to Move Event (keyboard panning is in update() below)
   eventTokens.push_back(eventBus->subscribe<CameraMoveEvent>([this](const CameraMoveEvent &e) {
-    if (this->isTracking) {
-      camera.target = e.delta;
-    } else {
-    // Correct for speed multiplier if this comes from update loop?
-    // Actually CameraMoveEvent comes mainly from external (if any).
-    // Standard movement is in update() below.
-    camera.target.x += e.delta.x;
-    camera.target.y += e.delta.y;
+    std::scoped_lock lock(cameraMutex);
+    if (!this->isTracking) {
+      camera.target.x += e.delta.x;
+      camera.target.y += e.delta.y;
     }
   }));
 
+  // Tracked car position, once per frame
+  eventTokens.push_back(eventBus->subscribe<CameraFollowEvent>([this](const CameraFollowEvent &e) {
+    std::scoped_lock lock(cameraMutex);
+    if (this->isTracking)
+      camera.target = e.target;
+  }));
+
   // Track Keys
-  eventTokens.push_back(
-      eventBus->subscribe<KeyPressedEvent>([this](const KeyPressedEvent &e) { keysDown.insert(e.key); }));
-  eventTokens.push_back(
-      eventBus->subscribe<KeyReleasedEvent>([this](const KeyReleasedEvent &e) { keysDown.erase(e.key); }));
-
-  // Subscribe to Speed Change
-  eventTokens.push_back(eventBus->subscribe<SimulationSpeedChangedEvent>([this](const SimulationSpeedChangedEvent &e) {
-    speedMultiplier = e.speedMultiplier;
-    if (speedMultiplier < 0.1)
-      speedMultiplier = 1.0; // Safety
+  eventTokens.push_back(eventBus->subscribe<KeyPressedEvent>([this](const KeyPressedEvent &e) {
+    std::scoped_lock lock(cameraMutex);
+    keysDown.insert(e.key);
+  }));
+  eventTokens.push_back(eventBus->subscribe<KeyReleasedEvent>([this](const KeyReleasedEvent &e) {
+    std::scoped_lock lock(cameraMutex);
+    keysDown.erase(e.key);
   }));
 
-  // Subscribe to GameUpdateEvent
-  eventTokens.push_back(eventBus->subscribe<GameUpdateEvent>([this](const GameUpdateEvent &e) { this->update(e.dt); }));
+  // Pan once per rendered frame with the real frame time, independent of the simulation speed
+  eventTokens.push_back(eventBus->subscribe<FrameUpdateEvent>([this](const FrameUpdateEvent &e) { this->update(e.dt); }));
 
   // Subscribe to WorldBoundsEvent
   eventTokens.push_back(eventBus->subscribe<WorldBoundsEvent>([this](const WorldBoundsEvent &e) {
@@ -70,7 +71,7 @@ CameraSystem::CameraSystem(std::shared_ptr<EventBus> bus) : eventBus(bus) {
 
   // Subscribe to Render Events
   eventTokens.push_back(eventBus->subscribe<BeginCameraEvent>([this](const BeginCameraEvent &) {
-    Camera2D renderCamera = camera;
+    Camera2D renderCamera = getCamera();
     renderCamera.zoom *= Config::PPM;
     BeginMode2D(renderCamera);
   }));
@@ -79,6 +80,7 @@ CameraSystem::CameraSystem(std::shared_ptr<EventBus> bus) : eventBus(bus) {
 
  // --- New tracking logic implementation ---
   eventTokens.push_back(eventBus->subscribe<TrackingStatusEvent>([this](const TrackingStatusEvent& e) {
+    std::scoped_lock lock(cameraMutex);
     this->isTracking = e.isTracking;
     if (!this->isTracking) {
         // Reset zoom to normal when tracking stops
@@ -98,17 +100,18 @@ CameraSystem::CameraSystem(std::shared_ptr<EventBus> bus) : eventBus(bus) {
 CameraSystem::~CameraSystem() { eventTokens.clear(); }
 
 void CameraSystem::setWorldBounds(float width, float height) {
+  std::scoped_lock lock(cameraMutex);
   worldWidth = width;
   worldHeight = height;
   boundsSet = true;
 }
 
 void CameraSystem::update(double dt) {
+  std::scoped_lock lock(cameraMutex);
 
   if (isTracking) return;
-  // Handle Input
-  // Compensate for Simulation Speed so camera moves at Real-Time speed
-  float effectiveDt = (float)dt / (float)speedMultiplier;
+  // Handle Input (dt is real frame time)
+  float effectiveDt = (float)dt;
 
   float speed = 20.0f / camera.zoom;
   Vector2 delta = {0, 0};
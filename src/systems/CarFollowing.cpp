@@ -0,0 +1,39 @@
+#include "systems/CarFollowing.hpp"
+#include "config.hpp"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @file CarFollowing.cpp
+ * @brief Intelligent Driver Model.
+ */
+
+float CarFollowing::acceleration(float speed, float desiredSpeed, float gap, float approachRate) {
+  using namespace Config::CarAI::Idm;
+  float ratio = speed / std::max(desiredSpeed, 0.1f);
+  float ratioSq = ratio * ratio;
+  float accel = MAX_ACCELERATION * (1.0f - ratioSq * ratioSq);
+
+  if (std::isfinite(gap)) {
+    float brakingTerm = 2.0f * std::sqrt(MAX_ACCELERATION * COMFORT_BRAKING);
+    float dynamicGap = speed * TIME_GAP + speed * approachRate / brakingTerm;
+    float desiredGap = MIN_GAP + std::max(0.0f, dynamicGap);
+    float pressure = desiredGap / std::max(gap, 0.1f);
+    accel -= MAX_ACCELERATION * pressure * pressure;
+  }
+  return std::max(accel, -MAX_BRAKING);
+}
+
+float CarFollowing::advance(float &speed, float acceleration, double dt) {
+  float t = (float)dt;
+  float next = speed + acceleration * t;
+  if (next < 0.0f) {
+    // Stops within the tick: drive the stopping distance only
+    float distance = acceleration < 0.0f ? -speed * speed / (2.0f * acceleration) : 0.0f;
+    speed = 0.0f;
+    return distance;
+  }
+  float distance = (speed + next) * 0.5f * t;
+  speed = next;
+  return distance;
+}
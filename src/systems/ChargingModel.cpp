@@ -0,0 +1,62 @@
+#include "systems/ChargingModel.hpp"
+#include "config.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+/**
+ * @file ChargingModel.cpp
+ * @brief Inversion of the charging exit hazard.
+ */
+
+float ChargingModel::exitDelay(float batteryLevel, const SimulationParams &params, float u) {
+  constexpr double INF = std::numeric_limits<double>::infinity();
+  const double start = batteryLevel;
+  const double rate = params.chargingRate;
+  const double exitLevel = params.batteryExitThreshold;
+  const double forceLevel = params.batteryForceExitThreshold;
+  const double full = 100.0;
+
+  // Forced exit: first moment the battery is above the force-exit threshold
+  double forcedAt = INF;
+  if (start > forceLevel)
+    forcedAt = 0.0;
+  else if (rate > 0.0 && forceLevel < full)
+    forcedAt = (forceLevel - start) / rate;
+
+  // Random exit: cumulative hazard H(t) = slope * integral of the excess over the exit threshold
+  double randomAt = INF;
+  double range = forceLevel - exitLevel;
+  if (range > 0.0 && exitLevel < full) {
+    double slope = 0.5 / range;
+    double target = -std::log((double)std::clamp(u, std::numeric_limits<float>::min(), 1.0f));
+
+    // Excess grows from 'excess' at 'reachAt' until the battery is full at 'fullAt'
+    double reachAt = start >= exitLevel ? 0.0 : (rate > 0.0 ? (exitLevel - start) / rate : INF);
+    double excess = std::max(0.0, start - exitLevel);
+    double fullAt = rate > 0.0 ? std::max(reachAt, (full - start) / rate) : INF;
+
+    if (reachAt < INF) {
+      double s = INF;
+      if (rate > 0.0)
+        s = (-excess + std::sqrt(excess * excess + 2.0 * rate * target / slope)) / rate;
+      else if (excess > 0.0)
+        s = target / (slope * excess);
+
+      if (reachAt + s <= fullAt) {
+        randomAt = reachAt + s;
+      } else {
+        // Battery full: the hazard stays at its maximum from then on
+        double ramp = fullAt - reachAt;
+        double rampHazard = slope * (excess * ramp + 0.5 * rate * ramp * ramp);
+        randomAt = fullAt + (target - rampHazard) / (slope * (full - exitLevel));
+      }
+    }
+  }
+
+  return (float)std::min({forcedAt, randomAt, (double)Config::MAX_CHARGING_SESSION});
+}
+
+float ChargingModel::sampleExitDelay(float batteryLevel, const SimulationParams &params, Random &random) {
+  return exitDelay(batteryLevel, params, 1.0f - random.uniformFloat(0.0f, 1.0f));
+}
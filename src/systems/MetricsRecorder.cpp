@@ -0,0 +1,193 @@
+#include "systems/MetricsRecorder.hpp"
+#include "config.hpp"
+#include "core/EntityManager.hpp"
+#include "core/Logger.hpp"
+#include "events/GameEvents.hpp"
+#include <fstream>
+
+/**
+ * @file MetricsRecorder.cpp
+ * @brief Implementation of the metrics sampler.
+ */
+
+MetricsRecorder::MetricsRecorder(std::shared_ptr<EventBus> bus, const EntityManager &em)
+    : eventBus(bus), entityManager(em) {
+  series.reserve(METRIC_COUNT);
+  for (size_t i = 0; i < METRIC_COUNT; ++i) {
+    series.emplace_back(Config::Metrics::BUCKETS_PER_TIER, Config::Metrics::TIERS, Config::Metrics::TIER_FACTOR);
+  }
+
+  eventTokens.push_back(eventBus->subscribe<GameUpdateEvent>([this](const GameUpdateEvent &e) {
+    simTime += e.dt;
+    if (++tickCount % Config::Metrics::SAMPLE_INTERVAL_TICKS == 0) {
+      this->sample();
+    }
+  }));
+
+  eventTokens.push_back(
+      eventBus->subscribe<CarSpawnedEvent>([this](const CarSpawnedEvent &) { spawnsInInterval++; }));
+
+  eventTokens.push_back(eventBus->subscribe<SpawnQueueChangedEvent>(
+      [this](const SpawnQueueChangedEvent &e) { spawnQueueLength = e.length; }));
+
+  eventTokens.push_back(eventBus->subscribe<SpotStateChangedEvent>([this](const SpotStateChangedEvent &e) {
+    this->onSpotStateChanged(e.module, e.spotIndex, e.previous, e.current, e.price);
+  }));
+
+  eventTokens.push_back(
+      eventBus->subscribe<ExportMetricsEvent>([this](const ExportMetricsEvent &) { this->exportFiles(); }));
+
+  // After a checkpoint restore the spots changed without transitions: stays in progress are
+  // counted from now on
+  eventTokens.push_back(eventBus->subscribe<CheckpointRestoredEvent>([this](const CheckpointRestoredEvent &) {
+    occupiedSince.clear();
+    for (const Module *facility : entityManager.getOccupancyStats().getFacilities()) {
+      for (int i = 0; i < (int)facility->getSpotCount(); ++i) {
+        if (facility->getSpot(i).state == SpotState::OCCUPIED)
+          occupiedSince[SpotKey{facility, i}] = simTime;
+      }
+    }
+  }));
+}
+
+void MetricsRecorder::onSpotStateChanged(const Module *module, int spotIndex, SpotState previous, SpotState current,
+                                         float price) {
+  SpotKey key{module, spotIndex};
+
+  if (current == SpotState::OCCUPIED) {
+    occupiedSince[key] = simTime;
+    return;
+  }
+
+  if (previous != SpotState::OCCUPIED)
+    return;
+
+  // A stay ended: dwell time, revenue and (for chargers) a completed charging session
+  auto it = occupiedSince.find(key);
+  if (it != occupiedSince.end()) {
+    dwellSumInInterval += simTime - it->second;
+    dwellCountInInterval++;
+    occupiedSince.erase(it);
+  }
+
+  revenueInInterval += price; // As quoted to the car, not the spot's current (surged) price
+  if (OccupancyStats::isCharging(module->getType())) {
+    chargingSessionsInInterval++;
+  }
+}
+
+void MetricsRecorder::sample() {
+  const OccupancyCounters &c = entityManager.getOccupancyStats().getCounters();
+  float occupancy = c.totalSpots > 0 ? (float)c.occupiedSpots / c.totalSpots * 100.0f : 0.0f;
+
+  // Counted per chunk at the end of every tick (cars outside active chunks are all parked)
+  int inTransit = entityManager.getChunkGrid().getMovingCarCount();
+
+  if (dwellCountInInterval > 0) {
+    lastAverageDwell = (float)(dwellSumInInterval / dwellCountInInterval);
+  }
+
+  // Normalize interval totals to "per simulated minute"
+  double minutes = (simTime - intervalStart) / 60.0;
+  float perMinute = minutes > 0.0 ? (float)(1.0 / minutes) : 0.0f;
+
+  {
+    std::scoped_lock lock(mutex);
+    series[(size_t)Metric::OCCUPANCY].add(occupancy);
+    series[(size_t)Metric::IN_TRANSIT].add((float)inTransit);
+    series[(size_t)Metric::SPAWN_RATE].add((float)spawnsInInterval * perMinute);
+    series[(size_t)Metric::AVG_DWELL].add(lastAverageDwell);
+    series[(size_t)Metric::CHARGING_THROUGHPUT].add((float)chargingSessionsInInterval * perMinute);
+    series[(size_t)Metric::REVENUE].add((float)revenueInInterval * perMinute);
+    series[(size_t)Metric::SPAWN_QUEUE].add((float)spawnQueueLength);
+  }
+
+  intervalStart = simTime;
+  spawnsInInterval = 0;
+  chargingSessionsInInterval = 0;
+  revenueInInterval = 0.0;
+  dwellSumInInterval = 0.0;
+  dwellCountInInterval = 0;
+}
+
+void MetricsRecorder::copySeries(Metric metric, size_t tier, std::vector<MetricSeries::Bucket> &out) const {
+  std::scoped_lock lock(mutex);
+  series[(size_t)metric].copyTier(tier, out);
+}
+
+float MetricsRecorder::latest(Metric metric) const {
+  std::scoped_lock lock(mutex);
+  return series[(size_t)metric].latest();
+}
+
+void MetricsRecorder::writeCsv(std::ostream &out) const {
+  std::scoped_lock lock(mutex);
+  std::vector<MetricSeries::Bucket> buckets;
+
+  out << "metric,tier,seconds_per_bucket,bucket,min,max,mean\n";
+  for (size_t m = 0; m < METRIC_COUNT; ++m) {
+    const MetricSeries &s = series[m];
+    for (size_t tier = 0; tier < s.tierCount(); ++tier) {
+      double secondsPerBucket =
+          (double)s.samplesPerBucket(tier) * Config::Metrics::SAMPLE_INTERVAL_TICKS * Config::FIXED_DELTA_TIME;
+      s.copyTier(tier, buckets);
+      for (size_t i = 0; i < buckets.size(); ++i) {
+        out << name((Metric)m) << ',' << tier << ',' << secondsPerBucket << ',' << i << ',' << buckets[i].min << ','
+            << buckets[i].max << ',' << buckets[i].mean() << '\n';
+      }
+    }
+  }
+}
+
+void MetricsRecorder::exportFiles() const {
+  std::ofstream metricsFile(Config::Metrics::EXPORT_PATH);
+  std::ofstream occupancyFile(Config::Metrics::OCCUPANCY_EXPORT_PATH);
+  if (!metricsFile || !occupancyFile) {
+    Logger::Error("MetricsRecorder: Could not open export files.");
+    return;
+  }
+  writeCsv(metricsFile);
+  entityManager.getOccupancyStats().writeCsv(occupancyFile);
+  Logger::Info("MetricsRecorder: Exported {} and {}", Config::Metrics::EXPORT_PATH,
+               Config::Metrics::OCCUPANCY_EXPORT_PATH);
+}
+
+const char *MetricsRecorder::name(Metric metric) {
+  switch (metric) {
+  case Metric::OCCUPANCY:
+    return "occupancy";
+  case Metric::IN_TRANSIT:
+    return "in_transit";
+  case Metric::SPAWN_RATE:
+    return "spawn_rate";
+  case Metric::AVG_DWELL:
+    return "avg_dwell";
+  case Metric::CHARGING_THROUGHPUT:
+    return "charging_throughput";
+  case Metric::REVENUE:
+    return "revenue";
+  case Metric::SPAWN_QUEUE:
+    return "spawn_queue";
+  default:
+    return "unknown";
+  }
+}
+
+const char *MetricsRecorder::unit(Metric metric) {
+  switch (metric) {
+  case Metric::OCCUPANCY:
+    return "%";
+  case Metric::IN_TRANSIT:
+  case Metric::SPAWN_QUEUE:
+    return "cars";
+  case Metric::SPAWN_RATE:
+  case Metric::CHARGING_THROUGHPUT:
+    return "/min";
+  case Metric::AVG_DWELL:
+    return "s";
+  case Metric::REVENUE:
+    return "$/min";
+  default:
+    return "";
+  }
+}
@@ -0,0 +1,108 @@
+#include "systems/OccupancyStats.hpp"
+#include "events/GameEvents.hpp"
+
+/**
+ * @file OccupancyStats.cpp
+ * @brief Implementation of the incremental occupancy aggregator.
+ */
+
+OccupancyStats::OccupancyStats(std::shared_ptr<EventBus> bus) {
+  eventTokens.push_back(bus->subscribe<SpotStateChangedEvent>(
+      [this](const SpotStateChangedEvent &e) { this->apply(e.module, e.previous, e.current); }));
+}
+
+void OccupancyStats::addFacility(const Module *module) {
+  ModuleType type = module->getType();
+  bool charging = isCharging(type);
+  bool parking = isParking(type);
+  if (!charging && !parking)
+    return; // Skip roads/etc
+
+  facilities.push_back(module);
+  counters.totalFacilities++;
+
+  auto counts = module->getSpotCounts();
+  int spots = counts.free + counts.reserved + counts.occupied;
+  counters.totalSpots += spots;
+  counters.occupiedSpots += counts.occupied;
+  counters.reservedSpots += counts.reserved;
+
+  if (charging) {
+    counters.chargingStations++;
+    counters.chargingSpots += spots;
+    counters.occupiedCharging += counts.occupied;
+    counters.reservedCharging += counts.reserved;
+  } else {
+    counters.parkingLots++;
+    counters.parkingSpots += spots;
+    counters.occupiedParking += counts.occupied;
+    counters.reservedParking += counts.reserved;
+  }
+}
+
+void OccupancyStats::rebuild(const std::vector<std::unique_ptr<Module>> &modules) {
+  reset();
+  for (const auto &m : modules) {
+    addFacility(m.get());
+  }
+}
+
+void OccupancyStats::reset() {
+  counters = {};
+  facilities.clear();
+}
+
+void OccupancyStats::apply(const Module *module, SpotState previous, SpotState current) {
+  if (!module || previous == current)
+    return;
+
+  int occupiedDelta = (current == SpotState::OCCUPIED) - (previous == SpotState::OCCUPIED);
+  int reservedDelta = (current == SpotState::RESERVED) - (previous == SpotState::RESERVED);
+
+  counters.occupiedSpots += occupiedDelta;
+  counters.reservedSpots += reservedDelta;
+
+  ModuleType type = module->getType();
+  if (isCharging(type)) {
+    counters.occupiedCharging += occupiedDelta;
+    counters.reservedCharging += reservedDelta;
+  } else if (isParking(type)) {
+    counters.occupiedParking += occupiedDelta;
+    counters.reservedParking += reservedDelta;
+  }
+}
+
+static const char *typeName(ModuleType type) {
+  switch (type) {
+  case ModuleType::SMALL_PARKING:
+    return "small_parking";
+  case ModuleType::LARGE_PARKING:
+    return "large_parking";
+  case ModuleType::SMALL_CHARGING:
+    return "small_charging";
+  case ModuleType::LARGE_CHARGING:
+    return "large_charging";
+  default:
+    return "other";
+  }
+}
+
+void OccupancyStats::writeCsv(std::ostream &out) const {
+  const OccupancyCounters &c = counters;
+  auto row = [&out](const char *scope, const char *type, int spots, int reserved, int occupied) {
+    out << scope << ',' << type << ',' << spots << ',' << spots - reserved - occupied << ',' << reserved << ','
+        << occupied << '\n';
+  };
+
+  out << "scope,type,spots,free,reserved,occupied\n";
+  row("global", "all", c.totalSpots, c.reservedSpots, c.occupiedSpots);
+  row("category", "parking", c.parkingSpots, c.reservedParking, c.occupiedParking);
+  row("category", "charging", c.chargingSpots, c.reservedCharging, c.occupiedCharging);
+
+  for (size_t i = 0; i < facilities.size(); ++i) {
+    auto counts = facilities[i]->getSpotCounts();
+    out << "facility_" << i << ',' << typeName(facilities[i]->getType()) << ','
+        << counts.free + counts.reserved + counts.occupied << ',' << counts.free << ',' << counts.reserved << ','
+        << counts.occupied << '\n';
+  }
+}
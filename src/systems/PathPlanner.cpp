@@ -1,5 +1,6 @@
 #include "systems/PathPlanner.hpp"
 #include "config.hpp"
+#include "core/Profiler.hpp"
 #include "raymath.h"
 #include <cmath>
 
@@ -7,126 +8,89 @@
  * @file PathPlanner.cpp
  * @brief Implementation of the Path Finding algorithms.
  *
- * Uses geometric knowledge of the modules (T-Junctions, Lane Offsets)
- * to construct Bezier-like or Linear paths made of Waypoints.
+ * The road part of a path comes from the RoadNetwork's routes; the geometry of the modules (gate
+ * depths, spot positions) gives the part inside the facility. Paths are the Waypoints where they
+ * turn or change phase; cars driven by the IDM follow a SplinePath through them.
  */
 
-// --- Constants for Waypoint Geometry ---
-
-// The horizontal center of the T-junction on an entrance road (in art pixels).
-// This is where the vertical access road meets the horizontal main road.
-static constexpr float ROAD_TJUNCTION_CENTER_X = 142.0f;
-
-// The horizontal distance from the T-junction center to the Entry/Exit lanes (in art pixels).
-// The total separation between the two vertical lanes is 36 pixels (18 * 2).
-static constexpr float ENTRANCE_LANE_OFFSET_X = 18.0f;
-
-// Helper to convert art pixels to meters
-static float P2M(float artPixels) { return artPixels / static_cast<float>(Config::ART_PIXELS_PER_METER); }
-
-std::vector<Waypoint> PathPlanner::GeneratePath(const Car *car, const Module *targetFac, const Spot &targetSpot) {
+std::vector<Waypoint> PathPlanner::GeneratePath(const RoadNetwork &network, const Car *car, const Module *targetFac,
+                                                const Spot &targetSpot) {
+  PROFILE_ZONE("PathPlanner::GeneratePath");
   std::vector<Waypoint> path;
 
-  // 1. Determine Horizontal Lane on the Main Road
-  Lane mainRoadLane = (car->getVelocity().x > 0) ? Lane::DOWN : Lane::UP;
-
-  // 2. Determine Facility Orientation and Entry Side
-  bool isUpFacility = targetFac->isUp();
-  bool useRightSideEntry = isUpFacility; // Up -> Right, Down -> Left
-
   // Track current position for segment generation
   Vector2 currentPos = car->getPosition();
 
-  // 3. Waypoint 1: Road Entry Point
-  // Phase: APPROACH
-  Module *parentRoad = targetFac->getParent();
-  Waypoint wpEntry = parentRoad ? CalculateRoadEntry(parentRoad, mainRoadLane, useRightSideEntry)
-                                : CalculateFacilityEntry(targetFac, useRightSideEntry);
-
-  // Set Angle
-  wpEntry.entryAngle = isUpFacility ? -PI / 2.0f : PI / 2.0f;
-
-  // Split the Approach:
-  // If the distance to the entry is long (> 40m), drive in HIGHWAY mode first.
-  // Then switch to APPROACH mode for the last 30m (where braking might occur).
-  float distToEntry = Vector2Distance(currentPos, wpEntry.position);
-  float approachDist = Config::CarAI::TURN_SLOWDOWN_DIST + 5.0f; // e.g. 35m
-
-  if (distToEntry > approachDist + 10.0f) {
-    // Create an intermediate "Pre-Approach" point
-    // Distance from Entry = approachDist
-    // Lerp factor = 1.0 - (approachDist / distToEntry)
-    // Actually, we want the point at (dist - approachDist)
-
-    float t = 1.0f - (approachDist / distToEntry);
-    Vector2 prePos = Vector2Lerp(currentPos, wpEntry.position, t);
-
-    // Target: Pre-Approach Point
-    // Phase: HIGHWAY
-    // Angle: 0 (Straight driving logic usually, or just point to next)
-    // Actually, entryAngle matters for the *next* turn.
-    // For this point, we are just driving straight on road.
-    // Let's set it to 0 or derive from direction.
-    // But simpler: just inherit 0.
-
-    Waypoint wpPre = wpEntry;
-    wpPre.position = prePos;
-    wpPre.entryAngle = 0.0f; // No sharp turn expected here
-    wpPre.stopAtEnd = false;
-
-    AddSegment(path, currentPos, wpPre, Config::CarAI::Phases::HIGHWAY);
-    currentPos = prePos;
+  // 1. Facility Entry Point (Gate), where the road route ends
+  Waypoint wpGate = CalculateFacilityEntry(targetFac, true);
+
+  // 2. Road Corners up to the facility's entrance lane
+  // Phase: APPROACH (HIGHWAY on the long stretches)
+  std::vector<Vector2> route;
+  int gate = network.getGate(targetFac);
+  // Empty when the car is already at the gate node
+  if (gate != -1 && network.route(currentPos, car->getVelocity(), gate, route) && !route.empty()) {
+    route.pop_back(); // The lane end at the facility, on the way to the gate waypoint
+    AddRoute(path, currentPos, route, wpGate.position, Config::CarAI::Phases::APPROACH);
   }
 
-  AddSegment(path, currentPos, wpEntry, Config::CarAI::Phases::APPROACH);
-  currentPos = wpEntry.position; // Update head
-
-  // 4. Waypoint 2: Facility Entry Point (Gate)
+  // 3. Waypoint: Gate
   // Phase: ACCESS
-  Waypoint wpGate = CalculateFacilityEntry(targetFac, useRightSideEntry);
-  wpGate.entryAngle = wpEntry.entryAngle; // Vertical
-
-  AddSegment(path, currentPos, wpGate, Config::CarAI::Phases::ACCESS);
-  currentPos = wpGate.position;
+  AddSegment(path, wpGate, Config::CarAI::Phases::ACCESS);
 
-  // 5. Waypoint 3: Alignment Point
+  // 4. Waypoint: Alignment Point
   // Phase: MANEUVER
   Waypoint wpAlign = CalculateAlignmentPoint(targetFac, targetSpot);
   wpAlign.entryAngle = targetSpot.orientation;
 
-  AddSegment(path, currentPos, wpAlign, Config::CarAI::Phases::MANEUVER);
-  currentPos = wpAlign.position;
+  AddSegment(path, wpAlign, Config::CarAI::Phases::MANEUVER);
 
-  // 6. Waypoint 4: Final Parking Spot
+  // 5. Waypoint: Final Parking Spot
   // Phase: PARKING
   Waypoint wpSpot = CalculateSpotPoint(targetFac, targetSpot);
 
-  AddSegment(path, currentPos, wpSpot, Config::CarAI::Phases::PARKING);
+  AddSegment(path, wpSpot, Config::CarAI::Phases::PARKING);
 
   return path;
 }
 
-Waypoint PathPlanner::CalculateRoadEntry(const Module *road, Lane roadLane, bool useRightSideEntry) {
-  Vector2 roadWorldPos = road->worldPosition;
-  float xCenter = P2M(ROAD_TJUNCTION_CENTER_X);
-  float xOffset = useRightSideEntry ? P2M(ENTRANCE_LANE_OFFSET_X) : -P2M(ENTRANCE_LANE_OFFSET_X);
-  float yOffset = (roadLane == Lane::DOWN) ? P2M(Config::LANE_OFFSET_DOWN) : P2M(Config::LANE_OFFSET_UP);
+void PathPlanner::AddRoute(std::vector<Waypoint> &path, Vector2 &currentPos, const std::vector<Vector2> &corners,
+                           Vector2 next, const Config::CarAI::AIPhase &phase) {
+  float approachDist = Config::CarAI::TURN_SLOWDOWN_DIST + 5.0f; // e.g. 35m
 
-  // Default tolerance/speed overridden by AddSegment
-  return Waypoint(Vector2Add(roadWorldPos, {xCenter + xOffset, yOffset}));
-}
+  for (size_t i = 0; i < corners.size(); ++i) {
+    Vector2 after = i + 1 < corners.size() ? corners[i + 1] : next;
+    Waypoint wpCorner(corners[i]);
+    wpCorner.entryAngle = atan2f(after.y - corners[i].y, after.x - corners[i].x); // Heading out of the turn
+
+    // Split the leg: if it is long (> 45m), drive in HIGHWAY mode first and switch to the phase's
+    // mode for the last 35m (where braking might occur)
+    float dist = Vector2Distance(currentPos, wpCorner.position);
+    if (dist > approachDist + 10.0f) {
+      Waypoint wpPre = wpCorner;
+      wpPre.position = Vector2Lerp(currentPos, wpCorner.position, 1.0f - (approachDist / dist));
+      wpPre.entryAngle = atan2f(wpCorner.position.y - currentPos.y, wpCorner.position.x - currentPos.x); // Straight on
+      wpPre.stopAtEnd = false;
+
+      AddSegment(path, wpPre, Config::CarAI::Phases::HIGHWAY);
+      currentPos = wpPre.position;
+    }
 
-Waypoint PathPlanner::CalculateFacilityEntry(const Module *facility, bool useRightSideEntry) {
-  // Determine Horizontal Center from Local Waypoint or Module Width
-  float xBase = facility->getWidth() / 2.0f;
-  std::vector<Waypoint> localWps = facility->getLocalWaypoints();
-  if (!localWps.empty()) {
-    xBase = localWps[0].position.x;
+    AddSegment(path, wpCorner, phase);
+    currentPos = wpCorner.position;
   }
+}
+
+Waypoint PathPlanner::CalculateFacilityEntry(const Module *facility, bool inbound) {
+  const std::vector<AttachmentPoint> &attachments = facility->getAttachmentPoints();
+  if (attachments.empty())
+    return Waypoint(Vector2Add(facility->worldPosition, {facility->getWidth() / 2.0f, facility->getHeight() / 2.0f}));
 
-  // Horizontal Offset for Lane (Left/Right entry)
-  float xOffset = useRightSideEntry ? P2M(ENTRANCE_LANE_OFFSET_X) : -P2M(ENTRANCE_LANE_OFFSET_X);
-  float finalX = facility->worldPosition.x + xBase + xOffset;
+  // The lane at the facility's attachment point (its entrance edge)
+  const AttachmentPoint &entrance = attachments.front();
+  Vector2 edge = Vector2Add(facility->worldPosition, entrance.position);
+  Vector2 inward = Vector2Scale(entrance.normal, -1.0f);
+  Vector2 lane = RoadNetwork::lanePosition(edge, inbound ? inward : entrance.normal);
 
   // Determine Depth based on Config and Type
   ModuleType type = facility->getType();
@@ -149,23 +113,11 @@ Waypoint PathPlanner::CalculateFacilityEntry(const Module *facility, bool useRig
     break;
   }
 
-  // Calculate Vertical Position relative to Physical Entrance Edge
-  // Up Facility: Top-Left at WorldPos. Entrance is at Bottom (WorldPos.y + Height).
-  // Driving IN means moving Up (-Y).
-  // Final Y = (WorldPos.y + Height) - Depth
-
-  // Down Facility: Top-Left at WorldPos. Entrance is at Top (WorldPos.y).
-  // Driving IN means moving Down (+Y).
-  // Final Y = WorldPos.y + Depth
-
-  float finalY = 0.0f;
-  if (facility->isUp()) {
-    finalY = (facility->worldPosition.y + facility->getHeight()) - depth;
-  } else {
-    finalY = facility->worldPosition.y + depth;
-  }
-
-  return Waypoint({finalX, finalY});
+  // Gate: Depth into the facility from its entrance edge, heading in or out
+  Vector2 heading = inbound ? inward : entrance.normal;
+  Waypoint wpGate(Vector2Add(lane, Vector2Scale(inward, depth)));
+  wpGate.entryAngle = atan2f(heading.y, heading.x);
+  return wpGate;
 }
 
 Waypoint PathPlanner::CalculateAlignmentPoint(const Module *facility, const Spot &spot) {
@@ -183,92 +135,87 @@ Waypoint PathPlanner::CalculateSpotPoint(const Module *facility, const Spot &spo
   return Waypoint(spotGlobal, 0.2f, spot.id, spot.orientation, true);
 }
 
-std::vector<Waypoint> PathPlanner::GenerateExitPath(const Car *car, const Module *currentFac, const Spot &currentSpot,
-                                                    bool exitRight, float finalX) {
+std::vector<Waypoint> PathPlanner::GenerateExitPath(const RoadNetwork &network, const Car * /*car*/,
+                                                    const Module *currentFac, const Spot &currentSpot, int exit) {
   std::vector<Waypoint> path;
-  Vector2 currentPos = car->getPosition();
 
   // 1. Waypoint 1: Alignment Point (Reverse)
   // Phase: MANEUVER
   Waypoint wpAlign = CalculateAlignmentPoint(currentFac, currentSpot);
   // Spot->Align is slow
-  AddSegment(path, currentPos, wpAlign, Config::CarAI::Phases::MANEUVER);
-  currentPos = wpAlign.position;
+  AddSegment(path, wpAlign, Config::CarAI::Phases::MANEUVER);
 
   // 2. Waypoint 2: Facility Exit Point (Gate)
   // Phase: ACCESS
-  bool isUpFac = currentFac->isUp();
-  bool useRightSideExit = !isUpFac;
+  Waypoint wpGate = CalculateFacilityEntry(currentFac, false);
 
-  Waypoint wpGate = CalculateFacilityEntry(currentFac, useRightSideExit);
-  wpGate.entryAngle = isUpFac ? PI / 2.0f : -PI / 2.0f;
+  AddSegment(path, wpGate, Config::CarAI::Phases::ACCESS);
+  Vector2 currentPos = wpGate.position;
 
-  AddSegment(path, currentPos, wpGate, Config::CarAI::Phases::ACCESS);
-  currentPos = wpGate.position;
+  if (exit < 0 || exit >= (int)network.getExits().size())
+    return path;
+  const RoadNetwork::Terminal &terminal = network.getExits()[exit];
 
-  // 3. Waypoint 3: Road Entry/Exit Point
+  // 3. Road Corners up to the exit
   // Phase: ACCESS
-  Module *parentRoad = currentFac->getParent();
-  if (parentRoad) {
-    Lane exitLane = exitRight ? Lane::DOWN : Lane::UP;
-    bool roadConnectorSide = !currentFac->isUp();
-
-    Waypoint wpRoad = CalculateRoadEntry(parentRoad, exitLane, roadConnectorSide);
-    wpRoad.entryAngle = exitRight ? 0.0f : PI;
-
-    AddSegment(path, currentPos, wpRoad, Config::CarAI::Phases::ACCESS);
-    currentPos = wpRoad.position;
+  std::vector<Vector2> route;
+  int from = network.getFacilityExit(currentFac);
+  if (from != -1 && network.route(from, terminal.node, route) && !route.empty()) {
+    route.pop_back(); // The exit itself
+    AddRoute(path, currentPos, route, terminal.position, Config::CarAI::Phases::ACCESS);
   }
 
   // 4. Waypoint 4: Map Edge Exit
-  // Phase: HIGHWAY (Crucial change: High density correction over long distance)
-  float yPos = 0.0f;
-  if (parentRoad) {
-    float laneOffset = (exitRight) ? P2M(Config::LANE_OFFSET_DOWN) : P2M(Config::LANE_OFFSET_UP);
-    yPos = parentRoad->worldPosition.y + laneOffset;
-  } else {
-    yPos = car->getPosition().y;
-  }
-
-  Waypoint wpEdge({finalX, yPos}, 1.0f, -1, 0.0f, true);
+  // Phase: HIGHWAY
+  Vector2 edge = Vector2Add(terminal.position, Vector2Scale(terminal.direction, Config::Roads::EXIT_OVERRUN));
+  Waypoint wpEdge(edge, 1.0f, -1, atan2f(terminal.direction.y, terminal.direction.x), true);
 
-  AddSegment(path, currentPos, wpEdge, Config::CarAI::Phases::HIGHWAY);
+  AddSegment(path, wpEdge, Config::CarAI::Phases::HIGHWAY);
 
   return path;
 }
 
-void PathPlanner::AddSegment(std::vector<Waypoint> &path, Vector2 startPos, Waypoint target,
-                             const Config::CarAI::AIPhase &phase) {
-  // 1. Calculate Segment distance
-  float dist = Vector2Distance(startPos, target.position);
-
-  // 2. Determine number of correction points
-  // If step is 15m and dist is 45m -> 3 steps -> 2 intermediate points?
-  // count = floor(dist / step)
-
-  if (phase.correctionStep > 0.0f && dist > phase.correctionStep) {
-    int steps = std::max(1, (int)(dist / phase.correctionStep));
-
-    for (int k = 1; k < steps; ++k) {
-      float t = (float)k / (float)steps;
-      Vector2 newPos = Vector2Lerp(startPos, target.position, t);
-
-      Waypoint wpCorr = target; // Inherit target properties (angle/ID potentially)
-      wpCorr.position = newPos;
-      wpCorr.id = -100; // Debug ID
-      wpCorr.stopAtEnd = false;
-
-      // Apply Phase Config
-      wpCorr.tolerance = phase.tolerance;
-      wpCorr.speedLimitFactor = phase.speedFactor;
-
-      path.push_back(wpCorr);
+std::vector<Waypoint> PathPlanner::GenerateThroughPath(const RoadNetwork &network, const Car *car) {
+  std::vector<Waypoint> path;
+  Vector2 position = car->getPosition();
+  Vector2 heading = car->getVelocity();
+
+  const std::vector<RoadNetwork::Terminal> &exits = network.getExits();
+  std::vector<Vector2> route;
+  int exit = network.findNearestExit(position, heading);
+  if (exit == -1 || !network.route(position, heading, exits[exit].node, route)) {
+    // Off the lanes: straight for the closest exit ahead, or the closest one at all
+    exit = -1;
+    float best = RoadNetwork::UNREACHABLE;
+    bool bestAhead = false;
+    for (size_t i = 0; i < exits.size(); ++i) {
+      Vector2 toExit = Vector2Subtract(exits[i].position, position);
+      bool ahead = Vector2DotProduct(toExit, heading) > 0.0f;
+      float dist = Vector2Length(toExit);
+      if ((ahead && !bestAhead) || (ahead == bestAhead && dist < best)) {
+        exit = (int)i;
+        best = dist;
+        bestAhead = ahead;
+      }
     }
+    if (exit == -1)
+      return path;
+    route.assign(1, exits[exit].position);
   }
 
-  // 3. Add the actual target waypoint
+  // Straight along the lanes, past the map edge
+  const RoadNetwork::Terminal &terminal = exits[exit];
+  route.back() = Vector2Add(terminal.position, Vector2Scale(terminal.direction, Config::Roads::EXIT_OVERRUN));
+  for (size_t i = 0; i < route.size(); ++i) {
+    bool last = i + 1 == route.size();
+    Vector2 out = last ? terminal.direction : Vector2Subtract(route[i + 1], route[i]);
+    path.push_back(Waypoint(route[i], 1.0f, -1, atan2f(out.y, out.x), last));
+  }
+  return path;
+}
+
+void PathPlanner::AddSegment(std::vector<Waypoint> &path, Waypoint target, const Config::CarAI::AIPhase &phase) {
   target.tolerance = phase.tolerance;
   target.speedLimitFactor = phase.speedFactor;
-
   path.push_back(target);
 }
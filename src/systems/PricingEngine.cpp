@@ -0,0 +1,158 @@
+#include "systems/PricingEngine.hpp"
+#include "config.hpp"
+#include "core/BinaryIO.hpp"
+#include "core/Profiler.hpp"
+#include "events/GameEvents.hpp"
+#include "systems/OccupancyStats.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+
+/**
+ * @file PricingEngine.cpp
+ * @brief Implementation of the surge pricing engine.
+ */
+
+PricingEngine::PricingEngine(std::shared_ptr<EventBus> bus) {
+  eventTokens.push_back(bus->subscribe<SpotStateChangedEvent>([this](const SpotStateChangedEvent &e) {
+    if (e.current != SpotState::RESERVED)
+      return;
+    auto it = facilityIndex.find(e.module);
+    if (it != facilityIndex.end())
+      reservations[it->second] += 1.0f;
+  }));
+}
+
+void PricingEngine::addFacility(Module *module) {
+  if (!OccupancyStats::isCharging(module->getType()) && !OccupancyStats::isParking(module->getType()))
+    return;
+
+  facilityIndex[module] = (int)facilities.size();
+  facilities.push_back(module);
+  spotOffset.push_back((int)listPrices.size());
+  spotCount.push_back((float)module->getSpotCount());
+  taken.push_back(0.0f);
+  reservations.push_back(0.0f);
+  surge.push_back(1.0f);
+  appliedSurge.push_back(1.0f);
+  for (const Spot &spot : module->getSpots())
+    listPrices.push_back(spot.price);
+}
+
+void PricingEngine::reset() {
+  facilityIndex.clear();
+  clock = 0.0f;
+  facilities.clear();
+  spotOffset.clear();
+  spotCount.clear();
+  taken.clear();
+  reservations.clear();
+  surge.clear();
+  appliedSurge.clear();
+  listPrices.clear();
+}
+
+void PricingEngine::update(double dt, float elasticity) {
+  if (elasticity <= 0.0f || facilities.empty())
+    return;
+  clock += (float)dt;
+  if (clock < Config::Pricing::INTERVAL)
+    return;
+  clock -= Config::Pricing::INTERVAL;
+  recompute(elasticity);
+}
+
+float PricingEngine::curve(float demand) {
+  using namespace Config::Pricing;
+  // Sum of clamped ramps: no branches, so the facility loop vectorizes
+  float factor = CURVE_SURGE[0];
+  for (size_t i = 0; i + 1 < std::size(CURVE_DEMAND); ++i) {
+    float width = CURVE_DEMAND[i + 1] - CURVE_DEMAND[i];
+    float slope = (CURVE_SURGE[i + 1] - CURVE_SURGE[i]) / width;
+    factor += slope * std::clamp(demand - CURVE_DEMAND[i], 0.0f, width);
+  }
+  return factor;
+}
+
+void PricingEngine::recompute(float elasticity) {
+  PROFILE_ZONE("PricingEngine::recompute");
+  using namespace Config::Pricing;
+  const size_t count = facilities.size();
+
+  for (size_t f = 0; f < count; ++f) {
+    Module::SpotCounts counts = facilities[f]->getSpotCounts();
+    taken[f] = (float)(counts.reserved + counts.occupied);
+  }
+
+  const float reservationDemand = RESERVATION_WEIGHT * 60.0f / INTERVAL; // Per reservation, as a rate per minute
+  for (size_t f = 0; f < count; ++f) {
+    float demand = (taken[f] + reservationDemand * reservations[f]) / std::max(spotCount[f], 1.0f);
+    float target = std::clamp(1.0f + elasticity * (curve(demand) - 1.0f), MIN_SURGE, MAX_SURGE);
+    surge[f] += SMOOTHING * (target - surge[f]);
+    reservations[f] = 0.0f;
+  }
+
+  for (size_t f = 0; f < count; ++f) {
+    if (std::fabs(surge[f] - appliedSurge[f]) > DIRTY_THRESHOLD)
+      reprice((int)f);
+  }
+}
+
+void PricingEngine::reprice(int facility) {
+  Module *module = facilities[facility];
+  const float factor = surge[facility];
+  const float *list = listPrices.data() + spotOffset[facility];
+  for (int i = 0; i < (int)spotCount[facility]; ++i) {
+    float price = std::max(list[i] * factor, Config::Pricing::MIN_SPOT_PRICE);
+    module->setSpotPrice(i, std::round(price * 100.0f) / 100.0f); // Whole cents
+  }
+  appliedSurge[facility] = factor;
+}
+
+float PricingEngine::getSurge(const Module *module) const {
+  auto it = facilityIndex.find(module);
+  return it != facilityIndex.end() ? surge[it->second] : 1.0f;
+}
+
+void PricingEngine::saveCheckpoint(BinaryWriter &out) const {
+  out.write(clock);
+  out.write((uint32_t)facilities.size());
+  for (size_t f = 0; f < facilities.size(); ++f) {
+    out.write(surge[f]);
+    out.write(appliedSurge[f]);
+    out.write(reservations[f]);
+  }
+}
+
+PricingEngine::State PricingEngine::readCheckpoint(BinaryReader &in) const {
+  State state;
+  state.clock = in.read<float>();
+  uint32_t count = in.read<uint32_t>();
+  if (count != facilities.size())
+    throw std::runtime_error("Checkpoint prices belong to a different layout");
+  for (uint32_t f = 0; f < count; ++f) {
+    float s = in.read<float>();
+    float applied = in.read<float>();
+    float r = in.read<float>();
+    if (!(s >= Config::Pricing::MIN_SURGE - 1e-3f && s <= Config::Pricing::MAX_SURGE + 1e-3f) || !(applied > 0.0f) ||
+        !(r >= 0.0f))
+      throw std::runtime_error("Checkpoint contains an invalid price state");
+    state.surge.push_back(s);
+    state.appliedSurge.push_back(applied);
+    state.reservations.push_back(r);
+  }
+  return state;
+}
+
+void PricingEngine::restore(const State &state) {
+  clock = state.clock;
+  reservations = state.reservations;
+  for (size_t f = 0; f < facilities.size(); ++f) {
+    if (state.appliedSurge[f] != appliedSurge[f]) {
+      surge[f] = state.appliedSurge[f];
+      reprice((int)f);
+    }
+  }
+  surge = state.surge;
+}
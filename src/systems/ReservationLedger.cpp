@@ -0,0 +1,87 @@
+#include "systems/ReservationLedger.hpp"
+#include "config.hpp"
+#include <algorithm>
+
+/**
+ * @file ReservationLedger.cpp
+ * @brief Implementation of the reservation ledger and its timer wheel.
+ */
+
+ReservationLedger::ReservationLedger() : wheel(Config::Reservation::WHEEL_SLOTS) {}
+
+bool ReservationLedger::holds(CarId carId) const {
+  return carId.isValid() && carId.index < byCar.size() && byCar[carId.index].facility &&
+         byCar[carId.index].carId == carId;
+}
+
+ReservationLedger::Reservation *ReservationLedger::lookup(CarId carId) {
+  return holds(carId) ? &byCar[carId.index] : nullptr;
+}
+
+const ReservationLedger::Reservation *ReservationLedger::find(CarId carId) const {
+  return holds(carId) ? &byCar[carId.index] : nullptr;
+}
+
+void ReservationLedger::reserve(CarId carId, Module *facility, int spotIndex, uint64_t timeoutTicks, float price) {
+  Reservation previous;
+  release(carId, previous);
+
+  if (carId.index >= byCar.size())
+    byCar.resize(carId.index + 1);
+  uint64_t expiry = tick + std::max<uint64_t>(timeoutTicks, 1);
+  byCar[carId.index] = {carId, facility, spotIndex, expiry, price};
+  spotHolders[{facility, spotIndex}] = carId;
+  wheel[expiry % wheel.size()].push_back(carId);
+}
+
+bool ReservationLedger::confirm(CarId carId) {
+  Reservation *r = lookup(carId);
+  if (!r)
+    return false;
+  r->expiry = NO_EXPIRY; // Its wheel entry goes stale
+  return true;
+}
+
+bool ReservationLedger::release(CarId carId, Reservation &released) {
+  Reservation *r = lookup(carId);
+  if (!r)
+    return false;
+  released = *r;
+  spotHolders.erase({r->facility, r->spotIndex});
+  *r = Reservation{};
+  return true;
+}
+
+CarId ReservationLedger::holder(const Module *facility, int spotIndex) const {
+  auto it = spotHolders.find({facility, spotIndex});
+  return it != spotHolders.end() ? it->second : CarId{};
+}
+
+void ReservationLedger::advance(std::vector<Reservation> &expired) {
+  ++tick;
+  std::vector<CarId> &bucket = wheel[tick % wheel.size()];
+
+  // Keep the entries due on a later turn of the wheel; drop stale ones
+  size_t kept = 0;
+  for (CarId carId : bucket) {
+    Reservation *r = lookup(carId);
+    if (!r || r->expiry == NO_EXPIRY || r->expiry % wheel.size() != tick % wheel.size())
+      continue;
+    if (r->expiry > tick) {
+      bucket[kept++] = carId;
+      continue;
+    }
+    expired.push_back(*r);
+    spotHolders.erase({r->facility, r->spotIndex});
+    *r = Reservation{};
+  }
+  bucket.resize(kept);
+}
+
+void ReservationLedger::clear(uint64_t startTick) {
+  byCar.clear();
+  spotHolders.clear();
+  for (auto &bucket : wheel)
+    bucket.clear();
+  tick = startTick;
+}
@@ -0,0 +1,577 @@
+#include "systems/RoadNetwork.hpp"
+#include "config.hpp"
+#include "core/Logger.hpp"
+#include "core/Profiler.hpp"
+#include "raymath.h"
+#include "systems/OccupancyStats.hpp"
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+/**
+ * @file RoadNetwork.cpp
+ * @brief Lane graph construction, route trees and A* search.
+ */
+
+namespace {
+float P2M(float artPixels) { return artPixels / static_cast<float>(Config::ART_PIXELS_PER_METER); }
+
+uint64_t cellKey(int32_t x, int32_t y) { return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y; }
+
+uint64_t gridKey(Vector2 p) {
+  return cellKey((int32_t)std::floor(p.x / Config::Roads::GRID_CELL), (int32_t)std::floor(p.y / Config::Roads::GRID_CELL));
+}
+
+/**
+ * @brief Adds points, treating points within Config::Roads::MERGE_DISTANCE of each other as one.
+ */
+class PointIndex {
+public:
+  explicit PointIndex(std::vector<Vector2> &points) : points(points) {}
+
+  int insert(Vector2 p) {
+    int32_t cx = (int32_t)std::floor(p.x / Config::Roads::MERGE_DISTANCE);
+    int32_t cy = (int32_t)std::floor(p.y / Config::Roads::MERGE_DISTANCE);
+    for (int32_t x = cx - 1; x <= cx + 1; ++x) {
+      for (int32_t y = cy - 1; y <= cy + 1; ++y) {
+        auto it = head.find(cellKey(x, y));
+        for (int i = it == head.end() ? -1 : it->second; i != -1; i = next[i]) {
+          if (Vector2Distance(points[i], p) < Config::Roads::MERGE_DISTANCE)
+            return i;
+        }
+      }
+    }
+    int index = (int)points.size();
+    points.push_back(p);
+    auto [it, added] = head.try_emplace(cellKey(cx, cy), index);
+    next.push_back(added ? -1 : it->second);
+    it->second = index;
+    return index;
+  }
+
+private:
+  std::vector<Vector2> &points;
+  std::unordered_map<uint64_t, int> head; ///< Cell -> newest point in it.
+  std::vector<int> next;                  ///< Per point, the one added before it to the same cell.
+};
+
+/**
+ * @brief Appends a point to a route, replacing the last point if that one lies on the straight way
+ * to the new one (or dropping the new one if it repeats the last).
+ */
+void appendPoint(std::vector<Vector2> &out, Vector2 start, Vector2 p) {
+  Vector2 last = out.empty() ? start : out.back();
+  Vector2 b = Vector2Subtract(p, last);
+  if (Vector2Length(b) < 1e-3f)
+    return;
+  if (!out.empty()) {
+    Vector2 a = Vector2Subtract(last, out.size() > 1 ? out[out.size() - 2] : start);
+    float cross = a.x * b.y - a.y * b.x;
+    if (std::fabs(cross) <= 0.01f * Vector2Length(a) * Vector2Length(b) && Vector2DotProduct(a, b) > 0.0f) {
+      out.back() = p;
+      return;
+    }
+  }
+  out.push_back(p);
+}
+} // namespace
+
+Vector2 RoadNetwork::lanePosition(Vector2 point, Vector2 direction) {
+  Vector2 right = {-direction.y, direction.x};
+  float offset = (float)Config::ENTRANCE_LANE_OFFSET;
+  if (std::fabs(direction.x) > std::fabs(direction.y)) {
+    offset = direction.x > 0 ? (float)(Config::LANE_OFFSET_DOWN - Config::ROAD_CENTER_OFFSET)
+                             : (float)(Config::ROAD_CENTER_OFFSET - Config::LANE_OFFSET_UP);
+  }
+  return Vector2Add(point, Vector2Scale(right, P2M(offset)));
+}
+
+void RoadNetwork::clear() {
+  nodes.clear();
+  edges.clear();
+  firstOut.clear();
+  incoming.clear();
+  firstIn.clear();
+  corners.clear();
+  entries.clear();
+  exits.clear();
+  facilityLanes.clear();
+  entryDistance.clear();
+  entryParent.clear();
+  exitDistance.clear();
+  exitNext.clear();
+  grid.clear();
+  searchCost.clear();
+  searchEdge.clear();
+  searchStamp.clear();
+  searchId = 0;
+}
+
+void RoadNetwork::build(const std::vector<std::unique_ptr<Module>> &modules) {
+  PROFILE_ZONE("RoadNetwork::build");
+  clear();
+
+  // 1. Attachment points in world coordinates, and the outline of the layout
+  struct Port {
+    const Module *module;
+    Vector2 position;
+    Vector2 normal;
+    int joint; ///< Same for every port at this position.
+  };
+  std::vector<Port> ports;
+  std::vector<Vector2> jointPositions;
+  std::vector<int> jointUse;
+  PointIndex joints(jointPositions);
+  float minX = std::numeric_limits<float>::max(), minY = minX;
+  float maxX = std::numeric_limits<float>::lowest(), maxY = maxX;
+  for (const auto &module : modules) {
+    minX = std::min(minX, module->worldPosition.x);
+    minY = std::min(minY, module->worldPosition.y);
+    maxX = std::max(maxX, module->worldPosition.x + module->getWidth());
+    maxY = std::max(maxY, module->worldPosition.y + module->getHeight());
+    for (const AttachmentPoint &ap : module->getAttachmentPoints()) {
+      Vector2 position = Vector2Add(module->worldPosition, ap.position);
+      int joint = joints.insert(position);
+      jointUse.resize(jointPositions.size(), 0);
+      jointUse[joint]++;
+      ports.push_back({module.get(), position, ap.normal, joint});
+    }
+  }
+
+  // 2. Lanes: one into and one out of each attachment point; inside a road, every lane in
+  // continues into the lanes out of its other points
+  struct RawEdge {
+    int from;
+    int to;
+    float length;
+    bool turns;
+    Vector2 corner;
+  };
+  std::vector<Vector2> rawNodes;
+  std::vector<RawEdge> rawEdges;
+  PointIndex lanes(rawNodes);
+  std::vector<std::pair<int, int>> rawEntries; // (raw node, port)
+  std::vector<std::pair<int, int>> rawExits;
+  std::vector<std::pair<const Module *, std::pair<int, int>>> rawFacilities;
+
+  auto isFacility = [](const Module *module) {
+    return OccupancyStats::isParking(module->getType()) || OccupancyStats::isCharging(module->getType());
+  };
+  auto faceOutside = [&](const Port &port) {
+    const float e = Config::Roads::MERGE_DISTANCE;
+    return (port.normal.x < -0.5f && port.position.x <= minX + e) ||
+           (port.normal.x > 0.5f && port.position.x >= maxX - e) ||
+           (port.normal.y < -0.5f && port.position.y <= minY + e) ||
+           (port.normal.y > 0.5f && port.position.y >= maxY - e);
+  };
+
+  for (size_t first = 0; first < ports.size();) {
+    size_t last = first;
+    while (last < ports.size() && ports[last].module == ports[first].module)
+      ++last;
+
+    if (isFacility(ports[first].module)) {
+      // Gate and way out, if the facility touches a road
+      const Port &port = ports[first];
+      if (jointUse[port.joint] > 1) {
+        int gate = lanes.insert(lanePosition(port.position, Vector2Scale(port.normal, -1.0f)));
+        int out = lanes.insert(lanePosition(port.position, port.normal));
+        rawFacilities.push_back({port.module, {gate, out}});
+      }
+      first = last;
+      continue;
+    }
+
+    for (size_t i = first; i < last; ++i) {
+      const Port &in = ports[i];
+      Vector2 inDir = Vector2Scale(in.normal, -1.0f);
+      Vector2 start = lanePosition(in.position, inDir);
+      int from = lanes.insert(start);
+
+      if (jointUse[in.joint] == 1 && faceOutside(in)) {
+        rawEntries.push_back({from, (int)i});
+        rawExits.push_back({lanes.insert(lanePosition(in.position, in.normal)), (int)i});
+      }
+
+      for (size_t j = first; j < last; ++j) {
+        const Port &out = ports[j];
+        if (j == i)
+          continue;
+        Vector2 outDir = out.normal;
+        Vector2 end = lanePosition(out.position, outDir);
+        RawEdge edge{from, lanes.insert(end), 0.0f, false, {0, 0}};
+
+        float cross = inDir.x * outDir.y - inDir.y * outDir.x;
+        if (std::fabs(cross) < 1e-3f) {
+          if (Vector2DotProduct(inDir, outDir) < 0.0f)
+            continue; // Back where it came from: roads have no U-turns
+          edge.length = Vector2Distance(start, end);
+        } else {
+          // Turn at the corner where the two lanes cross
+          Vector2 d = Vector2Subtract(end, start);
+          float t = (d.x * outDir.y - d.y * outDir.x) / cross;
+          edge.turns = true;
+          edge.corner = Vector2Add(start, Vector2Scale(inDir, t));
+          edge.length = std::fabs(t) + Vector2Distance(edge.corner, end);
+        }
+        rawEdges.push_back(edge);
+      }
+    }
+    first = last;
+  }
+
+  // 3. Keep the nodes where lanes meet or split and the named ones; fold the others into the edges
+  const int rawCount = (int)rawNodes.size();
+  std::vector<int> outCount(rawCount, 0), inCount(rawCount, 0);
+  for (const RawEdge &edge : rawEdges) {
+    outCount[edge.from]++;
+    inCount[edge.to]++;
+  }
+  std::vector<char> kept(rawCount, 0);
+  for (int i = 0; i < rawCount; ++i)
+    kept[i] = outCount[i] != 1 || inCount[i] != 1;
+  for (const auto &[node, port] : rawEntries)
+    kept[node] = 1;
+  for (const auto &[node, port] : rawExits)
+    kept[node] = 1;
+  for (const auto &[facility, lanePair] : rawFacilities)
+    kept[lanePair.first] = kept[lanePair.second] = 1;
+
+  std::stable_sort(rawEdges.begin(), rawEdges.end(),
+                   [](const RawEdge &a, const RawEdge &b) { return a.from < b.from; });
+  std::vector<uint32_t> rawFirstOut(rawCount + 1, 0);
+  for (const RawEdge &edge : rawEdges)
+    rawFirstOut[edge.from + 1]++;
+  for (int i = 0; i < rawCount; ++i)
+    rawFirstOut[i + 1] += rawFirstOut[i];
+
+  std::vector<int> nodeOf(rawCount, -1);
+  for (int i = 0; i < rawCount; ++i) {
+    if (kept[i]) {
+      nodeOf[i] = (int)nodes.size();
+      nodes.push_back(rawNodes[i]);
+    }
+  }
+
+  std::vector<Vector2> line;
+  for (int u = 0; u < rawCount; ++u) {
+    if (!kept[u])
+      continue;
+    for (uint32_t e = rawFirstOut[u]; e < rawFirstOut[u + 1]; ++e) {
+      line.clear();
+      float length = 0.0f;
+      int at = u;
+      uint32_t next = e;
+      do {
+        const RawEdge &raw = rawEdges[next];
+        if (raw.turns)
+          appendPoint(line, rawNodes[u], raw.corner);
+        appendPoint(line, rawNodes[u], rawNodes[raw.to]);
+        length += raw.length;
+        at = raw.to;
+        next = rawFirstOut[at]; // The only lane out of a folded node
+      } while (!kept[at]);
+
+      uint32_t cornerCount = line.empty() ? 0 : (uint32_t)line.size() - 1;
+      edges.push_back({nodeOf[u], nodeOf[at], length, (uint32_t)corners.size(), cornerCount});
+      corners.insert(corners.end(), line.begin(), line.begin() + cornerCount);
+    }
+  }
+
+  // 4. Adjacency both ways (edges are already sorted by their start)
+  const int n = (int)nodes.size();
+  firstOut.assign(n + 1, 0);
+  firstIn.assign(n + 1, 0);
+  for (const Edge &edge : edges) {
+    firstOut[edge.from + 1]++;
+    firstIn[edge.to + 1]++;
+  }
+  for (int i = 0; i < n; ++i) {
+    firstOut[i + 1] += firstOut[i];
+    firstIn[i + 1] += firstIn[i];
+  }
+  incoming.resize(edges.size());
+  std::vector<uint32_t> fill(firstIn.begin(), firstIn.end() - 1);
+  for (uint32_t e = 0; e < edges.size(); ++e)
+    incoming[fill[edges[e].to]++] = e;
+
+  for (const auto &[node, port] : rawEntries)
+    entries.push_back({nodeOf[node], rawNodes[node], Vector2Scale(ports[port].normal, -1.0f)});
+  for (const auto &[node, port] : rawExits)
+    exits.push_back({nodeOf[node], rawNodes[node], ports[port].normal});
+  for (const auto &[facility, lanePair] : rawFacilities)
+    facilityLanes[facility] = {nodeOf[lanePair.first], nodeOf[lanePair.second]};
+
+  computeTrees();
+  buildGrid();
+  Logger::Info("RoadNetwork: {} nodes, {} lanes, {} entries, {} exits, {} facilities", nodes.size(), edges.size(),
+               entries.size(), exits.size(), facilityLanes.size());
+}
+
+void RoadNetwork::computeTrees() {
+  using QueueEntry = std::pair<float, int>;
+  const int n = (int)nodes.size();
+
+  // Dijkstra along the lanes (forward) or against them (toward the source)
+  auto tree = [&](int source, bool forward, std::vector<float> &distance, std::vector<int> &via) {
+    distance.assign(n, UNREACHABLE);
+    via.assign(n, -1);
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+    distance[source] = 0.0f;
+    queue.push({0.0f, source});
+    while (!queue.empty()) {
+      auto [d, u] = queue.top();
+      queue.pop();
+      if (d > distance[u])
+        continue;
+      uint32_t begin = forward ? firstOut[u] : firstIn[u];
+      uint32_t end = forward ? firstOut[u + 1] : firstIn[u + 1];
+      for (uint32_t k = begin; k < end; ++k) {
+        uint32_t e = forward ? k : incoming[k];
+        int v = forward ? edges[e].to : edges[e].from;
+        float candidate = d + edges[e].length;
+        if (candidate < distance[v]) {
+          distance[v] = candidate;
+          via[v] = (int)e;
+          queue.push({candidate, v});
+        }
+      }
+    }
+  };
+
+  entryDistance.resize(entries.size());
+  entryParent.resize(entries.size());
+  for (size_t i = 0; i < entries.size(); ++i)
+    tree(entries[i].node, true, entryDistance[i], entryParent[i]);
+  exitDistance.resize(exits.size());
+  exitNext.resize(exits.size());
+  for (size_t i = 0; i < exits.size(); ++i)
+    tree(exits[i].node, false, exitDistance[i], exitNext[i]);
+}
+
+void RoadNetwork::buildGrid() {
+  const float margin = Config::Roads::SNAP_DISTANCE;
+  for (int e = 0; e < (int)edges.size(); ++e) {
+    for (uint32_t s = 0; s <= edges[e].cornerCount; ++s) {
+      Vector2 a = edgePoint(edges[e], s);
+      Vector2 b = edgePoint(edges[e], s + 1);
+      int32_t x0 = (int32_t)std::floor((std::min(a.x, b.x) - margin) / Config::Roads::GRID_CELL);
+      int32_t x1 = (int32_t)std::floor((std::max(a.x, b.x) + margin) / Config::Roads::GRID_CELL);
+      int32_t y0 = (int32_t)std::floor((std::min(a.y, b.y) - margin) / Config::Roads::GRID_CELL);
+      int32_t y1 = (int32_t)std::floor((std::max(a.y, b.y) + margin) / Config::Roads::GRID_CELL);
+      for (int32_t x = x0; x <= x1; ++x) {
+        for (int32_t y = y0; y <= y1; ++y)
+          grid[cellKey(x, y)].push_back({e, (int)s});
+      }
+    }
+  }
+}
+
+Vector2 RoadNetwork::edgePoint(const Edge &edge, uint32_t i) const {
+  if (i == 0)
+    return nodes[edge.from];
+  if (i <= edge.cornerCount)
+    return corners[edge.firstCorner + i - 1];
+  return nodes[edge.to];
+}
+
+int RoadNetwork::getGate(const Module *facility) const {
+  auto it = facilityLanes.find(facility);
+  return it == facilityLanes.end() ? -1 : it->second.first;
+}
+
+int RoadNetwork::getFacilityExit(const Module *facility) const {
+  auto it = facilityLanes.find(facility);
+  return it == facilityLanes.end() ? -1 : it->second.second;
+}
+
+float RoadNetwork::getEntryDistance(int entry, int node) const {
+  if (entry < 0 || entry >= (int)entries.size() || node < 0 || node >= (int)nodes.size())
+    return UNREACHABLE;
+  return entryDistance[entry][node];
+}
+
+float RoadNetwork::getExitDistance(int node, int exit) const {
+  if (exit < 0 || exit >= (int)exits.size() || node < 0 || node >= (int)nodes.size())
+    return UNREACHABLE;
+  return exitDistance[exit][node];
+}
+
+int RoadNetwork::findNearestExit(int node) const {
+  int nearest = -1;
+  float best = UNREACHABLE;
+  for (int x = 0; x < (int)exits.size(); ++x) {
+    float d = getExitDistance(node, x);
+    if (d < best) {
+      best = d;
+      nearest = x;
+    }
+  }
+  return nearest;
+}
+
+int RoadNetwork::findNearestExit(Vector2 position, Vector2 heading) const {
+  int edge, segment;
+  if (!locate(position, heading, edge, segment))
+    return -1;
+  return findNearestExit(edges[edge].to);
+}
+
+bool RoadNetwork::route(int from, int to, std::vector<Vector2> &points) const {
+  points.clear();
+  if (from < 0 || from >= (int)nodes.size())
+    return false;
+  if (!appendRoute(from, to, nodes[from], points)) {
+    points.clear();
+    return false;
+  }
+  return true;
+}
+
+bool RoadNetwork::route(Vector2 position, Vector2 heading, int to, std::vector<Vector2> &points) const {
+  PROFILE_ZONE("RoadNetwork::route");
+  points.clear();
+  int e, segment;
+  if (to < 0 || to >= (int)nodes.size() || !locate(position, heading, e, segment))
+    return false;
+  const Edge &edge = edges[e];
+
+  // At the start of the lane: other lanes may leave the same node
+  bool ok;
+  if (segment == 0 && Vector2Distance(position, nodes[edge.from]) < Config::Roads::MERGE_DISTANCE) {
+    ok = appendRoute(edge.from, to, position, points);
+  } else {
+    for (uint32_t i = segment + 1; i <= edge.cornerCount + 1; ++i)
+      appendPoint(points, position, edgePoint(edge, i));
+    ok = appendRoute(edge.to, to, position, points);
+  }
+  if (!ok)
+    points.clear();
+  return ok;
+}
+
+bool RoadNetwork::appendRoute(int from, int to, Vector2 start, std::vector<Vector2> &out) const {
+  if (to < 0 || to >= (int)nodes.size())
+    return false;
+  if (from == to)
+    return true;
+
+  // Toward an exit: follow its tree
+  for (size_t x = 0; x < exits.size(); ++x) {
+    if (exits[x].node != to)
+      continue;
+    if (exitDistance[x][from] == UNREACHABLE)
+      return false;
+    for (int u = from; u != to; u = edges[exitNext[x][u]].to)
+      appendEdge(exitNext[x][u], start, out);
+    return true;
+  }
+
+  // From a node on an entry's shortest way to the target: the rest of that way is the shortest
+  std::vector<int> way;
+  for (size_t i = 0; i < entries.size(); ++i) {
+    if (entryDistance[i][from] == UNREACHABLE || entryDistance[i][to] == UNREACHABLE)
+      continue;
+    way.clear();
+    int u = to;
+    while (u != from && entryParent[i][u] != -1) {
+      way.push_back(entryParent[i][u]);
+      u = edges[way.back()].from;
+    }
+    if (u != from)
+      continue;
+    for (auto it = way.rbegin(); it != way.rend(); ++it)
+      appendEdge(*it, start, out);
+    return true;
+  }
+
+  return search(from, to, start, out);
+}
+
+void RoadNetwork::appendEdge(int edge, Vector2 start, std::vector<Vector2> &out) const {
+  const Edge &e = edges[edge];
+  for (uint32_t i = 1; i <= e.cornerCount + 1; ++i)
+    appendPoint(out, start, edgePoint(e, i));
+}
+
+bool RoadNetwork::search(int from, int to, Vector2 start, std::vector<Vector2> &out) const {
+  PROFILE_ZONE("RoadNetwork::search");
+  using QueueEntry = std::pair<float, int>;
+  const size_t n = nodes.size();
+  if (searchStamp.size() != n) {
+    searchCost.assign(n, 0.0f);
+    searchEdge.assign(n, -1);
+    searchStamp.assign(n, 0);
+    searchId = 0;
+  }
+  if (++searchId == 0) {
+    std::fill(searchStamp.begin(), searchStamp.end(), 0);
+    searchId = 1;
+  }
+  auto cost = [&](int u) { return searchStamp[u] == searchId ? searchCost[u] : UNREACHABLE; };
+
+  // Lanes are never shorter than the straight line between their ends: the heuristic is admissible
+  Vector2 goal = nodes[to];
+  std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> open;
+  searchStamp[from] = searchId;
+  searchCost[from] = 0.0f;
+  searchEdge[from] = -1;
+  open.push({Vector2Distance(nodes[from], goal), from});
+  while (!open.empty()) {
+    auto [f, u] = open.top();
+    open.pop();
+    if (u == to)
+      break;
+    float g = searchCost[u];
+    if (f > g + Vector2Distance(nodes[u], goal) + 1e-3f)
+      continue; // Reached more cheaply since
+    for (uint32_t e = firstOut[u]; e < firstOut[u + 1]; ++e) {
+      int v = edges[e].to;
+      float candidate = g + edges[e].length;
+      if (candidate < cost(v)) {
+        searchStamp[v] = searchId;
+        searchCost[v] = candidate;
+        searchEdge[v] = (int)e;
+        open.push({candidate + Vector2Distance(nodes[v], goal), v});
+      }
+    }
+  }
+  if (cost(to) == UNREACHABLE)
+    return false;
+
+  std::vector<int> way;
+  for (int u = to; u != from; u = edges[searchEdge[u]].from)
+    way.push_back(searchEdge[u]);
+  for (auto it = way.rbegin(); it != way.rend(); ++it)
+    appendEdge(*it, start, out);
+  return true;
+}
+
+bool RoadNetwork::locate(Vector2 position, Vector2 heading, int &edge, int &segment) const {
+  auto it = grid.find(gridKey(position));
+  if (it == grid.end())
+    return false;
+
+  bool anyDirection = Vector2Length(heading) < 1e-3f;
+  float best = std::numeric_limits<float>::max();
+  for (const auto &[e, s] : it->second) {
+    Vector2 a = edgePoint(edges[e], s);
+    Vector2 ab = Vector2Subtract(edgePoint(edges[e], s + 1), a);
+    float lengthSq = Vector2DotProduct(ab, ab);
+    if (lengthSq < 1e-6f || (!anyDirection && Vector2DotProduct(ab, heading) <= 0.0f))
+      continue;
+    float t = std::clamp(Vector2DotProduct(Vector2Subtract(position, a), ab) / lengthSq, 0.0f, 1.0f);
+    float d = Vector2Distance(position, Vector2Add(a, Vector2Scale(ab, t)));
+    if (d > Config::Roads::SNAP_DISTANCE)
+      continue;
+    // Between two segments, the one still ahead
+    float score = d + (t >= 1.0f ? 1e-3f : 0.0f);
+    if (score < best) {
+      best = score;
+      edge = e;
+      segment = s;
+    }
+  }
+  return best < std::numeric_limits<float>::max();
+}
@@ -0,0 +1,124 @@
+#include "systems/SpotMatcher.hpp"
+#include "config.hpp"
+#include "core/Profiler.hpp"
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+/**
+ * @file SpotMatcher.cpp
+ * @brief Successive shortest augmenting paths with early exit.
+ */
+
+std::vector<std::vector<int>> SpotMatcher::solve(const std::vector<Group> &groups, int spotCount) {
+  PROFILE_ZONE("SpotMatcher::solve");
+  constexpr int64_t INF = std::numeric_limits<int64_t>::max();
+  constexpr int NONE = -1;
+
+  // Nodes: the spots, one "stay out" node per group (never full), then the groups
+  const int groupCount = (int)groups.size();
+  const int stayOutBase = spotCount;
+  const int groupBase = spotCount + groupCount;
+  const int nodeCount = spotCount + 2 * groupCount;
+
+  int totalCars = 0;
+  for (const Group &group : groups)
+    totalCars += group.cars;
+  const int64_t stayOutCost = (int64_t)Config::Assignment::COST_LEVELS * (totalCars + 1) + 1;
+
+  std::vector<int> owner(spotCount, NONE); // Group holding a spot
+  std::vector<int64_t> ownerCost(spotCount, 0);
+
+  // Potentials keep every reduced cost (cost + potential[from] - potential[to]) non-negative
+  std::vector<int64_t> potential(nodeCount, 0);
+
+  // Search state, reset through the touched list
+  std::vector<int64_t> distance(nodeCount, INF);
+  std::vector<int> parent(nodeCount, NONE); // Group node before a spot / stay-out node, spot before a group node
+  std::vector<int64_t> parentCost(nodeCount, 0);
+  std::vector<char> done(nodeCount, 0);
+  std::vector<int> touched;
+  std::vector<int> settled;
+  using Entry = std::pair<int64_t, int>;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> heap;
+
+  auto relax = [&](int from, int to, int64_t cost) {
+    int64_t d = distance[from] + cost + potential[from] - potential[to];
+    if (d < distance[to]) {
+      if (distance[to] == INF)
+        touched.push_back(to);
+      distance[to] = d;
+      parent[to] = from;
+      parentCost[to] = cost;
+      heap.push({d, to});
+    }
+  };
+
+  for (int g = 0; g < groupCount; ++g) {
+    const int start = groupBase + g;
+    for (int car = 0; car < groups[g].cars; ++car) {
+      distance[start] = 0;
+      touched.push_back(start);
+      heap.push({0, start});
+
+      // Dijkstra until the first free node: a taken spot leads back to its group (residual edge)
+      int end = NONE;
+      int64_t length = 0;
+      while (!heap.empty()) {
+        auto [d, node] = heap.top();
+        heap.pop();
+        if (done[node] || d > distance[node])
+          continue;
+        done[node] = 1;
+        settled.push_back(node);
+
+        if (node >= groupBase) {
+          int y = node - groupBase;
+          for (const Candidate &c : groups[y].candidates) {
+            if (owner[c.spot] != y)
+              relax(node, c.spot, c.cost);
+          }
+          relax(node, stayOutBase + y, stayOutCost);
+        } else if (node < spotCount && owner[node] != NONE) {
+          relax(node, groupBase + owner[node], -ownerCost[node]);
+        } else {
+          end = node;
+          length = d;
+          break;
+        }
+      }
+
+      // Shift the potentials of everything settled closer than the free node (early exit)
+      for (int node : settled)
+        potential[node] -= length - distance[node];
+
+      // Flip the path: each group on it takes the spot it was reached from
+      for (int node = end; node != start;) {
+        int group = parent[node];
+        if (node < spotCount) {
+          owner[node] = group - groupBase;
+          ownerCost[node] = parentCost[node];
+        }
+        node = group == start ? start : parent[group];
+      }
+
+      for (int node : touched) {
+        distance[node] = INF;
+        parent[node] = NONE;
+        done[node] = 0;
+      }
+      touched.clear();
+      settled.clear();
+      heap = {};
+    }
+  }
+
+  std::vector<std::vector<int>> assignment(groupCount);
+  for (int spot = 0; spot < spotCount; ++spot) {
+    if (owner[spot] != NONE)
+      assignment[owner[spot]].push_back(spot);
+  }
+  return assignment;
+}
@@ -3,7 +3,8 @@
 #include "events/GameEvents.hpp"
 #include "events/TrackingEvents.hpp"
 
-TrackingSystem::TrackingSystem(std::shared_ptr<EventBus> bus) : eventBus(bus) {
+TrackingSystem::TrackingSystem(std::shared_ptr<EventBus> bus, EntityManager &em)
+    : eventBus(bus), entityManager(em) {
   // Subscribe to tracking events
   eventTokens.push_back(
       eventBus->subscribe<StartTrackingEvent>([this](const StartTrackingEvent &) { this->startTracking(); }));
@@ -14,7 +15,8 @@ TrackingSystem::TrackingSystem(std::shared_ptr<EventBus> bus) : eventBus(bus) {
   // Monitor for target car spawn
   eventTokens.push_back(eventBus->subscribe<CarSpawnedEvent>([this](const CarSpawnedEvent &e) {
     if (this->waitingForSpawn) {
-      this->targetCar = e.car;
+      this->targetCar = e.carId;
+      this->entityManager.setTrackedCar(e.carId);
       this->waitingForSpawn = false;
       Logger::Info("TrackingSystem: Target car found, beginning tracking.");
     }
@@ -22,7 +24,7 @@ TrackingSystem::TrackingSystem(std::shared_ptr<EventBus> bus) : eventBus(bus) {
 
   // Handle target car deletion (safety)
   eventTokens.push_back(eventBus->subscribe<CarDeletedEvent>([this](const CarDeletedEvent &e) {
-    if (this->targetCar == e.car) {
+    if (this->isTrackingActive && this->targetCar == e.carId) {
       Logger::Info("TrackingSystem: Target car deleted. Stopping tracking.");
       this->stopTracking();
     }
@@ -36,8 +38,9 @@ TrackingSystem::TrackingSystem(std::shared_ptr<EventBus> bus) : eventBus(bus) {
     }
   }));
 
-  // Update tracking position
+  // Lifecycle checks per tick, camera updates per rendered frame
   eventTokens.push_back(eventBus->subscribe<GameUpdateEvent>([this](const GameUpdateEvent &e) { this->update(e.dt); }));
+  eventTokens.push_back(eventBus->subscribe<FrameUpdateEvent>([this](const FrameUpdateEvent &) { this->followTarget(); }));
 }
 
 TrackingSystem::~TrackingSystem() = default;
@@ -45,7 +48,8 @@ TrackingSystem::~TrackingSystem() = default;
 void TrackingSystem::startTracking() {
   isTrackingActive = true;
   waitingForSpawn = true;
-  targetCar = nullptr;
+  targetCar = CarId{};
+  entityManager.setTrackedCar(targetCar);
 
   // Request a new car spawn to track
   eventBus->publish(SpawnCarRequestEvent{});
@@ -55,15 +59,17 @@ void TrackingSystem::startTracking() {
 
 void TrackingSystem::stopTracking() {
   isTrackingActive = false;
-  targetCar = nullptr;
+  targetCar = CarId{};
+  entityManager.setTrackedCar(targetCar);
   waitingForSpawn = false;
   eventBus->publish(TrackingStatusEvent{false});
   Logger::Info("TrackingSystem: Stopped.");
 }
 
 void TrackingSystem::update(double) {
-  if (!isTrackingActive || !targetCar) {
-    if (isTrackingActive && !targetCar && !waitingForSpawn) {
+  const Car *car = entityManager.getCar(targetCar);
+  if (!isTrackingActive || !car) {
+    if (isTrackingActive && !car && !waitingForSpawn) {
         // This shouldn't happen normally, maybe the car was deleted but we missed the event
         Logger::Warn("TrackingSystem: Active but no target car. Stopping.");
         stopTracking();
@@ -71,13 +77,16 @@ void TrackingSystem::update(double) {
     return;
   }
 
-  // Forward car position to camera
-  Vector2 carPos = targetCar->getPosition();
-  eventBus->publish(CameraMoveEvent{carPos});
-
   // End tracking if target car makes it to the exit
-  if (targetCar->getState() == Car::CarState::EXITING && targetCar->hasArrived()) {
+  if (car->getState() == Car::CarState::EXITING && car->hasArrived()) {
     Logger::Info("TrackingSystem: Target car exited. Stopping tracking.");
     stopTracking();
   }
-}
\ No newline at end of file
+}
+
+void TrackingSystem::followTarget() {
+  // The snapshot carries the target only while it is tracked and alive
+  Vector2 position;
+  if (entityManager.getTrackedCarPosition(position))
+    eventBus->publish(CameraFollowEvent{position});
+}
@@ -1,146 +1,72 @@
 #include "systems/TrafficSystem.hpp"
 #include "config.hpp" // Added for lane offsets
+#include "core/BinaryIO.hpp"
 #include "core/Logger.hpp"
+#include "core/Profiler.hpp"
 #include "entities/map/Modules.hpp"
 #include "events/GameEvents.hpp"
+#include "systems/ChargingModel.hpp"
 #include "systems/PathPlanner.hpp"
+#include "systems/SpotMatcher.hpp"
 
 #include "entities/Car.hpp"
 #include "raymath.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
 
 /**
  * @file TrafficSystem.cpp
  * @brief Implementation of the Traffic System.
  */
 
-TrafficSystem::TrafficSystem(std::shared_ptr<EventBus> bus, const EntityManager &em)
+TrafficSystem::TrafficSystem(std::shared_ptr<EventBus> bus, EntityManager &em)
     : eventBus(bus), entityManager(em) {
 
   // Cycle Auto Spawn Level
   eventTokens.push_back(eventBus->subscribe<CycleAutoSpawnLevelEvent>([this](const CycleAutoSpawnLevelEvent &) {
-    currentSpawnLevel++;
-    if (currentSpawnLevel > 5)
-      currentSpawnLevel = 0; // 0 to 5
-
-    Logger::Info("TrafficSystem: Auto-Spawn Level set to {}", currentSpawnLevel);
-    eventBus->publish(AutoSpawnLevelChangedEvent{currentSpawnLevel});
+    PROFILE_ZONE("TrafficSystem::onCycleAutoSpawnLevel");
+    setSpawnLevel(currentSpawnLevel + 1 > 5 ? 0 : currentSpawnLevel + 1); // 0 to 5
   }));
 
-  // 1. Handle Spawn Request -> Find Position -> Publish CreateCarEvent
+  // 1. Handle Spawn Request -> Admit or queue at an entry -> Publish CreateCarEvent
   eventTokens.push_back(eventBus->subscribe<SpawnCarRequestEvent>([this](const SpawnCarRequestEvent &) {
+    PROFILE_ZONE("TrafficSystem::onSpawnCarRequest");
     Logger::Info("TrafficSystem: Processing Spawn Request...");
-
-    const auto &modules = entityManager.getModules();
-    if (modules.empty())
-      return;
-
-    // Find Leftmost and Rightmost Roads
-    const Module *leftRoad = nullptr;
-    const Module *rightRoad = nullptr;
-    float minX = std::numeric_limits<float>::max();
-    float maxRightX = std::numeric_limits<float>::lowest();
-
-    for (const auto &mod : modules) {
-      // We assume external roads are NormalRoads
-      if (auto *r = dynamic_cast<NormalRoad *>(mod.get())) {
-        float x = r->worldPosition.x;
-        float w = r->getWidth();
-
-        if (x < minX) {
-          minX = x;
-          leftRoad = r;
-        }
-
-        if (x + w > maxRightX) {
-          maxRightX = x + w;
-          rightRoad = r;
-        }
-      }
-    }
-
-    if (!leftRoad && !rightRoad) {
-      Logger::Error("TrafficSystem: No roads found to spawn cars.");
-      return;
-    }
-
-    // Randomly choose side
-    bool spawnLeft = (GetRandomValue(0, 1) == 0);
-
-    // If one side is missing, force the other
-    if (!leftRoad)
-      spawnLeft = false;
-    if (!rightRoad)
-      spawnLeft = true;
-
-    Vector2 spawnPos = {0, 0};
-    Vector2 spawnVel = {0, 0};
-    float speed = 15.0f; // Initial speed (matches max speed roughly)
-
-    float pixelsPerMeter = static_cast<float>(Config::ART_PIXELS_PER_METER);
-
-    if (spawnLeft) {
-      // Spawn Left -> Drive Right
-      float laneOffset = (float)Config::LANE_OFFSET_DOWN / pixelsPerMeter;
-
-      // Note: road->worldPosition is Top-Left of the module in World Coordinates.
-      // Lane offset is usually relative to the top of the road asset.
-
-      spawnPos.x = leftRoad->worldPosition.x;
-      spawnPos.y = leftRoad->worldPosition.y + laneOffset;
-
-      spawnVel = {speed, 0};
-      Logger::Info("Spawning Car LEFT at ({}, {})", spawnPos.x, spawnPos.y);
-
-    } else {
-      // Spawn Right -> Drive Left
-      float laneOffset = (float)Config::LANE_OFFSET_UP / pixelsPerMeter;
-
-      spawnPos.x = rightRoad->worldPosition.x + rightRoad->getWidth();
-      spawnPos.y = rightRoad->worldPosition.y + laneOffset;
-
-      spawnVel = {-speed, 0};
-    }
-    // Random Car Type
-    // 50% Combustion, 50% Electric
-    int carType = (GetRandomValue(0, 1) == 0) ? 0 : 1;
-
-    // Random Priority
-    // 50% Price, 50% Distance
-    int priority = (GetRandomValue(0, 1) == 0) ? 0 : 1;
-
-    // Entry Side is determined by spawnLeft
-    // spawnLeft means coming FROM Left (driving Right?)
-    // Logic: if spawnLeft is true, spawnPos is on leftRoad. Velocity is positive X (Right).
-    // So it entered from LEFT.
-    bool enteredFromLeft = spawnLeft;
-
-    eventBus->publish(CreateCarEvent{spawnPos, spawnVel, carType, priority, enteredFromLeft});
+    spawnCar();
   }));
 
   // 2. Handle Car Spawned -> Calculate Path -> Publish AssignPathEvent
   eventTokens.push_back(eventBus->subscribe<CarSpawnedEvent>([this](const CarSpawnedEvent &e) {
+    PROFILE_ZONE("TrafficSystem::onCarSpawned");
     // Logger::Info("TrafficSystem: Calculating path for new car...");
+    Car *car = entityManager.getCar(e.carId);
+    if (!car)
+      return;
 
-    std::vector<Module *> facilities;
-    const auto &modules = entityManager.getModules();
+    // Keeps its entry closed until the car is listed in its lane
+    lastAdmitted[car->getEnteredFromLeft() ? 0 : 1] = e.carId;
 
-    Car::CarType type = e.car->getType();
-    float battery = e.car->getBatteryLevel();
+    Car::CarType type = car->getType();
+    float battery = car->getBatteryLevel();
+    const SimulationParams &params = entityManager.getParams();
 
     bool seekCharging = false;
 
     if (type == Car::CarType::ELECTRIC) {
-      if (battery < Config::BATTERY_LOW_THRESHOLD) {
+      if (battery < params.batteryLowThreshold) {
         seekCharging = true;
-      } else if (battery > Config::BATTERY_HIGH_THRESHOLD) {
+      } else if (battery > params.batteryHighThreshold) {
         seekCharging = false;
       } else {
         // Weighted Random: Higher battery -> Lower chance to charge
         // Normalize battery between Low (30) and High (70): 0.0 to 1.0
-        float t = (battery - Config::BATTERY_LOW_THRESHOLD) /
-                  (Config::BATTERY_HIGH_THRESHOLD - Config::BATTERY_LOW_THRESHOLD);
+        float t = (battery - params.batteryLowThreshold) /
+                  std::max(params.batteryHighThreshold - params.batteryLowThreshold, 1e-3f);
         // Probability to park (not charge) increases with battery
-        if ((float)GetRandomValue(0, 100) / 100.0f < t) {
+        if ((float)entityManager.getRandom().uniformInt(0, 100) / 100.0f < t) {
           seekCharging = false;
         } else {
           seekCharging = true;
@@ -148,35 +74,29 @@ TrafficSystem::TrafficSystem(std::shared_ptr<EventBus> bus, const EntityManager
       }
     }
 
-    // Filter Facilities
-    for (const auto &mod : modules) {
-      if (type == Car::CarType::COMBUSTION) {
-        // Combustion: Parking Only
-        if (dynamic_cast<SmallParking *>(mod.get()) || dynamic_cast<LargeParking *>(mod.get())) {
-          facilities.push_back(mod.get());
-        }
-      } else {
-        // Electric
-        if (seekCharging) {
-          if (dynamic_cast<SmallChargingStation *>(mod.get()) || dynamic_cast<LargeChargingStation *>(mod.get())) {
-            facilities.push_back(mod.get());
-          }
-        } else {
-          if (dynamic_cast<SmallParking *>(mod.get()) || dynamic_cast<LargeParking *>(mod.get())) {
-            facilities.push_back(mod.get());
-          }
-        }
-      }
+    // Batch mode: the car keeps driving until the arrivals of its window are matched together
+    if (params.spotAssignment == SpotAssignmentMode::BATCH) {
+      holdForAssignment(car, seekCharging);
+      return;
     }
 
+    // Filter Facilities: the right kind, and reachable from the car's entry (whatever the priority;
+    // the random fallback below must not pick an unreachable one either)
+    std::vector<Module *> facilities = suitableFacilities(type, seekCharging);
+    const RoadNetwork &network = getRoads();
+    int entry = car->getEnteredFromLeft() ? roadEnds.leftEntry : roadEnds.rightEntry;
+    std::erase_if(facilities, [&](const Module *fac) {
+      return network.getEntryDistance(entry, network.getGate(fac)) == RoadNetwork::UNREACHABLE;
+    });
+
       if (facilities.empty()) {
         Logger::Info("TrafficSystem: No suitable facilities found. Car passing through.");
-        assignThroughTrafficPath(e.car);
+        assignThroughTrafficPath(car);
         return;
       }
 
     if (facilities.empty()) {
-      assignThroughTrafficPath(e.car);
+      assignThroughTrafficPath(car);
       return;
     }
 
@@ -184,8 +104,7 @@ TrafficSystem::TrafficSystem(std::shared_ptr<EventBus> bus, const EntityManager
     int bestSpotIndex = -1;
     float bestMetric = std::numeric_limits<float>::max(); // Price or Distance
 
-    Car::Priority priority = e.car->getPriority();
-    Vector2 carPos = e.car->getPosition();
+    Car::Priority priority = car->getPriority();
 
     Logger::Info("TrafficSystem: Selecting facility for Car (Pri: {})", (int)priority);
 
@@ -196,14 +115,13 @@ TrafficSystem::TrafficSystem(std::shared_ptr<EventBus> bus, const EntityManager
         if (fac->getSpotCounts().free == 0)
           continue;
 
-        // Metric: Distance (Manhattan or Euclidean? Euclidean is fine)
-        // Use WorldPosition X primarily? User said: "closest facility to the entrace... that's also available"
-        // e.car->getPosition() is the spawn point right now.
-        float dist = Vector2Distance(carPos, fac->worldPosition);
+        // Metric: driving distance from the car's entry to the facility's gate (precomputed by the
+        // network)
+        float dist = network.getEntryDistance(entry, network.getGate(fac));
 
         if (dist < bestMetric) {
           // Check if actually has valid spot index
-          int idx = fac->getRandomSpotIndex(); // Random valid spot in this facility
+          int idx = fac->getRandomSpotIndex(entityManager.getRandom()); // Random valid spot in this facility
           if (idx != -1) {
             bestMetric = dist;
             targetFac = fac;
@@ -223,7 +141,7 @@ TrafficSystem::TrafficSystem(std::shared_ptr<EventBus> bus, const EntityManager
       //    So finding cheapest FACILITY is 90% of the battle.
 
       for (auto *fac : facilities) {
-        int idx = fac->getRandomSpotIndex();
+        int idx = fac->getRandomSpotIndex(entityManager.getRandom());
         if (idx == -1)
           continue; // Full
 
@@ -239,8 +157,8 @@ TrafficSystem::TrafficSystem(std::shared_ptr<EventBus> bus, const EntityManager
     if (!targetFac || bestSpotIndex == -1) {
       // Fallback: Random
       if (!facilities.empty()) {
-        targetFac = facilities[GetRandomValue(0, (int)facilities.size() - 1)];
-        bestSpotIndex = targetFac->getRandomSpotIndex();
+        targetFac = facilities[entityManager.getRandom().uniformInt(0, (int)facilities.size() - 1)];
+        bestSpotIndex = targetFac->getRandomSpotIndex(entityManager.getRandom());
       }
     }
 
@@ -250,37 +168,45 @@ TrafficSystem::TrafficSystem(std::shared_ptr<EventBus> bus, const EntityManager
     int spotIndex = bestSpotIndex;
     // If still -1, try one more time
     if (targetFac && spotIndex == -1)
-      spotIndex = targetFac->getRandomSpotIndex();
+      spotIndex = targetFac->getRandomSpotIndex(entityManager.getRandom());
 
     // Handle "Through Traffic" (No spots available)
     if (spotIndex == -1 || !targetFac) {
       Logger::Info("TrafficSystem: Facility full (Free: 0). Car passing through.");
-      assignThroughTrafficPath(e.car);
+      assignThroughTrafficPath(car);
       return;
     }
 
-    // Reserve the spot immediately
-    targetFac->setSpotState(spotIndex, SpotState::RESERVED);
-
-    // Log Reservation
-    auto counts = targetFac->getSpotCounts();
-    Logger::Info("TrafficSystem: Spot Reserved. Facility Status: [Free: {}, Reserved: {}, Occupied: {}]", counts.free,
-                 counts.reserved, counts.occupied);
-
-    Spot spot = targetFac->getSpot(spotIndex);
+    assignSpot(car, targetFac, spotIndex);
+  }));
 
-    // 2. Generate Path
-    std::vector<Waypoint> path = PathPlanner::GeneratePath(e.car, targetFac, spot);
+  // 3. Car reached its spot -> Occupy it (or leave if its reservation lapsed and the spot is gone)
+  eventTokens.push_back(eventBus->subscribe<CarArrivedAtSpotEvent>([this](const CarArrivedAtSpotEvent &e) {
+    PROFILE_ZONE("TrafficSystem::onCarArrived");
+    occupyOnArrival(e.carId);
+  }));
 
-    // Store context in Car so it knows where it is when it wants to leave
-    e.car->setParkingContext(targetFac, spot, spotIndex);
+  // A car removed on its way or while parked gives its spot back on the next tick (not right away:
+  // a checkpoint restore removes the old cars after it has set the spot states)
+  eventTokens.push_back(eventBus->subscribe<CarDeletedEvent>([this](const CarDeletedEvent &e) {
+    ReservationLedger::Reservation held;
+    if (reservations.release(e.carId, held))
+      orphanedReservations.push_back(held);
+  }));
 
-    // Publish Path Assignment
-    eventBus->publish(AssignPathEvent{e.car, path});
+  // The facilities are replaced along with the world
+  eventTokens.push_back(eventBus->subscribe<GenerateWorldEvent>([this](const GenerateWorldEvent &) {
+    reservations.clear();
+    reservationClock = 0.0f;
+    orphanedReservations.clear();
   }));
 
-  // 3. Handle Game Update
+  // 4. Handle Game Update
   eventTokens.push_back(eventBus->subscribe<GameUpdateEvent>([this](const GameUpdateEvent &e) {
+    PROFILE_ZONE("TrafficSystem::onGameUpdate");
+    releaseQueuedArrivals();
+    advanceReservations((float)e.dt);
+
     // Auto-Spawn Logic
     if (currentSpawnLevel > 0) {
       spawnTimer += (float)e.dt;
@@ -295,82 +221,38 @@ TrafficSystem::TrafficSystem(std::shared_ptr<EventBus> bus, const EntityManager
       }
     }
 
-    // We use getCars() directly
-    const auto &cars = entityManager.getCars();
-
-    // List of cars to remove (pointers)
-    std::vector<Car *> carsToRemove;
-
-    // Calculate World Road Boundaries
-    float minRoadX = std::numeric_limits<float>::max();
-    float maxRoadX = std::numeric_limits<float>::lowest();
-
-    const auto &modules = entityManager.getModules();
-    for (const auto &mod : modules) {
-      if (auto *r = dynamic_cast<NormalRoad *>(mod.get())) {
-        float x = r->worldPosition.x;
-        float w = r->getWidth();
-        if (x < minRoadX)
-          minRoadX = x;
-        if (x + w > maxRoadX)
-          maxRoadX = x + w;
-      }
+    // Batch assignment: match the arrivals once the window of the first one is over
+    if (!pendingAssignments.empty()) {
+      assignmentTimer += (float)e.dt;
+      if (assignmentTimer >= Config::Assignment::WINDOW)
+        assignPendingArrivals();
     }
 
-    if (minRoadX == std::numeric_limits<float>::max())
-      minRoadX = 0;
-    if (maxRoadX == std::numeric_limits<float>::lowest())
-      maxRoadX = 100;
+    // Only awake cars: sleeping parked cars are caught up by the ChunkGrid when they become due
+    const std::vector<CarId> &activeCars = entityManager.getActiveCars();
 
-    for (const auto &carPtr : cars) {
-      Car *car = carPtr.get();
+    // List of cars to remove (handles)
+    std::vector<CarId> carsToRemove;
+
+    for (CarId id : activeCars) {
+      Car *car = entityManager.getCar(id);
       if (!car)
         continue;
 
-      // Check for Arrival (Transition RESERVED -> OCCUPIED)
-      if (car->getState() == Car::CarState::ALIGNING || car->getState() == Car::CarState::PARKED) {
-        Module *fac = const_cast<Module *>(car->getParkedFacility());
-        int idx = car->getParkedSpotIndex();
-        if (fac && idx != -1) {
-          Spot s = fac->getSpot(idx);
-          if (s.state == SpotState::RESERVED) {
-            fac->setSpotState(idx, SpotState::OCCUPIED);
-            // auto counts = fac->getSpotCounts();
-            // Logger::Info("TrafficSystem: Spot Occupied.");
-          }
-        }
-      }
-
-      // Handle Parked Logic (Charging vs Waiting)
+      // Handle Parked Logic: an electric car on a charger plugs in once, with its exit time
+      // sampled up front; from then on it waits for its timer like any parked car
       bool shouldExit = false;
 
       if (car->getState() == Car::CarState::PARKED) {
-        Module *fac = const_cast<Module *>(car->getParkedFacility());
-
-        bool isChargingSpot = false;
-        if (dynamic_cast<SmallChargingStation *>(fac) || dynamic_cast<LargeChargingStation *>(fac)) {
-          isChargingSpot = true;
-        }
-
-        if (isChargingSpot && car->getType() == Car::CarType::ELECTRIC) {
-          car->charge(Config::CHARGING_RATE * (float)e.dt);
-          float bat = car->getBatteryLevel();
-
-          if (bat > Config::BATTERY_FORCE_EXIT_THRESHOLD) {
-            shouldExit = true;
-          } else if (bat > Config::BATTERY_EXIT_THRESHOLD) {
-            float range = Config::BATTERY_FORCE_EXIT_THRESHOLD - Config::BATTERY_EXIT_THRESHOLD;
-            float excess = bat - Config::BATTERY_EXIT_THRESHOLD;
-            float probability = 0.5f * (excess / range) * (float)e.dt;
-            if ((float)GetRandomValue(0, 10000) / 10000.0f < probability) {
-              shouldExit = true;
-            }
-          }
-        } else {
-          if (car->isReadyToLeave()) {
-            shouldExit = true;
-          }
+        const Module *fac = car->getParkedFacility();
+        if (!car->isCharging() && car->getType() == Car::CarType::ELECTRIC && fac &&
+            OccupancyStats::isCharging(fac->getType())) {
+          const SimulationParams &params = entityManager.getParams();
+          float duration =
+              ChargingModel::sampleExitDelay(car->getBatteryLevel(), params, entityManager.getRandom());
+          car->startCharging(params.chargingRate, duration);
         }
+        shouldExit = car->isReadyToLeave();
       }
 
       // Check if ready to leave parking
@@ -378,47 +260,194 @@ TrafficSystem::TrafficSystem(std::shared_ptr<EventBus> bus, const EntityManager
         // ... (Existing Exit Logic) ...
         Logger::Info("TrafficSystem: Car exiting.");
 
-        Module *currentFac = const_cast<Module *>(car->getParkedFacility());
-        Spot currentSpot = car->getParkedSpot();
-        int idx = car->getParkedSpotIndex();
-
-        if (!currentFac) {
+        if (!car->getParkedFacility()) {
           car->setState(Car::CarState::DRIVING);
           continue;
         }
 
-        if (idx != -1) {
-          currentFac->setSpotState(idx, SpotState::FREE);
-        }
-
-        bool exitRight = false;
-        if (car->getPriority() == Car::Priority::PRIORITY_DISTANCE) {
-          exitRight = !car->getEnteredFromLeft();
-        } else {
-          exitRight = (GetRandomValue(0, 1) == 1);
-        }
-
-        float finalX = exitRight ? (maxRoadX + 2.0f) : (minRoadX - 2.0f);
-        std::vector<Waypoint> path = PathPlanner::GenerateExitPath(car, currentFac, currentSpot, exitRight, finalX);
-
-        car->setPath(path);
-        car->setState(Car::CarState::EXITING);
+        ReservationLedger::Reservation held;
+        if (reservations.release(id, held))
+          entityManager.setSpotState(held.facility, held.spotIndex, SpotState::FREE, held.price);
+        sendToExit(car);
       }
 
       // Check if finished exiting
       if (car->getState() == Car::CarState::EXITING && car->hasArrived()) {
-        carsToRemove.push_back(car);
+        carsToRemove.push_back(car->getId());
       }
     }
 
-    for (Car *c : carsToRemove) {
-      const_cast<EntityManager &>(entityManager).removeCar(c);
+    for (CarId id : carsToRemove) {
+      entityManager.removeCar(id);
     }
   }));
 }
 
 TrafficSystem::~TrafficSystem() { eventTokens.clear(); }
 
+void TrafficSystem::setSpawnLevel(int level) {
+  if (level < 0 || level >= (int)std::size(Config::Spawner::SPAWN_RATES))
+    throw std::out_of_range("Auto-spawn level out of range");
+  currentSpawnLevel = level;
+
+  Logger::Info("TrafficSystem: Auto-Spawn Level set to {}", currentSpawnLevel);
+  eventBus->publish(AutoSpawnLevelChangedEvent{currentSpawnLevel});
+}
+
+void TrafficSystem::saveCheckpoint(BinaryWriter &out) const {
+  out.write((int32_t)currentSpawnLevel);
+  out.write(spawnTimer);
+  for (const auto &queue : entryQueues) {
+    out.write((uint32_t)queue.size());
+    for (const QueuedArrival &arrival : queue) {
+      out.write((int32_t)arrival.carType);
+      out.write((int32_t)arrival.priority);
+    }
+  }
+
+  // Reservations, by the car's position in the checkpoint's car list and the facility's module index
+  std::unordered_map<const Module *, int32_t> moduleIndex;
+  const auto &modules = entityManager.getModules();
+  for (size_t i = 0; i < modules.size(); ++i)
+    moduleIndex[modules[i].get()] = (int32_t)i;
+
+  std::vector<std::pair<uint32_t, const ReservationLedger::Reservation *>> held;
+  std::unordered_map<uint32_t, uint32_t> listPosition; // CarId slot -> position in the car list
+  const auto &cars = entityManager.getCars();
+  for (size_t i = 0; i < cars.size(); ++i) {
+    listPosition[cars[i]->getId().index] = (uint32_t)i;
+    if (const ReservationLedger::Reservation *r = reservations.find(cars[i]->getId()))
+      held.push_back({(uint32_t)i, r});
+  }
+  out.write(reservations.getTick());
+  out.write(reservationClock);
+  out.write((uint32_t)held.size());
+  for (const auto &[car, r] : held) {
+    out.write(car);
+    out.write(moduleIndex.at(r->facility));
+    out.write((int32_t)r->spotIndex);
+    out.write(r->expiry);
+  }
+
+  // Arrivals waiting for the batch assignment, by the car's position in the car list
+  std::vector<std::pair<uint32_t, bool>> pending;
+  for (const PendingAssignment &arrival : pendingAssignments) {
+    auto it = listPosition.find(arrival.carId.index);
+    if (it != listPosition.end() && cars[it->second]->getId() == arrival.carId)
+      pending.push_back({it->second, arrival.seekCharging});
+  }
+  out.write(assignmentTimer);
+  out.write((uint32_t)pending.size());
+  for (const auto &[car, seekCharging] : pending) {
+    out.write(car);
+    out.write((uint8_t)seekCharging);
+  }
+}
+
+TrafficSystem::CheckpointState TrafficSystem::readCheckpoint(BinaryReader &in, size_t carCount) const {
+  CheckpointState state;
+  state.spawnLevel = in.read<int32_t>();
+  state.spawnTimer = in.read<float>();
+  if (state.spawnLevel < 0 || state.spawnLevel >= (int32_t)std::size(Config::Spawner::SPAWN_RATES))
+    throw std::runtime_error("Checkpoint contains an invalid spawn level");
+
+  for (auto &queue : state.entryQueues) {
+    uint32_t count = in.read<uint32_t>();
+    for (uint32_t i = 0; i < count; ++i) {
+      int32_t carType = in.read<int32_t>();
+      int32_t priority = in.read<int32_t>();
+      if (carType < 0 || carType > 1 || priority < 0 || priority > 1)
+        throw std::runtime_error("Checkpoint contains an invalid queued arrival");
+      queue.push_back({carType, priority});
+    }
+  }
+
+  state.reservationTick = in.read<uint64_t>();
+  state.reservationClock = in.read<float>();
+  uint32_t heldCount = in.read<uint32_t>();
+  const auto &modules = entityManager.getModules();
+  for (uint32_t i = 0; i < heldCount; ++i) {
+    CheckpointState::HeldSpot h;
+    h.car = in.read<uint32_t>();
+    h.facility = in.read<int32_t>();
+    h.spotIndex = in.read<int32_t>();
+    h.expiry = in.read<uint64_t>();
+    if (h.car >= carCount || h.facility < 0 || h.facility >= (int32_t)modules.size() || h.spotIndex < 0 ||
+        h.spotIndex >= (int32_t)modules[h.facility]->getSpotCount() || h.expiry <= state.reservationTick)
+      throw std::runtime_error("Checkpoint contains an invalid reservation");
+    state.held.push_back(h);
+  }
+
+  state.assignmentTimer = in.read<float>();
+  uint32_t pendingCount = in.read<uint32_t>();
+  for (uint32_t i = 0; i < pendingCount; ++i) {
+    uint32_t car = in.read<uint32_t>();
+    uint8_t seekCharging = in.read<uint8_t>();
+    if (car >= carCount || seekCharging > 1)
+      throw std::runtime_error("Checkpoint contains an invalid pending assignment");
+    state.pending.push_back({car, seekCharging == 1});
+  }
+  return state;
+}
+
+void TrafficSystem::restoreCheckpoint(const CheckpointState &state) {
+  currentSpawnLevel = state.spawnLevel;
+  spawnTimer = state.spawnTimer;
+  entryQueues = state.entryQueues;
+
+  // The restored cars have new ids. The removed ones gave nothing back: their reservations were
+  // orphaned by the CarDeletedEvents of the restore, and freeing them would undo the restored spot states.
+  const auto &modules = entityManager.getModules();
+  const auto &cars = entityManager.getCars();
+  reservations.clear(state.reservationTick);
+  reservationClock = state.reservationClock;
+  orphanedReservations.clear();
+  for (const CheckpointState::HeldSpot &h : state.held) {
+    // The quote is not written with the reservation: the car kept it with its parking context
+    const Car *car = cars[h.car].get();
+    CarId carId = car->getId();
+    bool arrived = h.expiry == ReservationLedger::NO_EXPIRY;
+    reservations.reserve(carId, modules[h.facility].get(), h.spotIndex, arrived ? 1 : h.expiry - state.reservationTick,
+                         car->getParkedSpot().price);
+    if (arrived)
+      reservations.confirm(carId);
+  }
+  lastAdmitted = {};
+
+  // The waiting arrivals, under their cars' new ids
+  pendingAssignments.clear();
+  for (const CheckpointState::Pending &p : state.pending)
+    pendingAssignments.push_back({cars[p.car]->getId(), p.seekCharging});
+  assignmentTimer = state.assignmentTimer;
+
+  publishQueueLength();
+}
+
+const RoadNetwork &TrafficSystem::getRoads() {
+  if (entityManager.getModuleRevision() == roadsRevision)
+    return roads;
+
+  roadsRevision = entityManager.getModuleRevision();
+  roads.build(entityManager.getModules());
+
+  // The main road's ends: the outermost entries and exits along X
+  roadEnds = {};
+  auto outermost = [](const std::vector<RoadNetwork::Terminal> &terminals, float side, float heading) {
+    int best = -1;
+    for (int i = 0; i < (int)terminals.size(); ++i) {
+      const RoadNetwork::Terminal &t = terminals[i];
+      if (t.direction.x * heading > 0.5f && (best == -1 || t.position.x * side > terminals[best].position.x * side))
+        best = i;
+    }
+    return best;
+  };
+  roadEnds.leftEntry = outermost(roads.getEntries(), -1.0f, 1.0f);
+  roadEnds.rightEntry = outermost(roads.getEntries(), 1.0f, -1.0f);
+  roadEnds.leftExit = outermost(roads.getExits(), -1.0f, -1.0f);
+  roadEnds.rightExit = outermost(roads.getExits(), 1.0f, 1.0f);
+  return roads;
+}
+
 void TrafficSystem::spawnCar() {
   Logger::Info("TrafficSystem: Processing Spawn Logic...");
 
@@ -426,102 +455,349 @@ void TrafficSystem::spawnCar() {
   if (modules.empty())
     return;
 
-  // Find Leftmost and Rightmost Roads
-  const Module *leftRoad = nullptr;
-  const Module *rightRoad = nullptr;
-  float minX = std::numeric_limits<float>::max();
-  float maxRightX = std::numeric_limits<float>::lowest();
+  // Ends of the main road
+  getRoads();
+  if (roadEnds.leftEntry == -1 && roadEnds.rightEntry == -1)
+    return;
+
+  bool spawnLeft = (entityManager.getRandom().uniformInt(0, 1) == 0);
+  if (roadEnds.leftEntry == -1)
+    spawnLeft = false;
+  if (roadEnds.rightEntry == -1)
+    spawnLeft = true;
+
+  int carType = (entityManager.getRandom().uniformInt(0, 1) == 0) ? 0 : 1;
+  int priority = (entityManager.getRandom().uniformInt(0, 1) == 0) ? 0 : 1;
 
-  for (const auto &mod : modules) {
-    if (auto *r = dynamic_cast<NormalRoad *>(mod.get())) {
-      float x = r->worldPosition.x;
-      float w = r->getWidth();
+  // Queue behind the ones already waiting; enters right away if it is the only one and the lane is clear
+  entryQueues[spawnLeft ? 0 : 1].push_back({carType, priority});
+  releaseQueuedArrivals();
+}
 
-      if (x < minX) {
-        minX = x;
-        leftRoad = r;
-      }
+bool TrafficSystem::getEntry(bool left, Vector2 &position, Vector2 &velocity) {
+  const RoadNetwork &network = getRoads();
+  const float speed = 15.0f; // Initial speed (matches max speed roughly)
+
+  // Spawn Left -> Drive Right in the down lane; Spawn Right -> Drive Left in the up lane
+  int entry = left ? roadEnds.leftEntry : roadEnds.rightEntry;
+  if (entry == -1)
+    return false;
+  position = network.getEntries()[entry].position;
+  velocity = Vector2Scale(network.getEntries()[entry].direction, speed);
+  return true;
+}
+
+bool TrafficSystem::isEntryClear(bool left, Vector2 entry) {
+  float direction = left ? 1.0f : -1.0f;
+  auto blocks = [&](const Car *car) {
+    return car && std::fabs(car->getPosition().y - entry.y) < Config::CarAI::Idm::LANE_HALF_WIDTH &&
+           (car->getPosition().x - entry.x) * direction < Config::Spawner::ENTRY_CLEARANCE;
+  };
+
+  // The lane lists are one tick old: the car admitted since is checked on its own
+  if (blocks(entityManager.getLanes().lastInLane(left ? Lane::DOWN : Lane::UP)))
+    return false;
+  return !blocks(entityManager.getCar(lastAdmitted[left ? 0 : 1]));
+}
+
+void TrafficSystem::releaseQueuedArrivals() {
+  for (int side = 0; side < 2; ++side) {
+    std::deque<QueuedArrival> &queue = entryQueues[side];
+    if (queue.empty())
+      continue;
+
+    bool left = side == 0;
+    Vector2 position;
+    Vector2 velocity;
+    if (!getEntry(left, position, velocity)) {
+      queue.clear(); // The road of this side is gone
+      continue;
+    }
+    if (!isEntryClear(left, position))
+      continue;
 
-      if (x + w > maxRightX) {
-        maxRightX = x + w;
-        rightRoad = r;
+    QueuedArrival arrival = queue.front();
+    queue.pop_front();
+    eventBus->publish(CreateCarEvent{position, velocity, arrival.carType, arrival.priority, left});
+  }
+  publishQueueLength();
+}
+
+void TrafficSystem::publishQueueLength() {
+  int length = getSpawnQueueLength();
+  if (length == reportedQueueLength)
+    return;
+  reportedQueueLength = length;
+  eventBus->publish(SpawnQueueChangedEvent{length});
+}
+
+std::vector<Module *> TrafficSystem::suitableFacilities(Car::CarType type, bool seekCharging) const {
+  std::vector<Module *> facilities;
+  for (const auto &mod : entityManager.getModules()) {
+    if (type == Car::CarType::COMBUSTION) {
+      // Combustion: Parking Only
+      if (dynamic_cast<SmallParking *>(mod.get()) || dynamic_cast<LargeParking *>(mod.get())) {
+        facilities.push_back(mod.get());
+      }
+    } else {
+      // Electric
+      if (seekCharging) {
+        if (dynamic_cast<SmallChargingStation *>(mod.get()) || dynamic_cast<LargeChargingStation *>(mod.get())) {
+          facilities.push_back(mod.get());
+        }
+      } else {
+        if (dynamic_cast<SmallParking *>(mod.get()) || dynamic_cast<LargeParking *>(mod.get())) {
+          facilities.push_back(mod.get());
+        }
       }
     }
   }
+  return facilities;
+}
+
+void TrafficSystem::assignSpot(Car *car, Module *facility, int spotIndex) {
+  // Reserve the spot immediately, until the car arrives or the reservation lapses
+  entityManager.setSpotState(facility, spotIndex, SpotState::RESERVED);
+  reservations.reserve(car->getId(), facility, spotIndex,
+                       (uint64_t)std::ceil(Config::Reservation::TIMEOUT / Config::Reservation::TICK),
+                       facility->getSpot(spotIndex).price);
+
+  // How long the car will stay once parked (0.1 s resolution)
+  const SimulationParams &params = entityManager.getParams();
+  car->setParkingDuration((float)entityManager.getRandom().uniformInt((int)(params.parkingMinTime * 10),
+                                                                      (int)(params.parkingMaxTime * 10)) /
+                          10.0f);
+
+  // Log Reservation
+  auto counts = facility->getSpotCounts();
+  Logger::Info("TrafficSystem: Spot Reserved. Facility Status: [Free: {}, Reserved: {}, Occupied: {}]", counts.free,
+               counts.reserved, counts.occupied);
+
+  Spot spot = facility->getSpot(spotIndex);
+
+  // Generate Path
+  std::vector<Waypoint> path = PathPlanner::GeneratePath(getRoads(), car, facility, spot);
+
+  // Store context in Car so it knows where it is when it wants to leave
+  car->setParkingContext(facility, spot, spotIndex);
+
+  // Publish Path Assignment
+  eventBus->publish(AssignPathEvent{car->getId(), path});
+}
 
-  if (!leftRoad && !rightRoad)
+void TrafficSystem::occupyOnArrival(CarId carId) {
+  Car *car = entityManager.getCar(carId);
+  if (!car)
     return;
 
-  bool spawnLeft = (GetRandomValue(0, 1) == 0);
-  if (!leftRoad)
-    spawnLeft = false;
-  if (!rightRoad)
-    spawnLeft = true;
+  if (reservations.confirm(carId)) {
+    const ReservationLedger::Reservation *held = reservations.find(carId);
+    entityManager.setSpotState(held->facility, held->spotIndex, SpotState::OCCUPIED);
+    return;
+  }
+
+  // The reservation lapsed on the way: take the spot if nobody else did, otherwise drive on out
+  const Module *parked = car->getParkedFacility();
+  int spotIndex = car->getParkedSpotIndex();
+  if (!parked || spotIndex == -1)
+    return;
+  Module *facility = nullptr;
+  for (const auto &module : entityManager.getModules()) {
+    if (module.get() == parked)
+      facility = module.get();
+  }
+  if (facility && facility->getSpot(spotIndex).state == SpotState::FREE) {
+    reservations.reserve(carId, facility, spotIndex, 1, car->getParkedSpot().price);
+    reservations.confirm(carId);
+    entityManager.setSpotState(facility, spotIndex, SpotState::OCCUPIED);
+    return;
+  }
+  Logger::Info("TrafficSystem: Car arrived after its spot was given away. Leaving.");
+  sendToExit(car);
+}
 
-  Vector2 spawnPos = {0, 0};
-  Vector2 spawnVel = {0, 0};
-  float speed = 15.0f;
-  float pixelsPerMeter = static_cast<float>(Config::ART_PIXELS_PER_METER);
+void TrafficSystem::advanceReservations(float dt) {
+  // Spots of removed cars
+  for (const ReservationLedger::Reservation &orphan : orphanedReservations)
+    entityManager.setSpotState(orphan.facility, orphan.spotIndex, SpotState::FREE, orphan.price);
+  orphanedReservations.clear();
+
+  reservationClock += dt;
+  while (reservationClock >= Config::Reservation::TICK) {
+    reservationClock -= Config::Reservation::TICK;
+    lapsedReservations.clear();
+    reservations.advance(lapsedReservations);
+    for (const ReservationLedger::Reservation &lapsed : lapsedReservations) {
+      Logger::Warn("TrafficSystem: Car {} did not reach its spot in time. Reservation released.",
+                   lapsed.carId.index);
+      entityManager.setSpotState(lapsed.facility, lapsed.spotIndex, SpotState::FREE);
+    }
+  }
+}
 
-  if (spawnLeft) {
-    float laneOffset = (float)Config::LANE_OFFSET_DOWN / pixelsPerMeter;
-    spawnPos.x = leftRoad->worldPosition.x;
-    spawnPos.y = leftRoad->worldPosition.y + laneOffset;
-    spawnVel = {speed, 0};
+void TrafficSystem::sendToExit(Car *car) {
+  bool exitRight = false;
+  if (car->getPriority() == Car::Priority::PRIORITY_DISTANCE) {
+    exitRight = !car->getEnteredFromLeft();
   } else {
-    float laneOffset = (float)Config::LANE_OFFSET_UP / pixelsPerMeter;
-    spawnPos.x = rightRoad->worldPosition.x + rightRoad->getWidth();
-    spawnPos.y = rightRoad->worldPosition.y + laneOffset;
-    spawnVel = {-speed, 0};
+    exitRight = (entityManager.getRandom().uniformInt(0, 1) == 1);
   }
 
-  int carType = (GetRandomValue(0, 1) == 0) ? 0 : 1;
-  int priority = (GetRandomValue(0, 1) == 0) ? 0 : 1;
-  bool enteredFromLeft = spawnLeft;
+  // An end the facility cannot reach (one-way layouts): the nearest exit it can
+  const RoadNetwork &network = getRoads();
+  int exit = exitRight ? roadEnds.rightExit : roadEnds.leftExit;
+  int from = network.getFacilityExit(car->getParkedFacility());
+  if (from != -1 && network.getExitDistance(from, exit) == RoadNetwork::UNREACHABLE)
+    exit = network.findNearestExit(from);
+  std::vector<Waypoint> path =
+      PathPlanner::GenerateExitPath(network, car, car->getParkedFacility(), car->getParkedSpot(), exit);
 
-  eventBus->publish(CreateCarEvent{spawnPos, spawnVel, carType, priority, enteredFromLeft});
+  car->setPath(path);
+  car->setState(Car::CarState::EXITING);
 }
 
-void TrafficSystem::assignThroughTrafficPath(Car *car) {
-  if (!car)
+void TrafficSystem::holdForAssignment(Car *car, bool seekCharging) {
+  if (pendingAssignments.empty())
+    assignmentTimer = 0.0f;
+  pendingAssignments.push_back({car->getId(), seekCharging});
+
+  // Keep going along the lanes meanwhile (without stopping or turning away)
+  car->setPath(PathPlanner::GenerateThroughPath(getRoads(), car));
+}
+
+void TrafficSystem::assignPendingArrivals() {
+  PROFILE_ZONE("TrafficSystem::assignPendingArrivals");
+  std::vector<PendingAssignment> arrivals;
+  arrivals.swap(pendingAssignments);
+
+  // Interchangeable arrivals: same kind of facility, same preference, same entry
+  struct Batch {
+    std::vector<Car *> cars;
+    Car::CarType type = Car::CarType::COMBUSTION;
+    bool seekCharging = false;
+    Car::Priority priority = Car::Priority::PRIORITY_PRICE;
+    bool fromLeft = false;
+  };
+  std::array<Batch, 8> batches;
+  int carCount = 0;
+  for (const PendingAssignment &arrival : arrivals) {
+    Car *car = entityManager.getCar(arrival.carId);
+    if (!car)
+      continue;
+    bool charging = car->getType() == Car::CarType::ELECTRIC && arrival.seekCharging;
+    bool byDistance = car->getPriority() == Car::Priority::PRIORITY_DISTANCE;
+    Batch &batch = batches[(charging ? 4 : 0) + (byDistance ? 2 : 0) + (car->getEnteredFromLeft() ? 1 : 0)];
+    batch.cars.push_back(car);
+    batch.type = car->getType();
+    batch.seekCharging = arrival.seekCharging;
+    batch.priority = car->getPriority();
+    batch.fromLeft = car->getEnteredFromLeft();
+    carCount++;
+  }
+  if (carCount == 0)
     return;
 
-  // Calculate Map Bounds
-  float minRoadX = std::numeric_limits<float>::max();
-  float maxRoadX = std::numeric_limits<float>::lowest();
+  // Free spots of the facilities any arrival may use, and the candidates of every group
+  struct FreeSpot {
+    Module *facility;
+    int index;
+  };
+  std::vector<FreeSpot> spots;
+  std::unordered_map<const Module *, size_t> firstSpot; // Facility -> its first entry in spots
+  std::vector<SpotMatcher::Group> groups;
+  std::vector<Batch *> groupBatches;
+  std::vector<std::pair<float, int>> ranked; // (raw cost, spot)
+
+  const RoadNetwork &network = getRoads();
+  for (Batch &batch : batches) {
+    if (batch.cars.empty())
+      continue;
+
+    int entry = batch.fromLeft ? roadEnds.leftEntry : roadEnds.rightEntry;
+
+    ranked.clear();
+    for (Module *facility : suitableFacilities(batch.type, batch.seekCharging)) {
+      // Only facilities the entry leads to; distance is driven to the gate, then straight to the spot
+      int gate = network.getGate(facility);
+      float toGate = network.getEntryDistance(entry, gate);
+      if (toGate == RoadNetwork::UNREACHABLE)
+        continue;
 
-  const auto &modules = entityManager.getModules();
-  for (const auto &mod : modules) {
-    if (auto *r = dynamic_cast<NormalRoad *>(mod.get())) {
-      float x = r->worldPosition.x;
-      float w = r->getWidth();
-      if (x < minRoadX)
-        minRoadX = x;
-      if (x + w > maxRoadX)
-        maxRoadX = x + w;
+      auto [it, added] = firstSpot.try_emplace(facility, spots.size());
+      if (added) {
+        for (int i = 0; i < (int)facility->getSpotCount(); ++i) {
+          if (facility->getSpot(i).state == SpotState::FREE)
+            spots.push_back({facility, i});
+        }
+      }
+      for (size_t s = it->second; s < spots.size() && spots[s].facility == facility; ++s) {
+        const Spot &spot = facility->getSpot(spots[s].index);
+        float cost = batch.priority == Car::Priority::PRIORITY_DISTANCE
+                         ? toGate + Vector2Distance(network.getNodePosition(gate),
+                                                    Vector2Add(facility->worldPosition, spot.localPosition))
+                         : spot.price;
+        ranked.push_back({cost, (int)s});
+      }
+    }
+
+    // No car needs more candidates than there are arrivals; costs scaled to the group's range
+    size_t keep = std::min(ranked.size(), (size_t)carCount);
+    std::partial_sort(ranked.begin(), ranked.begin() + keep, ranked.end());
+    ranked.resize(keep);
+    float lowest = std::numeric_limits<float>::max();
+    float highest = std::numeric_limits<float>::lowest();
+    for (const auto &[cost, s] : ranked) {
+      lowest = std::min(lowest, cost);
+      highest = std::max(highest, cost);
+    }
+
+    SpotMatcher::Group group;
+    group.cars = (int)batch.cars.size();
+    for (const auto &[cost, s] : ranked) {
+      float t = highest > lowest ? (cost - lowest) / (highest - lowest) : 0.0f;
+      group.candidates.push_back({s, (int)std::lround(t * Config::Assignment::COST_LEVELS)});
     }
+    groups.push_back(std::move(group));
+    groupBatches.push_back(&batch);
   }
 
-  // Fallback if no roads (shouldn't happen if we are here)
-  if (minRoadX == std::numeric_limits<float>::max())
-    minRoadX = 0;
-  if (maxRoadX == std::numeric_limits<float>::lowest())
-    maxRoadX = 100;
+  std::vector<std::vector<int>> assigned = SpotMatcher::solve(groups, (int)spots.size());
+  std::vector<int> spotGroup(spots.size(), -1);
+  for (size_t g = 0; g < assigned.size(); ++g) {
+    for (int s : assigned[g])
+      spotGroup[s] = (int)g;
+  }
 
-  // Determine direction based on current velocity
-  bool movingRight = car->getVelocity().x > 0;
+  for (size_t g = 0; g < groups.size(); ++g) {
+    // Candidates are sorted by cost: the best spots go to the earliest arrivals of the group
+    std::vector<int> taken;
+    for (const SpotMatcher::Candidate &c : groups[g].candidates) {
+      if (spotGroup[c.spot] == (int)g)
+        taken.push_back(c.spot);
+    }
 
-  // Target beyond map edge with some padding (2 meters)
-  float finalX = movingRight ? (maxRoadX + 2.0f) : (minRoadX - 2.0f);
-  float yPos = car->getPosition().y; // Maintain current lane Y
+    std::vector<Car *> &cars = groupBatches[g]->cars;
+    for (size_t i = 0; i < cars.size(); ++i) {
+      if (i < taken.size()) {
+        assignSpot(cars[i], spots[taken[i]].facility, spots[taken[i]].index);
+      } else {
+        Logger::Info("TrafficSystem: No spot left in the batch. Car passing through.");
+        assignThroughTrafficPath(cars[i]);
+      }
+    }
+  }
+}
+
+void TrafficSystem::assignThroughTrafficPath(Car *car) {
+  if (!car)
+    return;
 
-  // Create direct exit path
-  std::vector<Waypoint> exitPath;
-  // A single waypoint at the end of the world
-  exitPath.push_back(Waypoint({finalX, yPos}, 1.0f, -1, 0.0f, true));
+  // On along the lanes and out of the nearest exit (an empty path if the car is off the roads: it is removed)
+  std::vector<Waypoint> exitPath = PathPlanner::GenerateThroughPath(getRoads(), car);
 
   car->setPath(exitPath);
   car->setState(Car::CarState::EXITING);
 
-  eventBus->publish(AssignPathEvent{car, exitPath});
+  eventBus->publish(AssignPathEvent{car->getId(), exitPath});
+  eventBus->publish(CarTurnedAwayEvent{car->getId()});
 }
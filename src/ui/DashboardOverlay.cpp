@@ -2,15 +2,24 @@
 #include "config.hpp"
 #include "events/InputEvents.hpp"
 #include "raymath.h"
+#include <algorithm>
 #include <format>
 #include <string>
 
-DashboardOverlay::DashboardOverlay(std::shared_ptr<EventBus> bus, EntityManager *em)
-    : UIElement({0, 0}, {0, 0}, bus), entityManager(em) {
+namespace {
+// Metrics shown as sparklines on the general page
+constexpr MetricsRecorder::Metric SPARKLINE_METRICS[] = {
+    MetricsRecorder::Metric::OCCUPANCY, MetricsRecorder::Metric::IN_TRANSIT, MetricsRecorder::Metric::SPAWN_RATE,
+    MetricsRecorder::Metric::SPAWN_QUEUE, MetricsRecorder::Metric::REVENUE};
+constexpr int SPARKLINE_COUNT = sizeof(SPARKLINE_METRICS) / sizeof(SPARKLINE_METRICS[0]);
+constexpr int SPARKLINE_HEIGHT = 42; // Label (16) + chart (22) + spacing
+} // namespace
+
+DashboardOverlay::DashboardOverlay(std::shared_ptr<EventBus> bus, EntityManager *em, const MetricsRecorder *metrics)
+    : UIElement({0, 0}, {0, 0}, bus), entityManager(em), metrics(metrics) {
 
   // Subscribe to selection events
   eventTokens.push_back(bus->subscribe<EntitySelectedEvent>([this](const EntitySelectedEvent &e) {
-    currentSelection = e;
     // If something is selected, ensure it's visible? Or keep user preference?
     // Let's force visible on selection for better UX
     if (e.type != SelectionType::GENERAL) {
@@ -28,9 +37,6 @@ DashboardOverlay::DashboardOverlay(std::shared_ptr<EventBus> bus, EntityManager
       eventBus->publish(ToggleDashboardEvent{});
     }
   }));
-
-  // Default to general info
-  currentSelection.type = SelectionType::GENERAL;
 }
 
 DashboardOverlay::~DashboardOverlay() {
@@ -42,9 +48,12 @@ void DashboardOverlay::update(double /*dt*/) {
 }
 
 void DashboardOverlay::draw() {
-  if (!visible)
+  if (!visible || !entityManager)
     return;
 
+  const RenderSnapshot &snapshot = entityManager->getRenderSnapshot();
+  const SelectionView &selection = snapshot.selection;
+
   int screenWidth = Config::LOGICAL_WIDTH;
   int panelWidth = 300;
   int pad = 20;
@@ -57,15 +66,17 @@ void DashboardOverlay::draw() {
   int headerHeight = 30;
 
   // Rough estimation per type
-  if (currentSelection.type == SelectionType::GENERAL) {
+  if (selection.type == SelectionType::GENERAL) {
     estimatedHeight = headerHeight + 10 + 25 + (3 * 25) + 10 + 25 + 25 + (3 * 25); // ~350
-  } else if (currentSelection.type == SelectionType::CAR) {
+    if (metrics)
+      estimatedHeight += 10 + 25 + SPARKLINE_COUNT * SPARKLINE_HEIGHT;
+  } else if (selection.type == SelectionType::CAR) {
     estimatedHeight = headerHeight + (5 * 25); // ~155
-    if (currentSelection.car && currentSelection.car->getType() == Car::CarType::ELECTRIC)
+    if (selection.carFound && selection.car.type == Car::CarType::ELECTRIC)
       estimatedHeight += 25;
-  } else if (currentSelection.type == SelectionType::FACILITY) {
-    estimatedHeight = headerHeight + (8 * 25); // ~230
-  } else if (currentSelection.type == SelectionType::SPOT) {
+  } else if (selection.type == SelectionType::FACILITY) {
+    estimatedHeight = headerHeight + (9 * 25); // ~255
+  } else if (selection.type == SelectionType::SPOT) {
     estimatedHeight = headerHeight + (3 * 25); // ~105
   }
 
@@ -80,69 +91,29 @@ void DashboardOverlay::draw() {
   int contentY = y + 15;
   int contentWidth = panelWidth - 30;
 
-  switch (currentSelection.type) {
+  switch (selection.type) {
   case SelectionType::CAR:
-    drawCarInfo(contentX, contentY, contentWidth);
+    drawCarInfo(selection, contentX, contentY, contentWidth);
     break;
   case SelectionType::FACILITY:
-    drawFacilityInfo(contentX, contentY, contentWidth);
+    drawFacilityInfo(selection, contentX, contentY, contentWidth);
     break;
   case SelectionType::SPOT:
-    drawSpotInfo(contentX, contentY, contentWidth);
+    drawSpotInfo(selection, contentX, contentY, contentWidth);
     break;
   case SelectionType::GENERAL:
   default:
-    drawGeneralInfo(contentX, contentY, contentWidth);
+    drawGeneralInfo(snapshot, contentX, contentY, contentWidth);
     break;
   }
 }
 
-void DashboardOverlay::drawGeneralInfo(int x, int y, int width) {
+void DashboardOverlay::drawGeneralInfo(const RenderSnapshot &snapshot, int x, int y, int width) {
   DrawText("GENERAL INFO", x, y, 20, GOLD);
   y += 30;
 
-  int totalFacilities = 0;
-  int totalSpots = 0;
-  int occupiedSpots = 0;
-
-  int chargingStations = 0;
-  int parkingLots = 0;
-
-  int chargingSpots = 0;
-  int occupiedCharging = 0;
-
-  int parkingSpots = 0;
-  int occupiedParking = 0;
-
-  if (entityManager) {
-    auto &modules = entityManager->getModules();
-    // totalFacilities = modules.size(); // Incorrect, includes roads
-
-    for (const auto &m : modules) {
-      auto type = m->getType();
-      bool isCharging = (type == ModuleType::SMALL_CHARGING || type == ModuleType::LARGE_CHARGING);
-      bool isParking = (type == ModuleType::SMALL_PARKING || type == ModuleType::LARGE_PARKING);
-
-      if (!isCharging && !isParking)
-        continue; // Skip roads/etc
-
-      totalFacilities++;
-
-      auto counts = m->getSpotCounts();
-      totalSpots += (counts.free + counts.reserved + counts.occupied);
-      occupiedSpots += counts.occupied;
-
-      if (isCharging) {
-        chargingStations++;
-        chargingSpots += (counts.free + counts.reserved + counts.occupied);
-        occupiedCharging += counts.occupied;
-      } else if (isParking) {
-        parkingLots++;
-        parkingSpots += (counts.free + counts.reserved + counts.occupied);
-        occupiedParking += counts.occupied;
-      }
-    }
-  }
+  // Counters are aggregated on the simulation side when the snapshot is published
+  const OccupancyCounters &c = snapshot.counters;
 
   auto drawStat = [&](const char *label, const std::string &val) {
     DrawText(label, x, y, 20, WHITE);
@@ -150,27 +121,77 @@ void DashboardOverlay::drawGeneralInfo(int x, int y, int width) {
     y += 25;
   };
 
-  drawStat("Facilities:", std::format("{}", totalFacilities));
-  drawStat("Pk Lots:", std::format("{}", parkingLots));
-  drawStat("Chrg Stns:", std::format("{}", chargingStations));
+  drawStat("Facilities:", std::format("{}", c.totalFacilities));
+  drawStat("Pk Lots:", std::format("{}", c.parkingLots));
+  drawStat("Chrg Stns:", std::format("{}", c.chargingStations));
 
   y += 10;
   DrawText("OCCUPANCY", x, y, 20, YELLOW);
   y += 25;
 
-  float overallOcc = totalSpots > 0 ? (float)occupiedSpots / totalSpots * 100.0f : 0.0f;
-  float parkingOcc = parkingSpots > 0 ? (float)occupiedParking / parkingSpots * 100.0f : 0.0f;
-  float chargingOcc = chargingSpots > 0 ? (float)occupiedCharging / chargingSpots * 100.0f : 0.0f;
+  float overallOcc = c.totalSpots > 0 ? (float)c.occupiedSpots / c.totalSpots * 100.0f : 0.0f;
+  float parkingOcc = c.parkingSpots > 0 ? (float)c.occupiedParking / c.parkingSpots * 100.0f : 0.0f;
+  float chargingOcc = c.chargingSpots > 0 ? (float)c.occupiedCharging / c.chargingSpots * 100.0f : 0.0f;
 
   drawStat("Overall:", std::format("{:.1f}%", overallOcc));
   drawStat("Parking:", std::format("{:.1f}%", parkingOcc));
   drawStat("Charging:", std::format("{:.1f}%", chargingOcc));
+
+  if (!metrics)
+    return;
+
+  y += 10;
+  DrawText("HISTORY", x, y, 20, YELLOW);
+  y += 25;
+  for (auto metric : SPARKLINE_METRICS) {
+    y += drawSparkline(metric, x, y, width);
+  }
+}
+
+int DashboardOverlay::drawSparkline(MetricsRecorder::Metric metric, int x, int y, int width) {
+  // Finest tier: one bucket per sample
+  metrics->copySeries(metric, 0, sparkBuffer);
+
+  std::string label = std::format("{} ({})", MetricsRecorder::name(metric), MetricsRecorder::unit(metric));
+  std::string value = sparkBuffer.empty() ? "-" : std::format("{:.1f}", sparkBuffer.back().mean());
+  DrawText(label.c_str(), x, y, 14, LIGHTGRAY);
+  DrawText(value.c_str(), x + width - MeasureText(value.c_str(), 14), y, 14, GREEN);
+
+  int chartY = y + 16;
+  int chartH = 22;
+  DrawRectangleLines(x, chartY, width, chartH, DARKGRAY);
+
+  if (sparkBuffer.size() < 2)
+    return SPARKLINE_HEIGHT;
+
+  float lo = sparkBuffer[0].min;
+  float hi = sparkBuffer[0].max;
+  for (const auto &b : sparkBuffer) {
+    lo = std::min(lo, b.min);
+    hi = std::max(hi, b.max);
+  }
+  float range = (hi - lo) > 0.001f ? (hi - lo) : 1.0f;
+
+  // Buckets are laid out on the full ring width so the chart scrolls once the ring is full
+  float step = (float)width / (float)(Config::Metrics::BUCKETS_PER_TIER - 1);
+  auto toY = [&](float v) { return (float)(chartY + chartH) - (v - lo) / range * (float)chartH; };
+
+  Vector2 prev = {(float)x, toY(sparkBuffer[0].mean())};
+  for (size_t i = 0; i < sparkBuffer.size(); ++i) {
+    float px = (float)x + step * (float)i;
+    DrawLineV({px, toY(sparkBuffer[i].min)}, {px, toY(sparkBuffer[i].max)}, Fade(SKYBLUE, 0.3f));
+    Vector2 cur = {px, toY(sparkBuffer[i].mean())};
+    if (i > 0)
+      DrawLineV(prev, cur, SKYBLUE);
+    prev = cur;
+  }
+  return SPARKLINE_HEIGHT;
 }
 
-void DashboardOverlay::drawCarInfo(int x, int y, int width) {
-  if (!currentSelection.car)
+void DashboardOverlay::drawCarInfo(const SelectionView &selection, int x, int y, int width) {
+  if (!selection.carFound)
     return;
-  auto *car = currentSelection.car;
+  const CarRenderState *car = &selection.car;
 
   DrawText("CAR INFO", x, y, 20, GOLD);
   y += 30;
@@ -181,11 +202,11 @@ void DashboardOverlay::drawCarInfo(int x, int y, int width) {
     y += 25;
   };
 
-  std::string typeStr = (car->getType() == Car::CarType::ELECTRIC) ? "Electric" : "Gas";
+  std::string typeStr = (car->type == Car::CarType::ELECTRIC) ? "Electric" : "Gas";
   drawStat("Type:", typeStr);
 
   std::string stateStr;
-  switch (car->getState()) {
+  switch (car->state) {
   case Car::CarState::DRIVING:
     stateStr = "Driving";
     break;
@@ -201,20 +222,19 @@ void DashboardOverlay::drawCarInfo(int x, int y, int width) {
   }
   drawStat("State:", stateStr);
 
-  float speed = Vector2Length(car->getVelocity());
+  float speed = Vector2Length(car->velocity);
   drawStat("Speed:", std::format("{:.1f}", speed));
 
-  if (car->getType() == Car::CarType::ELECTRIC) {
-    drawStat("Battery:", std::format("{:.1f}%", car->getBatteryLevel()));
+  if (car->type == Car::CarType::ELECTRIC) {
+    drawStat("Battery:", std::format("{:.1f}%", car->batteryLevel));
   }
 
-  drawStat("Priority:", (car->getPriority() == Car::Priority::PRIORITY_PRICE) ? "Price" : "Distance");
+  drawStat("Priority:", (car->priority == Car::Priority::PRIORITY_PRICE) ? "Price" : "Distance");
 }
 
-void DashboardOverlay::drawFacilityInfo(int x, int y, int width) {
-  if (!currentSelection.module)
+void DashboardOverlay::drawFacilityInfo(const SelectionView &selection, int x, int y, int width) {
+  if (!selection.module)
     return;
-  auto *m = currentSelection.module;
 
   DrawText("FACILITY INFO", x, y, 20, GOLD);
   y += 30;
@@ -226,7 +246,7 @@ void DashboardOverlay::drawFacilityInfo(int x, int y, int width) {
   };
 
   std::string typeStr = "Unknown";
-  switch (m->getType()) {
+  switch (selection.moduleType) {
   case ModuleType::SMALL_PARKING:
     typeStr = "Sml Parking";
     break;
@@ -244,7 +264,7 @@ void DashboardOverlay::drawFacilityInfo(int x, int y, int width) {
   }
   drawStat("Type:", typeStr);
 
-  auto counts = m->getSpotCounts();
+  const auto &counts = selection.facilityCounts;
   int total = counts.free + counts.reserved + counts.occupied;
 
   drawStat("Total Spots:", std::format("{}", total));
@@ -255,14 +275,14 @@ void DashboardOverlay::drawFacilityInfo(int x, int y, int width) {
   float occ = total > 0 ? (float)counts.occupied / total * 100.0f : 0.0f;
   drawStat("Occ. Rate:", std::format("{:.1f}%", occ));
 
-  drawStat("Price Mult:", std::format("{:.2f}x", m->getPriceMultiplier()));
+  drawStat("Price Mult:", std::format("{:.2f}x", selection.priceMultiplier));
+  drawStat("Surge:", std::format("{:.2f}x", selection.surge));
 }
 
-void DashboardOverlay::drawSpotInfo(int x, int y, int width) {
-  if (!currentSelection.module || currentSelection.spotIndex == -1)
+void DashboardOverlay::drawSpotInfo(const SelectionView &selection, int x, int y, int width) {
+  if (!selection.module || selection.spotIndex == -1)
     return;
-  auto *m = currentSelection.module;
-  Spot spot = m->getSpot(currentSelection.spotIndex);
+  const Spot &spot = selection.spot;
 
   DrawText("SPOT INFO", x, y, 20, GOLD);
   y += 30;
@@ -273,7 +293,7 @@ void DashboardOverlay::drawSpotInfo(int x, int y, int width) {
     y += 25;
   };
 
-  drawStat("Index:", std::format("{}", currentSelection.spotIndex));
+  drawStat("Index:", std::format("{}", selection.spotIndex));
 
   std::string stateStr = "Free";
   if (spot.state == SpotState::RESERVED)
@@ -12,9 +12,10 @@
  * @brief Implementation of GameHUD.
  */
 
-GameHUD::GameHUD(std::shared_ptr<EventBus> bus, EntityManager *entityManager) : eventBus(bus) {
+GameHUD::GameHUD(std::shared_ptr<EventBus> bus, EntityManager *entityManager, const MetricsRecorder *metrics)
+    : eventBus(bus) {
   // Setup UI Elements
-  uiManager.add(std::make_shared<DashboardOverlay>(eventBus, entityManager));
+  uiManager.add(std::make_shared<DashboardOverlay>(eventBus, entityManager, metrics));
 
   auto spawnBtn = std::make_shared<UIButton>(Vector2{10, 10}, Vector2{150, 40}, "Spawn Car", eventBus);
   spawnBtn->setOnClick([this]() { eventBus->publish(SpawnCarRequestEvent{}); });
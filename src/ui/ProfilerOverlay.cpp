@@ -0,0 +1,66 @@
+#include "ui/ProfilerOverlay.hpp"
+#include "config.hpp"
+#include "core/Logger.hpp"
+#include "core/Profiler.hpp"
+#include "events/InputEvents.hpp"
+#include <algorithm>
+#include <format>
+#include <fstream>
+#include <string>
+
+ProfilerOverlay::ProfilerOverlay(std::shared_ptr<EventBus> bus) : UIElement({10, 10}, {360, 0}, bus) {
+  visible = false;
+
+  eventTokens.push_back(bus->subscribe<KeyPressedEvent>([this](const KeyPressedEvent &e) {
+    if (e.key == KEY_F3) {
+      visible = !visible;
+      Profiler::Get().setEnabled(visible);
+    } else if (e.key == KEY_F4) {
+      dumpTrace();
+    }
+  }));
+}
+
+void ProfilerOverlay::update(double /*dt*/) {}
+
+bool ProfilerOverlay::dumpTrace() {
+  std::ofstream out(Config::Profiler::TRACE_PATH);
+  if (!out) {
+    Logger::Error("ProfilerOverlay: Could not open {}", Config::Profiler::TRACE_PATH);
+    return false;
+  }
+  Profiler::Get().writeChromeTrace(out);
+  Logger::Info("ProfilerOverlay: Trace written to {}", Config::Profiler::TRACE_PATH);
+  return true;
+}
+
+void ProfilerOverlay::draw() {
+  if (!visible)
+    return;
+
+  const auto &summary = Profiler::Get().getFrameSummary();
+  int rows = std::min((int)summary.size(), Config::Profiler::OVERLAY_ROWS);
+
+  int x = (int)position.x;
+  int y = (int)position.y;
+  int width = (int)size.x;
+  int height = 15 + 25 + rows * 18 + 15;
+
+  DrawRectangle(x, y, width, height, Fade(BLACK, 0.8f));
+  DrawRectangleLines(x, y, width, height, DARKGRAY);
+
+  x += 10;
+  y += 10;
+  std::string header = std::format("PROFILER  {:.2f} ms", Profiler::Get().getFrameMs());
+  DrawText(header.c_str(), x, y, 20, GOLD);
+  y += 25;
+
+  // Zones of all threads that ended during the last frame, slowest first
+  for (int i = 0; i < rows; ++i) {
+    const auto &zone = summary[i];
+    std::string value = std::format("{:.3f} ms  x{}", zone.totalMs, zone.calls);
+    DrawText(zone.name, x, y, 14, WHITE);
+    DrawText(value.c_str(), x + width - 20 - MeasureText(value.c_str(), 14), y, 14, GREEN);
+    y += 18;
+  }
+}
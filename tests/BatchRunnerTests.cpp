@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+#include "core/BatchRunner.hpp"
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+BatchRun smallRun(uint64_t seed) {
+    BatchRun run;
+    run.map = MapConfig{1, 1, 1, 1, {}};
+    run.spawnLevel = 5;
+    run.params.parkingMinTime = 20.0f;
+    run.params.parkingMaxTime = 40.0f;
+    run.seed = seed;
+    return run;
+}
+
+void expectSameResult(const BatchResult &a, const BatchResult &b) {
+    EXPECT_EQ(a.meanOccupancy, b.meanOccupancy);
+    EXPECT_EQ(a.carsSpawned, b.carsSpawned);
+    EXPECT_EQ(a.carsTurnedAway, b.carsTurnedAway);
+    EXPECT_EQ(a.staysCompleted, b.staysCompleted);
+    EXPECT_EQ(a.revenue, b.revenue);
+    EXPECT_EQ(a.chargeDelivered, b.chargeDelivered);
+}
+} // namespace
+
+TEST(BatchRunnerTests, SweepExpandsToTheCartesianProduct) {
+    std::istringstream in("# comment\n"
+                          "small_parking = 1, 3\n"
+                          "large_charging = 0..2   # range\n"
+                          "battery_exit_threshold = 75.5\n"
+                          "seeds = 10..12\n"
+                          "duration = 120\n"
+                          "car_following = idm\n"
+                          "tick_length = 0.1\n"
+                          "spot_assignment = batch\n");
+    SweepSpec spec = SweepSpec::parse(in);
+    EXPECT_EQ(spec.duration, 120.0);
+
+    std::vector<BatchRun> runs = spec.expand();
+    ASSERT_EQ(runs.size(), 2u * 3u * 3u);
+
+    // Seeds vary fastest, so the runs of a combination are adjacent
+    EXPECT_EQ(runs[0].configIndex, 0);
+    EXPECT_EQ(runs[0].seed, 10u);
+    EXPECT_EQ(runs[2].seed, 12u);
+    EXPECT_EQ(runs[2].configIndex, 0);
+    EXPECT_EQ(runs[3].configIndex, 1);
+    EXPECT_EQ(runs[3].map.largeChargingCount, 1);
+    EXPECT_EQ(runs.back().map.smallParkingCount, 3);
+    EXPECT_EQ(runs.back().map.largeChargingCount, 2);
+    EXPECT_FLOAT_EQ(runs.back().params.batteryExitThreshold, 75.5f);
+    EXPECT_EQ(runs.back().params.carFollowing, CarFollowingModel::IDM);
+    EXPECT_EQ(runs.back().tickLength, 0.1);
+    EXPECT_EQ(runs.back().params.spotAssignment, SpotAssignmentMode::BATCH);
+}
+
+TEST(BatchRunnerTests, InvalidSweepLinesAreRejected) {
+    for (const char *text : {"spawn_levels = 1\n", "spawn_level = 9\n", "seeds = 5..1\n", "charging_rate = fast\n",
+                             "duration = 0\n", "small_parking\n", "car_following = fast\n",
+                             "tick_length = 0\n", "spot_assignment = best\n", "price_elasticity = -1\n",
+                             "charging_rate = nan\n", "battery_low_threshold = inf\n", "parking_max_time = 1e30\n"}) {
+        std::istringstream in(text);
+        EXPECT_THROW(SweepSpec::parse(in), std::runtime_error) << text;
+    }
+}
+
+TEST(BatchRunnerTests, RangesEndAtTheTypeMaximumAndAreBounded) {
+    std::istringstream last("seeds = 18446744073709551613..18446744073709551615\n");
+    SweepSpec spec = SweepSpec::parse(last);
+    ASSERT_EQ(spec.seeds.size(), 3u);
+    EXPECT_EQ(spec.seeds.back(), 18446744073709551615ull);
+
+    std::istringstream huge("seeds = 0..18446744073709551615\n");
+    EXPECT_THROW(SweepSpec::parse(huge), std::runtime_error);
+
+    // Every list is within its range bound, but their product is not
+    std::istringstream product("small_parking = 0..99\nlarge_parking = 0..99\nsmall_charging = 0..99\n"
+                               "large_charging = 0..99\nseeds = 1..100\n");
+    SweepSpec wide = SweepSpec::parse(product);
+    EXPECT_THROW(wide.expand(), std::runtime_error);
+}
+
+TEST(BatchRunnerTests, PriceElasticityIsSwept) {
+    std::istringstream in("price_elasticity = 0, 1.5\n"
+                          "seeds = 1..2\n");
+    std::vector<BatchRun> runs = SweepSpec::parse(in).expand();
+    ASSERT_EQ(runs.size(), 4u);
+    EXPECT_EQ(runs[0].params.priceElasticity, 0.0f);
+    EXPECT_EQ(runs[2].configIndex, 1);
+    EXPECT_FLOAT_EQ(runs[2].params.priceElasticity, 1.5f);
+}
+
+TEST(BatchRunnerTests, RunsAreReproducibleAndIndependentOfThreads) {
+    const double duration = 240.0;
+    BatchResult first = BatchRunner::runOne(smallRun(7), duration);
+    EXPECT_GT(first.carsSpawned, 0);
+    EXPECT_GT(first.staysCompleted, 0);
+    expectSameResult(BatchRunner::runOne(smallRun(7), duration), first);
+
+    std::vector<BatchRun> runs = {smallRun(7), smallRun(8), smallRun(9), smallRun(7)};
+    std::vector<BatchResult> parallel = BatchRunner::runAll(runs, duration, 3);
+    ASSERT_EQ(parallel.size(), runs.size());
+    expectSameResult(parallel[0], first);
+    expectSameResult(parallel[3], first);
+    expectSameResult(parallel[1], BatchRunner::runOne(smallRun(8), duration));
+}
+
+TEST(BatchRunnerTests, ReportAggregatesSeedsPerCombination) {
+    std::vector<BatchRun> runs = {smallRun(1), smallRun(2), smallRun(3)};
+    runs[2].configIndex = 1;
+    std::vector<BatchResult> results(3);
+    results[0].revenue = 10.0;
+    results[1].revenue = 20.0;
+    results[2].revenue = 5.0;
+
+    std::ostringstream out;
+    BatchRunner::writeReport(out, runs, results);
+
+    std::istringstream lines(out.str());
+    std::string header, row1, row2, extra;
+    std::getline(lines, header);
+    std::getline(lines, row1);
+    std::getline(lines, row2);
+    EXPECT_FALSE(std::getline(lines, extra));
+
+    EXPECT_NE(header.find("revenue_mean,revenue_stddev"), std::string::npos);
+    EXPECT_EQ(row1.rfind("0,", 0), 0u);
+    EXPECT_NE(row1.find(",2,"), std::string::npos); // two runs
+    EXPECT_NE(row1.find(",15,7.07107,"), std::string::npos);
+    EXPECT_NE(row2.find(",5,0,"), std::string::npos);
+}
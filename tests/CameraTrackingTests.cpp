@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "core/EntityManager.hpp"
+#include "events/InputEvents.hpp"
+#include "events/TrackingEvents.hpp"
+#include "systems/CameraSystem.hpp"
+#include "systems/TrackingSystem.hpp"
+#include "systems/TrafficSystem.hpp"
+#include <memory>
+
+class CameraTrackingTests : public ::testing::Test {
+protected:
+    std::shared_ptr<EventBus> bus = std::make_shared<EventBus>();
+    EntityManager em{bus};
+    TrafficSystem traffic{bus, em};
+    TrackingSystem tracking{bus, em};
+    CameraSystem camera{bus};
+
+    void SetUp() override {
+        em.getRandom().reseed(8);
+        bus->publish(GenerateWorldEvent{MapConfig{1, 1, 1, 1, {}}});
+    }
+};
+
+TEST_F(CameraTrackingTests, PanningUsesFrameTimeAtAnySpeed) {
+    Vector2 start = camera.getCamera().target;
+    bus->publish(SimulationSpeedChangedEvent{5.0});
+    bus->publish(KeyPressedEvent{KEY_D});
+
+    // Simulation ticks no longer move the camera
+    for (int i = 0; i < 5; i++)
+        bus->publish(GameUpdateEvent{Config::FIXED_DELTA_TIME});
+    EXPECT_FLOAT_EQ(camera.getCamera().target.x, start.x);
+
+    // 20 m/s at zoom 1, in real time
+    bus->publish(FrameUpdateEvent{0.5});
+    EXPECT_FLOAT_EQ(camera.getCamera().target.x, start.x + 10.0f);
+    EXPECT_FLOAT_EQ(camera.getCamera().target.y, start.y);
+}
+
+TEST_F(CameraTrackingTests, TrackingFollowsOncePerFrame) {
+    int follows = 0;
+    auto token = bus->subscribe<CameraFollowEvent>([&](const CameraFollowEvent &) { follows++; });
+
+    bus->publish(StartTrackingEvent{});
+    for (int i = 0; i < 30; i++)
+        bus->publish(GameUpdateEvent{Config::FIXED_DELTA_TIME});
+    EXPECT_EQ(follows, 0);
+
+    // One camera update per frame, at the tracked car's position in the snapshot
+    em.publishSnapshot(1.0, 0.0);
+    bus->publish(FrameUpdateEvent{1.0 / 60.0});
+    EXPECT_EQ(follows, 1);
+
+    const RenderSnapshot &snapshot = em.getRenderSnapshot();
+    ASSERT_TRUE(snapshot.trackedFound);
+    const Car *car = em.getCar(snapshot.tracked.id);
+    ASSERT_NE(car, nullptr);
+    EXPECT_FLOAT_EQ(camera.getCamera().target.x, car->getPosition().x);
+    EXPECT_FLOAT_EQ(camera.getCamera().target.y, car->getPosition().y);
+
+    // After stopping, frames leave the camera alone
+    bus->publish(StopTrackingEvent{});
+    em.publishSnapshot(1.0, 0.0);
+    bus->publish(FrameUpdateEvent{1.0 / 60.0});
+    EXPECT_EQ(follows, 1);
+}
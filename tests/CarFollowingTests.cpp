@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include "config.hpp"
+#include "entities/Car.hpp"
+#include "systems/CarFollowing.hpp"
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+namespace {
+constexpr float FREE_ROAD = std::numeric_limits<float>::infinity();
+
+/**
+ * @brief A platoon on a straight road behind a leader limited to 30 % of the top speed.
+ */
+struct Platoon {
+    std::vector<std::unique_ptr<Car>> cars;
+    std::vector<const Car *> neighbors;
+
+    explicit Platoon(int count) {
+        for (int i = 0; i < count; i++) {
+            // Leader in front, followers queued 6 m apart, all starting at full speed
+            auto car = std::make_unique<Car>(Vector2{-6.0f * (float)i, 0.0f}, nullptr, Vector2{15.0f, 0.0f},
+                                             Car::CarType::COMBUSTION);
+            car->setId({(uint32_t)i, 0});
+            car->addWaypoint(Waypoint({5000.0f, 0.0f}, 1.0f, -1, 0.0f, false, i == 0 ? 0.3f : 1.0f));
+            neighbors.push_back(car.get());
+            cars.push_back(std::move(car));
+        }
+    }
+
+    float minCenterDistance() const {
+        float best = FREE_ROAD;
+        for (size_t i = 1; i < cars.size(); i++)
+            best = std::min(best, cars[i - 1]->getPosition().x - cars[i]->getPosition().x);
+        return best;
+    }
+
+    void tick(double dt) {
+        for (auto &car : cars)
+            car->updateWithNeighbors(dt, neighbors, CarFollowingModel::IDM);
+    }
+};
+} // namespace
+
+TEST(CarFollowingTests, AccelerationLimits) {
+    using namespace Config::CarAI::Idm;
+    EXPECT_FLOAT_EQ(CarFollowing::acceleration(0.0f, 15.0f, FREE_ROAD, 0.0f), MAX_ACCELERATION);
+    EXPECT_FLOAT_EQ(CarFollowing::acceleration(15.0f, 15.0f, FREE_ROAD, 0.0f), 0.0f);
+
+    // Standing at the minimum gap behind a standing leader: stays put
+    EXPECT_NEAR(CarFollowing::acceleration(0.0f, 15.0f, MIN_GAP, 0.0f), 0.0f, 1e-5f);
+
+    // Closing in fast: braking, capped at the emergency limit
+    EXPECT_LT(CarFollowing::acceleration(10.0f, 15.0f, 12.0f, 10.0f), -COMFORT_BRAKING);
+    EXPECT_FLOAT_EQ(CarFollowing::acceleration(15.0f, 15.0f, 0.5f, 15.0f), -MAX_BRAKING);
+
+    // Stopping within the tick drives the stopping distance, never backwards
+    float speed = 2.0f;
+    EXPECT_FLOAT_EQ(CarFollowing::advance(speed, -8.0f, 1.0), 0.25f);
+    EXPECT_EQ(speed, 0.0f);
+}
+
+TEST(CarFollowingTests, PlatoonSettlesWithoutCollisionsAtCoarseTicks) {
+    for (double dt : {1.0 / 60.0, 0.1, 0.25}) {
+        Platoon platoon(8);
+        int ticks = (int)std::lround(90.0 / dt);
+        for (int i = 0; i < ticks; i++) {
+            platoon.tick(dt);
+            ASSERT_GT(platoon.minCenterDistance(), Config::CarAI::Idm::VEHICLE_LENGTH) << "dt " << dt << " tick " << i;
+        }
+
+        // Everyone ends up at the leader's speed, at the equilibrium gap and without oscillation
+        float leaderSpeed = platoon.cars[0]->getVelocity().x;
+        EXPECT_NEAR(leaderSpeed, 4.5f, 0.01f);
+        for (size_t i = 1; i < platoon.cars.size(); i++) {
+            EXPECT_NEAR(platoon.cars[i]->getVelocity().x, leaderSpeed, 0.05f) << "dt " << dt << " car " << i;
+            EXPECT_NEAR(platoon.cars[i]->getVelocity().y, 0.0f, 1e-4f);
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+#include "core/CarPool.hpp"
+#include <vector>
+
+static std::vector<Waypoint> makePath(int length) {
+    std::vector<Waypoint> path;
+    for (int i = 0; i < length; i++)
+        path.push_back(Waypoint({(float)i, 0.0f}, 1.0f, -1, 0.0f, false));
+    return path;
+}
+
+TEST(CarPoolTests, SteadyStateCyclesDoNotAllocate) {
+    CarPool pool;
+    auto path = makePath(32);
+
+    // Warm-up: the first car is a pool miss
+    auto car = pool.acquire({0, 0}, nullptr, {15, 0}, Car::CarType::COMBUSTION);
+    car->setPath(path);
+    pool.release(std::move(car));
+    ASSERT_EQ(pool.getStats().allocations, 1u);
+
+    for (int i = 0; i < 100; i++) {
+        auto reused = pool.acquire({0, 0}, nullptr, {15, 0}, Car::CarType::ELECTRIC);
+        size_t capacityBefore = reused->getWaypointCapacity();
+        reused->setPath(path);
+        EXPECT_EQ(reused->getWaypointCapacity(), capacityBefore);
+        pool.release(std::move(reused));
+    }
+
+    EXPECT_EQ(pool.getStats().allocations, 1u);
+    EXPECT_EQ(pool.getStats().reuses, 100u);
+    EXPECT_EQ(pool.getStats().releases, 101u);
+}
+
+TEST(CarPoolTests, ReusedCarIsReset) {
+    CarPool pool;
+    auto car = pool.acquire({0, 0}, nullptr, {15, 0}, Car::CarType::COMBUSTION);
+    car->setPath(makePath(4));
+    car->setState(Car::CarState::PARKED);
+    car->setSelected(true);
+    car->setParkingContext(nullptr, {{1, 1}, 0.0f, 2}, 2);
+    pool.release(std::move(car));
+
+    auto reused = pool.acquire({5, 5}, nullptr, {-15, 0}, Car::CarType::ELECTRIC);
+    EXPECT_EQ(reused->getState(), Car::CarState::DRIVING);
+    EXPECT_EQ(reused->getType(), Car::CarType::ELECTRIC);
+    EXPECT_FALSE(reused->isSelected());
+    EXPECT_TRUE(reused->hasArrived());
+    EXPECT_EQ(reused->getParkedSpotIndex(), -1);
+    EXPECT_FALSE(reused->getId().isValid());
+    EXPECT_FLOAT_EQ(reused->getPosition().x, 5.0f);
+    EXPECT_FLOAT_EQ(reused->getVelocity().x, -15.0f);
+}
+
+TEST(CarPoolTests, ReserveMakesFirstSpawnsHits) {
+    CarPool pool;
+    pool.reserve(8);
+    EXPECT_EQ(pool.available(), 8u);
+
+    auto car = pool.acquire({0, 0}, nullptr, {15, 0}, Car::CarType::COMBUSTION);
+    EXPECT_EQ(pool.getStats().allocations, 8u);
+    EXPECT_EQ(pool.getStats().reuses, 1u);
+}
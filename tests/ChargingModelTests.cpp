@@ -0,0 +1,115 @@
+#include <gtest/gtest.h>
+#include "entities/Car.hpp"
+#include "systems/ChargingModel.hpp"
+#include <cmath>
+
+namespace {
+struct ExitStats {
+    double meanDelay = 0.0;
+    double forcedShare = 0.0;
+};
+
+// The former per-tick model: charge, then leave for certain above the force-exit threshold or
+// with probability 0.5 * excess / range * dt above the exit threshold
+ExitStats perTickExits(float startLevel, const SimulationParams &params, int sessions) {
+    const double dt = 1.0 / 60.0;
+    Random random(5);
+    ExitStats stats;
+    for (int i = 0; i < sessions; i++) {
+        float level = startLevel;
+        double t = 0.0;
+        while (true) {
+            level = std::min(100.0f, level + params.chargingRate * (float)dt);
+            t += dt;
+            if (level > params.batteryForceExitThreshold) {
+                stats.forcedShare += 1.0;
+                break;
+            }
+            float range = params.batteryForceExitThreshold - params.batteryExitThreshold;
+            if (level > params.batteryExitThreshold &&
+                random.uniformFloat(0.0f, 1.0f) < 0.5f * (level - params.batteryExitThreshold) / range * (float)dt)
+                break;
+        }
+        stats.meanDelay += t;
+    }
+    stats.meanDelay /= sessions;
+    stats.forcedShare /= sessions;
+    return stats;
+}
+
+ExitStats sampledExits(float startLevel, const SimulationParams &params, int sessions) {
+    float forcedAt = (params.batteryForceExitThreshold - startLevel) / params.chargingRate;
+    Random random(6);
+    ExitStats stats;
+    for (int i = 0; i < sessions; i++) {
+        float delay = ChargingModel::sampleExitDelay(startLevel, params, random);
+        stats.meanDelay += delay;
+        stats.forcedShare += (delay >= forcedAt - 1e-3f) ? 1.0 : 0.0;
+    }
+    stats.meanDelay /= sessions;
+    stats.forcedShare /= sessions;
+    return stats;
+}
+} // namespace
+
+TEST(ChargingModelTests, SampledExitTimesMatchThePerTickModel) {
+    const int sessions = 2000;
+
+    // Default thresholds: nearly every driver leaves at random between 80 % and 95 %
+    SimulationParams defaults;
+    ExitStats ticked = perTickExits(76.0f, defaults, sessions);
+    ExitStats sampled = sampledExits(76.0f, defaults, sessions);
+    EXPECT_NEAR(sampled.meanDelay, ticked.meanDelay, 1.0);
+    EXPECT_NEAR(sampled.forcedShare, ticked.forcedShare, 0.02);
+
+    // Narrow band: about one driver in seven stays until the forced exit
+    SimulationParams narrow;
+    narrow.batteryForceExitThreshold = 82.0f;
+    ticked = perTickExits(76.0f, narrow, sessions);
+    sampled = sampledExits(76.0f, narrow, sessions);
+    EXPECT_NEAR(sampled.meanDelay, ticked.meanDelay, 0.5);
+    EXPECT_NEAR(sampled.forcedShare, ticked.forcedShare, 0.04);
+    EXPECT_GT(sampled.forcedShare, 0.08);
+}
+
+TEST(ChargingModelTests, EdgeCases) {
+    SimulationParams params;
+    EXPECT_EQ(ChargingModel::exitDelay(97.0f, params, 0.5f), 0.0f); // Already above the force-exit level
+    EXPECT_FLOAT_EQ(ChargingModel::exitDelay(50.0f, params, 1e-30f), 180.0f); // Forced at 95 %
+
+    // u = exp(-H): from the exit threshold on, H(s) = 0.5 / 15 * 0.25 * s^2 / 2
+    float s = ChargingModel::exitDelay(80.0f, params, std::exp(-1.0f));
+    EXPECT_NEAR(s, std::sqrt(240.0f), 1e-3f);
+
+    // Nobody leaves if the exit threshold cannot be reached: capped session
+    params.batteryExitThreshold = 100.0f;
+    params.batteryForceExitThreshold = 110.0f;
+    EXPECT_EQ(ChargingModel::exitDelay(50.0f, params, 0.5f), Config::MAX_CHARGING_SESSION);
+}
+
+TEST(ChargingModelTests, BatteryFollowsTheParkingTimer) {
+    Car car({0, 0}, nullptr, {0, 0}, Car::CarType::ELECTRIC);
+    car.setBatteryLevel(50.0f);
+    car.setState(Car::CarState::PARKED);
+    car.startCharging(0.25f, 100.0f);
+    EXPECT_TRUE(car.isCharging());
+    EXPECT_FLOAT_EQ(car.getParkingTimer(), 100.0f);
+
+    car.skipParkedTime(40.0f);
+    EXPECT_FLOAT_EQ(car.getBatteryLevel(), 60.0f);
+    EXPECT_FLOAT_EQ(car.getChargeReceived(), 10.0f);
+
+    car.update(20.0);
+    EXPECT_FLOAT_EQ(car.getBatteryLevel(), 65.0f);
+
+    // Leaving ends the session and keeps what was charged
+    car.setState(Car::CarState::EXITING);
+    EXPECT_FALSE(car.isCharging());
+    EXPECT_FLOAT_EQ(car.getBatteryLevel(), 65.0f);
+    EXPECT_FLOAT_EQ(car.getChargeReceived(), 15.0f);
+
+    Car combustion({0, 0}, nullptr, {0, 0}, Car::CarType::COMBUSTION);
+    combustion.setState(Car::CarState::PARKED);
+    combustion.startCharging(0.25f, 100.0f);
+    EXPECT_FALSE(combustion.isCharging());
+}
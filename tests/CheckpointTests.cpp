@@ -0,0 +1,277 @@
+#include <gtest/gtest.h>
+#include "core/BinaryIO.hpp"
+#include "core/Checkpoint.hpp"
+#include "core/EntityManager.hpp"
+#include "systems/TrafficSystem.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+struct CarSummary {
+    Vector2 position;
+    Car::CarState state;
+    float battery;
+    float parkingTimer;
+    size_t pathLength;
+    const Module *facility;
+    int spotIndex;
+
+    bool operator==(const CarSummary &o) const {
+        return position.x == o.position.x && position.y == o.position.y && state == o.state &&
+               battery == o.battery && parkingTimer == o.parkingTimer && pathLength == o.pathLength &&
+               facility == o.facility && spotIndex == o.spotIndex;
+    }
+};
+} // namespace
+
+class CheckpointTests : public ::testing::Test {
+protected:
+    std::shared_ptr<EventBus> bus = std::make_shared<EventBus>();
+    EntityManager em{bus};
+    TrafficSystem traffic{bus, em};
+
+    void SetUp() override {
+        em.getRandom().reseed(3);
+        bus->publish(GenerateWorldEvent{MapConfig{2, 2, 2, 2, {}}});
+        for (int i = 0; i < 30; i++)
+            bus->publish(SpawnCarRequestEvent{});
+        run(600);
+    }
+
+    void run(int ticks) {
+        for (int i = 0; i < ticks; i++)
+            bus->publish(GameUpdateEvent{1.0 / 60.0});
+    }
+
+    std::vector<CarSummary> cars() const {
+        std::vector<CarSummary> out;
+        for (const auto &car : em.getCars()) {
+            out.push_back({car->getPosition(), car->getState(), car->getBatteryLevel(), car->getParkingTimer(),
+                           car->getWaypoints().size(), car->getParkedFacility(), car->getParkedSpotIndex()});
+        }
+        return out;
+    }
+
+    std::vector<SpotState> spots() const {
+        std::vector<SpotState> out;
+        for (const auto &mod : em.getModules()) {
+            for (int i = 0; i < (int)mod->getSpotCount(); i++)
+                out.push_back(mod->getSpot(i).state);
+        }
+        return out;
+    }
+};
+
+TEST_F(CheckpointTests, RestoreReturnsToTheCapturedState) {
+    Checkpoint checkpoint = Checkpoint::capture(em, traffic);
+    auto carsBefore = cars();
+    auto spotsBefore = spots();
+    int occupiedBefore = em.getOccupancyStats().getCounters().occupiedSpots;
+    ASSERT_FALSE(carsBefore.empty());
+    ASSERT_TRUE(std::any_of(carsBefore.begin(), carsBefore.end(), [](const CarSummary &c) { return c.facility; }));
+
+    run(600);
+    ASSERT_NE(cars(), carsBefore);
+
+    checkpoint.restore(em, traffic);
+    EXPECT_EQ(cars(), carsBefore);
+    EXPECT_EQ(spots(), spotsBefore);
+    EXPECT_EQ(em.getOccupancyStats().getCounters().occupiedSpots, occupiedBefore);
+}
+
+TEST_F(CheckpointTests, ForkedRunsFromOneCheckpointAreIdentical) {
+    Checkpoint checkpoint = Checkpoint::capture(em, traffic);
+
+    checkpoint.restore(em, traffic);
+    em.getRandom().reseed(11);
+    run(900);
+    auto first = cars();
+    auto firstSpots = spots();
+
+    // Restoring reuses the pooled cars of the first run
+    size_t allocations = em.getCarPoolStats().allocations;
+    checkpoint.restore(em, traffic);
+    EXPECT_EQ(em.getCarPoolStats().allocations, allocations);
+    em.getRandom().reseed(11);
+    run(900);
+
+    EXPECT_EQ(cars(), first);
+    EXPECT_EQ(spots(), firstSpots);
+}
+
+TEST(CheckpointBatchTests, PendingAssignmentsSurviveARestore) {
+    auto bus = std::make_shared<EventBus>();
+    SimulationParams params;
+    params.spotAssignment = SpotAssignmentMode::BATCH;
+    EntityManager em(bus, params);
+    TrafficSystem traffic(bus, em);
+    em.getRandom().reseed(4);
+    bus->publish(GenerateWorldEvent{MapConfig{2, 2, 2, 2, {}}});
+    auto run = [&](int ticks) {
+        for (int i = 0; i < ticks; i++)
+            bus->publish(GameUpdateEvent{1.0 / 60.0});
+    };
+    auto assigned = [&]() {
+        int count = 0;
+        for (const auto &car : em.getCars())
+            count += car->getParkedFacility() != nullptr;
+        return count;
+    };
+
+    // Captured inside an assignment window, while the arrivals wait for their spots
+    for (int i = 0; i < 4; i++)
+        bus->publish(SpawnCarRequestEvent{});
+    run(5);
+    ASSERT_FALSE(em.getCars().empty());
+    ASSERT_EQ(assigned(), 0);
+    Checkpoint checkpoint = Checkpoint::capture(em, traffic);
+
+    em.getRandom().reseed(9);
+    run(60);
+    int expected = assigned();
+    ASSERT_GT(expected, 0);
+
+    // The restored arrivals are matched at the same time, to the same spots
+    checkpoint.restore(em, traffic);
+    em.getRandom().reseed(9);
+    run(60);
+    EXPECT_EQ(assigned(), expected);
+}
+
+TEST_F(CheckpointTests, CorruptTrafficSectionChangesNothing) {
+    const char *path = "checkpoint_corrupt.checkpoint";
+    Checkpoint::capture(em, traffic).saveTo(path);
+    run(300);
+    auto carsBefore = cars();
+    auto spotsBefore = spots();
+
+    // Read the file back without its last bytes (the reservations at the end of the traffic
+    // section), then with a stray byte after it: the cars and spots must stay as they are
+    std::vector<char> bytes;
+    {
+        std::FILE *file = std::fopen(path, "rb");
+        ASSERT_NE(file, nullptr);
+        int c;
+        while ((c = std::fgetc(file)) != EOF)
+            bytes.push_back((char)c);
+        std::fclose(file);
+    }
+    auto rewrite = [&](size_t size, bool trailing) {
+        std::FILE *file = std::fopen(path, "wb");
+        std::fwrite(bytes.data(), 1, size, file);
+        if (trailing)
+            std::fputc(0, file);
+        std::fclose(file);
+    };
+
+    rewrite(bytes.size() - 4, false);
+    EXPECT_THROW(Checkpoint::loadFrom(path).restore(em, traffic), std::runtime_error);
+    EXPECT_EQ(cars(), carsBefore);
+    EXPECT_EQ(spots(), spotsBefore);
+
+    rewrite(bytes.size(), true);
+    EXPECT_THROW(Checkpoint::loadFrom(path).restore(em, traffic), std::runtime_error);
+    EXPECT_EQ(cars(), carsBefore);
+    EXPECT_EQ(spots(), spotsBefore);
+
+    std::remove(path);
+}
+
+TEST_F(CheckpointTests, OutOfRangeCarFieldsAreRejected) {
+    BinaryWriter out;
+    em.saveCheckpoint(out);
+    ASSERT_FALSE(em.getCars().empty());
+
+    // The first car record follows the module and spot counts, the layout fingerprint, the spot states and the
+    // car count
+    size_t record = 2 * sizeof(uint32_t) + sizeof(uint64_t) + spots().size() + sizeof(uint32_t);
+    auto corrupt = [&](size_t offset, uint8_t value) {
+        std::vector<std::byte> data = out.data();
+        data[record + offset] = (std::byte)value;
+        BinaryReader in(data);
+        return em.readCheckpoint(in);
+    };
+
+    EXPECT_NO_THROW(corrupt(offsetof(Car::Snapshot, charging), 1));
+    EXPECT_THROW(corrupt(offsetof(Car::Snapshot, state), 4), std::runtime_error);
+    EXPECT_THROW(corrupt(offsetof(Car::Snapshot, type), 2), std::runtime_error);
+    EXPECT_THROW(corrupt(offsetof(Car::Snapshot, priority), 0xff), std::runtime_error);
+    EXPECT_THROW(corrupt(offsetof(Car::Snapshot, enteredFromLeft), 2), std::runtime_error);
+    EXPECT_THROW(corrupt(offsetof(Car::Snapshot, charging), 0x80), std::runtime_error);
+
+    // A car count far beyond the data is refused before anything is reserved
+    std::vector<std::byte> data = out.data();
+    uint32_t count = 0xffffffffu;
+    std::memcpy(data.data() + record - sizeof(uint32_t), &count, sizeof(count));
+    BinaryReader in(data);
+    EXPECT_THROW(em.readCheckpoint(in), std::runtime_error);
+}
+
+TEST_F(CheckpointTests, InvalidWaypointsAreRejected) {
+    BinaryWriter out;
+    em.saveCheckpoint(out);
+
+    // Walk the car records to the first waypoint: x, y, tolerance, id, entry angle, stop flag, speed factor
+    const size_t waypointSize = 5 * sizeof(float) + sizeof(int32_t) + sizeof(uint8_t);
+    size_t offset = 2 * sizeof(uint32_t) + sizeof(uint64_t) + spots().size() + sizeof(uint32_t);
+    bool found = false;
+    for (const auto &car : em.getCars()) {
+        offset += sizeof(Car::Snapshot) + sizeof(uint32_t);
+        if (!car->getWaypoints().empty()) {
+            found = true;
+            break;
+        }
+        offset += car->getWaypoints().size() * waypointSize;
+    }
+    ASSERT_TRUE(found);
+
+    auto corrupt = [&](size_t field, const void *value, size_t size) {
+        std::vector<std::byte> data = out.data();
+        std::memcpy(data.data() + offset + field, value, size);
+        BinaryReader in(data);
+        return em.readCheckpoint(in);
+    };
+    uint8_t flag = 2;
+    float nan = std::numeric_limits<float>::quiet_NaN();
+    float infinity = std::numeric_limits<float>::infinity();
+    EXPECT_THROW(corrupt(5 * sizeof(float), &flag, sizeof(flag)), std::runtime_error);
+    EXPECT_THROW(corrupt(0, &nan, sizeof(nan)), std::runtime_error);
+    EXPECT_THROW(corrupt(2 * sizeof(float), &infinity, sizeof(infinity)), std::runtime_error);
+}
+
+TEST_F(CheckpointTests, FileRoundTripAndLayoutCheck) {
+    const char *path = "checkpoint_test.checkpoint";
+    Checkpoint::capture(em, traffic).saveTo(path);
+    auto carsBefore = cars();
+
+    run(300);
+    Checkpoint::loadFrom(path).restore(em, traffic);
+    EXPECT_EQ(cars(), carsBefore);
+
+    // Another layout refuses the checkpoint and keeps its own state
+    auto otherBus = std::make_shared<EventBus>();
+    EntityManager other(otherBus);
+    TrafficSystem otherTraffic(otherBus, other);
+    otherBus->publish(GenerateWorldEvent{MapConfig{1, 0, 0, 0, {}}});
+    EXPECT_THROW(Checkpoint::loadFrom(path).restore(other, otherTraffic), std::runtime_error);
+    EXPECT_TRUE(other.getCars().empty());
+
+    // So does the same layout with one module moved: module and spot counts alone would match
+    auto movedBus = std::make_shared<EventBus>();
+    EntityManager moved(movedBus);
+    TrafficSystem movedTraffic(movedBus, moved);
+    moved.getRandom().reseed(3);
+    movedBus->publish(GenerateWorldEvent{MapConfig{2, 2, 2, 2, {}}});
+    ASSERT_EQ(moved.getModules().size(), em.getModules().size());
+    moved.getModules().back()->worldPosition.x += 1.0f;
+    EXPECT_THROW(Checkpoint::loadFrom(path).restore(moved, movedTraffic), std::runtime_error);
+
+    std::remove(path);
+    EXPECT_THROW(Checkpoint::loadFrom(path), std::runtime_error);
+}
@@ -0,0 +1,129 @@
+#include <gtest/gtest.h>
+#include "core/ChunkGrid.hpp"
+#include "config.hpp"
+#include "entities/map/Waypoint.hpp"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+class ChunkGridTests : public ::testing::Test {
+protected:
+    ChunkGrid grid;
+    std::vector<std::unique_ptr<Car>> cars;
+
+    Car *makeCar(float x, Vector2 velocity) {
+        auto car = std::make_unique<Car>(Vector2{x, 0.0f}, nullptr, velocity, Car::CarType::COMBUSTION);
+        car->setId({(uint32_t)cars.size(), 0});
+        cars.push_back(std::move(car));
+        return cars.back().get();
+    }
+
+    Car *makeParkedCar(float x, float parkingTime) {
+        Car *car = makeCar(x, {0, 0});
+        car->setState(Car::CarState::PARKED);
+        car->skipParkedTime(-parkingTime);
+        return car;
+    }
+
+    // One simulation tick, the way EntityManager::update drives the grid
+    void tick(double dt) {
+        grid.beginTick(dt);
+        grid.forEachActiveChunk([dt](ChunkGrid::Chunk &chunk, std::span<const Car *const> neighbors) {
+            for (Car *car : chunk.cars)
+                car->updateWithNeighbors(dt, neighbors);
+        });
+        grid.endTick();
+    }
+};
+
+TEST_F(ChunkGridTests, ParkedOnlyChunkSleepsUntilDueAndCatchesUp) {
+    Car *car = makeParkedCar(10.0f, 20.0f);
+    grid.addCar(car);
+
+    // Nothing due for the first 19 ticks: the chunk stays dormant and the car untouched
+    for (int i = 0; i < 19; i++) {
+        tick(1.0);
+        EXPECT_EQ(grid.getActiveChunkCount(), 0u) << "tick " << i;
+    }
+    EXPECT_FLOAT_EQ(car->getParkingTimer(), 20.0f);
+
+    // The tick during which the timer runs out wakes the chunk, catches up 19 s, then simulates 1 s
+    tick(1.0);
+    EXPECT_EQ(grid.getActiveChunkCount(), 1u);
+    EXPECT_TRUE(car->isReadyToLeave());
+    EXPECT_FLOAT_EQ(car->getParkingTimer(), 0.0f);
+    ASSERT_EQ(grid.getActiveCars().size(), 1u);
+    EXPECT_EQ(grid.getActiveCars()[0], car->getId());
+}
+
+TEST_F(ChunkGridTests, MovingCarKeepsChunkActiveAndCrossesBorders) {
+    Car *car = makeCar(Config::Chunks::WIDTH - 4.0f, {15, 0});
+    car->setPath({Waypoint({1.0e6f, 0.0f}, 10.0f)});
+    grid.addCar(car);
+
+    for (int i = 0; i < 60; i++)
+        tick(1.0 / 60.0);
+
+    ASSERT_GT(car->getPosition().x, Config::Chunks::WIDTH);
+    EXPECT_EQ(grid.getMovingCarCount(), 1);
+    EXPECT_EQ(grid.getActiveChunkCount(), 1u);
+
+    int found = 0;
+    grid.forEachCarIn(Config::Chunks::WIDTH, 2.0f * Config::Chunks::WIDTH - 1.0f, [&](const Car &c) {
+        EXPECT_EQ(&c, car);
+        found++;
+    });
+    EXPECT_EQ(found, 1);
+    grid.forEachCarIn(0.0f, Config::Chunks::WIDTH - 1.0f, [&](const Car &) { ADD_FAILURE() << "car left behind"; });
+}
+
+TEST_F(ChunkGridTests, ViewKeepsParkedChunksSimulated) {
+    Car *near = makeParkedCar(10.0f, 100.0f);
+    Car *far = makeParkedCar(20.0f * Config::Chunks::WIDTH, 100.0f);
+    grid.addCar(near);
+    grid.addCar(far);
+
+    grid.setView(0.0f, 50.0f);
+    tick(1.0);
+    EXPECT_FLOAT_EQ(near->getParkingTimer(), 99.0f);
+    EXPECT_FLOAT_EQ(far->getParkingTimer(), 100.0f);
+    const auto &active = grid.getActiveCars();
+    EXPECT_NE(std::find(active.begin(), active.end(), near->getId()), active.end());
+    EXPECT_EQ(std::find(active.begin(), active.end(), far->getId()), active.end());
+
+    // Camera leaves: the chunk goes back to sleep, time keeps being accounted for on wake
+    grid.setView(0.0f, 0.0f);
+    tick(1.0);
+    EXPECT_EQ(grid.getActiveChunkCount(), 0u);
+    grid.setView(0.0f, 50.0f);
+    tick(1.0);
+    EXPECT_FLOAT_EQ(near->getParkingTimer(), 97.0f);
+}
+
+TEST_F(ChunkGridTests, ParkedCarsSleepInsideActiveChunks) {
+    Car *mover = makeCar(1.0f, {5, 0});
+    mover->setPath({Waypoint({Config::Chunks::WIDTH - 1.0f, 0.0f}, 0.5f)});
+    Car *parked = makeParkedCar(20.0f, 2.0f);
+    grid.addCar(mover);
+    grid.addCar(parked);
+
+    // The driving car keeps the chunk active, the parked one is not touched until it is due
+    tick(0.5);
+    EXPECT_EQ(grid.getActiveChunkCount(), 1u);
+    EXPECT_EQ(grid.getSleepingCarCount(), 1u);
+    ASSERT_EQ(grid.getActiveCars().size(), 1u);
+    EXPECT_EQ(grid.getActiveCars()[0], mover->getId());
+
+    int visible = 0;
+    grid.forEachCarIn(0.0f, Config::Chunks::WIDTH - 1.0f, [&](const Car &) { visible++; });
+    EXPECT_EQ(visible, 2);
+
+    tick(0.5);
+    tick(0.5);
+    EXPECT_FLOAT_EQ(parked->getParkingTimer(), 2.0f);
+
+    tick(0.5);
+    EXPECT_EQ(grid.getSleepingCarCount(), 0u);
+    EXPECT_TRUE(parked->isReadyToLeave());
+    EXPECT_EQ(grid.getActiveCars().size(), 2u);
+}
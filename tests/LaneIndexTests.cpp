@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include "core/LaneIndex.hpp"
+#include "entities/Car.hpp"
+#include <memory>
+#include <vector>
+
+namespace {
+/**
+ * @brief Cars driving straight along the two lanes of a road whose top edge is at y = 0.
+ */
+struct Road {
+    LaneIndex index;
+    std::vector<std::unique_ptr<Car>> cars;
+
+    Road() { index.setRoad(0.0f); }
+
+    Car *add(Lane lane, float x, float speedFactor = 1.0f) {
+        float y = index.laneY(lane);
+        float dir = lane == Lane::DOWN ? 1.0f : -1.0f;
+        auto car = std::make_unique<Car>(Vector2{x, y}, nullptr, Vector2{5.0f * dir, 0.0f}, Car::CarType::COMBUSTION);
+        car->setId({(uint32_t)cars.size(), 0});
+        car->addWaypoint(Waypoint({x + 5000.0f * dir, y}, 1.0f, -1, 0.0f, false, speedFactor));
+        cars.push_back(std::move(car));
+        return cars.back().get();
+    }
+
+    // One tick without interaction: every car drives freely toward its waypoint
+    void tick(double dt = 1.0 / 60.0) {
+        index.beginTick();
+        for (auto &car : cars) {
+            if (!car)
+                continue;
+            car->updateWithNeighbors(dt, {}, CarFollowingModel::IDM);
+            index.observe(car.get());
+        }
+        index.endTick();
+    }
+
+    void remove(Car *car) {
+        index.removeCar(car);
+        for (auto &owned : cars) {
+            if (owned.get() == car)
+                owned.reset();
+        }
+    }
+};
+} // namespace
+
+TEST(LaneIndexTests, LeadersAndFollowersAreListNeighbors) {
+    Road road;
+    Car *a = road.add(Lane::DOWN, 10.0f);
+    Car *b = road.add(Lane::DOWN, 30.0f);
+    Car *c = road.add(Lane::DOWN, 20.0f);
+    Car *up1 = road.add(Lane::UP, 50.0f);
+    Car *up2 = road.add(Lane::UP, 40.0f);
+
+    // Nothing is listed before the first tick ends
+    const Car *leader = nullptr;
+    EXPECT_FALSE(road.index.findLeader(*a, leader));
+    road.tick();
+
+    ASSERT_EQ(road.index.getCars(Lane::DOWN).size(), 3u);
+    EXPECT_EQ(road.index.getCars(Lane::DOWN)[0], a);
+    EXPECT_EQ(road.index.getCars(Lane::DOWN)[1], c);
+    EXPECT_EQ(road.index.getCars(Lane::DOWN)[2], b);
+
+    ASSERT_TRUE(road.index.findLeader(*a, leader));
+    EXPECT_EQ(leader, c);
+    ASSERT_TRUE(road.index.findLeader(*b, leader));
+    EXPECT_EQ(leader, nullptr);
+    EXPECT_EQ(road.index.findFollower(*c), a);
+    EXPECT_EQ(road.index.findFollower(*a), nullptr);
+
+    // UP drives toward -X: the leader has the smaller X
+    ASSERT_TRUE(road.index.findLeader(*up1, leader));
+    EXPECT_EQ(leader, up2);
+    EXPECT_EQ(road.index.findFollower(*up2), up1);
+
+    // The car nearest to each lane's entry
+    EXPECT_EQ(road.index.lastInLane(Lane::DOWN), a);
+    EXPECT_EQ(road.index.lastInLane(Lane::UP), up1);
+}
+
+TEST(LaneIndexTests, OvertakingResortsTheLane) {
+    Road road;
+    Car *slow = road.add(Lane::DOWN, 20.0f, 0.2f);
+    Car *fast = road.add(Lane::DOWN, 10.0f);
+    road.tick();
+    const Car *leader = nullptr;
+    ASSERT_TRUE(road.index.findLeader(*fast, leader));
+    EXPECT_EQ(leader, slow);
+
+    // Without interaction the fast car drives through the slow one and becomes the leader
+    for (int i = 0; i < 600 && fast->getPosition().x <= slow->getPosition().x; i++)
+        road.tick();
+    ASSERT_GT(fast->getPosition().x, slow->getPosition().x);
+    road.tick();
+    ASSERT_TRUE(road.index.findLeader(*slow, leader));
+    EXPECT_EQ(leader, fast);
+    EXPECT_EQ(road.index.lastInLane(Lane::DOWN), slow);
+}
+
+TEST(LaneIndexTests, CarsLeaveTheLane) {
+    Road road;
+    Car *a = road.add(Lane::DOWN, 10.0f);
+    Car *b = road.add(Lane::DOWN, 20.0f);
+    Car *c = road.add(Lane::DOWN, 30.0f);
+    road.tick();
+
+    // Removed mid-tick: lookups skip the hole until the list is compacted
+    road.remove(b);
+    const Car *leader = nullptr;
+    ASSERT_TRUE(road.index.findLeader(*a, leader));
+    EXPECT_EQ(leader, c);
+    EXPECT_EQ(road.index.findFollower(*c), a);
+    road.tick();
+    EXPECT_EQ(road.index.getCars(Lane::DOWN).size(), 2u);
+
+    // Parking leaves the lane; turning back onto it rejoins
+    c->setState(Car::CarState::PARKED);
+    road.tick();
+    EXPECT_FALSE(road.index.findLeader(*c, leader));
+    ASSERT_TRUE(road.index.findLeader(*a, leader));
+    EXPECT_EQ(leader, nullptr);
+
+    c->setState(Car::CarState::EXITING);
+    road.tick();
+    ASSERT_TRUE(road.index.findLeader(*a, leader));
+    EXPECT_EQ(leader, c);
+
+    road.index.clearCars();
+    EXPECT_EQ(road.index.lastInLane(Lane::DOWN), nullptr);
+    EXPECT_FALSE(road.index.findLeader(*a, leader));
+}
+
+TEST(LaneIndexTests, SwitchingLanesInOneTickListsTheCarOnce) {
+    Road road;
+    Car *ahead = road.add(Lane::UP, 10.0f);
+    Car *car = road.add(Lane::DOWN, 30.0f);
+    road.tick();
+
+    // From DOWN straight onto UP, turned around (UP is compacted before DOWN drops the car)
+    Car::Snapshot s = car->saveState(-1);
+    s.position = {car->getPosition().x, road.index.laneY(Lane::UP)};
+    s.velocity = {-5.0f, 0.0f};
+    car->restoreState(s, nullptr);
+    car->addWaypoint(Waypoint({-5000.0f, s.position.y}));
+    for (int i = 0; i < 3; i++)
+        road.tick();
+
+    EXPECT_EQ(road.index.getCars(Lane::UP).size(), 2u);
+    EXPECT_TRUE(road.index.getCars(Lane::DOWN).empty());
+    const Car *leader = nullptr;
+    ASSERT_TRUE(road.index.findLeader(*car, leader));
+    EXPECT_EQ(leader, ahead);
+}
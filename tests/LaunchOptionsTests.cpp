@@ -0,0 +1,68 @@
+#include <gtest/gtest.h>
+#include "config.hpp"
+#include "core/LaunchOptions.hpp"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+TEST(LaunchOptionsTests, NoArgumentsKeepsTheMenus) {
+    LaunchOptions options = LaunchOptions::parse({});
+    EXPECT_FALSE(options.mapConfig.has_value());
+}
+
+TEST(LaunchOptionsTests, CommandLineCountsBothSyntaxes) {
+    LaunchOptions options = LaunchOptions::parse({"--small-parking=2500", "--large-charging", "40"});
+    ASSERT_TRUE(options.mapConfig.has_value());
+    EXPECT_EQ(options.mapConfig->smallParkingCount, 2500);
+    EXPECT_EQ(options.mapConfig->largeParkingCount, 0);
+    EXPECT_EQ(options.mapConfig->smallChargingCount, 0);
+    EXPECT_EQ(options.mapConfig->largeChargingCount, 40);
+}
+
+TEST(LaunchOptionsTests, ConfigFileWithCommandLineOverride) {
+    const char *path = "launch_options_test.cfg";
+    {
+        std::ofstream out(path);
+        out << "# load test\n"
+            << "small_parking = 100\n"
+            << "large_parking = 200 # inline comment\n"
+            << "\n"
+            << "small_charging=300\n";
+    }
+
+    LaunchOptions options = LaunchOptions::parse({std::string("--map-config=") + path, "--large-parking=7"});
+    std::remove(path);
+
+    ASSERT_TRUE(options.mapConfig.has_value());
+    EXPECT_EQ(options.mapConfig->smallParkingCount, 100);
+    EXPECT_EQ(options.mapConfig->largeParkingCount, 7);
+    EXPECT_EQ(options.mapConfig->smallChargingCount, 300);
+    EXPECT_EQ(options.mapConfig->largeChargingCount, 0);
+}
+
+TEST(LaunchOptionsTests, CountsAreClampedToTheHardLimit) {
+    LaunchOptions options = LaunchOptions::parse({"--small-parking=999999999"});
+    ASSERT_TRUE(options.mapConfig.has_value());
+    EXPECT_EQ(options.mapConfig->smallParkingCount, Config::Map::MAX_PER_TYPE);
+}
+
+TEST(LaunchOptionsTests, MapFileOption) {
+    LaunchOptions options = LaunchOptions::parse({"--map", "site.map"});
+    ASSERT_TRUE(options.mapConfig.has_value());
+    EXPECT_EQ(options.mapConfig->mapFile, "site.map");
+}
+
+TEST(LaunchOptionsTests, InvalidInputThrows) {
+    EXPECT_THROW(LaunchOptions::parse({"--unknown=1"}), std::runtime_error);
+    EXPECT_THROW(LaunchOptions::parse({"--small-parking=abc"}), std::runtime_error);
+    EXPECT_THROW(LaunchOptions::parse({"--small-parking=-3"}), std::runtime_error);
+    EXPECT_THROW(LaunchOptions::parse({"--small-parking"}), std::runtime_error);
+    EXPECT_THROW(LaunchOptions::parse({"small-parking=3"}), std::runtime_error);
+    EXPECT_THROW(LaunchOptions::parse({"--map-config=does_not_exist.cfg"}), std::runtime_error);
+}
+
+TEST(LaunchOptionsTests, ReplayOption) {
+    LaunchOptions options = LaunchOptions::parse({"--replay=session.replay"});
+    EXPECT_EQ(options.replayPath, "session.replay");
+    EXPECT_FALSE(options.mapConfig.has_value());
+}
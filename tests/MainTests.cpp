@@ -9,6 +9,7 @@
 #include "events/GameEvents.hpp"
 #include "core/EventBus.hpp"
 #include "core/EntityManager.hpp"
+#include "entities/map/WorldGenerator.hpp"
 
 // --- Test Suite 1: Car Logic ---
 
@@ -92,7 +93,7 @@ TEST(PathPlannerTest, GeneratePathSanity) {
     Spot targetSpot = { {10.0f, 10.0f}, 0.0f, 1, SpotState::FREE, 5.0f };
 
     // 4. Generate Path
-    std::vector<Waypoint> path = PathPlanner::GeneratePath(&myCar, &parkingFac, targetSpot);
+    std::vector<Waypoint> path = PathPlanner::GeneratePath(RoadNetwork(), &myCar, &parkingFac, targetSpot);
 
     // 5. Assertions
     EXPECT_FALSE(path.empty()) << "PathPlanner failed to generate a path!";
@@ -109,7 +110,7 @@ TEST(PathPlannerTest, PathEndsAtTarget) {
 
     Spot targetSpot = { {20.0f, 20.0f}, 1.57f, 5, SpotState::FREE, 10.0f };
 
-    std::vector<Waypoint> path = PathPlanner::GeneratePath(&myCar, &charger, targetSpot);
+    std::vector<Waypoint> path = PathPlanner::GeneratePath(RoadNetwork(), &myCar, &charger, targetSpot);
     
     ASSERT_FALSE(path.empty());
 
@@ -135,6 +136,24 @@ TEST(WorldTest, GridToggle) {
     EXPECT_NE(myWorld.isGridEnabled(), initialState);
 }
 
+TEST(WorldTest, LargeGenerationPlacesEveryFacilityInsideTheWorld) {
+    // Far beyond the 5-per-type limit of the map configuration screen
+    MapConfig config{500, 500, 500, 500, {}};
+    GeneratedMap map = WorldGenerator::generate(config);
+
+    int facilities = 0;
+    for (const auto &mod : map.modules) {
+        if (mod->getType() == ModuleType::GENERIC) // Roads
+            continue;
+        facilities++;
+        EXPECT_GE(mod->worldPosition.x, 0.0f);
+        EXPECT_LE(mod->worldPosition.x + mod->getWidth(), map.world->getWidth() + 0.01f);
+        EXPECT_GE(mod->worldPosition.y, 0.0f);
+        EXPECT_LE(mod->worldPosition.y + mod->getHeight(), map.world->getHeight() + 0.01f);
+    }
+    EXPECT_EQ(facilities, 2000);
+}
+
 // --- Test Suite 4: TrafficSystem Logic ---
 
 TEST(TrafficSystemTest, PassThroughFallback) {
@@ -151,10 +170,10 @@ TEST(TrafficSystemTest, PassThroughFallback) {
     // Create a car
     auto car = std::make_unique<Car>(Vector2{0, 0}, nullptr, Vector2{15, 0}, Car::CarType::COMBUSTION);
     Car* carPtr = car.get();
-    em.addCar(std::move(car));
+    CarId id = em.addCar(std::move(car));
     
     // Manually trigger the spawn event (which TrafficSystem listens to)
-    bus->publish(CarSpawnedEvent{carPtr});
+    bus->publish(CarSpawnedEvent{id});
     
     // Wait a bit or explicitly check state
     // TrafficSystem should have assigned a path immediately
@@ -0,0 +1,128 @@
+#include <gtest/gtest.h>
+#include "core/EntityManager.hpp"
+#include "entities/map/MapFile.hpp"
+#include "entities/map/WorldGenerator.hpp"
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <typeinfo>
+
+namespace {
+int indexOf(const std::vector<std::unique_ptr<Module>> &modules, const Module *module) {
+    for (size_t i = 0; i < modules.size(); i++) {
+        if (modules[i].get() == module)
+            return (int)i;
+    }
+    return -1;
+}
+} // namespace
+
+TEST(MapFileTests, RoundTripReproducesTheLayout) {
+    const char *path = "map_file_test.map";
+    GeneratedMap original = WorldGenerator::generate(MapConfig{5, 5, 5, 5, {}});
+    MapFile::save(path, *original.world, original.modules);
+
+    GeneratedMap loaded = MapFile::load(path);
+    std::remove(path);
+
+    ASSERT_EQ(loaded.modules.size(), original.modules.size());
+    for (size_t i = 0; i < original.modules.size(); i++) {
+        const Module &a = *original.modules[i];
+        const Module &b = *loaded.modules[i];
+        EXPECT_EQ(typeid(a), typeid(b)) << "module " << i;
+        EXPECT_EQ(a.isUp(), b.isUp());
+        EXPECT_EQ(a.worldPosition.x, b.worldPosition.x);
+        EXPECT_EQ(a.worldPosition.y, b.worldPosition.y);
+        EXPECT_EQ(a.getPriceMultiplier(), b.getPriceMultiplier());
+        EXPECT_EQ(indexOf(original.modules, a.getParent()), indexOf(loaded.modules, b.getParent()));
+        ASSERT_EQ(a.getSpotCount(), b.getSpotCount());
+        for (int s = 0; s < (int)a.getSpotCount(); s++)
+            EXPECT_EQ(a.getSpot(s).price, b.getSpot(s).price);
+    }
+
+    EXPECT_EQ(loaded.world->getWidth(), original.world->getWidth());
+    EXPECT_EQ(loaded.world->getHeight(), original.world->getHeight());
+    EXPECT_EQ(loaded.world->getBackgroundTiles(), original.world->getBackgroundTiles());
+}
+
+TEST(MapFileTests, GenerateWorldEventLoadsTheMapFile) {
+    const char *path = "map_file_event_test.map";
+    auto bus = std::make_shared<EventBus>();
+    EntityManager saved(bus);
+    bus->publish(GenerateWorldEvent{MapConfig{2, 2, 2, 2, {}}});
+    saved.saveMap(path);
+
+    auto otherBus = std::make_shared<EventBus>();
+    EntityManager loaded(otherBus);
+    float boundsWidth = 0.0f;
+    auto token = otherBus->subscribe<WorldBoundsEvent>([&](const WorldBoundsEvent &e) { boundsWidth = e.width; });
+
+    MapConfig config{0, 0, 0, 0, {}};
+    config.mapFile = path;
+    otherBus->publish(GenerateWorldEvent{config});
+    std::remove(path);
+
+    ASSERT_NE(loaded.getWorld(), nullptr);
+    EXPECT_EQ(boundsWidth, saved.getWorld()->getWidth());
+    EXPECT_EQ(loaded.getModules().size(), saved.getModules().size());
+    EXPECT_EQ(loaded.getOccupancyStats().getCounters().totalSpots,
+              saved.getOccupancyStats().getCounters().totalSpots);
+}
+
+TEST(MapFileTests, DamagedFilesAreRejected) {
+    const char *path = "map_file_damaged.map";
+    GeneratedMap original = WorldGenerator::generate(MapConfig{1, 1, 1, 1, {}});
+    MapFile::save(path, *original.world, original.modules);
+
+    // Truncated
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), {});
+    }
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(bytes.data(), (std::streamsize)bytes.size() - 10);
+    }
+    EXPECT_THROW(MapFile::load(path), std::runtime_error);
+
+    // Not a map
+    {
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out << "small_parking = 3\n";
+    }
+    EXPECT_THROW(MapFile::load(path), std::runtime_error);
+    std::remove(path);
+
+    EXPECT_THROW(MapFile::load("does_not_exist.map"), std::runtime_error);
+}
+
+TEST(MapFileTests, InvalidSizesAndPositionsAreRejected) {
+    const char *path = "map_file_invalid.map";
+    GeneratedMap original = WorldGenerator::generate(MapConfig{1, 1, 1, 1, {}});
+    MapFile::save(path, *original.world, original.modules);
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), {});
+    }
+
+    // Header: magic[8], version, byte order, world width (16), world height (20), ...; module records start at 40
+    // with their x at +8
+    auto loadPatched = [&](size_t offset, float value) {
+        std::string patched = bytes;
+        std::memcpy(patched.data() + offset, &value, sizeof(value));
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(patched.data(), (std::streamsize)patched.size());
+        out.close();
+        MapFile::load(path);
+    };
+    EXPECT_THROW(loadPatched(16, std::numeric_limits<float>::quiet_NaN()), std::runtime_error);
+    EXPECT_THROW(loadPatched(16, -1.0f), std::runtime_error);
+    EXPECT_THROW(loadPatched(20, 1.0e30f), std::runtime_error);
+    EXPECT_THROW(loadPatched(20, original.world->getHeight() * 2.0f), std::runtime_error);
+    EXPECT_THROW(loadPatched(40 + 8, std::numeric_limits<float>::infinity()), std::runtime_error);
+    std::remove(path);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "core/MetricSeries.hpp"
+#include <vector>
+
+TEST(MetricSeriesTests, FinestTierKeepsRecentSamples) {
+    MetricSeries series(4, 1, 10);
+    for (int i = 1; i <= 6; i++)
+        series.add((float)i);
+
+    std::vector<MetricSeries::Bucket> out;
+    series.copyTier(0, out);
+
+    // Ring of 4: the two oldest samples were overwritten
+    ASSERT_EQ(out.size(), 4u);
+    EXPECT_FLOAT_EQ(out.front().mean(), 3.0f);
+    EXPECT_FLOAT_EQ(out.back().mean(), 6.0f);
+    EXPECT_FLOAT_EQ(series.latest(), 6.0f);
+}
+
+TEST(MetricSeriesTests, CoarseTiersAggregateMinMaxMean) {
+    MetricSeries series(8, 2, 4);
+    const float values[] = {1, 5, 3, 7, 2, 2, 2, 2};
+    for (float v : values)
+        series.add(v);
+
+    std::vector<MetricSeries::Bucket> out;
+    series.copyTier(1, out);
+
+    ASSERT_EQ(out.size(), 2u);
+    EXPECT_FLOAT_EQ(out[0].min, 1.0f);
+    EXPECT_FLOAT_EQ(out[0].max, 7.0f);
+    EXPECT_FLOAT_EQ(out[0].mean(), 4.0f);
+    EXPECT_EQ(out[0].count, 4u);
+    EXPECT_FLOAT_EQ(out[1].mean(), 2.0f);
+    EXPECT_EQ(series.samplesPerBucket(1), 4u);
+}
+
+TEST(MetricSeriesTests, MemoryStaysBounded) {
+    MetricSeries series(16, 3, 4);
+    for (int i = 0; i < 100000; i++)
+        series.add((float)(i % 10));
+
+    std::vector<MetricSeries::Bucket> out;
+    for (size_t tier = 0; tier < series.tierCount(); tier++) {
+        series.copyTier(tier, out);
+        EXPECT_LE(out.size(), series.capacity());
+    }
+    // Coarsest tier: 16 samples per bucket, mean of a 0..9 cycle window stays in range
+    series.copyTier(2, out);
+    ASSERT_FALSE(out.empty());
+    EXPECT_EQ(out.back().count, 16u);
+    EXPECT_GE(out.back().min, 0.0f);
+    EXPECT_LE(out.back().max, 9.0f);
+}
@@ -0,0 +1,90 @@
+#include <gtest/gtest.h>
+#include "core/EntityManager.hpp"
+#include "entities/map/Modules.hpp"
+#include <memory>
+#include <sstream>
+#include <string>
+
+class OccupancyStatsTests : public ::testing::Test {
+protected:
+    std::shared_ptr<EventBus> bus;
+    std::unique_ptr<EntityManager> em;
+    Module *parking = nullptr;
+    Module *charging = nullptr;
+
+    void SetUp() override {
+        bus = std::make_shared<EventBus>();
+        em = std::make_unique<EntityManager>(bus);
+
+        em->addModule(std::make_unique<NormalRoad>());
+        auto p = std::make_unique<SmallParking>(true);
+        parking = p.get();
+        em->addModule(std::move(p));
+        auto c = std::make_unique<SmallChargingStation>(false);
+        charging = c.get();
+        em->addModule(std::move(c));
+    }
+};
+
+TEST_F(OccupancyStatsTests, RegistersFacilitiesOnly) {
+    const auto &c = em->getOccupancyStats().getCounters();
+
+    EXPECT_EQ(c.totalFacilities, 2);
+    EXPECT_EQ(c.parkingLots, 1);
+    EXPECT_EQ(c.chargingStations, 1);
+    EXPECT_EQ(c.parkingSpots, (int)parking->getSpotCount());
+    EXPECT_EQ(c.chargingSpots, (int)charging->getSpotCount());
+    EXPECT_EQ(c.totalSpots, c.parkingSpots + c.chargingSpots);
+    EXPECT_EQ(c.occupiedSpots, 0);
+}
+
+TEST_F(OccupancyStatsTests, TracksTransitionsIncrementally) {
+    const auto &c = em->getOccupancyStats().getCounters();
+
+    em->setSpotState(parking, 0, SpotState::RESERVED);
+    EXPECT_EQ(c.reservedSpots, 1);
+    EXPECT_EQ(c.occupiedSpots, 0);
+
+    em->setSpotState(parking, 0, SpotState::OCCUPIED);
+    em->setSpotState(charging, 1, SpotState::OCCUPIED);
+    EXPECT_EQ(c.reservedSpots, 0);
+    EXPECT_EQ(c.occupiedSpots, 2);
+    EXPECT_EQ(c.occupiedParking, 1);
+    EXPECT_EQ(c.occupiedCharging, 1);
+
+    // Repeating a state is not a transition
+    em->setSpotState(charging, 1, SpotState::OCCUPIED);
+    EXPECT_EQ(c.occupiedCharging, 1);
+
+    em->setSpotState(parking, 0, SpotState::FREE);
+    EXPECT_EQ(c.occupiedParking, 0);
+    EXPECT_EQ(c.occupiedSpots, 1);
+
+    // Per-facility counters agree with the aggregate
+    auto counts = charging->getSpotCounts();
+    EXPECT_EQ(counts.occupied, 1);
+    EXPECT_EQ(counts.free, (int)charging->getSpotCount() - 1);
+}
+
+TEST_F(OccupancyStatsTests, ExportsCsv) {
+    em->setSpotState(parking, 2, SpotState::OCCUPIED);
+    em->setSpotState(parking, 3, SpotState::RESERVED);
+
+    std::ostringstream out;
+    em->getOccupancyStats().writeCsv(out);
+    std::string csv = out.str();
+
+    EXPECT_EQ(csv.rfind("scope,type,spots,free,reserved,occupied\n", 0), 0u);
+    EXPECT_NE(csv.find("facility_0,small_parking,"), std::string::npos);
+    EXPECT_NE(csv.find("facility_1,small_charging,"), std::string::npos);
+
+    // Category rows fill every column
+    int spots = (int)parking->getSpotCount();
+    std::string parkingRow =
+        "category,parking," + std::to_string(spots) + ',' + std::to_string(spots - 2) + ",1,1\n";
+    EXPECT_NE(csv.find(parkingRow), std::string::npos);
+    int chargers = (int)charging->getSpotCount();
+    std::string chargingRow =
+        "category,charging," + std::to_string(chargers) + ',' + std::to_string(chargers) + ",0,0\n";
+    EXPECT_NE(csv.find(chargingRow), std::string::npos);
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include "core/EntityManager.hpp"
+#include "raymath.h"
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+class PickingTests : public ::testing::Test {
+protected:
+    std::shared_ptr<EventBus> bus = std::make_shared<EventBus>();
+    EntityManager em{bus};
+
+    void SetUp() override {
+        em.getRandom().reseed(3);
+        bus->publish(GenerateWorldEvent{MapConfig{3, 3, 3, 3, {}}});
+    }
+
+    CarId addCar(Vector2 position) {
+        return em.addCar(std::make_unique<Car>(position, nullptr, Vector2{0, 0}, Car::CarType::COMBUSTION));
+    }
+
+    const Module *firstModuleWithSpots() const {
+        for (const auto &module : em.getModules()) {
+            if (module->getSpotCount() > 0)
+                return module.get();
+        }
+        return nullptr;
+    }
+};
+
+TEST_F(PickingTests, NearestCarWins) {
+    CarId far = addCar({100.0f, 500.0f});
+    CarId near = addCar({100.5f, 500.0f});
+    EntitySelectedEvent hit = em.pick({100.4f, 500.0f});
+    EXPECT_EQ(hit.type, SelectionType::CAR);
+    EXPECT_EQ(hit.carId, near);
+
+    hit = em.pick({99.6f, 500.0f});
+    EXPECT_EQ(hit.type, SelectionType::CAR);
+    EXPECT_EQ(hit.carId, far);
+
+    // Outside the click radius of both, and off the site
+    EXPECT_EQ(em.pick({100.0f, 502.0f}).type, SelectionType::GENERAL);
+}
+
+TEST_F(PickingTests, FacilityClickSelectsNearestSpot) {
+    const Module *module = firstModuleWithSpots();
+    ASSERT_NE(module, nullptr);
+    const Spot &spot = module->getSpots()[module->getSpotCount() - 1];
+    Vector2 spotPos = Vector2Add(module->worldPosition, spot.localPosition);
+
+    EntitySelectedEvent hit = em.pick(spotPos);
+    EXPECT_EQ(hit.type, SelectionType::SPOT);
+    EXPECT_EQ(hit.module, module);
+    EXPECT_EQ(hit.spotIndex, (int)module->getSpotCount() - 1);
+
+    // A car on the spot is picked before the facility
+    CarId car = addCar(spotPos);
+    hit = em.pick(spotPos);
+    EXPECT_EQ(hit.type, SelectionType::CAR);
+    EXPECT_EQ(hit.carId, car);
+}
+
+TEST_F(PickingTests, AreaMatchesFullScan) {
+    for (int i = 0; i < 200; i++)
+        addCar({em.getRandom().uniformFloat(-20.0f, 400.0f), em.getRandom().uniformFloat(-50.0f, 50.0f)});
+
+    const Rectangle areas[] = {
+        {30.0f, -20.0f, 60.0f, 40.0f}, {-100.0f, -100.0f, 1000.0f, 200.0f}, {250.0f, 0.0f, 5.0f, 5.0f}};
+    for (const Rectangle &area : areas) {
+        std::vector<CarId> cars;
+        std::vector<Module *> modules;
+        em.pickArea(area, cars, modules);
+
+        std::vector<CarId> expectedCars;
+        for (const auto &car : em.getCars()) {
+            if (CheckCollisionPointRec(car->getPosition(), area))
+                expectedCars.push_back(car->getId());
+        }
+        std::vector<Module *> expectedModules;
+        for (const auto &module : em.getModules()) {
+            Rectangle rec = {module->worldPosition.x, module->worldPosition.y, module->getWidth(), module->getHeight()};
+            if (CheckCollisionRecs(area, rec))
+                expectedModules.push_back(module.get());
+        }
+
+        auto byIndex = [](CarId a, CarId b) { return a.index < b.index; };
+        std::sort(cars.begin(), cars.end(), byIndex);
+        std::sort(expectedCars.begin(), expectedCars.end(), byIndex);
+        std::sort(modules.begin(), modules.end());
+        std::sort(expectedModules.begin(), expectedModules.end());
+        EXPECT_EQ(cars, expectedCars);
+        EXPECT_EQ(modules, expectedModules);
+    }
+}
+
+TEST_F(PickingTests, SnapshotCopiesSpotStates) {
+    Module *module = const_cast<Module *>(firstModuleWithSpots());
+    ASSERT_NE(module, nullptr);
+    em.setSpotState(module, 0, SpotState::RESERVED);
+    em.publishSnapshot(1.0, 0.0);
+
+    // The render side sees the state at publication, not the live spot
+    em.setSpotState(module, 0, SpotState::FREE);
+    em.draw(Rectangle{0.0f, 0.0f, 0.0f, 0.0f});
+    const RenderSnapshot &snapshot = em.getRenderSnapshot();
+    ASSERT_EQ(snapshot.modules.size(), em.getModules().size());
+    auto entry = std::find_if(snapshot.modules.begin(), snapshot.modules.end(),
+                              [&](const ModuleRenderState &m) { return m.module == module; });
+    ASSERT_NE(entry, snapshot.modules.end());
+    ASSERT_EQ(entry->spotCount, (uint32_t)module->getSpotCount());
+    EXPECT_EQ(snapshot.spots[entry->firstSpot].state, SpotState::RESERVED);
+    EXPECT_FLOAT_EQ(snapshot.spots[entry->firstSpot].price, module->getSpot(0).price);
+}
@@ -0,0 +1,158 @@
+#include <gtest/gtest.h>
+#include "config.hpp"
+#include "core/BinaryIO.hpp"
+#include "core/EntityManager.hpp"
+#include "events/GameEvents.hpp"
+#include "systems/PricingEngine.hpp"
+#include "systems/TrafficSystem.hpp"
+#include <cmath>
+#include <map>
+#include <memory>
+#include <vector>
+
+class PricingEngineTests : public ::testing::Test {
+protected:
+    std::shared_ptr<EventBus> bus = std::make_shared<EventBus>();
+    PricingEngine engine{bus};
+    SmallParking busy{true};
+    SmallParking quiet{false};
+    LargeParking steady{true};
+    std::vector<float> busyList, quietList;
+
+    void SetUp() override {
+        for (int i = 0; i < (int)busy.getSpotCount(); i++)
+            busy.setSpotPrice(i, 2.0f + 0.1f * (float)(i % 5));
+        busyList = prices(busy);
+        quietList = prices(quiet);
+        engine.addFacility(&busy);
+        engine.addFacility(&quiet);
+        engine.addFacility(&steady);
+
+        // Busy: every spot taken. Steady: about as full as the curve's neutral point
+        for (int i = 0; i < (int)busy.getSpotCount(); i++)
+            busy.setSpotState(i, SpotState::OCCUPIED);
+        int neutral = (int)std::lround(steady.getSpotCount() * 0.5);
+        for (int i = 0; i < neutral; i++)
+            steady.setSpotState(i, SpotState::OCCUPIED);
+    }
+
+    static std::vector<float> prices(const Module &module) {
+        std::vector<float> out;
+        for (const Spot &spot : module.getSpots())
+            out.push_back(spot.price);
+        return out;
+    }
+};
+
+TEST_F(PricingEngineTests, CurveIsPiecewiseLinearAndFlatOutside) {
+    using namespace Config::Pricing;
+    EXPECT_FLOAT_EQ(PricingEngine::curve(-1.0f), CURVE_SURGE[0]);
+    EXPECT_FLOAT_EQ(PricingEngine::curve(CURVE_DEMAND[1]), CURVE_SURGE[1]);
+    EXPECT_FLOAT_EQ(PricingEngine::curve(10.0f), CURVE_SURGE[std::size(CURVE_SURGE) - 1]);
+    float mid = (CURVE_DEMAND[1] + CURVE_DEMAND[2]) / 2.0f;
+    EXPECT_FLOAT_EQ(PricingEngine::curve(mid), (CURVE_SURGE[1] + CURVE_SURGE[2]) / 2.0f);
+    EXPECT_FLOAT_EQ(PricingEngine::curve(0.5f), 1.0f); // Half full is the list price
+}
+
+TEST_F(PricingEngineTests, PricesFollowDemand) {
+    // Elasticity 0 never touches the prices
+    engine.update(Config::Pricing::INTERVAL * 3, 0.0f);
+    EXPECT_EQ(prices(busy), busyList);
+
+    engine.update(Config::Pricing::INTERVAL, 1.0f);
+    float busySurge = engine.getSurge(&busy);
+    EXPECT_GT(busySurge, 1.0f);
+    EXPECT_LT(engine.getSurge(&quiet), 1.0f);
+    EXPECT_FLOAT_EQ(engine.getSurge(&steady), 1.0f);
+
+    std::vector<float> now = prices(busy);
+    for (size_t i = 0; i < now.size(); i++)
+        EXPECT_NEAR(now[i], busyList[i] * busySurge, 0.005f);
+    EXPECT_LT(prices(quiet)[0], quietList[0]);
+
+    // The surge keeps moving toward its target, within the bounds
+    for (int i = 0; i < 20; i++)
+        engine.recompute(1.0f);
+    EXPECT_GT(engine.getSurge(&busy), busySurge);
+    EXPECT_LE(engine.getSurge(&busy), Config::Pricing::MAX_SURGE);
+}
+
+TEST_F(PricingEngineTests, ReservationsRaiseDemand) {
+    for (int i = 0; i < 4; i++) {
+        quiet.setSpotState(i, SpotState::RESERVED);
+        bus->publish(SpotStateChangedEvent{&quiet, i, SpotState::FREE, SpotState::RESERVED});
+        quiet.setSpotState(i, SpotState::FREE);
+    }
+    engine.recompute(1.0f);
+    float withReservations = engine.getSurge(&quiet);
+
+    // Counted per interval: a quiet interval drops it again
+    engine.recompute(1.0f);
+    EXPECT_LT(engine.getSurge(&quiet), withReservations);
+}
+
+TEST_F(PricingEngineTests, OnlyDirtyFacilitiesAreRepriced) {
+    // The steady facility's surge does not move, so its spots are never rewritten
+    steady.setSpotPrice(0, 123.0f);
+    engine.recompute(1.0f);
+    EXPECT_EQ(steady.getSpot(0).price, 123.0f);
+    EXPECT_NE(prices(busy), busyList);
+}
+
+TEST_F(PricingEngineTests, CheckpointRestoresThePrices) {
+    engine.recompute(1.0f);
+    BinaryWriter out;
+    engine.saveCheckpoint(out);
+    std::vector<float> saved = prices(busy);
+    float savedSurge = engine.getSurge(&busy);
+
+    engine.recompute(2.0f);
+    ASSERT_NE(prices(busy), saved);
+
+    BinaryReader in(out.data());
+    engine.restore(engine.readCheckpoint(in));
+    EXPECT_EQ(prices(busy), saved);
+    EXPECT_EQ(engine.getSurge(&busy), savedSurge);
+
+    // Another layout is rejected
+    PricingEngine other(bus);
+    BinaryReader again(out.data());
+    EXPECT_THROW(other.readCheckpoint(again), std::runtime_error);
+}
+
+TEST(PricingEngineRevenueTests, StaysArePaidAtTheQuotedPrice) {
+    auto bus = std::make_shared<EventBus>();
+    SimulationParams params;
+    params.parkingMinTime = 5.0f;
+    params.parkingMaxTime = 10.0f;
+    EntityManager em(bus, params);
+    TrafficSystem traffic(bus, em);
+    em.getRandom().reseed(5);
+    bus->publish(GenerateWorldEvent{MapConfig{2, 2, 2, 2, {}}});
+
+    // Quotes are taken when a spot is reserved; released stays must be paid at them, even though
+    // every price goes up while the cars are parked
+    std::map<std::pair<const Module *, int>, float> quotes;
+    int released = 0;
+    auto token = bus->subscribe<SpotStateChangedEvent>([&](const SpotStateChangedEvent &e) {
+        if (e.current == SpotState::RESERVED)
+            quotes[{e.module, e.spotIndex}] = e.module->getSpot(e.spotIndex).price;
+        if (e.previous == SpotState::OCCUPIED && e.current == SpotState::FREE) {
+            EXPECT_FLOAT_EQ(e.price, quotes.at({e.module, e.spotIndex}));
+            released++;
+        }
+    });
+
+    for (int i = 0; i < 20; i++)
+        bus->publish(SpawnCarRequestEvent{});
+    for (int tick = 0; tick < 60 * 120 && released < 3; tick++) {
+        bus->publish(GameUpdateEvent{1.0 / 60.0});
+        if (tick % 60 == 0) {
+            for (const auto &module : em.getModules()) {
+                for (int s = 0; s < (int)module->getSpotCount(); s++)
+                    module->setSpotPrice(s, module->getSpot(s).price + 1.0f);
+            }
+        }
+    }
+    EXPECT_GE(released, 3);
+}
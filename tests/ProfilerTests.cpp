@@ -0,0 +1,65 @@
+#include <gtest/gtest.h>
+#include "core/Profiler.hpp"
+#include <cstring>
+#include <sstream>
+#include <thread>
+
+namespace {
+const Profiler::ZoneSummary *findZone(const char *name) {
+    for (const auto &zone : Profiler::Get().getFrameSummary()) {
+        if (std::strcmp(zone.name, name) == 0)
+            return &zone;
+    }
+    return nullptr;
+}
+} // namespace
+
+TEST(ProfilerTests, FrameSummaryAggregatesZonesOfAllThreads) {
+    Profiler &profiler = Profiler::Get();
+    profiler.setEnabled(true);
+    profiler.markFrame();
+
+    for (int i = 0; i < 3; i++) {
+        ProfileZone zone("ProfilerTests::main");
+    }
+    std::thread worker([]() { ProfileZone zone("ProfilerTests::worker"); });
+    worker.join();
+
+    profiler.markFrame();
+    profiler.setEnabled(false);
+
+    const auto *mainZone = findZone("ProfilerTests::main");
+    ASSERT_NE(mainZone, nullptr);
+    EXPECT_EQ(mainZone->calls, 3u);
+    ASSERT_NE(findZone("ProfilerTests::worker"), nullptr);
+    EXPECT_GT(profiler.getFrameMs(), 0.0);
+}
+
+TEST(ProfilerTests, DisabledZonesAreNotRecorded) {
+    Profiler &profiler = Profiler::Get();
+    profiler.setEnabled(false);
+    profiler.markFrame();
+    {
+        ProfileZone zone("ProfilerTests::disabled");
+    }
+    profiler.markFrame();
+    EXPECT_EQ(findZone("ProfilerTests::disabled"), nullptr);
+}
+
+TEST(ProfilerTests, ChromeTraceContainsCompleteEvents) {
+    Profiler &profiler = Profiler::Get();
+    profiler.setEnabled(true);
+    {
+        ProfileZone zone("ProfilerTests::trace", "detail \"quoted\"");
+    }
+    profiler.setEnabled(false);
+
+    std::ostringstream out;
+    profiler.writeChromeTrace(out);
+    std::string json = out.str();
+
+    EXPECT_EQ(json.rfind("{\"traceEvents\":[", 0), 0u);
+    EXPECT_NE(json.find("\"name\":\"ProfilerTests::trace\""), std::string::npos);
+    EXPECT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+    EXPECT_NE(json.find("detail \\\"quoted\\\""), std::string::npos);
+}
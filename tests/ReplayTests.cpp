@@ -0,0 +1,178 @@
+#include <gtest/gtest.h>
+#include "core/EntityManager.hpp"
+#include "core/Replay.hpp"
+#include "systems/TrafficSystem.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+/**
+ * @brief Records a headless session that uses every kind of injected event.
+ */
+ReplayRecording recordSession() {
+    const MapConfig map{2, 2, 2, 2, {}};
+    auto bus = std::make_shared<EventBus>();
+    EntityManager em(bus);
+    TrafficSystem traffic(bus, em);
+    em.getRandom().reseed(21);
+    ReplayRecorder recorder(bus, em, 21, map);
+    bus->publish(GenerateWorldEvent{map});
+
+    for (int tick = 0; tick < 1200; ++tick) {
+        if (tick == 0) {
+            for (int i = 0; i < 10; ++i)
+                bus->publish(SpawnCarRequestEvent{});
+        }
+        if (tick == 100)
+            bus->publish(CycleAutoSpawnLevelEvent{});
+        if (tick == 200) {
+            bus->publish(SimulationSpeedChangedEvent{4.0});
+            bus->publish(GamePausedEvent{});
+            bus->publish(GameResumedEvent{});
+        }
+        if (tick == 300) {
+            EntitySelectedEvent selection;
+            selection.type = SelectionType::SPOT;
+            for (const auto &module : em.getModules()) {
+                if (module->getSpotCount() > 0) {
+                    selection.module = module.get();
+                    selection.spotIndex = 0;
+                    break;
+                }
+            }
+            bus->publish(selection);
+        }
+        if (tick == 400)
+            em.setView(0.0f, 60.0f);
+        if (tick == 700)
+            em.setView(0.0f, 0.0f);
+        bus->publish(GameUpdateEvent{tick < 600 ? Config::FIXED_DELTA_TIME : 2.0 * Config::FIXED_DELTA_TIME});
+    }
+    return recorder.getRecording();
+}
+} // namespace
+
+TEST(ReplayTests, RecordedSessionReplaysIdentically) {
+    ReplayRecording recording = recordSession();
+    EXPECT_EQ(recording.seed, 21u);
+    EXPECT_EQ(recording.tickCount, 1200u);
+    ASSERT_EQ(recording.hashes.size(), 1200u / Config::Replay::HASH_INTERVAL_TICKS);
+
+    auto count = [&](ReplayEventKind kind) {
+        return std::count_if(recording.entries.begin(), recording.entries.end(),
+                             [kind](const ReplayEntry &e) { return e.kind == kind; });
+    };
+    EXPECT_EQ(count(ReplayEventKind::SPAWN_REQUEST), 10);
+    EXPECT_EQ(count(ReplayEventKind::SELECTION), 1);
+    EXPECT_EQ(count(ReplayEventKind::VIEW), 2);
+    EXPECT_EQ(count(ReplayEventKind::TICK_LENGTH), 2);
+
+    ReplayResult result = ReplayPlayer::play(recording);
+    EXPECT_FALSE(result.diverged) << "at tick " << result.divergedAtTick;
+    EXPECT_EQ(result.ticks, recording.tickCount);
+    EXPECT_EQ(result.hashesChecked, recording.hashes.size());
+}
+
+TEST(ReplayTests, MissingOrAlteredInputIsDetected) {
+    ReplayRecording recording = recordSession();
+
+    ReplayRecording missingSpawn = recording;
+    missingSpawn.entries.erase(missingSpawn.entries.begin());
+    ReplayResult result = ReplayPlayer::play(missingSpawn);
+    EXPECT_TRUE(result.diverged);
+    EXPECT_EQ(result.divergedAtTick, recording.hashes.front().tick);
+
+    ReplayRecording altered = recording;
+    altered.hashes[5].hash ^= 1;
+    result = ReplayPlayer::play(altered);
+    EXPECT_TRUE(result.diverged);
+    EXPECT_EQ(result.divergedAtTick, recording.hashes[5].tick);
+    EXPECT_EQ(result.hashesChecked, 5u);
+    EXPECT_EQ(result.expectedHash, altered.hashes[5].hash);
+    EXPECT_EQ(result.actualHash, recording.hashes[5].hash);
+}
+
+TEST(ReplayTests, FileRoundTrip) {
+    ReplayRecording recording = recordSession();
+    const char *path = "replay_test.replay";
+    recording.saveTo(path);
+
+    ReplayRecording loaded = ReplayRecording::loadFrom(path);
+    std::remove(path);
+    EXPECT_EQ(loaded.seed, recording.seed);
+    EXPECT_EQ(loaded.tickCount, recording.tickCount);
+    EXPECT_EQ(loaded.map.smallChargingCount, 2);
+    ASSERT_EQ(loaded.entries.size(), recording.entries.size());
+    ASSERT_EQ(loaded.hashes.size(), recording.hashes.size());
+    EXPECT_EQ(loaded.hashes.back().hash, recording.hashes.back().hash);
+    EXPECT_FALSE(ReplayPlayer::play(loaded).diverged);
+}
+
+TEST(ReplayTests, DamagedFilesAreRejected) {
+    ReplayRecording recording = recordSession();
+    const char *path = "replay_damaged.replay";
+    recording.saveTo(path);
+
+    // Truncated
+    std::ifstream in(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(bytes.data(), (std::streamsize)bytes.size() - 10);
+    EXPECT_THROW(ReplayRecording::loadFrom(path), std::runtime_error);
+
+    // Another version: its params and records may be laid out differently
+    std::string older = bytes;
+    uint32_t version = ReplayRecording::VERSION - 1;
+    std::memcpy(older.data() + 8, &version, sizeof(version));
+    std::ofstream(path, std::ios::binary | std::ios::trunc).write(older.data(), (std::streamsize)older.size());
+    EXPECT_THROW(ReplayRecording::loadFrom(path), std::runtime_error);
+
+    // Not a replay
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << "PLKCHKPT and some more bytes to read";
+    EXPECT_THROW(ReplayRecording::loadFrom(path), std::runtime_error);
+
+    // Values the player would act on, out of range
+    auto rejects = [&](ReplayRecording damaged) {
+        damaged.saveTo(path);
+        EXPECT_THROW(ReplayRecording::loadFrom(path), std::runtime_error);
+    };
+    auto entryOf = [&](ReplayEventKind kind) {
+        return (size_t)(std::find_if(recording.entries.begin(), recording.entries.end(),
+                                     [&](const ReplayEntry &e) { return e.kind == kind; }) -
+                        recording.entries.begin());
+    };
+    ReplayRecording damaged = recording;
+    damaged.params.carFollowing = (CarFollowingModel)2;
+    rejects(damaged);
+    damaged = recording;
+    damaged.params.spotAssignment = (SpotAssignmentMode)-1;
+    rejects(damaged);
+    damaged = recording;
+    damaged.params.parkingMaxTime = std::numeric_limits<float>::quiet_NaN();
+    rejects(damaged);
+
+    size_t selection = entryOf(ReplayEventKind::SELECTION);
+    ASSERT_LT(selection, recording.entries.size());
+    damaged = recording;
+    damaged.entries[selection].selectionType = 5;
+    rejects(damaged);
+
+    damaged = recording;
+    ReplayEntry tickLength;
+    tickLength.kind = ReplayEventKind::TICK_LENGTH;
+    tickLength.value = -1.0;
+    damaged.entries.insert(damaged.entries.begin(), tickLength);
+    rejects(damaged);
+
+    // The untouched recording still loads
+    recording.saveTo(path);
+    EXPECT_NO_THROW(ReplayRecording::loadFrom(path));
+
+    std::remove(path);
+    EXPECT_THROW(ReplayRecording::loadFrom("does_not_exist.replay"), std::runtime_error);
+}
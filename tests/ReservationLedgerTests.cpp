@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+#include "config.hpp"
+#include "core/Checkpoint.hpp"
+#include "core/EntityManager.hpp"
+#include "systems/ReservationLedger.hpp"
+#include "systems/TrafficSystem.hpp"
+#include <memory>
+#include <vector>
+
+namespace {
+CarId car(uint32_t index, uint32_t generation = 0) { return {index, generation}; }
+Module *facility(uintptr_t n) { return reinterpret_cast<Module *>(n * 64); }
+
+std::vector<ReservationLedger::Reservation> advance(ReservationLedger &ledger, int ticks) {
+    std::vector<ReservationLedger::Reservation> expired;
+    for (int i = 0; i < ticks; i++)
+        ledger.advance(expired);
+    return expired;
+}
+} // namespace
+
+TEST(ReservationLedgerTests, RecordsBothWays) {
+    ReservationLedger ledger;
+    ledger.reserve(car(3), facility(1), 7, 10, 0.0f);
+    ASSERT_NE(ledger.find(car(3)), nullptr);
+    EXPECT_EQ(ledger.find(car(3))->spotIndex, 7);
+    EXPECT_EQ(ledger.holder(facility(1), 7), car(3));
+    EXPECT_FALSE(ledger.holder(facility(1), 8).isValid());
+
+    // An older handle of the same slot holds nothing
+    EXPECT_EQ(ledger.find(car(3, 1)), nullptr);
+
+    // Reserving again moves the car
+    ledger.reserve(car(3), facility(2), 0, 10, 4.5f);
+    EXPECT_FALSE(ledger.holder(facility(1), 7).isValid());
+    EXPECT_EQ(ledger.size(), 1u);
+
+    ReservationLedger::Reservation released;
+    ASSERT_TRUE(ledger.release(car(3), released));
+    EXPECT_EQ(released.facility, facility(2));
+    EXPECT_EQ(released.price, 4.5f);
+    EXPECT_FALSE(ledger.release(car(3), released));
+    EXPECT_EQ(ledger.size(), 0u);
+}
+
+TEST(ReservationLedgerTests, LapsesFromTheWheel) {
+    ReservationLedger ledger;
+    const int slots = Config::Reservation::WHEEL_SLOTS;
+    ledger.reserve(car(0), facility(1), 0, 5, 0.0f);
+    ledger.reserve(car(1), facility(1), 1, 5, 0.0f);
+    ledger.reserve(car(2), facility(1), 2, 5, 0.0f);
+    ledger.reserve(car(3), facility(1), 3, slots + 5, 0.0f); // Same bucket, one turn later
+    ledger.reserve(car(4), facility(1), 4, 5, 0.0f);
+
+    ledger.confirm(car(1)); // Arrived
+    ReservationLedger::Reservation released;
+    ledger.release(car(2), released); // Left
+    ledger.reserve(car(4), facility(1), 4, 20, 0.0f); // Renewed
+
+    EXPECT_TRUE(advance(ledger, 4).empty());
+    auto expired = advance(ledger, 1);
+    ASSERT_EQ(expired.size(), 1u);
+    EXPECT_EQ(expired[0].carId, car(0));
+    EXPECT_FALSE(ledger.holder(facility(1), 0).isValid());
+
+    expired = advance(ledger, 15);
+    ASSERT_EQ(expired.size(), 1u);
+    EXPECT_EQ(expired[0].carId, car(4));
+
+    expired = advance(ledger, slots - 15);
+    ASSERT_EQ(expired.size(), 1u);
+    EXPECT_EQ(expired[0].carId, car(3));
+    EXPECT_EQ(ledger.getTick(), (uint64_t)slots + 5);
+
+    // The arrived car keeps its spot
+    EXPECT_EQ(ledger.size(), 1u);
+    EXPECT_EQ(ledger.holder(facility(1), 1), car(1));
+}
+
+class ReservationLifecycleTests : public ::testing::Test {
+protected:
+    std::shared_ptr<EventBus> bus = std::make_shared<EventBus>();
+    EntityManager em{bus};
+    TrafficSystem traffic{bus, em};
+    std::vector<Subscription> tokens;
+    std::vector<CarId> spawned;
+
+    void SetUp() override {
+        em.getRandom().reseed(5);
+        bus->publish(GenerateWorldEvent{MapConfig{2, 2, 2, 2, {}}});
+        tokens.push_back(bus->subscribe<CarSpawnedEvent>([this](const CarSpawnedEvent &e) { spawned.push_back(e.carId); }));
+    }
+
+    void run(int ticks) {
+        for (int i = 0; i < ticks; i++)
+            bus->publish(GameUpdateEvent{1.0 / 60.0});
+    }
+
+    const OccupancyCounters &counters() { return em.getOccupancyStats().getCounters(); }
+};
+
+TEST_F(ReservationLifecycleTests, ArrivalOccupiesAndLeavingFrees) {
+    bus->publish(SpawnCarRequestEvent{});
+    ASSERT_EQ(spawned.size(), 1u);
+    const ReservationLedger::Reservation *held = traffic.getReservations().find(spawned[0]);
+    ASSERT_NE(held, nullptr);
+    EXPECT_NE(held->expiry, ReservationLedger::NO_EXPIRY);
+    EXPECT_EQ(counters().reservedSpots, 1);
+
+    for (int i = 0; i < 3600 && counters().occupiedSpots == 0; i++)
+        run(1);
+    EXPECT_EQ(counters().occupiedSpots, 1);
+    EXPECT_EQ(counters().reservedSpots, 0);
+    ASSERT_NE(traffic.getReservations().find(spawned[0]), nullptr);
+    EXPECT_EQ(traffic.getReservations().find(spawned[0])->expiry, ReservationLedger::NO_EXPIRY);
+
+    // A checkpoint keeps the record, under the restored car's id
+    Checkpoint checkpoint = Checkpoint::capture(em, traffic);
+    checkpoint.restore(em, traffic);
+    run(1);
+    ASSERT_EQ(em.getCars().size(), 1u);
+    EXPECT_EQ(traffic.getReservations().size(), 1u);
+    EXPECT_NE(traffic.getReservations().find(em.getCars()[0]->getId()), nullptr);
+    EXPECT_EQ(counters().occupiedSpots, 1);
+
+    // Removed while parked: the spot comes back on the next tick
+    em.removeCar(em.getCars()[0]->getId());
+    run(1);
+    EXPECT_EQ(counters().occupiedSpots, 0);
+    EXPECT_EQ(traffic.getReservations().size(), 0u);
+}
+
+TEST_F(ReservationLifecycleTests, LateCarLosesItsSpot) {
+    bus->publish(SpawnCarRequestEvent{});
+    ASSERT_EQ(spawned.size(), 1u);
+    Car *car = em.getCar(spawned[0]);
+
+    // Held up far from its spot
+    Vector2 p = car->getPosition();
+    car->setPath({Waypoint({p.x, p.y + 10000.0f}, 1.0f, -1, 0.0f, false, 0.01f)});
+    run((int)(Config::Reservation::TIMEOUT * 60) - 60);
+    EXPECT_EQ(counters().reservedSpots, 1);
+
+    run(120);
+    EXPECT_EQ(counters().reservedSpots, 0);
+    EXPECT_EQ(traffic.getReservations().find(spawned[0]), nullptr);
+}
@@ -0,0 +1,284 @@
+#include <gtest/gtest.h>
+#include "config.hpp"
+#include "entities/Car.hpp"
+#include "entities/map/Modules.hpp"
+#include "entities/map/WorldGenerator.hpp"
+#include "raymath.h"
+#include "systems/OccupancyStats.hpp"
+#include "systems/PathPlanner.hpp"
+#include "systems/RoadNetwork.hpp"
+#include <cmath>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace {
+float length(Vector2 start, const std::vector<Vector2> &points) {
+    float total = 0.0f;
+    for (Vector2 p : points) {
+        total += Vector2Distance(start, p);
+        start = p;
+    }
+    return total;
+}
+} // namespace
+
+class RoadNetworkTests : public ::testing::Test {
+protected:
+    GeneratedMap map = WorldGenerator::generate(MapConfig{2, 2, 2, 2, {}});
+    RoadNetwork network;
+    std::vector<const Module *> facilities;
+
+    void SetUp() override {
+        network.build(map.modules);
+        for (const auto &mod : map.modules)
+            if (OccupancyStats::isParking(mod->getType()) || OccupancyStats::isCharging(mod->getType()))
+                facilities.push_back(mod.get());
+    }
+};
+
+TEST_F(RoadNetworkTests, StripHasBothEndsAndEveryGate) {
+    // Two map ends, each with a way in and a way out
+    ASSERT_EQ(network.getEntries().size(), 2u);
+    ASSERT_EQ(network.getExits().size(), 2u);
+    for (const auto &entry : network.getEntries())
+        EXPECT_EQ(std::fabs(entry.direction.x), 1.0f);
+
+    // Folded: far fewer nodes than lane ends
+    EXPECT_LT(network.getNodeCount(), map.modules.size() * 4);
+
+    ASSERT_EQ(facilities.size(), 8u);
+    for (const Module *fac : facilities) {
+        int gate = network.getGate(fac);
+        int out = network.getFacilityExit(fac);
+        ASSERT_NE(gate, -1);
+        ASSERT_NE(out, -1);
+        for (int i = 0; i < 2; i++) {
+            EXPECT_NE(network.getEntryDistance(i, gate), RoadNetwork::UNREACHABLE);
+            EXPECT_NE(network.getExitDistance(out, i), RoadNetwork::UNREACHABLE);
+        }
+    }
+}
+
+TEST_F(RoadNetworkTests, RoutesMatchTheTreeDistances) {
+    for (const Module *fac : facilities) {
+        int gate = network.getGate(fac);
+        for (int i = 0; i < 2; i++) {
+            const RoadNetwork::Terminal &entry = network.getEntries()[i];
+            std::vector<Vector2> points;
+            ASSERT_TRUE(network.route(entry.node, gate, points));
+            EXPECT_NEAR(length(entry.position, points), network.getEntryDistance(i, gate), 0.01f);
+            EXPECT_EQ(Vector2Distance(points.back(), network.getNodePosition(gate)), 0.0f);
+
+            // From the facility to an exit: the exit's tree
+            int out = network.getFacilityExit(fac);
+            const RoadNetwork::Terminal &exit = network.getExits()[i];
+            ASSERT_TRUE(network.route(out, exit.node, points));
+            EXPECT_NEAR(length(network.getNodePosition(out), points), network.getExitDistance(out, i), 0.01f);
+        }
+    }
+
+    // From one facility to another: no shorter than the straight line
+    int from = network.getFacilityExit(facilities.front());
+    int to = network.getGate(facilities.back());
+    std::vector<Vector2> points;
+    ASSERT_TRUE(network.route(from, to, points));
+    EXPECT_EQ(Vector2Distance(points.back(), network.getNodePosition(to)), 0.0f);
+    EXPECT_GE(length(network.getNodePosition(from), points),
+              Vector2Distance(network.getNodePosition(from), network.getNodePosition(to)));
+}
+
+TEST_F(RoadNetworkTests, GateRouteTurnsAtTheEntranceLane) {
+    const Module *fac = facilities.front();
+    const RoadNetwork::Terminal &entry = network.getEntries()[0];
+    std::vector<Vector2> points;
+    ASSERT_TRUE(network.route(entry.node, network.getGate(fac), points));
+
+    // Straight along the lane, then one turn onto the entrance road
+    ASSERT_EQ(points.size(), 2u);
+    EXPECT_NEAR(points[0].y, entry.position.y, 0.01f);
+    EXPECT_NEAR(points[0].x, points[1].x, 0.01f);
+
+    const AttachmentPoint &attachment = fac->getAttachmentPoints()[0];
+    Vector2 point = Vector2Add(fac->worldPosition, attachment.position);
+    Vector2 inward = Vector2Scale(attachment.normal, -1.0f);
+    Vector2 gate = network.getNodePosition(network.getGate(fac));
+    EXPECT_NEAR(Vector2Distance(gate, RoadNetwork::lanePosition(point, inward)), 0.0f, 0.01f);
+}
+
+TEST_F(RoadNetworkTests, RouteFromTheGateItselfIsEmpty) {
+    const Module *fac = facilities.front();
+    int gate = network.getGate(fac);
+    Vector2 position = network.getNodePosition(gate);
+    Vector2 inward = Vector2Scale(fac->getAttachmentPoints()[0].normal, -1.0f);
+
+    std::vector<Vector2> points;
+    ASSERT_TRUE(network.route(position, inward, gate, points));
+    EXPECT_TRUE(points.empty());
+
+    // A car standing there goes straight to the gate, alignment and spot waypoints
+    Car car(position, nullptr, inward, Car::CarType::COMBUSTION);
+    std::vector<Waypoint> path = PathPlanner::GeneratePath(network, &car, fac, fac->getSpot(0));
+    EXPECT_EQ(path.size(), 3u);
+}
+
+TEST_F(RoadNetworkTests, CarsFollowTheirLaneOnly) {
+    const RoadNetwork::Terminal &entry = network.getEntries()[0];
+    int gate = network.getGate(facilities.back());
+    Vector2 onLane = Vector2Add(entry.position, Vector2Scale(entry.direction, 20.0f));
+
+    std::vector<Vector2> points;
+    ASSERT_TRUE(network.route(onLane, entry.direction, gate, points));
+    EXPECT_NEAR(length(onLane, points), network.getEntryDistance(0, gate) - 20.0f, 0.01f);
+
+    // Lanes are one way, and a car off the road is on none
+    EXPECT_FALSE(network.route(onLane, Vector2Scale(entry.direction, -1.0f), gate, points));
+    EXPECT_TRUE(points.empty());
+    Vector2 offRoad = {onLane.x, onLane.y + 2.0f * Config::Roads::SNAP_DISTANCE + 10.0f};
+    EXPECT_FALSE(network.route(offRoad, entry.direction, gate, points));
+    EXPECT_EQ(network.findNearestExit(offRoad, entry.direction), -1);
+
+    network.clear();
+    EXPECT_EQ(network.getNodeCount(), 0u);
+    EXPECT_EQ(network.getGate(facilities.back()), -1);
+}
+
+// Two strips joined by a connector. Strip A (top): road, double entrance, road, road. Strip B
+// (below): road, up entrance (the connector, under A's double entrance), down entrance. B ends
+// short of A's east end, so its east end is a dead end rather than a map end.
+class MultiRoadNetworkTests : public ::testing::Test {
+protected:
+    std::vector<std::unique_ptr<Module>> modules;
+    RoadNetwork network;
+    const Module *top = nullptr;
+    const Module *bottom = nullptr;
+    Vector2 deadEnd = {0, 0};
+
+    template <typename T, typename... Args> Module *add(Vector2 position, Args... args) {
+        modules.push_back(std::make_unique<T>(args...));
+        modules.back()->worldPosition = position;
+        return modules.back().get();
+    }
+
+    // A facility placed so that its attachment point meets one of a road's
+    const Module *attach(std::unique_ptr<Module> facility, const Module *road, int point) {
+        Vector2 at = Vector2Add(road->worldPosition, road->getAttachmentPoints()[point].position);
+        facility->worldPosition = Vector2Subtract(at, facility->getAttachmentPoints()[0].position);
+        modules.push_back(std::move(facility));
+        return modules.back().get();
+    }
+
+    void SetUp() override {
+        float road = NormalRoad().getWidth();
+        float entrance = DoubleEntranceRoad().getWidth();
+        float height = NormalRoad().getHeight();
+
+        add<NormalRoad>({0, 0});
+        Module *junction = add<DoubleEntranceRoad>({road, 0});
+        add<NormalRoad>({road + entrance, 0});
+        add<NormalRoad>({2 * road + entrance, 0});
+
+        add<NormalRoad>({0, height});
+        add<UpEntranceRoad>({road, height});
+        Module *last = add<DownEntranceRoad>({road + entrance, height});
+
+        top = attach(std::make_unique<SmallParking>(true), junction, 2);
+        bottom = attach(std::make_unique<SmallParking>(false), last, 2);
+        deadEnd = Vector2Add(last->worldPosition, last->getAttachmentPoints()[1].position);
+        network.build(modules);
+    }
+
+    int nodeAt(Vector2 position) const {
+        for (int n = 0; n < (int)network.getNodeCount(); n++)
+            if (Vector2Distance(network.getNodePosition(n), position) < Config::Roads::MERGE_DISTANCE)
+                return n;
+        return -1;
+    }
+
+    float routeLength(int from, int to) const {
+        std::vector<Vector2> points;
+        if (!network.route(from, to, points))
+            return RoadNetwork::UNREACHABLE;
+        return length(network.getNodePosition(from), points);
+    }
+};
+
+TEST_F(MultiRoadNetworkTests, MapEndsSkipTheDeadEnd) {
+    // West ends of both strips and the east end of A, each a way in and a way out
+    ASSERT_EQ(network.getEntries().size(), 3u);
+    ASSERT_EQ(network.getExits().size(), 3u);
+    int west = 0;
+    for (const auto &entry : network.getEntries()) {
+        EXPECT_GT(std::fabs(entry.position.x - deadEnd.x), 1.0f);
+        west += entry.direction.x > 0.0f;
+    }
+    EXPECT_EQ(west, 2);
+
+    // Into the dead end from B's west end, but no way on from there (roads have no U-turns)
+    int into = nodeAt(RoadNetwork::lanePosition(deadEnd, {1, 0}));
+    int outOf = nodeAt(RoadNetwork::lanePosition(deadEnd, {-1, 0}));
+    ASSERT_NE(into, -1);
+    ASSERT_NE(outOf, -1);
+    bool entered = false;
+    for (int i = 0; i < 3; i++) {
+        entered |= network.getEntryDistance(i, into) != RoadNetwork::UNREACHABLE;
+        EXPECT_EQ(network.getEntryDistance(i, outOf), RoadNetwork::UNREACHABLE);
+        EXPECT_EQ(network.getExitDistance(into, i), RoadNetwork::UNREACHABLE);
+    }
+    EXPECT_TRUE(entered);
+    EXPECT_EQ(network.findNearestExit(into), -1);
+    EXPECT_NE(network.findNearestExit(outOf), -1);
+}
+
+TEST_F(MultiRoadNetworkTests, BothGatesAreReachableAcrossTheConnector) {
+    for (const Module *fac : {top, bottom}) {
+        int gate = network.getGate(fac);
+        int out = network.getFacilityExit(fac);
+        ASSERT_NE(gate, -1);
+        ASSERT_NE(out, -1);
+        for (int i = 0; i < 3; i++) {
+            // Tree routes match the tree distances, from every map end of either strip
+            float toGate = network.getEntryDistance(i, gate);
+            ASSERT_NE(toGate, RoadNetwork::UNREACHABLE);
+            EXPECT_NEAR(routeLength(network.getEntries()[i].node, gate), toGate, 0.01f);
+
+            float toExit = network.getExitDistance(out, i);
+            ASSERT_NE(toExit, RoadNetwork::UNREACHABLE);
+            EXPECT_NEAR(routeLength(out, network.getExits()[i].node), toExit, 0.01f);
+        }
+    }
+}
+
+TEST_F(MultiRoadNetworkTests, SearchedRoutesAgreeWithTheTrees) {
+    const int nodes = (int)network.getNodeCount();
+    for (const Module *fac : {top, bottom}) {
+        int gate = network.getGate(fac);
+        for (int v = 0; v < nodes; v++) {
+            // From any node (searched with A* off the entries' shortest ways): never shorter than
+            // the entry trees allow
+            float rest = routeLength(v, gate);
+            for (int i = 0; i < 3; i++) {
+                float toV = network.getEntryDistance(i, v);
+                if (toV != RoadNetwork::UNREACHABLE && rest != RoadNetwork::UNREACHABLE) {
+                    EXPECT_GE(toV + rest, network.getEntryDistance(i, gate) - 0.01f);
+                }
+            }
+        }
+    }
+
+    // From one strip's facility to the other's, over the connector: a search, and no longer than
+    // going by any other node
+    for (auto [from, to] : {std::pair{top, bottom}, std::pair{bottom, top}}) {
+        int out = network.getFacilityExit(from);
+        int gate = network.getGate(to);
+        float direct = routeLength(out, gate);
+        ASSERT_NE(direct, RoadNetwork::UNREACHABLE);
+        for (int v = 0; v < nodes; v++) {
+            float first = routeLength(out, v);
+            float second = routeLength(v, gate);
+            if (first != RoadNetwork::UNREACHABLE && second != RoadNetwork::UNREACHABLE) {
+                EXPECT_LE(direct, first + second + 0.01f);
+            }
+        }
+    }
+}
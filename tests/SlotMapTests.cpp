@@ -0,0 +1,60 @@
+#include <gtest/gtest.h>
+#include "core/SlotMap.hpp"
+#include <string>
+
+TEST(SlotMapTests, InsertAndResolve) {
+    SlotMap<std::string> map;
+    SlotHandle a = map.insert("a");
+    SlotHandle b = map.insert("b");
+
+    ASSERT_NE(map.get(a), nullptr);
+    ASSERT_NE(map.get(b), nullptr);
+    EXPECT_EQ(*map.get(a), "a");
+    EXPECT_EQ(*map.get(b), "b");
+    EXPECT_EQ(map.size(), 2u);
+}
+
+TEST(SlotMapTests, RemovedHandleNoLongerResolves) {
+    SlotMap<int> map;
+    SlotHandle a = map.insert(1);
+
+    EXPECT_TRUE(map.remove(a));
+    EXPECT_EQ(map.get(a), nullptr);
+    EXPECT_FALSE(map.remove(a));
+
+    // The slot is recycled, but the old handle must not see the new value
+    SlotHandle b = map.insert(2);
+    EXPECT_EQ(b.index, a.index);
+    EXPECT_NE(b.generation, a.generation);
+    EXPECT_EQ(map.get(a), nullptr);
+    ASSERT_NE(map.get(b), nullptr);
+    EXPECT_EQ(*map.get(b), 2);
+}
+
+TEST(SlotMapTests, SwapRemoveKeepsOtherHandlesValid) {
+    SlotMap<int> map;
+    SlotHandle a = map.insert(10);
+    SlotHandle b = map.insert(20);
+    SlotHandle c = map.insert(30);
+
+    map.remove(a); // c moves into a's dense position
+
+    EXPECT_EQ(map.size(), 2u);
+    EXPECT_EQ(*map.get(b), 20);
+    EXPECT_EQ(*map.get(c), 30);
+    EXPECT_EQ(map.values()[0], 30);
+    EXPECT_EQ(map.handleAt(0), c);
+}
+
+TEST(SlotMapTests, ClearInvalidatesAllHandles) {
+    SlotMap<int> map;
+    SlotHandle a = map.insert(1);
+    SlotHandle b = map.insert(2);
+
+    map.clear();
+
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(map.get(a), nullptr);
+    EXPECT_EQ(map.get(b), nullptr);
+    EXPECT_EQ(map.get(SlotHandle{}), nullptr);
+}
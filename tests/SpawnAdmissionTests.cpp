@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+#include "config.hpp"
+#include "core/Checkpoint.hpp"
+#include "core/EntityManager.hpp"
+#include "systems/TrafficSystem.hpp"
+#include <cmath>
+#include <memory>
+#include <vector>
+
+class SpawnAdmissionTests : public ::testing::Test {
+protected:
+    std::shared_ptr<EventBus> bus = std::make_shared<EventBus>();
+    EntityManager em{bus};
+    TrafficSystem traffic{bus, em};
+    std::vector<Subscription> tokens;
+    int reportedLength = 0;
+    int crowdedSpawns = 0;
+
+    void SetUp() override {
+        em.getRandom().reseed(7);
+        bus->publish(GenerateWorldEvent{MapConfig{2, 2, 2, 2, {}}});
+
+        tokens.push_back(bus->subscribe<SpawnQueueChangedEvent>(
+            [this](const SpawnQueueChangedEvent &e) { reportedLength = e.length; }));
+
+        // Every new car must find its entry clear of the other cars of its lane
+        tokens.push_back(bus->subscribe<CarSpawnedEvent>([this](const CarSpawnedEvent &e) {
+            const Car *spawned = em.getCar(e.carId);
+            for (const auto &car : em.getCars()) {
+                if (car.get() == spawned || car->getState() == Car::CarState::PARKED)
+                    continue;
+                Vector2 d = {car->getPosition().x - spawned->getPosition().x,
+                             car->getPosition().y - spawned->getPosition().y};
+                if (std::fabs(d.y) < 1.0f && std::fabs(d.x) < Config::Spawner::ENTRY_CLEARANCE)
+                    crowdedSpawns++;
+            }
+        }));
+    }
+
+    void run(int ticks) {
+        for (int i = 0; i < ticks; i++)
+            bus->publish(GameUpdateEvent{1.0 / 60.0});
+    }
+};
+
+TEST_F(SpawnAdmissionTests, BurstWaitsInTheQueue) {
+    for (int i = 0; i < 20; i++)
+        bus->publish(SpawnCarRequestEvent{});
+
+    // At most one car per entry enters at once, the rest wait as queued arrivals
+    EXPECT_LE(em.getCars().size(), 2u);
+    EXPECT_EQ(traffic.getSpawnQueueLength(), 20 - (int)em.getCars().size());
+    EXPECT_EQ(reportedLength, traffic.getSpawnQueueLength());
+
+    int previous = traffic.getSpawnQueueLength();
+    run(120);
+    EXPECT_LT(traffic.getSpawnQueueLength(), previous);
+
+    run(1200);
+    EXPECT_EQ(traffic.getSpawnQueueLength(), 0);
+    EXPECT_EQ(reportedLength, 0);
+    EXPECT_EQ(crowdedSpawns, 0);
+}
+
+TEST_F(SpawnAdmissionTests, CheckpointKeepsTheQueue) {
+    for (int i = 0; i < 12; i++)
+        bus->publish(SpawnCarRequestEvent{});
+    run(30);
+    int queued = traffic.getSpawnQueueLength();
+    ASSERT_GT(queued, 0);
+
+    Checkpoint checkpoint = Checkpoint::capture(em, traffic);
+    run(1200);
+    EXPECT_EQ(traffic.getSpawnQueueLength(), 0);
+
+    checkpoint.restore(em, traffic);
+    EXPECT_EQ(traffic.getSpawnQueueLength(), queued);
+    EXPECT_EQ(reportedLength, queued);
+    run(1200);
+    EXPECT_EQ(traffic.getSpawnQueueLength(), 0);
+    EXPECT_EQ(crowdedSpawns, 0);
+}
@@ -0,0 +1,78 @@
+#include <gtest/gtest.h>
+#include "config.hpp"
+#include "entities/Car.hpp"
+#include "entities/map/SplinePath.hpp"
+#include "raymath.h"
+#include <cmath>
+#include <vector>
+
+TEST(SplinePathTests, StraightRunsStayStraight) {
+    SplinePath curve;
+    std::vector<Waypoint> path = {Waypoint({10.0f, 0.0f}), Waypoint({40.0f, 0.0f})};
+    curve.build({0.0f, 0.0f}, {15.0f, 0.0f}, path);
+
+    ASSERT_EQ(curve.getSegmentCount(), 2u);
+    EXPECT_NEAR(curve.getWaypointDistance(0), 10.0f, 1e-3f);
+    EXPECT_NEAR(curve.getLength(), 40.0f, 1e-3f);
+    for (float d = 0.0f; d <= 40.0f; d += 2.5f) {
+        SplinePath::Sample at = curve.sample(d);
+        EXPECT_NEAR(at.position.x, d, 0.05f);
+        EXPECT_EQ(at.position.y, 0.0f);
+        EXPECT_NEAR(at.tangent.x, 1.0f, 1e-4f);
+    }
+
+    // Clamped to the ends
+    EXPECT_EQ(curve.sample(-5.0f).position.x, 0.0f);
+    EXPECT_NEAR(curve.sample(100.0f).position.x, 40.0f, 1e-4f);
+}
+
+TEST(SplinePathTests, CornersAreSmoothAndHitTheWaypoints) {
+    SplinePath curve;
+    std::vector<Waypoint> path = {Waypoint({30.0f, 0.0f}), Waypoint({30.0f, 20.0f}), Waypoint({0.0f, 20.0f})};
+    curve.build({0.0f, 0.0f}, {1.0f, 0.0f}, path);
+
+    // Through every waypoint, turning at each
+    for (size_t i = 0; i < path.size(); i++) {
+        Vector2 at = curve.sample(curve.getWaypointDistance(i)).position;
+        EXPECT_NEAR(Vector2Distance(at, path[i].position), 0.0f, 1e-3f);
+    }
+    Vector2 corner = curve.sample(curve.getWaypointDistance(0)).tangent;
+    EXPECT_NEAR(corner.x, corner.y, 1e-3f);
+
+    // Close to the length of the waypoint polyline, and even steps of distance along it
+    float polyline = 30.0f + 20.0f + 30.0f;
+    EXPECT_GT(curve.getLength(), polyline * 0.9f);
+    EXPECT_LT(curve.getLength(), polyline * 1.1f);
+    Vector2 previous = curve.sample(0.0f).position;
+    for (float d = 0.5f; d <= curve.getLength(); d += 0.5f) {
+        Vector2 p = curve.sample(d).position;
+        EXPECT_NEAR(Vector2Distance(previous, p), 0.5f, 0.05f);
+        previous = p;
+    }
+
+    // A start heading pointing away from the path is ignored
+    curve.build({0.0f, 0.0f}, {-1.0f, 0.0f}, path);
+    EXPECT_GT(curve.sample(0.0f).tangent.x, 0.99f);
+}
+
+TEST(SplinePathTests, IdmCarFollowsTheCurve) {
+    Car car({0.0f, 0.0f}, nullptr, {10.0f, 0.0f}, Car::CarType::COMBUSTION);
+    car.setPath({Waypoint({40.0f, 0.0f}, 0.5f), Waypoint({40.0f, 40.0f}, 0.5f, -1, 0.0f, true)});
+    SplinePath curve;
+    curve.build({0.0f, 0.0f}, {10.0f, 0.0f}, car.getWaypoints());
+
+    float worst = 0.0f;
+    for (int i = 0; i < 1200 && !car.hasArrived(); i++) {
+        car.updateWithNeighbors(1.0 / 60.0, {}, CarFollowingModel::IDM);
+
+        // On the curve: within the table's blending of the closest sample
+        float closest = INFINITY;
+        for (float d = 0.0f; d <= curve.getLength(); d += 0.1f)
+            closest = std::min(closest, Vector2Distance(car.getPosition(), curve.sample(d).position));
+        worst = std::max(worst, closest);
+    }
+    EXPECT_TRUE(car.hasArrived());
+    EXPECT_EQ(car.getState(), Car::CarState::ALIGNING);
+    EXPECT_LT(worst, 0.1f);
+    EXPECT_LT(Vector2Distance(car.getPosition(), {40.0f, 40.0f}), 0.5f);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+#include "core/EntityManager.hpp"
+#include "systems/SpotMatcher.hpp"
+#include "systems/TrafficSystem.hpp"
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace {
+using Candidate = SpotMatcher::Candidate;
+
+struct Outcome {
+    int placed = 0;
+    long cost = 0;
+    bool operator==(const Outcome &) const = default;
+};
+
+// Every way to seat the cars (or leave them out): most cars placed, then the lowest cost
+Outcome bruteForce(const std::vector<std::vector<Candidate>> &cars, int spotCount) {
+    Outcome best{-1, 0};
+    std::vector<char> used(spotCount, 0);
+    std::function<void(size_t, Outcome)> seat = [&](size_t car, Outcome current) {
+        if (car == cars.size()) {
+            if (current.placed > best.placed || (current.placed == best.placed && current.cost < best.cost))
+                best = current;
+            return;
+        }
+        seat(car + 1, current);
+        for (const Candidate &c : cars[car]) {
+            if (used[c.spot])
+                continue;
+            used[c.spot] = 1;
+            seat(car + 1, {current.placed + 1, current.cost + c.cost});
+            used[c.spot] = 0;
+        }
+    };
+    seat(0, {0, 0});
+    return best;
+}
+} // namespace
+
+TEST(SpotMatcherTests, ReshufflesEarlierCarsToPlaceMore) {
+    // The first car prefers spot 0, but the second can only take spot 0
+    std::vector<SpotMatcher::Group> groups(2);
+    groups[0] = {1, {{0, 0}, {1, 1000}}};
+    groups[1] = {1, {{0, 0}}};
+    auto assigned = SpotMatcher::solve(groups, 2);
+    EXPECT_EQ(assigned[0], std::vector<int>{1});
+    EXPECT_EQ(assigned[1], std::vector<int>{0});
+
+    // More cars than spots: the cheapest spots are filled, the rest stay out
+    groups = {{5, {{0, 3}, {1, 1}, {2, 2}}}};
+    assigned = SpotMatcher::solve(groups, 3);
+    EXPECT_EQ(assigned[0].size(), 3u);
+}
+
+TEST(SpotMatcherTests, MatchesBruteForce) {
+    std::mt19937 rng(4);
+    for (int trial = 0; trial < 500; trial++) {
+        int spotCount = 1 + (int)(rng() % 6);
+        std::vector<SpotMatcher::Group> groups(1 + rng() % 3);
+        std::vector<std::vector<Candidate>> cars;
+        for (SpotMatcher::Group &group : groups) {
+            group.cars = 1 + (int)(rng() % 2);
+            for (int s = 0; s < spotCount; s++) {
+                // Few cost levels on odd trials, to provoke ties
+                if (rng() % 2)
+                    group.candidates.push_back({s, (int)(rng() % (trial % 2 ? 3 : 1001))});
+            }
+            cars.insert(cars.end(), group.cars, group.candidates);
+        }
+
+        auto assigned = SpotMatcher::solve(groups, spotCount);
+        Outcome outcome;
+        std::vector<int> taken(spotCount, 0);
+        for (size_t g = 0; g < groups.size(); g++) {
+            ASSERT_LE((int)assigned[g].size(), groups[g].cars);
+            for (int spot : assigned[g]) {
+                ASSERT_EQ(taken[spot]++, 0);
+                auto it = std::find_if(groups[g].candidates.begin(), groups[g].candidates.end(),
+                                       [spot](const Candidate &c) { return c.spot == spot; });
+                ASSERT_NE(it, groups[g].candidates.end());
+                outcome.placed++;
+                outcome.cost += it->cost;
+            }
+        }
+        EXPECT_EQ(outcome, bruteForce(cars, spotCount)) << "trial " << trial;
+    }
+}
+
+TEST(SpotMatcherTests, BatchModeAssignsEveryArrival) {
+    auto bus = std::make_shared<EventBus>();
+    SimulationParams params;
+    params.spotAssignment = SpotAssignmentMode::BATCH;
+    EntityManager em(bus, params);
+    TrafficSystem traffic(bus, em);
+    em.getRandom().reseed(9);
+    bus->publish(GenerateWorldEvent{MapConfig{2, 2, 2, 2, {}}});
+
+    int spawned = 0;
+    int turnedAway = 0;
+    std::vector<Subscription> tokens;
+    tokens.push_back(bus->subscribe<CarSpawnedEvent>([&](const CarSpawnedEvent &) { spawned++; }));
+    tokens.push_back(bus->subscribe<CarTurnedAwayEvent>([&](const CarTurnedAwayEvent &) { turnedAway++; }));
+
+    for (int i = 0; i < 12; i++)
+        bus->publish(SpawnCarRequestEvent{});
+    // Until the entries let everyone in, then one more assignment window
+    for (int i = 0; i < 3600 && traffic.getSpawnQueueLength() > 0; i++)
+        bus->publish(GameUpdateEvent{1.0 / 60.0});
+    for (int i = 0; i < 60; i++)
+        bus->publish(GameUpdateEvent{1.0 / 60.0});
+
+    // Plenty of free spots: every arrival got one, each reserved (or taken) once
+    EXPECT_EQ(spawned, 12);
+    EXPECT_EQ(turnedAway, 0);
+    const OccupancyCounters &c = em.getOccupancyStats().getCounters();
+    EXPECT_EQ(c.reservedSpots + c.occupiedSpots, 12);
+    for (const auto &car : em.getCars())
+        EXPECT_NE(car->getParkedFacility(), nullptr);
+}
@@ -0,0 +1,76 @@
+#include <gtest/gtest.h>
+#include "core/TripleBuffer.hpp"
+#include <atomic>
+#include <thread>
+
+TEST(TripleBufferTests, RefreshWithoutPublishKeepsFront) {
+    TripleBuffer<int> buffer;
+    buffer.writeBuffer() = 7;
+
+    EXPECT_FALSE(buffer.refresh());
+    EXPECT_EQ(buffer.readBuffer(), 0);
+}
+
+TEST(TripleBufferTests, ReaderSeesLatestPublishedValue) {
+    TripleBuffer<int> buffer;
+
+    buffer.writeBuffer() = 1;
+    buffer.publish();
+    buffer.writeBuffer() = 2;
+    buffer.publish();
+
+    EXPECT_TRUE(buffer.refresh());
+    EXPECT_EQ(buffer.readBuffer(), 2);
+
+    // Nothing new since the last refresh
+    EXPECT_FALSE(buffer.refresh());
+    EXPECT_EQ(buffer.readBuffer(), 2);
+}
+
+TEST(TripleBufferTests, WriterNeverTouchesReaderSlot) {
+    TripleBuffer<int> buffer;
+
+    buffer.writeBuffer() = 1;
+    buffer.publish();
+    ASSERT_TRUE(buffer.refresh());
+    const int *front = &buffer.readBuffer();
+
+    for (int i = 2; i < 10; i++) {
+        EXPECT_NE(&buffer.writeBuffer(), front);
+        buffer.writeBuffer() = i;
+        buffer.publish();
+    }
+    EXPECT_EQ(*front, 1);
+}
+
+TEST(TripleBufferTests, ConcurrentValuesAreMonotonic) {
+    struct Payload {
+        int a = 0;
+        int b = 0;
+    };
+    TripleBuffer<Payload> buffer;
+    std::atomic<bool> done{false};
+    constexpr int count = 100000;
+
+    std::thread writer([&]() {
+        for (int i = 1; i <= count; i++) {
+            buffer.writeBuffer() = {i, -i};
+            buffer.publish();
+        }
+        done = true;
+    });
+
+    int last = 0;
+    bool consistent = true;
+    while (!done || buffer.refresh()) {
+        buffer.refresh();
+        const Payload &p = buffer.readBuffer();
+        if (p.a != -p.b || p.a < last)
+            consistent = false;
+        last = p.a;
+    }
+    writer.join();
+
+    EXPECT_TRUE(consistent);
+    EXPECT_EQ(buffer.readBuffer().a, count);
+}